@@ -24,6 +24,9 @@ disp(sprintf('\nExplicit controller (based on %s controller %s)',...
 disp(sprintf('%3d parameter(s)',expcon.npar));
 disp(sprintf('%3d input(s)',expcon.nu));
 disp(sprintf('%3d partition(s)',sum(expcon.nr)));
+if isfield(expcon.info,'lazy') && ~isempty(expcon.info.lazy),
+    disp('    (lazy controller: further regions are computed online, see REFINE)');
+end
 disp(sprintf('sampling time = %g',expcon.ts));
 disp(' ')
 sys='????';
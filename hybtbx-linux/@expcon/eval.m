@@ -16,6 +16,19 @@ function [U,region,Useq,cost]=eval(expcon,x);
 %
 %   [u,j,Useq]=EVAL(EXPCON,TH) also returns the entire optimal sequence, if this
 %   was stored by setting options.sequence=1 when constructing the explicit controller.
+%
+%   For compact controllers (options.compact=N>0 in EXPCON) the regions
+%   used last are tested first; then the active sets of the other regions
+%   are tested at TH, and the critical region and gain of the one found are
+%   reconstructed and kept among the last N used regions. The optimal
+%   sequence Useq is always available.
+%
+%   For lazy controllers (options.lazy=1 in EXPCON) the regions found so
+%   far are tested, starting from the last one used. If TH is not covered,
+%   the QP is solved, and the critical region of its optimal active set is
+%   added to the partition kept in memory (see EXPCON/REFINE). If TH is
+%   on a degenerate region that cannot be stored, the QP solution is
+%   returned with j=0. The optimal sequence Useq is always available.
 
 % (C) 2003-2004 by Alberto Bemporad
 
@@ -44,6 +57,17 @@ if ~expcon.info.isconstr,
    return
 end
 
+if isfield(expcon.info,'compact') && ~isempty(expcon.info.compact),
+    [U,region,Useq]=evalcompact(expcon,x);
+    cost='not computed';
+    return
+end
+if isfield(expcon.info,'lazy') && ~isempty(expcon.info.lazy),
+    [U,region,Useq]=evallazy(expcon,x);
+    cost='not computed';
+    return
+end
+
 % 2005-10-7: Bound check removed from here to prevent numerical errors
 %            generating infeasibility, but done in case infeasibility is detected.
 % if any(x>expcon.thmax)|any(x<expcon.thmin),
@@ -75,7 +99,7 @@ else
     nvar=expcon.info.nvar;
 end
 
-if expcon.info.islin || (expcon.info.ishyb && isinf(expcon.norm)) || expcon.info.ismpc,
+if expcon.info.islin || (expcon.info.ishyb && isinf(expcon.norm) && ~iscell(H)) || expcon.info.ismpc,
     i=1;
     while i<=nr && flag,
         i1i=i1(i);
@@ -105,7 +129,8 @@ else
 
     
     
-    % Hybrid 2-norm, must compare value functions
+    % Hybrid 2-norm or Inf-norm by dynamic programming (multiple
+    % partitions), must compare value functions
     value=Inf;
     for j=1:length(nr), % = number of partitions
         i=1;
@@ -121,7 +146,23 @@ else
             i1i=i1j(i);
             i2i=i2j(i);
             Hi=Hj(i1i:i2i,:);
-            if all(Hi*x<=Kj(i1i:i2i,:)),
+            if all(Hi*x<=Kj(i1i:i2i,:)) && isinf(expcon.norm),
+                % theta belongs to this region, the cost is affine
+                thisvalue=expcon.cost{j}.V(i,:)*x+expcon.cost{j}.v(i);
+                if thisvalue<value,
+                    value=thisvalue;
+                    U=Fj((i-1)*nu+1:i*nu,:)*x+Gj((i-1)*nu+1:i*nu,:);
+                    region=sum(nr(1:j-1))+i;
+                    if nargout>=3,
+                        Useq='not computed';
+                    end
+                    if nargout>=4,
+                        cost=thisvalue;
+                    end
+                end
+                thisflag=0; % Abandon the current partition
+                flag=0; % The solution has been found
+            elseif all(Hi*x<=Kj(i1i:i2i,:)),
                 % theta belongs to this region
                 H1=expcon.cost{j}.H; % Hessian:       .5*U'HU
                 D1=expcon.cost{j}.D; % Linear term:   theta'D'U
@@ -174,4 +215,176 @@ if flag,
     U=Inf*ones(expcon.nu,1); %(infeasible)
 end
 
-%U=Z-Hinv*F'*x;
\ No newline at end of file
+%U=Z-Hinv*F'*x;
+
+%-----------------
+function [U,region,Useq]=evalcompact(expcon,x)
+% Point location in a compact controller: reconstructed regions (most
+% recently used first), regions stored explicitly, then the active sets
+% of the remaining regions
+
+persistent Rc
+
+cmp=expcon.info.compact;
+cost=expcon.cost;
+nu=expcon.nu;
+tol=1e-8;
+if isempty(Rc) || ~isequal(Rc.id,cmp.id),
+    % Shared data of the active-set tests
+    Rc=struct('id',cmp.id,'GZ',cost.G*cmp.Rinv,'RC',cmp.Rinv'*cost.C,...
+        'reg',zeros(0,1),'used',zeros(0,1),'clock',0);
+    Rc.H={};
+    Rc.K={};
+    Rc.F={};
+    Rc.g={};
+end
+
+U=Inf*ones(nu,1); % (infeasible)
+Useq='not computed';
+if any(x>expcon.thmax+tol) || any(x<expcon.thmin-tol),
+    warning('Determining the control action is impossible');
+    warning('Parameters are outside bounds')
+    region=-2;
+    return
+end
+
+[aux,ord]=sort(-Rc.used);
+for j=ord(:)',
+    if all(Rc.H{j}*x<=Rc.K{j}+tol),
+        Rc.clock=Rc.clock+1;
+        Rc.used(j)=Rc.clock;
+        z=Rc.F{j}*x+Rc.g{j};
+        U=z(1:nu);
+        Useq=z;
+        region=Rc.reg(j);
+        return
+    end
+end
+
+ne=numel(cmp.explicit);
+if ne>0,
+    nF=size(expcon.F,1)/ne;
+    for k=1:ne,
+        Hk=expcon.H(expcon.i1(k):expcon.i2(k),:);
+        if all(Hk*x<=expcon.K(expcon.i1(k):expcon.i2(k))),
+            ii=(k-1)*nF;
+            U=expcon.F(ii+1:ii+nu,:)*x+expcon.G(ii+1:ii+nu);
+            if nF>nu,
+                Useq=expcon.F(ii+1:ii+nF,:)*x+expcon.G(ii+1:ii+nF);
+            end
+            region=cmp.explicit(k);
+            return
+        end
+    end
+end
+
+% Active set act is optimal at x if its multipliers are nonnegative and
+% the corresponding optimizer is feasible
+a1=double(cmp.a1);
+a2=double(cmp.a2);
+skip=(a1==0);
+skip(Rc.reg)=true;
+y0=Rc.RC*x;
+b=cost.W+cost.S*x;
+for i=find(~skip(:))',
+    act=double(cmp.act(a1(i):a2(i)));
+    GA=Rc.GZ(act,:);
+    lam=-(GA*GA')\(b(act)+GA*y0);
+    if any(lam<-tol),
+        continue
+    end
+    v=y0+GA'*lam;
+    if any(-Rc.GZ*v>b+tol*(1+abs(b))),
+        continue
+    end
+    [H,K,Fz,gz]=actregion(cost,cmp.Rinv,act);
+    if numel(Rc.used)<cmp.cachesize,
+        j=numel(Rc.used)+1;
+    else
+        [aux,j]=min(Rc.used); % least recently used
+    end
+    Rc.H{j}=H;
+    Rc.K{j}=K;
+    Rc.F{j}=Fz;
+    Rc.g{j}=gz;
+    Rc.reg(j,1)=i;
+    Rc.clock=Rc.clock+1;
+    Rc.used(j,1)=Rc.clock;
+    z=-cmp.Rinv*v;
+    U=z(1:nu);
+    Useq=z;
+    region=i;
+    return
+end
+
+warning('Determining the control action is impossible');
+region=-1;
+
+%-----------------
+function [U,region,Useq]=evallazy(expcon,x)
+% Point location in a lazy controller: regions found so far (last used
+% first), otherwise QP solution and new critical region
+
+Lz=lazyregions(expcon);
+lz=expcon.info.lazy;
+nu=expcon.nu;
+tol=1e-8;
+
+U=Inf*ones(nu,1); % (infeasible)
+Useq='not computed';
+if any(x>expcon.thmax+tol) || any(x<expcon.thmin-tol),
+    warning('Determining the control action is impossible');
+    warning('Parameters are outside bounds')
+    region=-2;
+    return
+end
+
+n=numel(Lz.act);
+if Lz.last>0,
+    ord=[Lz.last,1:Lz.last-1,Lz.last+1:n];
+else
+    ord=1:n;
+end
+for k=ord,
+    if all(Lz.H{k}*x<=Lz.K{k}+tol),
+        if k~=Lz.last,
+            Lz.last=k;
+            lazyregions(expcon,Lz);
+        end
+        z=Lz.F{k}*x+Lz.g{k};
+        U=z(1:nu);
+        Useq=z;
+        region=k;
+        return
+    end
+end
+
+[act,z,how]=qpactset(expcon.cost,Lz.GZ,x,lz.reltol);
+if ~strcmp(how,'ok'),
+    warning('Determining the control action is impossible');
+    region=-1;
+    return
+end
+U=z(1:nu);
+Useq=z;
+region=0;
+
+[H,K,Fz,gz]=actregion(expcon.cost,lz.Rinv,act);
+npar=expcon.npar;
+H=[H;eye(npar);-eye(npar)];
+K=[K;expcon.thmax(:);-expcon.thmin(:)];
+if any(H*x-K>lz.reltol),
+    return % degenerate active set, region not stored
+end
+[H,K,isemptypoly]=polyreduce(H,K,lptype);
+if isemptypoly,
+    return
+end
+region=n+1;
+Lz.act{region,1}=act;
+Lz.H{region,1}=H;
+Lz.K{region,1}=K;
+Lz.F{region,1}=Fz;
+Lz.g{region,1}=gz;
+Lz.last=region;
+lazyregions(expcon,Lz);
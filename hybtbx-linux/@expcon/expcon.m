@@ -39,6 +39,44 @@ function C=expcon(con,range,options)
 %                  as an explicit function of the parameters also in the
 %                  linear case. Flag ignored in the hybrid case: sequence
 %                  always stored with quadratic costs, never stored with inf-norms.
+%    .compact    = number N of regions kept in memory by EXPCON/EVAL (linear
+%                  controllers only, default: 0). If N>0, only the optimal
+%                  active set of each region is stored, together with the
+%                  QP matrices: EVAL reconstructs the critical regions and
+%                  gains when needed and keeps the last N used ones (LRU).
+%                  This reduces the memory occupancy of large controllers
+%                  at the price of a slower evaluation. Regions are not
+%                  joined. Regions whose active set cannot be determined
+%                  (flat, degenerate) are still stored explicitly in
+%                  H,K,F,G. PLOT, HWRITE and LATEX need the regions and do
+%                  not support compact controllers.
+%    .nthreads   = number of threads used for the multiparametric QP of
+%                  linear controllers when parallel=1, or for the dynamic
+%                  programming of hybrid controllers when method='dp'
+%                  (default: 0 = all cores).
+%    .parallel   = flag for exploring the critical regions of linear
+%                  controllers on several threads by MPQPPAR (requires the
+%                  MEX function MPQPPARMEX, default: 0 = MPQP is used).
+%                  Regions thinner than flattol are discarded without
+%                  enlarging the neighboring ones as MPQP does, and
+%                  qpsolver and lpsolver are not used.
+%    .lazy       = flag for building the explicit controller on demand (linear
+%                  controllers only, default: 0). If lazy=1, no region is
+%                  computed here: EXPCON/EVAL solves the QP for parameters
+%                  not covered yet, computes the critical region of the
+%                  optimal active set and adds it to a partition kept in
+%                  memory. E=REFINE(E) stores that partition in E, in the
+%                  format of a full explicit controller (so that it can be
+%                  saved, plotted or exported by HWRITE). Regions are not
+%                  joined, options 'compact' and 'join' are ignored.
+%    .method     = algorithm for hybrid controllers with Inf-norm costs:
+%                  'enum' (default) solves mp-LPs for the feasible mode
+%                  sequences (PWAOPT), 'dp' runs a multiparametric dynamic
+%                  programming backwards in time on several threads, and
+%                  only extends the mode sequences that are optimal
+%                  somewhere (PWADP, requires hard constraints and the MEX
+%                  function PWADPMEX). With 'dp' the solution is made of
+%                  overlapping partitions, as for 2-norm hybrid controllers.
 %
 % Example: to fix the reference signal for x(1),x(2) at the values
 % rx(1)=0.6, rx(2)=-1.4 and mantain the reference rx(3) for x(3) as a free
@@ -55,7 +93,7 @@ function C=expcon(con,range,options)
 info=struct('rCheb',[],'flattol',[],'colors',[],'islin',[],'ishyb',[],...
     'ismpc',[],'name',[],...
     'lintracking',[],'isconstr',[],'refsignals',[],'refsize',[],...
-    'fixref',[],'valueref',[],'fixmd',[],'valuemd',[]);
+    'fixref',[],'valueref',[],'fixmd',[],'valuemd',[],'compact',[],'lazy',[]);
 
 if nargin<1,
 %     C=struct('H',[],'K',[],'F',[],'G',[],'i1',[],'i2',[],'nr',[],'thmin',[],'thmax',[],'nu',[],...
@@ -121,7 +159,8 @@ fixdef=struct('x',[],'u',[],'y',[]);
 optdef=struct('lpsolver','glpk','qpsolver','qpact','fixref',fixdef,'valueref',valuedef,...
     'fixmd',[],'valuemd',[],'noslack',0,...
     'flattol',1e-6,'waitbar',1,'verbose',0,'mplpverbose',1,'uniteeps',1e-3,...
-    'join',1,'reltol',1e-6,'sequence',0);
+    'join',1,'reltol',1e-6,'sequence',0,'compact',0,'nthreads',0,'lazy',0,...
+    'method','enum','parallel',0);
 if nargin<3 || isempty(options),
     options=optdef;
 end
@@ -199,14 +238,36 @@ if islin,
     end
     %try
     envelope=0;
-    mpqpsol=mpqp(con.Q,con.C,con.G,con.W,con.S,thmin,thmax,options.verbose,...
-        options.qpsolver,options.lpsolver,envelope,[],[],options.reltol);
-    [C,colors]=getcontroller(mpqpsol,nu,options.uniteeps,options.reltol,...
-        options.join,options.lpsolver,options.sequence);
-    info.rCheb=C.rCheb;
-    info.flattol=C.flattol;
-    C=rmfield(C,'rCheb');
-    C=rmfield(C,'flattol');
+    if options.compact>0,
+        options.join=0; % Each region must be a critical region
+    end
+    if options.lazy && con.isconstr,
+        % Empty partition, regions are added by EVAL
+        npar=length(thmin);
+        C=struct('H',zeros(0,npar),'K',zeros(0,1),'F',zeros(0,npar),'G',zeros(0,1),...
+            'i1',zeros(0,1),'i2',zeros(0,1),'nr',0,'thmin',thmin,'thmax',thmax,...
+            'nu',nu,'npar',npar);
+        colors=[];
+        info.rCheb=zeros(0,1);
+        info.flattol=options.reltol;
+    else
+        if options.parallel && exist('mpqpparmex')~=3,
+            warning('MPQPPARMEX is not compiled, using MPQP');
+        end
+        if options.parallel && exist('mpqpparmex')==3,
+            mpqpsol=mpqppar(con.Q,con.C,con.G,con.W,con.S,thmin,thmax,options.verbose,...
+                options.flattol,options.nthreads);
+        else
+            mpqpsol=mpqp(con.Q,con.C,con.G,con.W,con.S,thmin,thmax,options.verbose,...
+                options.qpsolver,options.lpsolver,envelope,[],[],options.reltol);
+        end
+        [C,colors]=getcontroller(mpqpsol,nu,options.uniteeps,options.reltol,...
+            options.join,options.lpsolver,options.sequence);
+        info.rCheb=C.rCheb;
+        info.flattol=C.flattol;
+        C=rmfield(C,'rCheb');
+        C=rmfield(C,'flattol');
+    end
 
     info.nvar=size(con.Q,1); % number of optimization variables
 
@@ -384,8 +445,16 @@ elseif ishyb
         setup.qpsolver=options.qpsolver;
     end
     setup.sequence=options.sequence;
-    [sol,lpsolved,colors]=pwaopt(con.pwa,con.horizon,setup);
-    if isinf(setup.norm),
+    if ~isinf(setup.norm) && strcmp(options.method,'dp'),
+        warning('Option method=''dp'' only applies to Inf-norm costs, using method=''enum''');
+    end
+    if isinf(setup.norm) && strcmp(options.method,'dp'),
+        setup.nthreads=options.nthreads;
+        [sol,lpsolved,colors]=pwadp(con.pwa,con.horizon,setup);
+    else
+        [sol,lpsolved,colors]=pwaopt(con.pwa,con.horizon,setup);
+    end
+    if isinf(setup.norm) && ~isfield(sol,'cost'),
         costs=[];
     else
         costs=sol.cost;
@@ -445,6 +514,13 @@ if islin,
     end
     sHm=Udata.sHm;
     C.cost=struct('Q',con.Q*sHm,'C',con.C*sHm,'G',con.G,'W',con.W,'S',con.S,'Y',Udata.Y*sHm);
+    if options.lazy && info.isconstr,
+        info.lazy=struct('Rinv',inv(chol(C.cost.Q)),'reltol',options.reltol,...
+            'act',{cell(0,1)},'id',[now rand]);
+    elseif options.compact>0 && info.isconstr,
+        % Keep only the optimal active sets of the regions
+        [C,info.compact]=compactregions(C,options.compact,options.reltol);
+    end
 elseif ishyb,
     info.lintracking=NaN;
     info.isconstr=1;
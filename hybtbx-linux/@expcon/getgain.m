@@ -7,6 +7,9 @@ function [Fi,Gi,Hi,Ki]=getgain(expcon,reg);
 %   [F,G,H,K]=GETGAIN(EXPCON,I) also returns the polyhedral cell H*x<=K
 %   corresponding to region number I of the PWA map stored in controller EXPCON. 
 %
+%   For compact controllers (see EXPCON) the region and gain are
+%   reconstructed from the optimal active set of region I.
+%
 %   See also EXPCON/GETREGNUM
 %
 % (C) 2003-2006 by Alberto Bemporad
@@ -27,15 +30,36 @@ end
 i1=expcon.i1;
 i2=expcon.i2;
 nu=expcon.nu;
+
+if isfield(expcon.info,'compact') && ~isempty(expcon.info.compact),
+    cmp=expcon.info.compact;
+    k=find(cmp.explicit==reg);
+    if isempty(k),
+        act=double(cmp.act(double(cmp.a1(reg)):double(cmp.a2(reg))));
+        [Hi,Ki,Fi,Gi]=actregion(expcon.cost,cmp.Rinv,act);
+        npar=expcon.npar;
+        Hi=[Hi;eye(npar);-eye(npar)];
+        Ki=[Ki;expcon.thmax(:);-expcon.thmin(:)];
+        Fi=Fi(1:nu,:);
+        Gi=Gi(1:nu);
+    else
+        nF=size(expcon.F,1)/numel(cmp.explicit);
+        Hi=expcon.H(i1(k):i2(k),:);
+        Ki=expcon.K(i1(k):i2(k),:);
+        Fi=expcon.F((k-1)*nF+1:(k-1)*nF+nu,:);
+        Gi=expcon.G((k-1)*nF+1:(k-1)*nF+nu,:);
+    end
+    return
+end
 Hi=expcon.H;
 Ki=expcon.K;
 Fi=expcon.F;
 Gi=expcon.G;
 
-if expcon.info.islin || (expcon.info.ishyb && isinf(expcon.norm)),
+if expcon.info.islin || (expcon.info.ishyb && isinf(expcon.norm) && ~iscell(Hi)),
     % do nothing
 else
-    % Hybrid 2-norm, multiple partitions
+    % Hybrid 2-norm or Inf-norm by dynamic programming, multiple partitions
     cumnr2=cumsum(nr);
     cumnr1=cumnr2-nr+1;
     par=find(and(reg>=cumnr1,reg<=cumnr2));
@@ -30,6 +30,9 @@ if ~isa(expcon,'expcon'),
     error('expcon:move:obj','Invalid EXPCON object');
 end
 sol=struct(expcon);
+if isfield(sol.info,'compact') && ~isempty(sol.info.compact),
+    error('expcon:plot:compact','Compact controllers do not store the regions, build the controller with options.compact=0');
+end
 
 if nargin<2,
     pwaplot(sol,sol.info.colors);
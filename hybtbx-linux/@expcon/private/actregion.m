@@ -0,0 +1,34 @@
+function [H,K,Fz,gz]=actregion(cost,Rinv,act)
+%ACTREGION Critical region and optimizer of an active set
+%
+% [H,K,Fz,gz]=ACTREGION(COST,RINV,ACT) returns the critical region
+% {th: H*th<=K} where the constraints ACT of the QP
+%
+%     min .5*z'*COST.Q*z+th'*COST.C'*z  s.t.  COST.G*z<=COST.W+COST.S*th
+%
+% are the optimal active set, and the optimizer z=Fz*th+gz there (mpQP
+% formulas). RINV=inv(chol(COST.Q)), the rows of COST.G(ACT,:) must be
+% linearly independent. The rows of H are normalized, zero rows removed.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+m=size(cost.G,1);
+ina=(1:m)';
+ina(act)=[];
+GZ=cost.G(act,:)*Rinv;
+M=GZ*GZ';
+RC=Rinv'*cost.C;
+
+% Multipliers lambda=Fl*th+gl, optimizer z=-Rinv*(RC*th+GZ'*lambda)
+Fl=-M\(cost.S(act,:)+GZ*RC);
+gl=-M\cost.W(act);
+Fz=-Rinv*(RC+GZ'*Fl);
+gz=-Rinv*(GZ'*gl);
+
+% Primal feasibility of the inactive constraints, dual feasibility
+H=[cost.G(ina,:)*Fz-cost.S(ina,:);-Fl];
+K=[cost.W(ina)-cost.G(ina,:)*gz;gl];
+nH=sqrt(sum(H.^2,2));
+keep=nH>1e-10;
+H=H(keep,:)./(nH(keep)*ones(1,size(H,2)));
+K=K(keep)./nH(keep);
@@ -21,7 +21,8 @@ end
         
 fields={'lpsolver','qpsolver','fixref','valueref','fixmd','valuemd',...
     'noslack','flattol','waitbar','verbose',...
-    'mplpverbose','uniteeps','join','reltol','sequence'};
+    'mplpverbose','uniteeps','join','reltol','sequence','compact','nthreads',...
+    'lazy','method','parallel'};
 
 s=fieldnames(options); % get field names
 for i=1:length(s),
@@ -37,6 +38,22 @@ end
 if ishyb && isfield(options,'sequence'),
     warning('Option ''sequence'' ignored for hybrid MPC');
 end
+if ishyb && isfield(options,'compact') && ~isempty(options.compact) && options.compact>0,
+    warning('Option ''compact'' ignored for hybrid MPC');
+end
+if ishyb && isfield(options,'lazy') && ~isempty(options.lazy) && options.lazy,
+    warning('Option ''lazy'' ignored for hybrid MPC');
+end
+if ishyb && isfield(options,'parallel') && ~isempty(options.parallel) && options.parallel,
+    warning('Option ''parallel'' ignored for hybrid MPC');
+end
+if islin && isfield(options,'method') && strcmp(options.method,'dp'),
+    warning('Option ''method'' ignored for linear MPC');
+end
+if isfield(options,'method') && ~isempty(options.method) && ...
+        ~any(strcmp(options.method,{'enum','dp'})),
+    error('options.method must be either ''enum'' or ''dp''');
+end
 
 % Define missing fields
 for i=1:length(fields),
@@ -0,0 +1,87 @@
+function [C,cmp]=compactregions(C,cachesize,reltol)
+%COMPACTREGIONS Replace the regions of a linear explicit controller by active sets
+%
+% [C,CMP]=COMPACTREGIONS(C,CACHESIZE,RELTOL) finds the optimal active set
+% of each region of the explicit controller C (structure with the fields
+% of an @EXPCON object) by solving the QP C.cost at its Chebychev center.
+% If the critical region of the active set contains the center and gives
+% the same gain, only the active set is kept. The other regions (flat or
+% degenerate) keep H,K,F,G, which are reduced to those regions.
+%
+% CMP.act(CMP.a1(i):CMP.a2(i)) = active set of region #i (a1(i)=0 if
+%                                region #i is stored explicitly)
+% CMP.explicit  = indices of the regions stored in C.H,K,F,G,i1,i2
+% CMP.Rinv      = inv(chol(C.cost.Q))
+% CMP.cachesize = number of reconstructed regions kept by EXPCON/EVAL
+%
+% See also EXPCON, EXPCON/EVAL.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+cost=C.cost;
+nr=C.nr;
+nu=C.nu;
+nF=size(C.F,1)/nr; % rows of F per region (nu, or nvar if options.sequence=1)
+Rinv=inv(chol(cost.Q));
+GZ=cost.G*Rinv;
+
+[rCheb,xCheb]=chebyballs(C.H,C.K,C.i1,C.i2,C.thmin,C.thmax);
+
+acts=cell(nr,1);
+isexp=true(nr,1);
+for i=1:nr,
+    if ~(rCheb(i)>reltol),
+        continue
+    end
+    th=xCheb(i,:)';
+    [act,z,how]=qpactset(cost,GZ,th,reltol);
+    if ~strcmp(how,'ok'),
+        continue
+    end
+    [H,K,Fz,gz]=actregion(cost,Rinv,act);
+    ii=(i-1)*nF;
+    Fi=C.F(ii+1:ii+nu,:);
+    Gi=C.G(ii+1:ii+nu,:);
+    if all(H*th-K<=reltol) && norm(Fz(1:nu,:)-Fi,inf)<=reltol*(1+norm(Fi,inf)) && ...
+            norm(gz(1:nu)-Gi,inf)<=reltol*(1+norm(Gi,inf)),
+        acts{i}=act;
+        isexp(i)=false;
+    end
+end
+
+% Concatenated active sets
+na=zeros(nr,1);
+for i=1:nr,
+    na(i)=numel(acts{i});
+end
+a2=cumsum(na);
+a1=a2-na+1;
+a1(isexp)=0;
+if size(cost.G,1)<65536,
+    act=uint16(cat(1,acts{:},zeros(0,1)));
+else
+    act=uint32(cat(1,acts{:},zeros(0,1)));
+end
+
+% Regions stored explicitly
+explicit=find(isexp);
+rows=[];
+Frows=[];
+i1=zeros(1,numel(explicit));
+i2=i1;
+for k=1:numel(explicit),
+    i=explicit(k);
+    i1(k)=numel(rows)+1;
+    rows=[rows,C.i1(i):C.i2(i)];
+    i2(k)=numel(rows);
+    Frows=[Frows,(i-1)*nF+1:i*nF];
+end
+C.H=C.H(rows,:);
+C.K=C.K(rows,:);
+C.F=C.F(Frows,:);
+C.G=C.G(Frows,:);
+C.i1=i1;
+C.i2=i2;
+
+cmp=struct('act',act,'a1',uint32(a1),'a2',uint32(a2),'explicit',explicit,...
+    'Rinv',Rinv,'cachesize',cachesize,'id',[now rand]);
@@ -0,0 +1,45 @@
+function Lz=lazyregions(expcon,Lz)
+%LAZYREGIONS Partition of a lazy explicit controller kept in memory
+%
+% LZ=LAZYREGIONS(EXPCON) returns the regions found so far by EVAL for the
+% lazy controller EXPCON (see EXPCON, option 'lazy'). Region #k is
+% {th: LZ.H{k}*th<=LZ.K{k}}, where z=LZ.F{k}*th+LZ.g{k}, and LZ.act{k} is
+% its optimal active set. The first EXPCON.nr regions are those stored in
+% EXPCON by REFINE. If the partition in memory belongs to another
+% controller (or was cleared), it is rebuilt from the active sets stored
+% in EXPCON.
+%
+% LAZYREGIONS(EXPCON,LZ) replaces the partition in memory by LZ.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+persistent Lzmem
+
+if nargin>1,
+    Lzmem=Lz;
+    return
+end
+
+lz=expcon.info.lazy;
+nr=expcon.nr;
+if ~isempty(Lzmem) && isequal(Lzmem.id,lz.id) && numel(Lzmem.act)>=nr && ...
+        isequal(Lzmem.act(1:nr),lz.act),
+    Lz=Lzmem;
+    return
+end
+
+cost=expcon.cost;
+Lz=struct('id',lz.id,'GZ',cost.G*lz.Rinv,'last',0);
+Lz.act=lz.act;
+Lz.H=cell(nr,1);
+Lz.K=cell(nr,1);
+Lz.F=cell(nr,1);
+Lz.g=cell(nr,1);
+for k=1:nr,
+    [H,K,Fz,gz]=actregion(cost,lz.Rinv,lz.act{k});
+    Lz.H{k}=expcon.H(expcon.i1(k):expcon.i2(k),:);
+    Lz.K{k}=expcon.K(expcon.i1(k):expcon.i2(k));
+    Lz.F{k}=Fz;
+    Lz.g{k}=gz;
+end
+Lzmem=Lz;
@@ -0,0 +1,27 @@
+function [act,z,how]=qpactset(cost,GZ,th,reltol)
+%QPACTSET Optimal active set of the QP of a linear explicit controller
+%
+% [ACT,Z,HOW]=QPACTSET(COST,GZ,TH,RELTOL) solves the QP
+%
+%     min .5*z'*COST.Q*z+th'*COST.C'*z  s.t.  COST.G*z<=COST.W+COST.S*th
+%
+% at TH and returns the optimizer Z, the status HOW (see QPSOL) and the
+% active constraints ACT with multipliers larger than RELTOL*max(1,max(lambda)),
+% largest first as long as the rows of GZ=COST.G*inv(chol(COST.Q)) are
+% linearly independent, sorted.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+[z,la,how]=qpsol(cost.Q,cost.C*th,cost.G,cost.W+cost.S*th,[],[],[],qptype);
+act=zeros(0,1);
+if ~strcmp(how,'ok'),
+    return
+end
+[lsort,ord]=sort(-la);
+ord=ord(-lsort>reltol*max(1,max(la)));
+for j=ord(:)',
+    if rank(GZ([act;j],:),reltol)>numel(act),
+        act=[act;j];
+    end
+end
+act=sort(act);
@@ -0,0 +1,68 @@
+function [expcon,nnew]=refine(expcon,X)
+%REFINE Store the regions found online in a lazy explicit controller
+%
+%   E=REFINE(E) returns the lazy explicit controller E (see EXPCON, option
+%   'lazy') with all the critical regions found so far by EVAL stored in
+%   E.H,E.K,E.F,E.G,E.i1,E.i2, as in a controller computed by EXPCON. E
+%   can then be saved, plotted, or exported by HWRITE; it keeps computing
+%   and adding regions online for parameters that are not covered.
+%
+%   E=REFINE(E,X) first evaluates E at the parameter vectors X(:,k) (for
+%   instance the states visited in a simulation), so that their regions
+%   are added.
+%
+%   [E,NNEW]=REFINE(...) also returns the number of regions added to E.
+%
+%   See also EXPCON, EXPCON/EVAL.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if ~isa(expcon,'expcon'),
+    error('expcon:refine:obj','Invalid EXPCON object');
+end
+if ~isfield(expcon.info,'lazy') || isempty(expcon.info.lazy),
+    error('expcon:refine:lazy','The controller was not created with options.lazy=1');
+end
+
+if nargin>1,
+    for k=1:size(X,2),
+        eval(expcon,X(:,k));
+    end
+end
+
+Lz=lazyregions(expcon);
+nr=expcon.nr;
+nnew=numel(Lz.act)-nr;
+if nnew==0,
+    return
+end
+
+nu=expcon.nu;
+if expcon.info.sequence,
+    nF=expcon.info.nvar;
+else
+    nF=nu;
+end
+H=cat(1,Lz.H{nr+1:end});
+K=cat(1,Lz.K{nr+1:end});
+F=zeros(nF*nnew,expcon.npar);
+G=zeros(nF*nnew,1);
+nh=zeros(nnew,1);
+for k=1:nnew,
+    F((k-1)*nF+1:k*nF,:)=Lz.F{nr+k}(1:nF,:);
+    G((k-1)*nF+1:k*nF)=Lz.g{nr+k}(1:nF);
+    nh(k)=size(Lz.H{nr+k},1);
+end
+i2=size(expcon.H,1)+cumsum(nh);
+i1=i2-nh+1;
+rCheb=chebyballs(H,K,i1-size(expcon.H,1),i2-size(expcon.H,1),expcon.thmin,expcon.thmax);
+
+expcon.H=[expcon.H;H];
+expcon.K=[expcon.K;K];
+expcon.F=[expcon.F;F];
+expcon.G=[expcon.G;G];
+expcon.i1=[expcon.i1(:);i1];
+expcon.i2=[expcon.i2(:);i2];
+expcon.nr=nr+nnew;
+expcon.info.rCheb=[expcon.info.rCheb(:);rCheb(:)];
+expcon.info.lazy.act=Lz.act;
@@ -21,6 +21,15 @@ disp(' ')
 nivar=length(hybcon.ivar);
 disp(sprintf('%3d optimization variable(s) (%d continuous, %d binary)',nvar,nvar-nivar,nivar));
 disp(sprintf('%3d mixed-integer linear inequalities',nq));
+if ~isempty(hybcon.presolve),
+    disp(sprintf('    (preprocessed: %d big-M coefficients tightened, %d inequalities before)',...
+        hybcon.presolve.ntight,hybcon.presolve.nq));
+end
+if ~isempty(hybcon.sparse),
+    [nq,nvar]=size(hybcon.sparse.A);
+    disp(sprintf('    (solved as sparse MIP: %d variables, %d equalities, %d inequalities, %d nonzeros)',...
+        nvar,size(hybcon.sparse.Aeq,1),nq,nnz(hybcon.sparse.A)+nnz(hybcon.sparse.Aeq)));
+end
 if isinf(hybcon.norm),
     solvertype='MILP';
 else
@@ -20,10 +20,30 @@ function [u,xnext,y,d,z]=eval(hybcon,MLD,r,x,solver,verbose,tilim)
 %   tilim       = time limit for solving the MIP. The best solution found by the solver 
 %                 within the time limit is used (only GLPK and CPLEX supported)
 %
+% The optimal sequence of the previous call, shifted by one step, is passed
+% to the MIP solver as initial point x0: MIQP.M uses it as first incumbent
+% and to choose which subproblem to solve first when branching.
+%
+% With the 'glpk' solver the MILP is solved by GLPKWARMMEX, if compiled,
+% which keeps the GLPK problem between calls and only updates the right
+% hand side (type "clear glpkwarmmex" to free it).
+%
+% If hybcon was built with Q.sparse=1 (see HYBCON), the sparse MIP with
+% the predicted states as optimization variables is solved instead of the
+% condensed one.
+%
+% If the MIP solver does not return a solution (e.g. because the time
+% limit is reached before an integer feasible solution is found), the
+% optimal sequence of the previous call shifted by one step is used, if it
+% satisfies the constraints of the current MIP. Otherwise u is NaN. The
+% previous sequence is discarded when a different controller is evaluated.
+%
 % See also HYBCON, HYBCON/SIM, MILPSOL, MIQPSOL.
 
 % (C) 2003-2004 by Alberto Bemporad
 
+persistent Xprev Xsig % Previous optimal solution of the MIP and its controller
+
 if nargin<1,
     error('hybcon:eval:none','No HYBCON object supplied.');
 end
@@ -134,9 +154,30 @@ end
 
 vlb=[];
 vub=[];
-x0=[];
+neq=0;
+if ~isempty(hybcon.sparse),
+    [A,b,neq]=sparsecon(hybcon.sparse,thenorm,x,rx,ry,ru,rz);
+end
+sig={hybcon.A,hybcon.b,hybcon.Cx,hybcon.f,hybcon.H,hybcon.D,isempty(hybcon.sparse)};
+if ~isequal(Xsig,sig),
+    Xprev=[]; % Another controller
+    Xsig=sig;
+end
+x0=shiftsol(hybcon,MLD,Xprev,A,b,neq,x); % Warm start from the previous solution
+uvar=hybcon.uvar;
+dvar=hybcon.dvar;
+zvar=hybcon.zvar;
 
-if isinf(thenorm)
+if ~isempty(hybcon.sparse),
+    % Sparse MIP, states x(1),...,x(N) are optimization variables
+    sp=hybcon.sparse;
+    [xmin,flag]=sparsesol(sp,thenorm,x,rx,ry,ru,rz,solver,x0,verbose,tilim);
+    uvar=sp.uvar;
+    dvar=sp.dvar;
+    zvar=sp.zvar;
+elseif isinf(thenorm) && milptype(solver)==3,
+    [xmin,flag]=glpkwarm(f,A,b,ivar,vlb,vub,0,x0,verbose,tilim);
+elseif isinf(thenorm)
     [xmin,flag]=milpsol(f,A,b,ivar,milptype(solver),vlb,vub,x0,verbose,tilim);
 else
     [xmin,flag] = miqpsol(H,f,A,b,ivar,miqptype(solver),vlb,vub,x0,verbose,tilim);
@@ -150,17 +191,27 @@ if ~(flag==1 || flag==2)
         warning(sprintf('MIQP not succeded, exit flag=%d',flag));
     end
     %end
-    xmin=NaN*ones(size(f));
     if flag==-2,
         warning(sprintf('Try increasing time limit, currently %f s',tilim));
     end
+    % Feasible fallback: previous solution shifted by one step
+    xmin=x0;
+    tol=1e-8*(1+abs(b));
+    if numel(xmin)==size(A,2) && all(A*xmin<=b+tol) && all(A(1:neq,:)*xmin>=b(1:neq)-tol(1:neq)),
+        warning('hybcon:eval:shift','Using the previous optimal solution shifted by one step');
+    else
+        xmin=NaN*ones(size(A,2),1);
+    end
+end
+if all(isfinite(xmin)),
+    Xprev=xmin;
 end
 
-u=xmin(hybcon.uvar(1:hybcon.nu));
+u=xmin(uvar(1:hybcon.nu));
 
 if nargout>=2,
-   d=xmin(hybcon.dvar(1:MLD.nd));
-   z=xmin(hybcon.zvar(1:MLD.nz));
+   d=xmin(dvar(1:MLD.nd));
+   z=xmin(zvar(1:MLD.nz));
    
    xnext=MLD.A*x;
    
@@ -27,6 +27,12 @@ function C=hybcon(MLD,Q,N,limits,refsignals,mipsolver)
 % Q.y, Q.x, Q.u, Q.z, Q.rho, Q.xN = weights
 % Q.norm = norm used (either 2 or Inf)
 %         (default: Q.y=I, Q.x=0, Q.u=0.1*I, Q.z=0, Q.rho=+Inf, Q.xN=Q.x, Q.norm=Inf)
+% Q.sparse = 1 to solve on-line the sparse MIP where the predicted states
+%         x(1),...,x(N) are optimization variables and the MLD dynamics are
+%         equality constraints, instead of the condensed MIP (default: 0).
+%         The number of nonzeros of the sparse MIP grows linearly with N
+%         rather than quadratically, which pays off for long horizons with
+%         'glpk' (MILP) and 'clp' (MIQP), that exploit sparsity.
 % N = control horizon  (default: N=1)
 %
 % The @HYBCON object has fields: 
@@ -47,6 +53,10 @@ function C=hybcon(MLD,Q,N,limits,refsignals,mipsolver)
 %   dvar = position of vector d(0),...,d(N-1) within vector of vars
 %   zvar = position of vector z(0),...,z(N-1) within vector of vars
 %   model = name of MLD variable which the controller is based on
+%   presolve = bounds on the optimization variables and statistics computed
+%              by PREPROCESS (empty if not preprocessed)
+%   sparse = sparse MIP used on-line if Q.sparse=1, otherwise empty
+%            (see the help of private/SPARSEMIP.M for its fields)
 %   name = name of HYSDEL model which generated the MLD model
 %     ts = sampling time of the controller (inherited from MLD's sampling time) 
 %
@@ -98,7 +108,7 @@ if nargin<1,
     C=struct('Cr',[],'H',[],'D',[],'Y',[],'f',[],'A',[],'b',[],'Cx',[],'ivar',[],'Q',[],'uvar',[],...
         'dvar',[],'zvar',[],'epsvar',[],'refsignals',[],'mipsolver',[],'limits',[],'norm',[],...
         'name',[],'model',[],'nx',[],'ny',[],'nu',[],'nz',[],'ts',[],'horizon',[],'pwa',[],...
-        'hysmodel',[]);
+        'hysmodel',[],'presolve',[],'sparse',[]);
     C=class(C,'hybcon');    
     return
 end
@@ -123,6 +133,11 @@ if nargin<6,
     mipsolver=[];
 end
 
+usesparse=isfield(Q,'sparse') && ~isempty(Q.sparse) && Q.sparse;
+if isfield(Q,'sparse'),
+    Q=rmfield(Q,'sparse');
+end
+
 try
     C=buildmip(MLD,Q,N,limits,refsignals,mipsolver);
 catch
@@ -138,4 +153,10 @@ C.ts=MLD.ts;
 C.horizon=N;
 C.pwa=[];
 C.hysmodel=MLD.hysmodel;
+C.presolve=[]; % bounds and statistics of PREPROCESS
+if usesparse,
+    C.sparse=sparsemip(MLD,C.Q,N,C.limits,C.refsignals,C.norm);
+else
+    C.sparse=[];
+end
 C=class(C,'hybcon');
\ No newline at end of file
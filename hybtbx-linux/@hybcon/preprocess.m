@@ -1,31 +1,50 @@
 function C2=preprocess(C,hybsys,range,options)
-%PREPROCESS Reduces computational complexity of on-line MIP problem 
+%PREPROCESS Reduces computational complexity of on-line MIP problem
 %
-% C2=PREPROCESS(C,SYS,RANGE,OPTIONS) preprocess controller C by adding useful cuts
-% that reduce the complexity of on-line optimization.
+% C2=PREPROCESS(C,SYS,RANGE,OPTIONS) preprocess controller C by tightening
+% the mixed-integer program that is solved on-line:
+%
+% 1. bounds on all optimization variables (u, delta, z over the prediction
+%    horizon, slack variables) are computed by solving LPs over the relaxed
+%    constraints, for all states (and references) in RANGE, and added as
+%    inequalities;
+% 2. the big-M coefficients of the binary variables are reduced to the
+%    smallest values that keep the same mixed-integer feasible set
+%    (coefficient tightening);
+% 3. inequalities that are implied by the others are removed.
+%
+% For states in RANGE the optimal control move is unchanged, and the LP/QP
+% relaxations solved in the nodes of the branch and bound are not looser.
+% Whether fewer nodes are explored depends on the problem: use
+% options.verbose=1 to compare. Outside RANGE the MIP of C2 may be infeasible or have a different solution.
 %
 % C is a constrained optimal controller for hybrid systems based on on-line MIP
 % optimization (an object of class @HYBCON).
 %
-% SYS is a hybrid model (an object of class @MLD or @PWA).
+% SYS is a hybrid model (an object of class @MLD or @PWA).
 %
-% RANGE optionally defines a range of states and inputs of the hybrid systems that
-% will occur during the execution of the controller (it may be different from the limits 
+% RANGE optionally defines a range of states of the hybrid systems that
+% will occur during the execution of the controller (it may be different from the limits
 % over variables imposed in the control law). RANGE is a structure with fields:
 %    .xmin, xmax = range of states            [ xmin <= x <= xmax ]
-%    .umin, umax = range of inputs            [ umin <= u <= umax ]
-% By default, ranges are inherited from the range specified HYSDEL model.
+%    .refymin, refymax, refxmin, refxmax, refumin, refumax, refzmin, refzmax
+%                = range of references (only for Inf-norm controllers,
+%                  whose constraints depend on the references; constraints
+%                  involving references without a range are not tightened)
+% By default, the range of states is inherited from the HYSDEL model.
 %
 % OPTIONS defines various options for preprocessing the mixed-integer program.
-% options.verbose=1: show information
+% options.verbose=1: show information, including the number of nodes
+%                    explored by MIQP.M at the state options.x (default:
+%                    center of RANGE) before and after preprocessing
 %                =0: silent
-% options.lpsolver=   LP solver (type "help lptype" for available options) 
-% options.milpsolver= MILP solver. Valid options are:
-%      'dantz'   uses DANTZGMP.DLL 
-%      'glpk'    uses GLPKMEX.DLL 
-%      'nag'     uses MIQP3_NAF.M based on E04MBF.M for LP
-%      'matlab'  uses MIQP3_NAF.M based on LP.M for LP
-%      'cplex'   uses MILP_CPLEX.DLL
+% options.lpsolver=   LP solver (type "help lptype" for available options)
+% options.tol     =   relative tolerance for removing and tightening
+%                     constraints (default: 1e-6)
+%
+% The bounds computed in step 1 are stored in C2 and reused when C2 is
+% preprocessed again over the same RANGE. Only the condensed MIP is
+% preprocessed, not the sparse MIP of controllers built with Q.sparse=1.
 %
 % See also HYBCON, EXPCON.
 
@@ -34,7 +53,7 @@ function C2=preprocess(C,hybsys,range,options)
 if nargin<1,
     error('hybcon:preprocess:none','No HYBCON object supplied.');
 end
-if ~isa(hybcon,'hybcon'),
+if ~isa(C,'hybcon'),
     error('hybcon:preprocess:obj','Invalid HYBCON object');
 end
 if nargin<2,
@@ -43,11 +62,210 @@ end
 if ~isa(hybsys,'mld') & ~isa(hybsys,'pwa'),
     error('hybcon:preprocess:hybsys','Invalid hybrid model object');
 end
+if nargin<3 || isempty(range),
+    range=struct;
+end
+if nargin<4 || isempty(options),
+    options=struct;
+end
+if ~isfield(options,'verbose'),
+    options.verbose=0;
+end
+if ~isfield(options,'lpsolver'),
+    options.lpsolver=[];
+end
+if ~isfield(options,'tol'),
+    options.tol=1e-6;
+end
+lpsolver=lptype(options.lpsolver);
+tol=options.tol;
 
 C2=C;
 
-% Convert MLD model to PWA form
+A=C.A;
+b=C.b(:);
+[nq,nv]=size(A);
+nx=C.nx;
+ivar=C.ivar(:);
+
+% Parameters of the MIP: state x(t) and, for Inf-norm, the references
+if ~isfield(range,'xmin') || ~isfield(range,'xmax'),
+    if ~isa(hybsys,'mld'),
+        error('hybcon:preprocess:range','RANGE.xmin and RANGE.xmax must be specified for PWA models');
+    end
+    bounds=getbounds(hybsys);
+    if ~isfield(range,'xmin'),
+        range.xmin=bounds.xmin;
+    end
+    if ~isfield(range,'xmax'),
+        range.xmax=bounds.xmax;
+    end
+end
+pmin=range.xmin(:);
+pmax=range.xmax(:);
+if length(pmin)~=nx || length(pmax)~=nx,
+    error(sprintf('RANGE.xmin and RANGE.xmax must be vectors of dimension %d',nx));
+end
+Cp=C.Cx;
+sig={'y','x','u','z'};
+if isinf(C.norm),
+    for i=1:4,
+        Cri=C.Cr.(sig{i});
+        nri=size(Cri,2);
+        if nri>0,
+            rmin=-inf(nri,1);
+            rmax=inf(nri,1);
+            if isfield(range,['ref' sig{i} 'min']),
+                rmin=range.(['ref' sig{i} 'min'])(:);
+            end
+            if isfield(range,['ref' sig{i} 'max']),
+                rmax=range.(['ref' sig{i} 'max'])(:);
+            end
+            Cp=[Cp,Cri];
+            pmin=[pmin;rmin];
+            pmax=[pmax;rmax];
+        end
+    end
+end
+np=length(pmin);
 
-% Performs reachability analysis
+% The LPs are in y=[U;p]: G*y <= h are the MIP constraints A*U <= b+Cp*p,
+% Gc*y <= hc the box on p and 0 <= U(ivar) <= 1
+G=[A,-Cp];
+h=b;
+Ip=[zeros(np,nv),eye(np)];
+Iv=[eye(nv),zeros(nv,np)];
+Gc=[Ip(isfinite(pmax),:);-Ip(isfinite(pmin),:);Iv(ivar,:);-Iv(ivar,:)];
+hc=[pmax(isfinite(pmax));-pmin(isfinite(pmin));ones(length(ivar),1);zeros(length(ivar),1)];
 
-% Add "no-good" constraints on integer vars
\ No newline at end of file
+% 1. Bounds on the optimization variables (cached)
+if isstruct(C.presolve) && isequal(C.presolve.range,range),
+    lb=C.presolve.lb;
+    ub=C.presolve.ub;
+else
+    lb=-inf(nv,1);
+    ub=inf(nv,1);
+    for j=1:nv,
+        e=Iv(j,:)';
+        ub(j)=lpmax(e,[G;Gc],[h;hc],lpsolver);
+        lb(j)=-lpmax(-e,[G;Gc],[h;hc],lpsolver);
+        if ub(j)<lb(j),
+            warning('hybcon:preprocess:infeasible','The MIP is infeasible for all states in RANGE, controller not preprocessed');
+            return
+        end
+    end
+end
+isbin=false(nv,1);
+isbin(ivar)=true;
+iu=find(isfinite(ub) & ~(isbin & ub>=1-tol));
+il=find(isfinite(lb) & ~(isbin & lb<=tol));
+nb=length(iu)+length(il);
+G=[G;Iv(iu,:);-Iv(il,:)];
+h=[h;ub(iu);-lb(il)];
+keep=true(nq+nb,1);
+
+% 2.-3. Coefficient tightening and removal of implied inequalities. Each
+% inequality is compared with the current system without it, so that the
+% mixed-integer feasible set is preserved. A row whose LP is not solved
+% ('ok') is kept as it is.
+ntight=0;
+for i=1:nq+nb,
+    keep(i)=false;
+    Go=[G(keep,:);Gc];
+    ho=[h(keep);hc];
+    if i<=nq,
+        for k=ivar(G(i,ivar)~=0)',
+            a=G(i,k);
+            c=G(i,:)';
+            c(k)=0;
+            [R,how]=lpmax(c,Go,ho,lpsolver); % max of the rest of the row
+            if ~strcmp(how,'ok'),
+                continue
+            end
+            bi=h(i);
+            tolb=tol*(1+abs(bi));
+            if a>0 && R<bi-tolb && a>bi-R+tolb,
+                % x(k)=0 makes the row redundant
+                G(i,k)=a-(bi-R);
+                h(i)=R;
+                ntight=ntight+1;
+            elseif a<0 && R>bi+tolb && R<bi-a-tolb,
+                % x(k)=1 makes the row redundant: reduce big-M
+                G(i,k)=bi-R;
+                ntight=ntight+1;
+            end
+        end
+    end
+    [v,how]=lpmax(G(i,:)',Go,ho,lpsolver);
+    keep(i)=~strcmp(how,'ok') || v>h(i)+tol*(1+abs(h(i)));
+end
+
+irows=find(keep);
+C2.A=G(irows,1:nv);
+C2.b=h(irows);
+Cp=-G(irows,nv+1:nv+np);
+C2.Cx=Cp(:,1:nx);
+if isinf(C.norm),
+    np=nx;
+    for i=1:4,
+        nri=size(C.Cr.(sig{i}),2);
+        if nri>0,
+            C2.Cr.(sig{i})=Cp(:,np+1:np+nri);
+            np=np+nri;
+        end
+    end
+end
+C2.presolve=struct('range',range,'lb',lb,'ub',ub,'nq',nq,...
+    'nbounds',sum(keep(nq+1:end)),'ntight',ntight);
+
+if options.verbose,
+    fprintf('MIP constraints: %d -> %d (%d added bounds, %d removed inequalities), %d big-M coefficients tightened\n',...
+        nq,length(irows),sum(keep(nq+1:end)),sum(~keep(1:nq)),ntight);
+    if ~isfield(options,'x'),
+        options.x=(range.xmin(:)+range.xmax(:))/2;
+    end
+    try
+        n1=mipnodes(C,options.x,pmin(nx+1:end),pmax(nx+1:end));
+        n2=mipnodes(C2,options.x,pmin(nx+1:end),pmax(nx+1:end));
+        fprintf('Nodes explored by MIQP.M at x=[%s]: %d -> %d\n',num2str(options.x(:)'),n1,n2);
+    catch
+        fprintf('Node counts not available (MIQP.M failed)\n');
+    end
+end
+
+%-----------------
+function [v,how]=lpmax(c,G,h,lpsolver)
+% Maximum of c'*y subject to G*y<=h (Inf if unbounded, -Inf if infeasible,
+% NaN if the LP solver failed)
+[y,lambda,how]=lpsol(-c,G,h,[],[],[],[],-1,lpsolver);
+switch how
+    case 'ok'
+        v=c'*y;
+    case 'unbounded'
+        v=Inf;
+    case 'infeasible'
+        v=-Inf;
+    otherwise
+        v=NaN;
+end
+
+function nodes=mipnodes(C,x,rmin,rmax)
+% Number of relaxed problems solved by MIQP.M for state x and references
+% at the center of their range (zero if unbounded)
+r=(rmin+rmax)/2;
+r(~isfinite(r))=0;
+nv=size(C.A,2);
+b=C.b+C.Cx*x(:);
+if isinf(C.norm),
+    H=zeros(nv);
+    f=C.f;
+    if ~isempty(r),
+        b=b+[C.Cr.y,C.Cr.x,C.Cr.u,C.Cr.z]*r;
+    end
+else
+    H=C.H;
+    nr=size(C.D,2)-C.nx;
+    f=C.D*[x(:);zeros(nr,1)];
+end
+[xmin,fmin,flag,Extendedflag]=miqp(H,f,C.A,b,[],[],C.ivar,[],[],[],struct('native',0));
+nodes=Extendedflag.QPiter;
@@ -0,0 +1,54 @@
+function [xmin,flag]=glpkwarm(f,A,b,ivar,lb,ub,neq,x0,verbose,tilim)
+% GLPKWARM Solve the MILP of a hybrid controller by GLPK, warm started
+%
+% [xmin,flag]=GLPKWARM(f,A,b,ivar,lb,ub,neq,x0,verbose,tilim) solves
+%
+%   min f'*x  s.t. A*x <= b (the first neq rows are equalities),
+%             lb <= x <= ub, x(ivar) in {0,1}
+%
+% by GLPKWARMMEX, that keeps the GLPK problem between calls. At
+% consecutive sampling steps only b changes: the bounds are updated in
+% place, the LP relaxation starts from the basis of the previous step and
+% x0 is a candidate incumbent. If GLPKWARMMEX is not compiled, sparse
+% problems are solved by GLPKMEX and dense ones by MILPSOL. flag is as in
+% MILPSOL.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+warm=(exist('glpkwarmmex')==3);
+if ~warm && ~(issparse(A) && exist('glpkmex')==3),
+    [xmin,flag]=milpsol(f,A,b,ivar,3,lb,ub,x0,verbose,tilim,neq);
+    return
+end
+
+nv=length(f);
+if isempty(lb),
+    lb=-Inf*ones(nv,1);
+end
+if isempty(ub),
+    ub=Inf*ones(nv,1);
+end
+lb(ivar)=max(lb(ivar),0);
+ub(ivar)=min(ub(ivar),1);
+ctype=[repmat('S',neq,1);repmat('U',length(b)-neq,1)];
+vartype=repmat('C',nv,1);
+vartype(ivar)='I';
+param.msglev=verbose;
+if ~isempty(tilim),
+    param.tmlim=tilim;
+end
+if warm,
+    [xmin,fmin,status]=glpkwarmmex(1,f(:),A,b(:),ctype,lb(:),ub(:),vartype,param,x0);
+else
+    [xmin,fmin,status]=glpkmex(1,f(:),A,b(:),ctype,lb(:),ub(:),vartype,param);
+end
+switch status
+    case 171 % integer optimal
+        flag=1;
+    case 172 % time limit reached, integer feasible
+        flag=2;
+    case 208 % time limit reached, no integer solution
+        flag=-2;
+    otherwise
+        flag=-1;
+end
@@ -0,0 +1,73 @@
+function xs=shiftsol(hybcon,MLD,xprev,A,b,neq,x)
+% SHIFTSOL Shift the optimal MIP solution of the previous step
+%
+% xs=SHIFTSOL(hybcon,MLD,xprev,A,b,neq,x) shifts u, delta, z of the
+% optimizer xprev of the previous sampling step by one step, repeating the
+% last one, and rounds its binary variables. The states x(1),...,x(N) of
+% the sparse MIP (see SPARSEMIP) are simulated by the MLD dynamics from
+% the current state x with the shifted u, delta, z, so that the equality
+% rows hold. The other continuous variables (slack variables of
+% the Inf-norm cost and of soft constraints) are set to the smallest
+% nonnegative values that satisfy the inequalities A(neq+1:end,:)*xs <=
+% b(neq+1:end) of the current MIP. xs is used as a hint for the MIP solver
+% and as a fallback solution. xs=[] if xprev does not match hybcon.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+sp=hybcon.sparse;
+if isempty(sp),
+    sp=struct('A',hybcon.A,'uvar',hybcon.uvar,'dvar',hybcon.dvar,'zvar',hybcon.zvar,...
+        'xvar',[],'ivar',hybcon.ivar);
+end
+xs=xprev(:);
+if numel(xs)~=size(sp.A,2) || ~all(isfinite(xs)),
+    xs=[];
+    return
+end
+xs=shiftvar(xs,sp.uvar,hybcon.nu);
+xs=shiftvar(xs,sp.dvar,MLD.nd);
+xs=shiftvar(xs,sp.zvar,MLD.nz);
+xs(sp.ivar)=round(xs(sp.ivar));
+
+% States of the sparse MIP (none in the condensed one)
+nu=hybcon.nu;
+nx=MLD.nx;
+nd=MLD.nd;
+nz=MLD.nz;
+xk=x(:);
+for k=1:numel(sp.xvar)/max(nx,1),
+    xk=MLD.A*xk;
+    if nu>0,
+        xk=xk+MLD.B1*xs(sp.uvar((k-1)*nu+(1:nu)));
+    end
+    if nd>0,
+        xk=xk+MLD.B2*xs(sp.dvar((k-1)*nd+(1:nd)));
+    end
+    if nz>0,
+        xk=xk+MLD.B3*xs(sp.zvar((k-1)*nz+(1:nz)));
+    end
+    xs(sp.xvar((k-1)*nx+(1:nx)))=xk;
+end
+
+% Slack variables: each row -a*s+(rest) <= b needs s >= ((rest)-b)/a, the
+% rows are taken with the other slack variables at zero
+J=true(size(xs));
+J([sp.uvar(:);sp.dvar(:);sp.zvar(:);sp.xvar(:);sp.ivar(:)])=false;
+J=find(J);
+if ~isempty(J),
+    I=(neq+1:size(A,1))';
+    F=find(~ismember((1:numel(xs))',J));
+    r=A(I,F)*xs(F)-b(I);
+    [i,j,a]=find(A(I,J));
+    i=i(:);
+    j=j(:);
+    a=a(:);
+    k=a<0;
+    s=accumarray(j(k),r(i(k))./(-a(k)),[numel(J) 1],@max,0);
+    xs(J)=max(full(s),0);
+end
+
+function x=shiftvar(x,iv,n)
+if n>0 && numel(iv)>n,
+    x(iv)=x(iv([n+1:end end-n+1:end]));
+end
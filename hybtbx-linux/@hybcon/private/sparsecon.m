@@ -0,0 +1,30 @@
+function [A,b,neq]=sparsecon(sp,thenorm,x,rx,ry,ru,rz)
+% SPARSECON Constraints of the sparse MIP of a hybrid controller
+%
+% [A,b,neq]=SPARSECON(sp,norm,x,rx,ry,ru,rz) returns the constraints
+% A*w <= b of the MIP built by SPARSEMIP for the current state x and
+% references rx, ry, ru, rz. The first neq rows are the equalities
+% (MLD dynamics).
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+x=x(:);
+beq=sp.Cxeq*x;
+b=sp.b+sp.Cx*x;
+if isinf(thenorm),
+    if ~isempty(ry),
+        b=b+sp.Cr.y*ry;
+    end
+    if ~isempty(rx),
+        b=b+sp.Cr.x*rx;
+    end
+    if ~isempty(ru),
+        b=b+sp.Cr.u*ru;
+    end
+    if ~isempty(rz),
+        b=b+sp.Cr.z*rz;
+    end
+end
+neq=length(beq);
+A=[sp.Aeq;sp.A];
+b=[beq;b];
@@ -0,0 +1,274 @@
+function sp=sparsemip(MLD,Q,N,limits,refsignals,thenorm)
+% SPARSEMIP Build the sparse (non-condensed) MIP of a hybrid controller
+%
+% sp=SPARSEMIP(MLD,Q,N,LIMITS,REFSIGNALS,NORM) builds the MIP of the
+% optimal control problem defined in HYBCON keeping the predicted states
+% x(1),...,x(N) as optimization variables, together with u(k), delta(k)
+% and z(k). The variables are ordered by prediction step
+%
+%   w = [v(0); v(1); ...; v(N-1); epsil],  v(k) = [u(k); d(k); z(k); x(k+1); s(k)]
+%
+% where s(k) are the slack variables of the Inf-norm cost terms at step k.
+% The MLD dynamics are equality constraints and each constraint involves
+% at most two consecutive steps, so that all matrices are sparse and block
+% banded, with a number of nonzeros that grows linearly with N (the
+% condensed MIP is dense and grows quadratically with N).
+%
+% The MIP is
+%
+%   min .5*w'*H*w + theta'*D'*w    (2-norm, theta=[x;rx;ry;ru;rz])
+%   min f'*w                        (Inf-norm)
+%   s.t. Aeq*w = Cxeq*x
+%        A*w <= b + Cx*x (+ Cr.y*ry + Cr.x*rx + Cr.u*ru + Cr.z*rz, Inf-norm)
+%        lb <= w <= ub, w(ivar) in {0,1}
+%
+% where x=x(t). sp also contains the positions uvar, dvar, zvar, xvar
+% and epsvar of the variables within w.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+nx=MLD.nx;
+nu=MLD.nu;
+nd=MLD.nd;
+nz=MLD.nz;
+ny=MLD.ny;
+
+iry=refsignals.y(:);
+irx=refsignals.x(:);
+iru=refsignals.u(:);
+irz=refsignals.z(:);
+nry=length(iry);
+nrx=length(irx);
+nru=length(iru);
+nrz=length(irz);
+
+Qy=weight(Q,'y',nry,eye(nry));
+Qu=weight(Q,'u',nru,0.1*eye(nru));
+Qz=weight(Q,'z',nrz,zeros(nrz));
+Qx=weight(Q,'x',nrx,zeros(nrx));
+QxN=weight(Q,'xN',nrx,Qx);
+rho=Inf;
+if isfield(Q,'rho') && ~isempty(Q.rho),
+    rho=Q.rho;
+end
+soft=isfinite(rho);
+
+% Variables of one prediction step
+isinfnorm=isinf(thenorm);
+nsy=double(isinfnorm && nry>0); % one slack for each Inf-norm term
+nsu=double(isinfnorm && nru>0);
+nsz=double(isinfnorm && nrz>0);
+nsx=double(isinfnorm && nrx>0);
+nb=nu+nd+nz+nx+nsy+nsu+nsz+nsx;
+neps=double(soft);
+nv=N*nb+neps;
+
+Ib=speye(nb);
+is=0;
+Su=Ib(is+(1:nu),:); is=is+nu;
+Sd=Ib(is+(1:nd),:); is=is+nd;
+Sz=Ib(is+(1:nz),:); is=is+nz;
+Sx=Ib(is+(1:nx),:); is=is+nx;
+Ssy=Ib(is+(1:nsy),:); is=is+nsy;
+Ssu=Ib(is+(1:nsu),:); is=is+nsu;
+Ssz=Ib(is+(1:nsz),:); is=is+nsz;
+Ssx=Ib(is+(1:nsx),:);
+
+Iy=speye(ny);
+Ey=Iy(iry,:);
+Iu=speye(nu);
+Eu=Iu(iru,:)*Su;
+Iz=speye(nz);
+Ez=Iz(irz,:)*Sz;
+Ix=speye(nx);
+Ex=Ix(irx,:)*Sx;
+
+% Dynamics x(k+1)=A*x(k)+B1*u(k)+B2*d(k)+B3*z(k)
+[M,Mx]=stages(Sx-MLD.B1*Su-MLD.B2*Sd-MLD.B3*Sz,-MLD.A,Sx,N,neps);
+sp.Aeq=M;
+sp.Cxeq=-Mx;
+
+% Outputs y(k)=C*x(k)+D1*u(k)+D2*d(k)+D3*z(k)
+Yk=MLD.D1*Su+MLD.D2*Sd+MLD.D3*Sz;
+[My,Myx]=stages(Yk,MLD.C,Sx,N,neps);
+
+nr=nry+nrx+nru+nrz;
+P=struct('A',sparse(0,nv),'b',zeros(0,1),'Cx',sparse(0,nx),'Cr',sparse(0,nr),'e',zeros(0,1));
+
+% MLD inequalities E2*d(k)+E3*z(k) <= E1*u(k)+E4*x(k)+E5
+[M,Mx]=stages(MLD.E2*Sd+MLD.E3*Sz-MLD.E1*Su,-MLD.E4,Sx,N,neps);
+P=addineq(P,M,Mx,[],repmat(MLD.E5(:),N,1),0);
+
+% Limits on outputs, states and terminal state
+ymin=getlim(limits,'ymin',ny,-Inf);
+ymax=getlim(limits,'ymax',ny,Inf);
+P=addineq(P,My,Myx,[],repmat(ymax,N,1),soft);
+P=addineq(P,-My,-Myx,[],-repmat(ymin,N,1),soft);
+xmin=getlim(limits,'xmin',nx,-Inf);
+xmax=getlim(limits,'xmax',nx,Inf);
+[M,Mx]=stages(Sx,sparse(nx,nx),Sx,N,neps);
+P=addineq(P,M,Mx,[],repmat(xmax,N,1),soft);
+P=addineq(P,-M,-Mx,[],-repmat(xmin,N,1),soft);
+if isfield(limits,'Sx') && ~isempty(limits.Sx),
+    nt=size(limits.Sx,1);
+    M=[sparse(nt,(N-1)*nb),sparse(limits.Sx)*Sx,sparse(nt,neps)];
+    P=addineq(P,M,sparse(nt,nx),[],limits.Tx(:),soft);
+end
+
+% Cost function
+ntheta=nx+nr;
+if isinfnorm,
+    % |Qs*(s(k)-r)|_inf <= slack(k), rows +/-Qs*s(k)-slack(k) <= +/-Qs*r
+    ir=0; % columns of Cr, ordered as y,x,u,z
+    if nsy,
+        Gr=sparse(N*nry,nr);
+        Gr(:,ir+(1:nry))=kron(ones(N,1),Qy);
+        [M,Mx]=stages(Qy*Ey*Yk-ones(nry,1)*Ssy,Qy*Ey*MLD.C,Sx,N,neps);
+        P=addineq(P,M,Mx,Gr,zeros(N*nry,1),0);
+        [M,Mx]=stages(-Qy*Ey*Yk-ones(nry,1)*Ssy,-Qy*Ey*MLD.C,Sx,N,neps);
+        P=addineq(P,M,Mx,-Gr,zeros(N*nry,1),0);
+    end
+    ir=ir+nry;
+    if nsx,
+        Gr=sparse(N*nrx,nr);
+        Gr(:,ir+(1:nrx))=[kron(ones(N-1,1),Qx);QxN];
+        for sgn=[1 -1],
+            M=blkdiag(kron(speye(N-1),sgn*Qx*Ex-ones(nrx,1)*Ssx),sgn*QxN*Ex-ones(nrx,1)*Ssx);
+            P=addineq(P,[M,sparse(N*nrx,neps)],sparse(N*nrx,nx),sgn*Gr,zeros(N*nrx,1),0);
+        end
+    end
+    ir=ir+nrx;
+    if nsu,
+        Gr=sparse(N*nru,nr);
+        Gr(:,ir+(1:nru))=kron(ones(N,1),Qu);
+        for sgn=[1 -1],
+            [M,Mx]=stages(sgn*Qu*Eu-ones(nru,1)*Ssu,sparse(nru,nx),Sx,N,neps);
+            P=addineq(P,M,Mx,sgn*Gr,zeros(N*nru,1),0);
+        end
+    end
+    ir=ir+nru;
+    if nsz,
+        Gr=sparse(N*nrz,nr);
+        Gr(:,ir+(1:nrz))=kron(ones(N,1),Qz);
+        for sgn=[1 -1],
+            [M,Mx]=stages(sgn*Qz*Ez-ones(nrz,1)*Ssz,sparse(nrz,nx),Sx,N,neps);
+            P=addineq(P,M,Mx,sgn*Gr,zeros(N*nrz,1),0);
+        end
+    end
+    fb=full(sum([Ssy;Ssu;Ssz;Ssx],1))';
+    sp.f=[repmat(fb,N,1);rho*ones(neps,1)];
+    sp.H=[];
+    sp.D=[];
+else
+    % Sum of (L*w+Lx*x-r)'*W*(L*w+Lx*x-r) over the weighted signals
+    H=sparse(nv,nv);
+    D=sparse(nv,ntheta);
+    ir=nx; % columns of theta
+    [L,Lx]=stages(Ex,sparse(nrx,nx),Sx,N,neps);
+    W=blkdiag(kron(speye(N-1),Qx),QxN);
+    [H,D]=addcost(H,D,L,W,Lx,ir,nrx,N);
+    ir=ir+nrx;
+    [L,Lx]=stages(Ey*Yk,Ey*MLD.C,Sx,N,neps);
+    [H,D]=addcost(H,D,L,kron(speye(N),Qy),Lx,ir,nry,N);
+    ir=ir+nry;
+    [L,Lx]=stages(Eu,sparse(nru,nx),Sx,N,neps);
+    [H,D]=addcost(H,D,L,kron(speye(N),Qu),Lx,ir,nru,N);
+    ir=ir+nru;
+    [L,Lx]=stages(Ez,sparse(nrz,nx),Sx,N,neps);
+    [H,D]=addcost(H,D,L,kron(speye(N),Qz),Lx,ir,nrz,N);
+    if soft,
+        H(nv,nv)=2*rho;
+    end
+    sp.H=(H+H')/2;
+    sp.D=D;
+    sp.f=[];
+end
+
+if soft,
+    P.A(:,nv)=P.e;
+end
+sp.A=P.A;
+sp.b=P.b;
+sp.Cx=P.Cx;
+sp.Cr=struct('y',P.Cr(:,1:nry),'x',P.Cr(:,nry+(1:nrx)),'u',P.Cr(:,nry+nrx+(1:nru)),...
+    'z',P.Cr(:,nry+nrx+nru+(1:nrz)));
+
+% Positions of the variables, bounds and binary variables
+o=(0:N-1)*nb;
+sp.uvar=vars(1:nu,o);
+sp.dvar=vars(nu+(1:nd),o);
+sp.zvar=vars(nu+nd+(1:nz),o);
+sp.xvar=vars(nu+nd+nz+(1:nx),o);
+svar=vars(nu+nd+nz+nx+1:nb,o);
+sp.epsvar=N*nb+(1:neps)';
+sp.ivar=[vars(nu+nd+nz+MLD.nxr+1:nu+nd+nz+nx,o);vars(MLD.nur+1:nu,o);sp.dvar];
+sp.ivar=sort(sp.ivar);
+
+sp.lb=-Inf*ones(nv,1);
+sp.ub=Inf*ones(nv,1);
+sp.lb(sp.uvar)=repmat(getlim(limits,'umin',nu,-Inf),N,1);
+sp.ub(sp.uvar)=repmat(getlim(limits,'umax',nu,Inf),N,1);
+sp.lb(sp.ivar)=max(sp.lb(sp.ivar),0);
+sp.ub(sp.ivar)=min(sp.ub(sp.ivar),1);
+sp.lb([svar;sp.epsvar])=0;
+
+%-----------------
+function [M,Mx]=stages(Qk,Pk,Sx,N,neps)
+% Stack the rows Qk*v(k)+Pk*x(k), k=0,...,N-1. x(k) is part of v(k-1)
+% for k>0 (Sx selects it), x(0)=x is the parameter and gives Mx*x.
+Qk=sparse(Qk);
+Pk=sparse(Pk);
+nk=size(Qk,1);
+M=[kron(speye(N),Qk)+kron(spdiags(ones(N,1),-1,N,N),Pk*Sx),sparse(N*nk,neps)];
+Mx=[Pk;sparse((N-1)*nk,size(Pk,2))];
+
+function P=addineq(P,G,Gx,Gr,h,soft)
+% Add the rows G*w+Gx*x <= h+Gr*r with finite h, soft rows are relaxed by epsil
+i=find(isfinite(h));
+if isempty(Gr),
+    Gr=sparse(length(h),size(P.Cr,2));
+end
+P.A=[P.A;G(i,:)];
+P.b=[P.b;h(i)];
+P.Cx=[P.Cx;-Gx(i,:)];
+P.Cr=[P.Cr;Gr(i,:)];
+P.e=[P.e;-soft*ones(length(i),1)];
+
+function [H,D]=addcost(H,D,L,W,Lx,ir,nr,N)
+% Add (L*w+Lx*x-r)'*W*(L*w+Lx*x-r), r repeated over the N steps (columns
+% ir+1:ir+nr of theta)
+if nr==0,
+    return
+end
+W=sparse(W);
+H=H+2*L'*W*L;
+D(:,1:size(Lx,2))=D(:,1:size(Lx,2))+2*L'*W*Lx;
+D(:,ir+(1:nr))=D(:,ir+(1:nr))-2*L'*W*kron(ones(N,1),speye(nr));
+
+function Q=weight(Q,name,n,def)
+% Weight Q.(name), n-by-n (default: def)
+if isfield(Q,name) && ~isempty(Q.(name)),
+    Q=Q.(name);
+    if numel(Q)==1,
+        Q=Q*eye(n);
+    end
+else
+    Q=def;
+end
+Q=sparse(Q);
+
+function v=getlim(limits,name,n,def)
+% Limit limits.(name) as a vector of dimension n (default: def)
+if isfield(limits,name) && ~isempty(limits.(name)),
+    v=limits.(name)(:);
+    if length(v)==1,
+        v=v*ones(n,1);
+    end
+else
+    v=def*ones(n,1);
+end
+
+function iv=vars(i,o)
+% Positions i within each step with offsets o
+i=i(:);
+iv=reshape(i(:,ones(1,length(o)))+o(ones(length(i),1),:),[],1);
@@ -0,0 +1,46 @@
+function [xmin,flag]=sparsesol(sp,thenorm,x,rx,ry,ru,rz,solver,x0,verbose,tilim)
+% SPARSESOL Solve the sparse MIP of a hybrid controller
+%
+% [xmin,flag]=SPARSESOL(sp,norm,x,rx,ry,ru,rz,solver,x0,verbose,tilim)
+% solves the MIP built by SPARSEMIP for the current state x and references
+% rx, ry, ru, rz. The sparse matrices are passed as they are to GLPK
+% (MILP, solver 'glpk', see GLPKWARM) and to MIQP.M + CLP (MIQP, solver
+% 'clp'), which store them in compressed column form; the other solvers
+% are called through MILPSOL and MIQPSOL. flag is as in MILPSOL and
+% MIQPSOL. The constraints are those returned by SPARSECON.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+x=x(:);
+[A,b,neq]=sparsecon(sp,thenorm,x,rx,ry,ru,rz);
+beq=b(1:neq);
+
+if isinf(thenorm),
+    if ischar(solver),
+        solver=milptype(solver);
+    end
+    if solver==3,
+        [xmin,flag]=glpkwarm(sp.f,A,b,sp.ivar,sp.lb,sp.ub,neq,x0,verbose,tilim);
+    else
+        [xmin,flag]=milpsol(sp.f,A,b,sp.ivar,solver,sp.lb,sp.ub,x0,verbose,tilim,neq);
+    end
+else
+    f=sp.D*[x;rx;ry;ru;rz];
+    if ischar(solver),
+        solver=miqptype(solver);
+    end
+    if solver==7,
+        Options=struct('solver','clp','native',0,'verbose',min(verbose,2));
+        [xmin,fmin,mflag]=miqp(sp.H,f,sp.A,b(neq+1:end),sp.Aeq,beq,sp.ivar,sp.lb,sp.ub,x0,Options);
+        switch mflag
+            case 1
+                flag=1;
+            case 11 % maxqp reached, integer feasible
+                flag=2;
+            otherwise
+                flag=-1;
+        end
+    else
+        [xmin,flag]=miqpsol(sp.H,f,A,b,sp.ivar,solver,sp.lb,sp.ub,x0,verbose,tilim,neq);
+    end
+end
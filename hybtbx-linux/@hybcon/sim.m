@@ -128,6 +128,16 @@ else
     solver=miqptype(solver);
 end
 xmin=[];
+sp=hybcon.sparse; % sparse MIP (option Q.sparse, see HYBCON)
+if isempty(sp),
+    uvar=hybcon.uvar;
+    dvar=hybcon.dvar;
+    zvar=hybcon.zvar;
+else
+    uvar=sp.uvar;
+    dvar=sp.dvar;
+    zvar=sp.zvar;
+end
 
 for t=1:Tsteps,
     if nrx>0,
@@ -172,16 +182,28 @@ for t=1:Tsteps,
 %         keyboard;
 %     end
     
-    if isinf(thenorm)
-        [xmin,flag] = milpsol(f,A,b,ivar,solver,[],[],xmin,verbose,tilim);
+    % Warm start: previous optimal sequence shifted by one step
+    if isempty(sp),
+        xwarm=shiftsol(hybcon,MLD,xmin,A,b,0,x);
+    else
+        [Asp,bsp,neq]=sparsecon(sp,thenorm,x,rxt,ryt,rut,rzt);
+        xwarm=shiftsol(hybcon,MLD,xmin,Asp,bsp,neq,x);
+    end
+    
+    if ~isempty(sp),
+        [xmin,flag] = sparsesol(sp,thenorm,x,rxt,ryt,rut,rzt,solver,xwarm,verbose,tilim);
+    elseif isinf(thenorm) && solver==3,
+        [xmin,flag] = glpkwarm(f,A,b,ivar,[],[],0,xwarm,verbose,tilim);
+    elseif isinf(thenorm)
+        [xmin,flag] = milpsol(f,A,b,ivar,solver,[],[],xwarm,verbose,tilim);
     else
         theta=[x;rxt;ryt;rut;rzt];
         f=theta'*D';
-        [xmin,flag] = miqpsol(H,f,A,b,ivar,solver,[],[],xmin,verbose,tilim);
+        [xmin,flag] = miqpsol(H,f,A,b,ivar,solver,[],[],xwarm,verbose,tilim);
     end
     
     if (flag==1 || flag==2) 
-        u=xmin(hybcon.uvar(1:nu));
+        u=xmin(uvar(1:nu));
     else 
         if isinf(thenorm)
             warning(sprintf('MILP not succeded at step %d, exit flag=%d -- Simulation stopped',t,flag));
@@ -191,11 +213,12 @@ for t=1:Tsteps,
         if flag==-2,
             warning(sprintf('Try increasing time limit, currently %f s',tilim));
         end
+        clear glpkwarmmex % free the GLPK problem of GLPKWARM
         return
     end
     
-    d=xmin(hybcon.dvar(1:nd));
-    z=xmin(hybcon.zvar(1:nz));
+    d=xmin(dvar(1:nd));
+    z=xmin(zvar(1:nz));
     %[d,z,flag]=dzfind(x,u,MLD,solv);
     
     if verbose,
@@ -221,3 +244,4 @@ for t=1:Tsteps,
     %X=[X,x];
 end
 fprintf('\n');
+clear glpkwarmmex % free the GLPK problem of GLPKWARM
@@ -0,0 +1,119 @@
+function admmcodegen(lincon,filename,opts)
+% ADMMCODEGEN Write the data of an ADMM QP solver for the MPC controller in a C header file
+%
+% ADMMCODEGEN(L) writes the header file ADMMCON.H for the MPC controller L.
+% Compiled together with ADMMCON.C (in the utils/ folder), it provides the
+% function
+%
+%    status=admmcon(double *u, double *th)
+%
+% that solves the QP of L for the parameter vector th (th=x for regulators,
+% th=[x;u(t-1);r] for tracking controllers) by the ADMM iterations of
+% ADMMQP.CPP and returns u=L.I1*U (the input, or the input increment for
+% tracking controllers). All arrays have fixed size and no memory is
+% allocated: the factor of Q+sigma*I+rho*G'*G is computed here, offline,
+% and the iterations are warm-started from the solution at the previous
+% call.
+%
+% ADMMCODEGEN(L,FILENAME) writes the file FILENAME instead.
+%
+% ADMMCODEGEN(L,FILENAME,OPTS) also specifies the solver settings in the
+% structure OPTS with fields rho (default: 0.1), sigma (1e-6), alpha (1.6),
+% eps_abs (1e-6), eps_rel (1e-6), maxiter (4000), check_every (5) (see
+% ADMMQP.H).
+%
+% See also ADMMQP, LINCON.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<2 || isempty(filename),
+    filename='admmcon.h';
+end
+if nargin<3,
+    opts=[];
+end
+cfg=struct('rho',.1,'sigma',1e-6,'alpha',1.6,'eps_abs',1e-6,'eps_rel',1e-6,...
+    'maxiter',4000,'check_every',5);
+if isstruct(opts),
+    fields=fieldnames(cfg);
+    for i=1:numel(fields),
+        if isfield(opts,fields{i}) && ~isempty(opts.(fields{i})),
+            cfg.(fields{i})=opts.(fields{i});
+        end
+    end
+end
+
+Q=lincon.Q;
+G=lincon.G;
+n=size(Q,1);
+m=size(G,1);
+if m==0,
+    G=zeros(0,n);
+end
+[L,p]=chol(Q+cfg.sigma*eye(n)+cfg.rho*(G'*G));
+if p>0,
+    error('admmcodegen:notposdef','Q+sigma*I+rho*G''*G is not positive definite');
+end
+L=L'; % lower triangular
+
+% Lower triangle of L, packed by rows
+Lp=zeros(n*(n+1)/2,1);
+k=0;
+for i=1:n,
+    Lp(k+1:k+i)=L(i,1:i)';
+    k=k+i;
+end
+
+fid=fopen(filename,'w');
+if fid<0,
+    error('admmcodegen:file','Cannot open file %s',filename);
+end
+fprintf(fid,'/* Data of the ADMM QP solver of a LINCON object, written by ADMMCODEGEN */\n\n');
+if strcmp(lincon.type,'track'),
+    fprintf(fid,'#define ADMMCON_TRACKING\n');
+end
+fprintf(fid,'#define ADMMCON_NU %d\n',lincon.nu);
+fprintf(fid,'#define ADMMCON_NX %d\n',lincon.nx);
+fprintf(fid,'#define ADMMCON_NTH %d\n',lincon.npar);
+fprintf(fid,'#define ADMMCON_NVAR %d\n',n);
+fprintf(fid,'#define ADMMCON_NCON %d\n',m);
+fprintf(fid,'#define ADMMCON_TS %.8f\n',lincon.ts);
+fprintf(fid,'#define ADMMCON_RHO %.17g\n',cfg.rho);
+fprintf(fid,'#define ADMMCON_SIGMA %.17g\n',cfg.sigma);
+fprintf(fid,'#define ADMMCON_ALPHA %.17g\n',cfg.alpha);
+fprintf(fid,'#define ADMMCON_EPS_ABS %.17g\n',cfg.eps_abs);
+fprintf(fid,'#define ADMMCON_EPS_REL %.17g\n',cfg.eps_rel);
+fprintf(fid,'#define ADMMCON_MAXITER %d\n',cfg.maxiter);
+fprintf(fid,'#define ADMMCON_CHECK_EVERY %d\n',max(1,cfg.check_every));
+
+writearray(fid,'ADMMCON_L',Lp);        % factor of Q+sigma*I+rho*G'*G
+writearray(fid,'ADMMCON_Q',Q(:));      % n-by-n
+writearray(fid,'ADMMCON_C',lincon.C(:)); % n-by-nth, q=C*th
+writearray(fid,'ADMMCON_G',G(:));      % m-by-n
+writearray(fid,'ADMMCON_W',lincon.W(:)); % G*U<=W+S*th
+writearray(fid,'ADMMCON_S',lincon.S(:)); % m-by-nth
+writearray(fid,'ADMMCON_I1',lincon.I1(:)); % nu-by-n, u=I1*U
+fclose(fid);
+
+%-----------------
+function writearray(fid,name,v)
+% Write v as a static array, 8 numbers per line (one zero if empty)
+
+if isempty(v),
+    v=0;
+end
+fprintf(fid,'static const double %s[]={\n',name);
+nv=numel(v);
+for i=1:nv,
+    if rem(i,8)==1,
+        fprintf(fid,'    ');
+    end
+    fprintf(fid,'%.17g',v(i));
+    if i<nv,
+        fprintf(fid,',');
+    end
+    if rem(i,8)==0 || i==nv,
+        fprintf(fid,'\n');
+    end
+end
+fprintf(fid,'};\n\n');
@@ -22,6 +22,11 @@ function [uout,Opt,Activeset]=eval(lincon,x,r,u,qpsolver,verbose)
 % Opt.y = optimal output sequence
 % Opt.t = sequence of prediction times
 % Opt.slack = optimal value of slack variable
+% Opt.how = exit status of the QP solver
+% Opt.gap = upper bound on the suboptimality of the cost (solver
+%           'anytime', 0 for the other solvers)
+% Opt.cached = 1 if the solution was obtained from a cached critical
+%           region without solving the QP (see below)
 %
 % Opt.u (.x, .y) has as many columns as the number of inputs (states, outputs)
 % as many rows as the prediction horizon.
@@ -40,7 +45,24 @@ function [uout,Opt,Activeset]=eval(lincon,x,r,u,qpsolver,verbose)
 %
 % Activeset.F and .G  = optimal feedback gain u=F*th+G
 %
-% See also LINCON.
+% With the QP solver 'anytime' the QP is solved within the budget
+% lincon.Budget (maxiter iterations, maxtime seconds), starting from the
+% optimal sequence of the previous call shifted by one step. If the
+% budget is exhausted, the best feasible sequence found is used
+% (Opt.how='suboptimal', Opt.gap bounds its suboptimality); if no
+% feasible sequence was found, a warning is issued and the last iterate
+% is used. Similarly, with the QP solver 'admm' a warning is issued and
+% the last iterate is used (Opt.how='unreliable') if the tolerances are
+% not met within the maximum number of iterations.
+%
+% If lincon.RegionCache>0, the critical region and the affine solution of
+% each optimal active set found are stored (up to lincon.RegionCache
+% regions, the least recently used is discarded first). If theta lies in
+% a stored region, the optimal sequence is obtained from the stored affine
+% law and the QP is not solved. The cache is emptied when a different
+% controller is evaluated.
+%
+% See also LINCON, RTQP.
 
 % (C) 2003-2009 by Alberto Bemporad
 
@@ -50,6 +72,14 @@ if ~exist('U'), % Previous optimal sequence
 elseif length(U)~=(lincon.nvar+lincon.soft),
     U=[]; % U may exists from a previous run, reset it
 end
+if ~exist('Aset'), % Previous active set (QPDUAL) and the QP it refers to
+    persistent Aset
+    Aset=[];
+end
+if ~exist('Rcache'), % Cached critical regions
+    persistent Rcache
+    Rcache=[];
+end
 
 if nargin<1,
     error('lincon:eval:none','No LINCON object supplied.');
@@ -72,19 +102,106 @@ else
     theta=x(:);
 end
 
-[U,la,how]=qpsol(lincon.Q,lincon.C*theta,lincon.G,lincon.W+lincon.S*theta,[],[],U,qptype(qpsolver),lincon.Qinv);
-if ~strcmp(how,'ok'),
+istimevarying=isa(lincon.model,'cell');
+if ~istimevarying,
+    interval=lincon.model.Userdata.interval;
+else
+    interval=lincon.model{1}.Userdata.interval;
+end
+basis=[]; % Input parametrization U=kron(basis,eye(nu))*V, see LINCON
+if isfield(interval,'basis'),
+    basis=interval.basis;
+end
+
+if isempty(qpsolver),
+    method=lincon.QPsolver;
+else
+    method=qpsolver;
+end
+usesparse=strcmp(method,'riccati');
+if usesparse && (isempty(lincon.Sparse) || exist('riccatimex')~=3),
+    usesparse=0;
+    qpsolver=[]; % Condensed QP, default solver
+end
+usedual=~usesparse && strcmp(method,'qpdual');
+useadmm=~usesparse && strcmp(method,'admm');
+if useadmm && exist('admmqpmex')~=3,
+    useadmm=0;
+    qpsolver=[];
+end
+useanytime=~usesparse && strcmp(method,'anytime');
+if useanytime && exist('rtqpmex')~=3,
+    useanytime=0;
+    qpsolver=[];
+end
+gap=0;
+
+cached=0;
+if lincon.RegionCache>0,
+    Rcache=cachereset(Rcache,lincon);
+    [Rcache,U1,la1]=cachefind(Rcache,theta);
+    if ~isempty(U1),
+        U=U1;
+        la=la1;
+        how='ok';
+        cached=1;
+    end
+end
+
+if cached,
+    % Affine solution of a cached critical region
+elseif usesparse,
+    % Interior-point method on the multistage problem, Riccati recursion
+    [V,Z,status]=riccatimex(lincon.Sparse,theta);
+    U=V(lincon.Sparse.Uidx);
+    hows={'ok','infeasible','unreliable','unreliable'};
+    how=hows{status+1};
+    la=[];
+    if nargout>=3,
+        % Multipliers of the condensed QP, needed for the active set
+        [U,la,how]=qpsol(lincon.Q,lincon.C*theta,lincon.G,lincon.W+lincon.S*theta,[],[],U,qptype,lincon.Qinv);
+    elseif lincon.RegionCache>0 && strcmp(how,'ok'),
+        la=riccatimult(lincon,theta,U);
+    end
+elseif usedual,
+    % Dual active-set solver, cached factor of Q, warm start from previous active set
+    if isempty(lincon.Qcholinv),
+        [Rq,p]=chol(lincon.Q);
+        if p>0,
+            error('The Hessian of the QP is not positive definite, QPDUAL cannot be used');
+        end
+        lincon.Qcholinv=inv(Rq);
+    end
+    if isempty(Aset) || ~isequal(Aset.Q,lincon.Q) || ~isequal(Aset.G,lincon.G),
+        Aset=struct('Q',lincon.Q,'G',lincon.G,'act',[]); % Another controller
+    end
+    [U,la,how,Aset.act]=qpdual([],lincon.C*theta,lincon.G,lincon.W+lincon.S*theta,[],[],[],lincon.Qcholinv,[],[],Aset.act);
+elseif useadmm,
+    % ADMM, factorization cached in ADMMQPMEX, warm start from previous solution
+    [U,la,how]=admmqp(lincon.Q,lincon.C*theta,lincon.G,lincon.W+lincon.S*theta);
+elseif useanytime,
+    % Primal active set within the budget, started from the previous
+    % optimal sequence shifted by one step
+    U0=shiftseq(U,nu,lincon.nvar,tracking,basis);
+    [U,la,how,gap]=rtqp(lincon.Q,lincon.C*theta,lincon.G,lincon.W+lincon.S*theta,U0,lincon.Budget);
+else
+    [U,la,how]=qpsol(lincon.Q,lincon.C*theta,lincon.G,lincon.W+lincon.S*theta,[],[],U,qptype(qpsolver),lincon.Qinv);
+end
+if useanytime && strcmp(how,'suboptimal'),
+    % Budget exhausted, feasible sequence
+elseif useanytime && strcmp(how,'unreliable'),
+    warning('lincon:eval:budget','No feasible solution found within the QP budget');
+elseif useadmm && strcmp(how,'unreliable'),
+    warning('lincon:eval:admm','ADMM did not converge within the maximum number of iterations, last iterate used');
+elseif ~strcmp(how,'ok'),
     error(sprintf('QP problem is %s',how));
 end
+if lincon.RegionCache>0 && ~cached && strcmp(how,'ok') && ~isempty(la),
+    Rcache=cacheadd(Rcache,lincon,theta,U,la);
+end
 uout=lincon.I1*U;
 
 if nargout>1,
-    istimevarying=isa(lincon.model,'cell');
-    if ~istimevarying,
-        interval=lincon.model.Userdata.interval;
-    else
-        interval=lincon.model{1}.Userdata.interval;
-    end
     N=interval.N;
     Nu=interval.Nu;
     Ustar=U;
@@ -94,6 +211,9 @@ if nargout>1,
     else
         slack=0;
     end
+    if ~isempty(basis),
+        Ustar=kron(basis,eye(nu))*Ustar;
+    end
     
     if tracking,
         DUopt=reshape(Ustar,nu,Nu)';
@@ -119,11 +239,144 @@ if nargout>1,
         xopt=model.A*xopt+model.B*uopt;
         Topt(k+1)=k;
     end
-    Opt=struct('u',Uopt,'x',Xopt,'y',Yopt,'t',Topt);
+    Opt=struct('u',Uopt,'x',Xopt,'y',Yopt,'t',Topt,'slack',slack,'how',how,'gap',gap,'cached',cached);
 end
 
 if nargout>=3,
     Activeset=one_explicit(lincon,theta,U,la);
 end
 
+%-----------------
+function U0=shiftseq(U,nu,nvar,tracking,basis)
+% Previous optimal sequence shifted by one step: the last move is repeated
+% (regulator) or the last increment is zero (tracking). With an input
+% basis, the shifted sequence is approximated in the basis.
+if isempty(U),
+    U0=[];
+    return
+end
+V=U(1:nvar);
+if ~isempty(basis),
+    T=kron(basis,eye(nu));
+    V=T*V;
+end
+if tracking,
+    ulast=zeros(nu,1);
+else
+    ulast=V(end-nu+1:end);
+end
+V=[V(nu+1:end);ulast];
+if ~isempty(basis),
+    V=T\V;
+end
+U0=U;
+U0(1:nvar)=V;
 
+%-----------------
+function la=riccatimult(lincon,theta,U)
+% Multipliers of the condensed QP at the solution U of the sparse QP, from
+% Q*U+C*theta+G(act,:)'*la(act)=0 on the constraints active at U. CACHEADD
+% stores the region only if the active set reproduces U.
+r=lincon.W+lincon.S*theta-lincon.G*U;
+act=find(r<=1e-6*(1+abs(lincon.W+lincon.S*theta)));
+la=zeros(size(lincon.G,1),1);
+if ~isempty(act),
+    la(act)=max(-(lincon.G(act,:)')\(lincon.Q*U+lincon.C*theta),0);
+end
+
+%-----------------
+function R=cachereset(R,lincon)
+% Empty the cache if the controller (QP matrices) or its size changed
+if ~isempty(R) && R.nmax==lincon.RegionCache && isequal(R.Q,lincon.Q) && ...
+        isequal(R.C,lincon.C) && isequal(R.G,lincon.G) && ...
+        isequal(R.W,lincon.W) && isequal(R.S,lincon.S),
+    return
+end
+R=struct('Q',lincon.Q,'C',lincon.C,'G',lincon.G,'W',lincon.W,'S',lincon.S,...
+    'nmax',lincon.RegionCache,'H',zeros(0,size(lincon.C,2)),'K',zeros(0,1),...
+    'idx',zeros(0,1),'used',zeros(0,1),'clock',0);
+R.FU={};
+R.gU={};
+R.Fl={};
+R.gl={};
+R.act={};
+
+%-----------------
+function [R,U,la]=cachefind(R,theta)
+% Point location: all stored regions are tested by one matrix product,
+% among the regions containing theta the most recently used is taken
+U=[];
+la=[];
+if isempty(R.used),
+    return
+end
+out=false(numel(R.used),1);
+out(R.idx(R.H*theta-R.K>1e-9))=true;
+j=find(~out);
+if isempty(j),
+    return
+end
+[aux,i]=max(R.used(j));
+j=j(i);
+R.clock=R.clock+1;
+R.used(j)=R.clock;
+U=R.FU{j}*theta+R.gU{j};
+la=zeros(size(R.G,1),1);
+la(R.act{j})=R.Fl{j}*theta+R.gl{j};
+
+%-----------------
+function R=cacheadd(R,lincon,theta,U,la)
+% Critical region of the active set of the QP solution (U,la) and affine
+% expressions of U and of the multipliers, as in mpQP. Degenerate active
+% sets (linearly dependent constraints) and inaccurate solutions are not
+% stored.
+act=find(la>1e-7*max(1,max(la)));
+ina=setdiff((1:size(R.G,1))',act);
+Qinv=lincon.Qinv;
+GA=R.G(act,:);
+M=GA*Qinv*GA';
+if ~isempty(act) && rcond(M)<1e-12,
+    return
+end
+Fl=-M\(R.S(act,:)+GA*Qinv*R.C);
+gl=-M\R.W(act);
+FU=-Qinv*(R.C+GA'*Fl);
+gU=-Qinv*GA'*gl;
+if norm(FU*theta+gU-U,inf)>1e-6*(1+norm(U,inf)),
+    return
+end
+
+% Primal feasibility of the inactive constraints, dual feasibility
+H=[R.G(ina,:)*FU-R.S(ina,:);-Fl];
+K=[R.W(ina)-R.G(ina,:)*gU;gl];
+nH=sqrt(sum(H.^2,2));
+keep=nH>1e-10;
+if any(K(~keep)<-1e-9),
+    return
+end
+H=H(keep,:)./(nH(keep)*ones(1,size(H,2)));
+K=K(keep)./nH(keep);
+if any(H*theta-K>1e-6),
+    return
+end
+
+% New slot, or the one of the least recently used region
+if numel(R.used)<R.nmax,
+    j=numel(R.used)+1;
+else
+    [aux,j]=min(R.used);
+    keep=(R.idx~=j);
+    R.H=R.H(keep,:);
+    R.K=R.K(keep);
+    R.idx=R.idx(keep);
+end
+R.H=[R.H;H];
+R.K=[R.K;K];
+R.idx=[R.idx;j*ones(size(K))];
+R.clock=R.clock+1;
+R.used(j,1)=R.clock;
+R.FU{j}=FU;
+R.gU{j}=gU;
+R.Fl{j}=Fl;
+R.gl{j}=gl;
+R.act{j}=act;
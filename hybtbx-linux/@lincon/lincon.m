@@ -59,6 +59,17 @@ function L=lincon(sys,type,cost,interval,limits,qpsolver,yzerocon)
 %      .Ncy = output constraints are checked up to time k=Ncy
 %      .Ncu = input constraints are checked up to time k=Ncu
 %
+%        If .Nu is a vector [n1 n2 ... nb], the free moves are blocked:
+%        u(k) is kept constant (regulator) or du(k)=0 (tracking) within
+%        blocks of n1, n2, ..., nb steps, and the number of free moves
+%        is sum(Nu). Alternatively,
+%    .basis = Nu-by-nb matrix T, the sequence of each input (regulator) or
+%             input increment (tracking) over the control horizon is
+%             T*v, where v are nb free coefficients (e.g., T=LAGUERREBASIS(Nu,a,nb)
+%             for Laguerre functions). The first row of T must be nonzero.
+%        Both reduce the number of QP variables from nu*Nu to nu*nb, for
+%        the online QP and for the mpQP solved by EXPCON.
+%
 % LIMITS is a structure of constraints with fields:
 %    .umin = lower bounds on inputs            [ u(k)>=umin ]
 %    .umax = upper bounds on inputs            [ u(k)<=umax ]
@@ -74,6 +85,30 @@ function L=lincon(sys,type,cost,interval,limits,qpsolver,yzerocon)
 %       'qp'       QP from Optimization Toolbox
 %       'nag'      QP from NAG Foundation Toolbox
 %       'cplex'    QP from Ilog Cplex
+%       'qpdual'   dual active-set method QPDUAL, warm-started from the
+%                  previous active set (no factorization online)
+%       'riccati'  interior-point method on the non-condensed problem,
+%                  Newton steps by Riccati recursion (RICCATIMEX), for long
+%                  prediction horizons: the online cost is linear in N
+%       'admm'     ADMM iterations ADMMQP, factorization done once and
+%                  warm start from the previous solution (see also
+%                  ADMMCODEGEN for embedded C code)
+%       'anytime'  primal active-set method RTQP with a budget on the
+%                  number of iterations and on the solution time (property
+%                  Budget, fields maxiter and maxtime, default: Inf,
+%                  that is 10*(n+m+1) iterations and no time limit),
+%                  started from the shifted previous solution: when the
+%                  budget is exhausted a feasible suboptimal solution is
+%                  used (see LINCON/EVAL)
+%
+% With any of the solvers above, setting the property RegionCache to a
+% positive number (e.g. L.RegionCache=200) makes LINCON/EVAL store up to
+% RegionCache critical regions of the optimal active sets found online,
+% with their affine control laws. When the current parameter vector lies
+% in a stored region the QP is not solved. The least recently used region
+% is discarded when the cache is full (default: RegionCache=0, no cache).
+% With 'riccati' the multipliers of the active constraints are recovered
+% from the interior-point solution by least squares.
 %
 % L=LINCON(SYS,TYPE,COST,INTERVAL,LIMITS,QPSOLVER,YZEROCON) enforce output
 % constraints also at prediction time k=0 if YZEROCON=1 (default:
@@ -97,8 +132,8 @@ function L=lincon(sys,type,cost,interval,limits,qpsolver,yzerocon)
 
 L=struct('Q',[],'C',[],'G',[],'W',[],'S',[],'model',[],'nx',[],'nu',[],'ny',[],...
     'type',[],'ts',[],'isconstr',[],'soft',[],...
-    'nvar',[],'nq',[],'npar',[],'QPsolver',[],'I1',[],'Qinv',[],...
-    'Observer',[]);
+    'nvar',[],'nq',[],'npar',[],'QPsolver',[],'I1',[],'Qinv',[],'Qcholinv',[],'Sparse',[],...
+    'Budget',[],'RegionCache',[],'Observer',[]);
 
 if nargin<1,
     L=class(L,'lincon');    
@@ -119,7 +154,7 @@ if nargin<5 | isempty(interval),
     Ncudef=Nudef-1; 
     interval=struct('N',Ndef,'Nu',Nudef,'Ncu',Ncudef,'Ncy',Ncydef);
 end
-[Ny,Nu,Ncu,Ncy]=chkinterval(interval,movesdef);
+[Ny,Nu,Ncu,Ncy,blocks,basis]=chkinterval(interval,movesdef);
 interval=struct('N',Ny,'Nu',Nu,'Ncu',Ncu,'Ncy',Ncy);
 
 
@@ -310,7 +345,7 @@ else
     end
     qpsolver=lower(qpsolver);
     switch qpsolver
-        case {'clp','qpact','qp','quadprog','cplex','nag'}
+        case {'clp','qpact','qp','quadprog','cplex','nag','qpdual','riccati','admm','anytime'}
         otherwise
             error('Unknown QP solver');
     end
@@ -339,15 +374,42 @@ end
 
 istimevarying=struct('model',isa(sys,'cell'),'cost',isa(cost,'cell'),'limits',isa(limits,'cell'));
 
+% Input parametrization U=kron(basis,eye(nu))*V (move blocking or basis functions)
+basis=inputbasis(blocks,basis,Nu,tracking);
+interval.basis=basis;
+if ~isempty(basis) && strcmp(qpsolver,'riccati'),
+    warning('lincon:riccati',['Move blocking and input bases are not supported by ' ...
+        'QP solver ''riccati'', switching to QP solver ''' qpsolverdef '''']);
+    qpsolver=qpsolverdef;
+end
+
 try
+    if strcmp(qpsolver,'riccati'),
+        % Multistage form of the same problem, states not eliminated
+        sp=sparsempc(sys,Q,R,P,K,rho,soft,Nu,Ny,Ncu,Ncy,...
+            umin,umax,dumin,dumax,ymin,ymax,yzerocon,tracking);
+    else
+        sp=[];
+    end
     [Q,C,G,W,S,Y,sHm]=buildqp(sys,Q,R,Nu,Ny,Ncu,Ncy,...
            umin,umax,dumin,dumax,ymin,ymax,soft,tracking,K,P,rho,yzerocon,istimevarying);
+    nb=Nu;
+    if ~isempty(basis),
+        [Q,C,G,W,S]=reduceqp(Q,C,G,W,S,kron(basis,eye(nu)),soft);
+        nb=size(basis,2);
+    end
     [nq,npar]=size(S);
-    nvar=nu*Nu;
-    I1=kron([1 zeros(1,Nu-1)],eye(nu));
+    nvar=nu*nb;
+    I1=kron([1 zeros(1,nb-1)],eye(nu));
     if soft,
         I1=[I1 zeros(nu,1)];
     end
+    if ~isempty(sp) && ~sparsecheck(sp,Q,C,G,W,S,soft),
+        warning('lincon:riccati',['Multistage form of the MPC problem not available, ' ...
+            'switching to QP solver ''' qpsolverdef '''']);
+        sp=[];
+        qpsolver=qpsolverdef;
+    end
     L.Q=Q;
     L.C=C;
     L.G=G;
@@ -373,6 +435,18 @@ try
     L.QPsolver=qpsolver;
     L.I1=I1;
     L.Qinv=inv(Q);
+    L.Qcholinv=[];
+    if strcmp(qpsolver,'qpdual'),
+        % Inverse Cholesky factor used by QPDUAL
+        [Rq,p]=chol(Q);
+        if p>0,
+            error('The Hessian of the QP is not positive definite, QPDUAL cannot be used');
+        end
+        L.Qcholinv=inv(Rq);
+    end
+    L.Sparse=sp; % Used by RICCATIMEX
+    L.Budget=struct('maxiter',Inf,'maxtime',Inf); % Used by RTQP
+    L.RegionCache=0; % Max number of critical regions cached by EVAL
     L.Observer='no'; 
 catch
     rethrow(lasterror);
@@ -396,3 +470,57 @@ if hasdelay(sys),
 end
 [nx,nu]=size(sys.b);
 ny=size(sys.c,1);
+
+%-----------------
+function T=inputbasis(blocks,T,Nu,tracking)
+% Basis of the sequence of moves of one input (Nu-by-nb), [] = all moves
+% free. The basis is changed so that the first move is the first coefficient
+% (T(1,:)=[1 0 ... 0]), as expected by I1 and by EXPCON.
+if ~isempty(blocks),
+    nb=numel(blocks);
+    T=zeros(Nu,nb);
+    k=0;
+    for j=1:nb,
+        if tracking,
+            T(k+1,j)=1; % du(k)=0 within the block
+        else
+            T(k+1:k+blocks(j),j)=1; % u(k) constant within the block
+        end
+        k=k+blocks(j);
+    end
+end
+if isempty(T),
+    return
+end
+nb=size(T,2);
+if rank(T)<nb,
+    error('INTERVAL.basis must have linearly independent columns');
+end
+r=T(1,:)';
+if ~any(r),
+    error('The first row of INTERVAL.basis must be nonzero (the first move must be free)');
+end
+T=T*[r/(r'*r) null(r')];
+T(1,:)=[1 zeros(1,nb-1)];
+
+%-----------------
+function [Q,C,G,W,S]=reduceqp(Q,C,G,W,S,T,soft)
+% QP in the coefficients V, U=T*V
+if soft,
+    T=blkdiag(T,1);
+end
+Q=T'*Q*T;
+Q=(Q+Q')/2;
+C=T'*C;
+G=G*T;
+% Remove the constraints that became identical (e.g. bounds on the moves
+% of the same block) or trivial (0<=W, bounds on blocked increments)
+keep=any(G,2) | any(S,2) | W<0;
+G=G(keep,:);
+W=W(keep);
+S=S(keep,:);
+[dummy,i]=unique([G W S],'rows');
+i=sort(i);
+G=G(i,:);
+W=W(i);
+S=S(i,:);
@@ -15,8 +15,8 @@ function [Props,AsgnVals] = pnames(lincon)
 
 % Remember to be consistent with LINCON.M in case of empty @LINCON objects
 Props = {'Q','C','G','W','S','model','nx','nu','ny',...
-        'type','ts','isconstr','soft','nvar','nq','npar','QPsolver','I1','Qinv',...
-        'Observer'};
+        'type','ts','isconstr','soft','nvar','nq','npar','QPsolver','I1','Qinv','Qcholinv','Sparse',...
+        'Budget','RegionCache','Observer'};
    
 % Also return assignable values if needed
 if nargout>1,
@@ -40,6 +40,10 @@ if nargout>1,
          'char array (QP solver)';...
          'nu-by-nvar array (extracts u(0) from optimal sequence)';...
          'nvar-by-nvar array (inverse of Hessian matrix)';...
+         'nvar-by-nvar array (inverse of Cholesky factor of Hessian matrix)';...
+         'structure (multistage form of the problem, solver ''riccati'')';...
+         'structure (maxiter, maxtime: budget of solver ''anytime'')';...
+         'scalar (max number of critical regions cached online)';...
          'char array or structure (observer information)';...
 };
 end
@@ -1,14 +1,18 @@
-function [Ny,Nu,Ncu,Ncy]=chkinterval(interval,movesdef);
+function [Ny,Nu,Ncu,Ncy,blocks,basis]=chkinterval(interval,movesdef);
 
 %CHKINTERVAL Check interval structure
 %
+% If INTERVAL.Nu is a vector, it contains the lengths of the blocks of
+% moves (BLOCKS) and Nu=sum(BLOCKS). INTERVAL.basis is an Nu-by-nb input
+% basis matrix (BASIS, [] if not given).
+%
 %(C) 2003 by A. Bemporad
 
 if ~isa(interval,'struct'),
     error('INTERVAL must be a structure of number of input and output optimal control steps');
 end
 
-fields={'N','Nu','Ncu','Ncy'};
+fields={'N','Nu','Ncu','Ncy','basis'};
 
 s=fieldnames(interval); % get field names
 for i=1:length(s),
@@ -21,7 +25,12 @@ for i=1:length(s),
     else
         aux=fields{j};
         eval(['w=interval.' Name ';']);
-        if ~isa(w,'double'),
+        if strcmp(aux,'basis'),
+            if ~isa(w,'double') || ndims(w)>2,
+                error('INTERVAL.basis must be a matrix.');
+            end
+            interval.basis=w;
+        elseif ~isa(w,'double'),
             error(['INTERVAL.' Name ' must be a nonnegative integer.']);
         else
             w=round(w);
@@ -43,6 +52,26 @@ if isempty(Nu),
     warning(sprintf('No input interval specified, assuming the number of free control moves is Nu=%d',movesdef));
     Nu=movesdef;
 end
+blocks=[];
+if numel(Nu)>1,
+    % Move blocking: lengths of the blocks
+    blocks=Nu(:)';
+    if any(blocks<1),
+        error('The blocks in INTERVAL.Nu must have positive length.');
+    end
+    Nu=sum(blocks);
+end
+basis=interval.basis;
+if ~isempty(basis),
+    if ~isempty(blocks),
+        error('Specify either a vector INTERVAL.Nu (move blocking) or INTERVAL.basis, not both.');
+    end
+    if isempty(interval.Nu),
+        Nu=size(basis,1);
+    elseif size(basis,1)~=Nu,
+        error(sprintf('INTERVAL.basis must have Nu=%d rows',Nu));
+    end
+end
 Ny=interval.N;
 if isempty(Ny),
     Ny=Nu;
@@ -56,6 +85,9 @@ if isempty(Ncu),
     Ncu=Nu-1;
 end
 
+if Nu>Ny && (~isempty(blocks) || ~isempty(basis)),
+   error(sprintf('The blocks or the basis cover %d moves, more than N=%d',Nu,Ny));
+end
 if Nu>Ny,
    Nu=Ny;
    warning(sprintf('Nu>Ny. Setting Nu=Ny=%d',Nu));
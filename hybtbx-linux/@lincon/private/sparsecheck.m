@@ -0,0 +1,98 @@
+function ok=sparsecheck(sp,Q,C,G,W,S,soft)
+
+%SPARSECHECK Check that the multistage problem SP condenses to the QP
+%             min .5*U'*Q*U+theta'*C'*U s.t. G*U<=W+S*theta
+%
+% ok=SPARSECHECK(sp,Q,C,G,W,S,soft) eliminates the states of the problem built
+% by SPARSEMPC and compares the result with the QP built by BUILDQP: the
+% cost up to a positive scaling, the constraints as sets of normalized
+% rows. Constraints that never affect the optimizer are ignored on both
+% sides (rows with zero G, and eps>=-c with c>=0).
+%
+%(C) 2026 by the Hybrid Toolbox authors
+
+N=numel(sp.Q)-1;
+nvar=size(Q,1);
+npar=size(sp.X0,2);
+
+% Condense: z(k)=Phi*theta+Gam*U, v(k)=V*U
+Phi=sp.X0;
+Gam=zeros(size(Phi,1),nvar);
+Qc=zeros(nvar);
+Cc=zeros(nvar,npar);
+Gc=zeros(0,nvar);
+Wc=zeros(0,1);
+Sc=zeros(0,npar);
+iv=0; % stacked input counter
+for k=0:N,
+    nv=size(sp.R{k+1},1)*(k<N);
+    V=zeros(nv,nvar);
+    for j=1:nv,
+        V(j,sp.Uidx==iv+j)=1;
+    end
+    iv=iv+nv;
+    if k<N && nv>0,
+        H=[sp.Q{k+1} sp.S{k+1}';sp.S{k+1} sp.R{k+1}];
+        T=[Gam;V];
+        Th=[Phi;zeros(nv,npar)];
+        Fl=[sp.Fq{k+1};sp.Fr{k+1}];
+        Dk=[sp.D{k+1} sp.E{k+1}];
+    else
+        H=sp.Q{k+1};
+        T=Gam;
+        Th=Phi;
+        Fl=sp.Fq{k+1};
+        Dk=sp.D{k+1};
+    end
+    Qc=Qc+T'*H*T;
+    Cc=Cc+T'*(H*Th+Fl);
+    Gc=[Gc;Dk*T];
+    Sc=[Sc;-Dk*Th];
+    Wc=[Wc;sp.d{k+1}];
+    if k<N,
+        if nv>0,
+            Gam=sp.A{k+1}*Gam+sp.B{k+1}*V;
+        else
+            Gam=sp.A{k+1}*Gam;
+        end
+        Phi=sp.A{k+1}*Phi;
+    end
+end
+
+% Cost, up to scaling
+alpha=(Q(:)'*Qc(:))/max(Qc(:)'*Qc(:),eps);
+ok=alpha>0 && norm(Q-alpha*Qc,'fro')<=1e-8*(1+norm(Q,'fro')) && ...
+    norm(C-alpha*Cc,'fro')<=1e-8*(1+norm(C,'fro'));
+if ~ok,
+    return
+end
+
+% Constraints, as sets of rows
+v1=rowkeys(G,W,S,soft);
+v2=rowkeys(Gc,Wc,Sc,soft);
+ok=numel(v1)==numel(v2) && all(abs(v1-v2)<=1e-7);
+
+%-----------------
+function v=rowkeys(G,W,S,soft)
+% Project the normalized rows [G -S W] on a fixed direction, sort them and
+% drop duplicates
+
+M=[G -S W];
+nvar=size(G,2);
+if isempty(M),
+    v=zeros(0,1);
+    return
+end
+nz=any(abs(G)>1e-12,2);
+if soft,
+    % rows -eps<=c, c>=0, are never active
+    epsonly=~any(abs(G(:,1:nvar-1))>1e-12,2) & G(:,nvar)<0 & ...
+        ~any(abs(S)>1e-12,2) & W>=0;
+    nz=nz & ~epsonly;
+end
+M=M(nz,:);
+M=M./(sqrt(sum(M.^2,2))*ones(1,size(M,2)));
+v=sort(M*sin(1:size(M,2))');
+if numel(v)>1,
+    v=v([true;diff(v)>1e-9]);
+end
@@ -0,0 +1,226 @@
+function sp=sparsempc(sys,Q,R,P,K,rho,soft,Nu,N,Ncu,Ncy,umin,umax,dumin,dumax,ymin,ymax,yzerocon,tracking)
+
+%SPARSEMPC Build the non-condensed (multistage) form of the MPC problem
+%
+% sp=SPARSEMPC(sys,Q,R,P,K,rho,soft,Nu,N,Ncu,Ncy,umin,umax,dumin,dumax,ymin,ymax,yzerocon,tracking)
+% returns the stage matrices of the same optimal control problem that
+% BUILDQP condenses, in the format of RICCATIMEX. States are kept as
+% optimization variables:
+%
+%   regulator: z(k)=x(k),        v(k)=u(k)    (k<Nu)
+%   tracking:  z(k)=[x(k);u(k-1)], v(k)=du(k) (k<Nu)
+%
+% and no input is left for k>=Nu (u(k)=K*x(k), or du(k)=0). The slack
+% variable eps of soft constraints is the last input at k=0 and the last
+% state for k>=1. sp.Uidx maps the stacked inputs returned by RICCATIMEX
+% to the optimization vector of the condensed QP.
+%
+% Constraints that do not depend on the optimization variables (e.g.
+% y(0) when D=0, or u(k)=K*x(k) when K=0) are not included.
+%
+%(C) 2026 by the Hybrid Toolbox authors
+
+nx=size(sys_at(sys,0).A,1);
+nu=size(sys_at(sys,0).B,2);
+ny=size(sys_at(sys,0).C,1);
+if isempty(K) || size(K,1)~=nu,
+    K=zeros(nu,nx);
+end
+if isempty(P),
+    P=zeros(nx);
+end
+ycon0=yzerocon(:).*ones(ny,1);
+
+if tracking,
+    nxs=nx+nu;
+    npar=nx+nu+ny;
+    X0=[eye(nx) zeros(nx,nu+ny);zeros(nu,nx) eye(nu) zeros(nu,ny)];
+    Rsel=[zeros(ny,nx+nu) eye(ny)];
+else
+    nxs=nx;
+    npar=nx;
+    X0=eye(nx);
+end
+
+sp=struct('A',{cell(N+1,1)},'B',{cell(N+1,1)},'Q',{cell(N+1,1)},'S',{cell(N+1,1)},...
+    'R',{cell(N+1,1)},'Fq',{cell(N+1,1)},'Fr',{cell(N+1,1)},'D',{cell(N+1,1)},...
+    'E',{cell(N+1,1)},'d',{cell(N+1,1)},'X0',X0,'Uidx',[]);
+
+for k=0:N,
+    free=(k<Nu && k<N);
+    nw=nu*free;
+
+    % u(k)=Mx*xs+Mw*w, xs(k+1)=Ax*xs+Bx*w, y(k)=Cy*xs+Dy*w
+    if k<N,
+        model=sys_at(sys,k);
+        A=model.A;
+        B=model.B;
+        C=model.C;
+        D=model.D;
+        if tracking,
+            Mx=[zeros(nu,nx) eye(nu)];
+            Ax=[A B;zeros(nu,nx) eye(nu)];
+            Bx=[B;eye(nu)];
+        else
+            Mx=K*(~free);
+            Ax=A+B*Mx;
+            Bx=B;
+        end
+        Mw=eye(nu);
+        Bx=Bx(:,1:nw);
+        Mw=Mw(:,1:nw);
+        Cy=C*[eye(nx) zeros(nx,nxs-nx)]+D*Mx;
+        Dy=D*Mw;
+    end
+
+    % Cost (Hessian is twice the weights, as .5*z'*H*z=J)
+    Fq=zeros(nxs,npar);
+    Fr=zeros(nw,npar);
+    if k==N,
+        if tracking,
+            Qk=zeros(nxs);
+        else
+            Qk=2*P;
+        end
+        Sk=zeros(0,nxs);
+        Rk=[];
+    else
+        Qw=weight_at(Q,k);
+        Rw=weight_at(R,k);
+        if tracking,
+            Qk=2*Cy'*Qw*Cy;
+            Sk=2*Dy'*Qw*Cy;
+            Rk=2*(Dy'*Qw*Dy+Rw(1:nw,1:nw));
+            Fq=-2*Cy'*Qw*Rsel;
+            Fr=-2*Dy'*Qw*Rsel;
+        else
+            Qk=2*(Qw+Mx'*Rw*Mx);
+            Sk=2*Mw'*Rw*Mx;
+            Rk=2*Mw'*Rw*Mw;
+        end
+    end
+
+    % Constraints Dk*xs+Ek*w<=dk, with soft flag
+    Dk=zeros(0,nxs);
+    Ek=zeros(0,nw);
+    dk=zeros(0,1);
+    sk=zeros(0,1);
+    if k<N,
+        % outputs
+        if (k>=1 && k<=Ncy) || (k==0 && any(ycon0)),
+            [ylo,yhi]=lim_at(ymin,ymax,k);
+            for j=1:ny,
+                if k==0 && ~ycon0(j),
+                    continue
+                end
+                if isfinite(yhi(j)),
+                    Dk=[Dk;Cy(j,:)];Ek=[Ek;Dy(j,:)];dk=[dk;yhi(j)];sk=[sk;soft];
+                end
+                if isfinite(ylo(j)),
+                    Dk=[Dk;-Cy(j,:)];Ek=[Ek;-Dy(j,:)];dk=[dk;-ylo(j)];sk=[sk;soft];
+                end
+            end
+        end
+        % inputs
+        if k<=Ncu,
+            [ulo,uhi]=lim_at(umin,umax,k);
+            softu=soft && k>=Nu;
+            for j=1:nu,
+                if isfinite(uhi(j)),
+                    Dk=[Dk;Mx(j,:)];Ek=[Ek;Mw(j,:)];dk=[dk;uhi(j)];sk=[sk;softu];
+                end
+                if isfinite(ulo(j)),
+                    Dk=[Dk;-Mx(j,:)];Ek=[Ek;-Mw(j,:)];dk=[dk;-ulo(j)];sk=[sk;softu];
+                end
+            end
+            % input increments
+            if tracking && free,
+                [dulo,duhi]=lim_at(dumin,dumax,k);
+                I=eye(nu);
+                for j=1:nu,
+                    if isfinite(duhi(j)),
+                        Dk=[Dk;zeros(1,nxs)];Ek=[Ek;I(j,:)];dk=[dk;duhi(j)];sk=[sk;0];
+                    end
+                    if isfinite(dulo(j)),
+                        Dk=[Dk;zeros(1,nxs)];Ek=[Ek;-I(j,:)];dk=[dk;-dulo(j)];sk=[sk;0];
+                    end
+                end
+            end
+        end
+    end
+    % constraints on x(0) only are not constraints of the QP
+    keep=any(Ek,2) | (k>0 & any(Dk,2)) | (soft & sk);
+    Dk=Dk(keep,:);Ek=Ek(keep,:);dk=dk(keep);sk=sk(keep);
+
+    % Add the slack variable
+    if soft,
+        if k==0,
+            Ak=[Ax;zeros(1,nxs)];
+            Bk=[Bx zeros(nxs,1);zeros(1,nw) 1];
+            Sk=[Sk;zeros(1,nxs)];
+            Rk=[Rk zeros(nw,1);zeros(1,nw) 2*rho];
+            Fr=[Fr;zeros(1,npar)];
+            Ek=[Ek -sk];
+        else
+            Qk=[Qk zeros(nxs,1);zeros(1,nxs+1)];
+            Fq=[Fq;zeros(1,npar)];
+            Sk=[Sk zeros(nw,1)];
+            Dk=[Dk -sk];
+            if k<N,
+                Ak=[Ax zeros(nxs,1);zeros(1,nxs) 1];
+                Bk=[Bx;zeros(1,nw)];
+            end
+        end
+    elseif k<N,
+        Ak=Ax;
+        Bk=Bx;
+    end
+
+    sp.Q{k+1}=Qk;
+    sp.Fq{k+1}=Fq;
+    sp.D{k+1}=Dk;
+    sp.d{k+1}=dk;
+    if k<N,
+        sp.A{k+1}=Ak;
+        sp.B{k+1}=Bk;
+        sp.S{k+1}=Sk;
+        sp.R{k+1}=Rk;
+        sp.Fr{k+1}=Fr;
+        sp.E{k+1}=Ek;
+    else
+        sp.A{k+1}=[];
+        sp.B{k+1}=[];
+        sp.S{k+1}=[];
+        sp.R{k+1}=[];
+        sp.Fr{k+1}=[];
+        sp.E{k+1}=[];
+    end
+end
+
+% Map stacked inputs [v(0);...;v(Nu-1)] to [w(0);...;w(Nu-1);eps]
+sp.Uidx=(1:nu*Nu)';
+if soft,
+    sp.Uidx=[(1:nu)';(nu+2:nu*Nu+1)';nu+1];
+end
+
+%-----------------
+function model=sys_at(sys,k)
+if isa(sys,'cell'),
+    model=sys{k+1};
+else
+    model=sys;
+end
+
+%-----------------
+function w=weight_at(W,k)
+if isa(W,'cell'),
+    w=W{k+1};
+else
+    w=W;
+end
+
+%-----------------
+function [lo,hi]=lim_at(wmin,wmax,k)
+j=min(k+1,size(wmin,2));
+lo=wmin(:,j);
+hi=wmax(:,j);
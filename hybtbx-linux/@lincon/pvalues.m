@@ -8,7 +8,7 @@ function Values = pvalues(lincon)
 
 %   (C) 2003 by A. Bemporad
 
-Npublic = 23;  % Number of lincon-specific public properties
+Npublic = 24;  % Number of lincon-specific public properties
 
 % Values of public LINCON properties
 
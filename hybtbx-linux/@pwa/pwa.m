@@ -18,6 +18,10 @@ function P = pwa(S,xmax,umax,options)
 %
 % options.method = 'sequential': Sequence of MILPs (default)
 %                = 'recursive' : Recursive method
+%                = 'parallel'  : Tree search on the binary variables with
+%                                LP pruning, on several threads (see
+%                                MLD2PWAPAR for its options, e.g. for
+%                                resuming long conversions)
 %
 % options.verbose=1: plots intermediate results
 %                =0: nothing
@@ -38,7 +42,7 @@ function P = pwa(S,xmax,umax,options)
 % A. Bemporad, "Efficient Conversion of Mixed Logical Dynamical Systems into an Equivalent 
 % Piecewise Affine Form", IEEE Transactions on Automatic Control, May 2004.
 %
-% See also PWAPROPS, MLD, HYSDEL.
+% See also PWAPROPS, MLD, HYSDEL, MLD2PWAPAR.
 
 %   (C) 2003 by A. Bemporad
 
@@ -66,7 +70,11 @@ else
         options=[];
     end
     
-    [P,options]=mld2pwa(S,xmax,umax,options);
+    if isstruct(options) && isfield(options,'method') && strcmp(options.method,'parallel'),
+        [P,options]=mld2pwapar(S,xmax,umax,options);
+    else
+        [P,options]=mld2pwa(S,xmax,umax,options);
+    end
     P.name=S.name;
     P.ts=S.ts;
     P.mld=inputname(1);
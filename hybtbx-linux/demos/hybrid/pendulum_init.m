@@ -77,6 +77,15 @@ limits.umax=tau_max;
 C=hybcon(S,Q,N,limits,refs);
 %C.mipsolver='gurobi';
 
+% Presolve the MILP (bounds, big-M tightening) for zero references, over
+% the range of states of the HYSDEL model
+clear range
+range.refymin=0;
+range.refymax=0;
+range.refumin=0;
+range.refumax=0;
+C=preprocess(C,S,range,struct('verbose',1));
+
 Tstop=4;
 r=struct('y',0,'u',0);
 x0=[pi;0];
@@ -29,6 +29,15 @@ C=hybcon(S,Q,N,limits,refs);
 %C.mipsolver='cplexint';
 %C.mipsolver='gurobi';
 
+% Presolve the MILP (bounds, big-M tightening) for the inventory levels and
+% demands that occur in the simulation below
+clear range
+range.xmin=limits.xmin;
+range.xmax=limits.xmax;
+range.refymin=[4;2];
+range.refymax=[8;8];
+C=preprocess(C,S,range,struct('verbose',1));
+
 Tstop=50;
 x0=[0;0;0;0];
 clear r
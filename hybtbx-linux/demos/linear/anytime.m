@@ -0,0 +1,50 @@
+% Anytime MPC: QP solved within an iteration budget
+%
+% The MPC controller of the double integrator is evaluated with the QP
+% solver 'anytime' and a decreasing budget of active-set iterations per
+% sample. Each QP starts from the previous optimal sequence shifted by
+% one step; when the budget is exhausted the best feasible sequence found
+% is applied, and Opt.gap bounds how far its cost is from the optimum.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+Ts=1;
+model=ss([1 1;0 1],[0;1],[0 1],0,Ts);
+
+clear limits interval weights
+limits.umin=-1;
+limits.umax=1;
+limits.ymin=-1;
+interval.N=20;
+interval.Nu=20;
+weights.R=.1;
+weights.Q=[1 0;0 0];
+weights.P='lqr';
+weights.rho=+Inf;
+
+C=lincon(model,'reg',weights,interval,limits,'anytime');
+
+x0=[10;-.3];
+Tstop=40;
+budgets=[Inf 10 5 2 1];
+
+fprintf('\n  maxiter   closed-loop cost   max gap   suboptimal steps   min y\n');
+for i=1:numel(budgets),
+    C.Budget.maxiter=budgets(i);
+    x=x0;
+    J=0;
+    maxgap=0;
+    nsub=0;
+    ymin=Inf;
+    for t=0:Tstop-1,
+        [u,Opt]=eval(C,x);
+        J=J+x(1)^2+weights.R*u^2;
+        maxgap=max(maxgap,Opt.gap);
+        nsub=nsub+strcmp(Opt.how,'suboptimal');
+        x=model.A*x+model.B*u;
+        ymin=min(ymin,model.C*x);
+    end
+    fprintf('%9g   %16.4f   %7.2g   %16d   %5.3f\n',budgets(i),J,maxgap,nsub,ymin);
+end
@@ -0,0 +1,65 @@
+% Move blocking and Laguerre input bases: QP size, solution time and
+% closed-loop performance
+%
+% The MPC controllers of AFTI16.M and MIMO.M are designed with a long
+% control horizon and three parametrizations of the input increments:
+% all moves free, move blocking (INTERVAL.Nu = vector of block lengths)
+% and Laguerre functions (INTERVAL.basis = LAGUERREBASIS(Nu,a,nb)). For
+% each, the number of QP variables and constraints, the simulation time
+% and the closed-loop cost sum (y-r)'*S*(y-r)+du'*T*du are reported.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+% AFTI-16 (see AFTI16.M)
+Ts=.05;
+A=[-.0151 -60.5651 0 -32.174;
+     -.0001 -1.3411 .9929 0;
+     .00018 43.2541 -.86939 0;
+      0      0       1      0];
+B=[-2.516 -13.136;
+     -.1689 -.2514;
+     -17.251 -1.5766;
+     0        0];
+C=[0 1 0 0;
+     0 0 0 1];
+plants{1}=c2d(ss(A,B,C,zeros(2)),Ts);
+names{1}='afti16';
+costs{1}=struct('S',eye(2),'T',.01*eye(2),'rho',Inf);
+lims{1}=struct('umin',-25*[1;1],'umax',25*[1;1]);
+N(1)=20;
+refs{1}=[0 20];
+Tstops(1)=80*Ts;
+
+% MIMO plant (see MIMO.M)
+plants{2}=ss(c2d(tf(10,[100 1])*[4 -5;-3 4],1));
+names{2}='mimo';
+costs{2}=struct('S',eye(2),'T',.1*eye(2),'rho',Inf);
+lims{2}=struct('umin',[-1;-1],'umax',[1;1]);
+N(2)=40;
+refs{2}=[0.63 0.79];
+Tstops(2)=200;
+
+fprintf('\n%-8s %-22s %5s %5s %10s %14s\n','plant','parametrization','nvar','nq','time [s]','cost');
+for p=1:2,
+    model=plants{p};
+    x0=zeros(size(model.A,1),1);
+    Nu=N(p)/2;
+    clear param
+    param{1}=struct('N',N(p),'Nu',Nu);
+    param{2}=struct('N',N(p),'Nu',[1 1 2 2 Nu-6]);
+    param{3}=struct('N',N(p),'Nu',Nu,'basis',laguerrebasis(Nu,.7,4));
+    pnames={sprintf('full (Nu=%d)',Nu),'blocking [1 1 2 2 ...]','Laguerre (a=.7, nb=4)'};
+    for i=1:3,
+        Con=lincon(model,'track',costs{p},param{i},lims{p});
+        r.y=refs{p};
+        tic;
+        [X,U,T,Y]=sim(Con,model,r,x0,Tstops(p),zeros(2,1));
+        t=toc;
+        E=Y-ones(size(Y,1),1)*refs{p};
+        DU=diff([zeros(1,2);U]);
+        J=sum(sum((E*costs{p}.S).*E))+sum(sum((DU*costs{p}.T).*DU));
+        fprintf('%-8s %-22s %5d %5d %10.3f %14.4f\n',names{p},pnames{i},Con.nvar,Con.nq,t,J);
+    end
+end
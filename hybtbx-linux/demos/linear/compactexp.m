@@ -0,0 +1,69 @@
+% Compact explicit controllers: memory vs evaluation time
+%
+% An explicit MPC controller for the double integrator with a long
+% horizon is computed twice: with all regions stored (H,K,F,G) and in
+% compact form (options.compact=N), where only the optimal active set of
+% each region and the QP matrices are stored and EXPCON/EVAL reconstructs
+% the regions it needs, keeping the last N used ones. The memory
+% occupancy, the time to evaluate the control law along a closed-loop
+% trajectory, and the largest difference between the two laws at random
+% points are reported.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+Ts=1;
+model=ss([1 1;0 1],[0;1],[0 1],0,Ts);
+
+clear limits interval weights
+limits.umin=-1;
+limits.umax=1;
+limits.ymin=-5;
+limits.ymax=5;
+interval.Nu=8;
+interval.N=8;
+weights.R=.1;
+weights.Q=[1 0;0 0];
+weights.P='lqr';
+weights.rho=+Inf;
+
+Cimp=lincon(model,'reg',weights,interval,limits);
+range=struct('xmin',[-15 -15],'xmax',[15 15]);
+
+clear options
+options.join=0;
+Cexp=expcon(Cimp,range,options);
+options.compact=20;
+Ccmp=expcon(Cimp,range,options);
+
+s=whos('Cexp');
+bfull=s.bytes;
+s=whos('Ccmp');
+bcmp=s.bytes;
+
+x0=[10,-.3]';
+Tstop=40;
+tic;
+[X1,U1]=sim(Cexp,model,[],x0,Tstop);
+tfull=toc;
+tic;
+[X2,U2]=sim(Ccmp,model,[],x0,Tstop);
+tcmp=toc;
+
+err=0;
+for k=1:500,
+    x=[30*rand-15;10*rand-5];
+    [u1,i1]=eval(Cexp,x);
+    [u2,i2]=eval(Ccmp,x);
+    if i1>0 && i2>0,
+        err=max(err,norm(u1-u2,inf));
+    end
+end
+
+fprintf('\n%d regions, %d stored explicitly in the compact controller\n',...
+    Cexp.nr,numel(Ccmp.info.compact.explicit));
+fprintf('%-10s %12s %12s\n','','memory [B]','sim time [s]');
+fprintf('%-10s %12d %12.3f\n','full',bfull,tfull);
+fprintf('%-10s %12d %12.3f\n','compact',bcmp,tcmp);
+fprintf('Largest difference between the control laws: %g\n',err);
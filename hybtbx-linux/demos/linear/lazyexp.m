@@ -0,0 +1,66 @@
+% Lazy explicit controllers: regions computed on demand
+%
+% An explicit MPC controller for the double integrator is created with
+% options.lazy=1: no region is computed offline. Closed-loop simulations
+% from a few initial states make EXPCON/EVAL solve the QP for the states
+% not covered yet and add the corresponding critical regions. REFINE then
+% stores the regions found in the controller, which is compared with the
+% full explicit controller (number of regions, synthesis time, largest
+% difference between the control laws on the visited states).
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+Ts=1;
+model=ss([1 1;0 1],[0;1],[0 1],0,Ts);
+
+clear limits interval weights
+limits.umin=-1;
+limits.umax=1;
+limits.ymin=-5;
+limits.ymax=5;
+interval.Nu=8;
+interval.N=8;
+weights.R=.1;
+weights.Q=[1 0;0 0];
+weights.P='lqr';
+weights.rho=+Inf;
+
+Cimp=lincon(model,'reg',weights,interval,limits);
+range=struct('xmin',[-15 -15],'xmax',[15 15]);
+
+clear options
+options.join=0;
+tic;
+Cexp=expcon(Cimp,range,options);
+tfull=toc;
+options.lazy=1;
+tic;
+Clazy=expcon(Cimp,range,options);
+tlazy=toc;
+
+Tstop=40;
+X=[];
+x0s=[10 -.3;-8 1;5 2]';
+tic;
+for j=1:size(x0s,2),
+    Xj=sim(Clazy,model,[],x0s(:,j),Tstop);
+    X=[X;Xj];
+end
+tsim=toc;
+[Clazy,nnew]=refine(Clazy);
+
+err=0;
+for k=1:size(X,1),
+    [u1,i1]=eval(Cexp,X(k,:)');
+    [u2,i2]=eval(Clazy,X(k,:)');
+    if i1>0 && i2>0,
+        err=max(err,norm(u1-u2,inf));
+    end
+end
+
+fprintf('\n%-10s %10s %14s\n','','regions','synthesis [s]');
+fprintf('%-10s %10d %14.3f\n','full',Cexp.nr,tfull);
+fprintf('%-10s %10d %14.3f\n','lazy',Clazy.nr,tlazy+tsim);
+fprintf('Largest difference between the control laws on visited states: %g\n',err);
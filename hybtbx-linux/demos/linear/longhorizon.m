@@ -0,0 +1,63 @@
+% Long-horizon linear MPC: condensed QP vs. multistage interior point
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+% Four masses connected by springs, two inputs
+Ts=.5;
+k=1;
+Ac=[zeros(4) eye(4);
+    -2*k k 0 0 zeros(1,4);
+    k -2*k k 0 zeros(1,4);
+    0 k -2*k k zeros(1,4);
+    0 0 k -2*k zeros(1,4)];
+Bc=[zeros(4,2);1 0;-1 0;0 1;0 0];
+model=c2d(ss(Ac,Bc,[eye(4) zeros(4)],zeros(4,2)),Ts);
+
+clear limits weights
+limits.umin=-.5*[1;1];
+limits.umax=.5*[1;1];
+limits.ymin=-1.5*ones(4,1);
+limits.ymax=1.5*ones(4,1);
+weights.Q=eye(8);
+weights.R=.1*eye(2);
+weights.P='lqr';
+weights.rho=1e3;
+
+x0=[1.4;-1.2;1;0;zeros(4,1)];
+Tstop=20;
+
+Nlist=[25 50 100 200];
+tqp=zeros(size(Nlist));
+tric=zeros(size(Nlist));
+err=zeros(size(Nlist));
+for i=1:numel(Nlist),
+    clear interval
+    interval.N=Nlist(i);
+    interval.Nu=Nlist(i);
+    interval.Ncy=Nlist(i)-1;
+    interval.Ncu=Nlist(i)-1;
+
+    Cqp=lincon(model,'reg',weights,interval,limits,'qpact');
+    Cric=lincon(model,'reg',weights,interval,limits,'riccati');
+
+    tic;
+    [X1,U1]=sim(Cqp,model,[],x0,Tstop);
+    tqp(i)=toc;
+    tic;
+    [X2,U2]=sim(Cric,model,[],x0,Tstop);
+    tric(i)=toc;
+    err(i)=max(abs(U1(:)-U2(:)));
+end
+
+fprintf('\n     N    condensed [s]    riccati [s]    max|u1-u2|\n');
+for i=1:numel(Nlist),
+    fprintf('%6d    %10.3f    %10.3f    %12.2e\n',Nlist(i),tqp(i),tric(i),err(i));
+end
+
+loglog(Nlist,tqp,'o-',Nlist,tric,'d-');
+xlabel('prediction horizon N');
+ylabel('simulation time [s]');
+legend('condensed QP (qpact)','multistage, Riccati (riccatimex)','Location','NorthWest');
+grid
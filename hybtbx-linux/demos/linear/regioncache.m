@@ -0,0 +1,67 @@
+% Online cache of critical regions ("semi-explicit" MPC)
+%
+% The MPC controller of AFTI16.M tracks a reference that revisits a few
+% set-points. With lincon.RegionCache>0, LINCON/EVAL stores the critical
+% regions of the optimal active sets found online with their affine
+% laws, and solves no QP when the current state/reference vector lies in
+% a stored region. The closed loop is simulated with and without cache;
+% the number of QPs solved, the computation time and the largest
+% difference between the input sequences are reported.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+% AFTI-16 (see AFTI16.M)
+Ts=.05;
+A=[-.0151 -60.5651 0 -32.174;
+     -.0001 -1.3411 .9929 0;
+     .00018 43.2541 -.86939 0;
+      0      0       1      0];
+B=[-2.516 -13.136;
+     -.1689 -.2514;
+     -17.251 -1.5766;
+     0        0];
+C=[0 1 0 0;
+     0 0 0 1];
+model=c2d(ss(A,B,C,zeros(2)),Ts);
+
+clear limits cost interval
+limits.umin=-25*[1 1]';
+limits.umax=25*[1 1]';
+limits.ymin=[-.5 -Inf]';
+limits.ymax=[.5 Inf]';
+cost.S=eye(2);
+cost.T=0.01*eye(2);
+cost.rho=Inf;
+interval.N=10;
+interval.Nu=4;
+interval.Ncy=1;
+
+Con=lincon(model,'track',cost,interval,limits);
+
+% Pitch angle set-points 0, 10, -10, revisited several times
+sp=[0 10 0 -10];
+Tstep=60;
+R=[zeros(4*Tstep*3,1) kron(repmat(sp',3,1),ones(Tstep,1))];
+Tsim=size(R,1);
+
+Ucl=cell(2,1);
+for c=1:2,
+    Con.RegionCache=(c==2)*200;
+    x=zeros(4,1);
+    u=zeros(2,1);
+    Ucl{c}=zeros(Tsim,2);
+    nqp=0;
+    tic;
+    for t=1:Tsim,
+        [du,Opt]=eval(Con,x,R(t,:)',u);
+        nqp=nqp+~Opt.cached;
+        u=u+du;
+        Ucl{c}(t,:)=u';
+        x=model.A*x+model.B*u;
+    end
+    time=toc;
+    fprintf('RegionCache=%3d: %4d QPs solved in %4d steps, %.3f s\n',Con.RegionCache,nqp,Tsim,time);
+end
+fprintf('Largest difference between the inputs: %g\n',max(max(abs(Ucl{1}-Ucl{2}))));
@@ -0,0 +1,93 @@
+% Time-varying MPC with incremental condensing
+%
+% The plant of TIMEVARYING1 is controlled by an MPC controller based on the
+% time-varying prediction model over the next N steps, with time-varying
+% output limits. At each time step the prediction window moves by one
+% step: CONDENSE detects that the model is the one of the previous step
+% shifted by one stage and only computes the new last stage, and the new
+% output limits only change the right-hand side W of the constraints.
+% The computation time is compared with building the condensed QP from
+% scratch at each step.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+clear variables
+
+N=60;
+Nu=10;
+Tstop=100;
+Ts=1;
+TT=round(Tstop/Ts);
+
+sys=ss(c2d(tf(1,[6 1.5 1]),Ts));
+
+% Time-varying output gain
+model=cell(TT+N+1,1);
+for i=1:TT+N+1,
+    model{i}=sys;
+    model{i}.C=sys.C*(1+0.5*sin(i/2));
+end
+
+clear weights limits
+weights.Q=1;
+weights.R=1e-2;
+weights.P=zeros(2);
+limits.umin=-3;
+limits.umax=3;
+
+r=1;    % Output reference
+x0=[0;0];
+
+if exist('condensemex')~=3,
+    warning('CONDENSEMEX not compiled, condensing in MATLAB (no incremental updates)');
+end
+
+tinc=0;
+tfull=0;
+err=0;
+x=x0;
+YY=zeros(1,TT);
+UU=zeros(1,TT);
+for t=0:TT-1,
+    % Output limit tightened along the simulation
+    limits.ymax=1.5-.4*(t>=TT/2);
+
+    tic;
+    [H,F,Y,G,W,S,Sbar,Tbar]=condense(model(t+1:t+N+1),N,Nu,weights,limits);
+    tinc=tinc+toc;
+
+    if exist('condensemex')==3,
+        % Same QP, rebuilt from scratch
+        clear condensemex
+        tic;
+        H1=condense(model(t+1:t+N+1),N,Nu,weights,limits);
+        tfull=tfull+toc;
+        err=max(err,max(abs(H(:)-H1(:))));
+        % Prime the engine again for the next incremental step
+        clear condensemex
+        condense(model(t+1:t+N+1),N,Nu,weights,limits);
+    end
+
+    % Tracking of r: weighted outputs y(1),...,y(N-1) replaced by y(k)-r
+    rr=[r*ones(N-1,1);0];
+    f=F*x-2*Sbar'*(weights.Q*rr);
+    U=qpsol(H,f,G,W+S*x);
+    u=U(1);
+
+    YY(t+1)=model{t+1}.C*x;
+    UU(t+1)=u;
+    x=model{t+1}.A*x+model{t+1}.B*u;
+end
+
+fprintf('\nCondensing, N=%d, %d steps: incremental %.3f s, from scratch %.3f s\n',N,TT,tinc,tfull);
+fprintf('max difference between the Hessians: %g\n',err);
+
+close all
+subplot(211)
+plot(0:Ts:Tstop-Ts,YY,[0 Tstop/2 Tstop/2 Tstop],[1.5 1.5 1.1 1.1],'--');
+grid
+title('Output');
+subplot(212)
+stairs(0:Ts:Tstop-Ts,UU);
+grid
+title('Input');
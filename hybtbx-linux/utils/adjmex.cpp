@@ -0,0 +1,242 @@
+/* Adjacency graph of the regions of a polyhedral partition - MEX interface
+
+   E=adjmex(H,K,i1,i2,thmin,thmax,tol,nthreads)
+
+   Region #i is {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, intersected
+   with the box thmin<=th<=thmax if thmin,thmax are not empty.
+
+   Each row [i,a,j,b] of E means that regions #i and #j (i<j) share a
+   facet of dimension npar-1, lying on the hyperplane H(a,:)*th=K(a) of
+   region #i and H(b,:)*th=K(b) of region #j. Rows of H are global row
+   indices (1-based).
+
+   Two facets can only be adjacent if they lie on the same hyperplane with
+   opposite normals. Rows are normalized to [H(a,:) K(a)]/norm(H(a,:)),
+   quantized and hashed, so that candidate pairs are found in linear time
+   instead of comparing all pairs of regions. Each candidate pair is then
+   confirmed:
+
+   - for free, if the center of the Chebychev ball of facet a (computed
+     once per row) lies strictly inside region #j;
+   - otherwise, by one small LP computing the largest ball of the
+     hyperplane contained in both regions (see LPDENSE.H).
+
+   Hyperplanes match if their normalized coefficients differ by at most tol
+   (default 1e-6); facets are adjacent if the common ball has radius > tol.
+   Rows are processed on nthreads worker threads (default: all cores).
+
+   Compile with MEXCOMPILE.M (or mex -O adjmex.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "lpdense.h"
+#include "mexthreads.h"
+#include "mexpart.h"
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <stdint.h>
+
+/* Input Arguments */
+
+#define H_IN       prhs[0]
+#define K_IN       prhs[1]
+#define I1_IN      prhs[2]
+#define I2_IN      prhs[3]
+#define THMIN_IN   prhs[4]
+#define THMAX_IN   prhs[5]
+#define TOL_IN     prhs[6]
+#define NTHREADS_IN prhs[7]
+
+/* Output Arguments */
+
+#define E_OUT   plhs[0]
+
+#define ADJ_CHUNK 32
+#define ADJ_QUANT 1000.0  /* hash cell = ADJ_QUANT*tol */
+#define ADJ_MAXAMB 8      /* max number of ambiguous coordinates probed */
+
+struct Edge {
+    int i, a, j, b;
+    bool operator<(const Edge &e) const { return a < e.a || (a == e.a && b < e.b); }
+};
+
+typedef std::unordered_map<uint64_t, std::vector<int> > HyperplaneHash;
+
+static uint64_t hash_cells(const std::vector<int64_t> &cell)
+{
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t k = 0; k < cell.size(); k++) {
+        h ^= (uint64_t) cell[k] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/* Normalized hyperplane [h k]/norm(h) of a row (sign flipped if neg) */
+static void normalized_row(const Partition &P, int row, bool neg, double *v)
+{
+    double s = (neg ? -1.0 : 1.0) / P.hn[row];
+    for (int j = 0; j < P.npar; j++)
+        v[j] = s * P.h(row, j);
+    v[P.npar] = s * P.K[row];
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    Partition P;
+    double tol = 1e-6, q, *e;
+    int row, j, nthreads = 0, nv;
+    size_t k, ne;
+
+    /* Check for proper number of arguments */
+
+    if (nrhs < 4) {
+        mexErrMsgTxt("At least four input arguments required (H,K,i1,i2).");
+    }
+    else if (nlhs > 1) {
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    mex_get_partition(P, H_IN, K_IN, I1_IN, I2_IN);
+    if (nrhs >= 6)
+        mex_get_box(P, THMIN_IN, THMAX_IN);
+    if (nrhs >= 7 && !mxIsEmpty(TOL_IN))
+        tol = mxGetScalar(TOL_IN);
+    if (tol <= 0)
+        mexErrMsgTxt("tol must be positive.");
+    if (nrhs >= 8 && !mxIsEmpty(NTHREADS_IN))
+        nthreads = (int) mxGetScalar(NTHREADS_IN);
+    nthreads = mex_num_threads(nthreads);
+
+    /* Hash the normalized hyperplanes of all rows */
+    nv = P.npar + 1;
+    q = ADJ_QUANT * tol;
+    HyperplaneHash table;
+    {
+        std::vector<double> v(nv);
+        std::vector<int64_t> cell(nv);
+        for (row = 0; row < P.nh; row++) {
+            if (P.region_of[row] < 0 || P.hn[row] <= tol)
+                continue;
+            normalized_row(P, row, false, &v[0]);
+            for (j = 0; j < nv; j++)
+                cell[j] = (int64_t) std::floor(v[j] / q + 0.5);
+            table[hash_cells(cell)].push_back(row);
+        }
+    }
+
+    /* Find and confirm the neighbors of each row */
+    std::vector<DenseLP> lps(nthreads);
+    std::vector<std::vector<Edge> > edges(nthreads);
+    mex_parallel_for(P.nh, nthreads, ADJ_CHUNK, [&](int a, int t) {
+        int i = P.region_of[a], j, jj, b, l, namb;
+        if (i < 0 || P.hn[a] <= tol)
+            return;
+
+        /* candidate rows: the opposite hyperplane, probing both cells of
+           the coordinates that are close to a cell boundary */
+        std::vector<double> v(nv), w(nv);
+        std::vector<int64_t> cell(nv), probe(nv);
+        std::vector<int> amb, cand;
+        normalized_row(P, a, true, &v[0]);
+        for (j = 0; j < nv; j++) {
+            double z = v[j] / q + 0.5, f = z - std::floor(z);
+            cell[j] = (int64_t) std::floor(z);
+            if (f < tol / q)
+                amb.push_back(-j - 1);
+            else if (f > 1.0 - tol / q)
+                amb.push_back(j + 1);
+        }
+        namb = std::min((int) amb.size(), ADJ_MAXAMB);
+        for (int mask = 0; mask < (1 << namb); mask++) {
+            probe = cell;
+            for (l = 0; l < namb; l++)
+                if (mask & (1 << l)) {
+                    if (amb[l] < 0)
+                        probe[-amb[l] - 1]--;
+                    else
+                        probe[amb[l] - 1]++;
+                }
+            HyperplaneHash::const_iterator it = table.find(hash_cells(probe));
+            if (it == table.end())
+                continue;
+            for (size_t c = 0; c < it->second.size(); c++) {
+                b = it->second[c];
+                if (P.region_of[b] <= i)
+                    continue;
+                normalized_row(P, b, false, &w[0]);
+                for (j = 0; j < nv; j++)
+                    if (std::fabs(v[j] - w[j]) > tol)
+                        break;
+                if (j == nv && std::find(cand.begin(), cand.end(), b) == cand.end())
+                    cand.push_back(b);
+            }
+        }
+        if (cand.empty())
+            return;
+
+        /* Chebychev ball of facet a in its own region */
+        DenseLP &lp = lps[t];
+        std::vector<double> h(P.npar), x(P.npar, 0.0), xa(P.npar), A, rhs;
+        double ra, r;
+        for (j = 0; j < P.npar; j++)
+            h[j] = P.h(a, j);
+        partition_region_rows(P, i, a, A, rhs);
+        lpdense_facet_chebyshev(lp, P.npar, &h[0], P.K[a], (int) rhs.size(),
+                                A.data(), rhs.data(), &x[0], &ra);
+        if (!(ra > tol))
+            return;   /* not a facet of region #i */
+        xa = x;
+        size_t ma = rhs.size();
+
+        for (size_t c = 0; c < cand.size(); c++) {
+            b = cand[c];
+            jj = P.region_of[b];
+
+            /* facet center of a strictly inside region #jj? */
+            for (l = P.i1[jj]; l <= P.i2[jj]; l++) {
+                if (l == b)
+                    continue;
+                double s = P.K[l];
+                for (j = 0; j < P.npar; j++)
+                    s -= P.h(l, j) * xa[j];
+                if (s <= tol * (1.0 + P.hn[l]))
+                    break;
+            }
+            if (l > P.i2[jj]) {
+                edges[t].push_back(Edge{i, a, jj, b});
+                continue;
+            }
+
+            /* largest ball of the hyperplane in both regions */
+            A.resize(ma * P.npar);
+            rhs.resize(ma);
+            partition_region_rows(P, jj, b, A, rhs);
+            x = xa;
+            lpdense_facet_chebyshev(lp, P.npar, &h[0], P.K[a], (int) rhs.size(),
+                                    A.data(), rhs.data(), &x[0], &r);
+            if (r > tol)
+                edges[t].push_back(Edge{i, a, jj, b});
+        }
+    });
+
+    /* Collect the edges, sorted by row */
+    std::vector<Edge> all;
+    for (int t = 0; t < nthreads; t++)
+        all.insert(all.end(), edges[t].begin(), edges[t].end());
+    std::sort(all.begin(), all.end());
+    ne = all.size();
+
+    E_OUT = mxCreateDoubleMatrix(ne, 4, mxREAL);
+    e = mxGetPr(E_OUT);
+    for (k = 0; k < ne; k++) {
+        e[k] = all[k].i + 1;
+        e[k + ne] = all[k].a + 1;
+        e[k + 2 * ne] = all[k].j + 1;
+        e[k + 3 * ne] = all[k].b + 1;
+    }
+}
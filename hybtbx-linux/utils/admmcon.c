@@ -0,0 +1,159 @@
+/* MPC controller by ADMM QP iterations - fixed size, no memory allocation
+
+status=admmcon(double *u, double *th)
+
+Solve the QP of the MPC controller written in ADMMCON.H by @LINCON/ADMMCODEGEN
+
+    min .5*U'*Q*U+th'*C'*U  s.t. G*U<=W+S*th
+
+and return the first move u=I1*U. For linear regulators th=x(t), for
+tracking controllers th=[x(t);u(t-1);r(t)] and u is the input increment.
+
+The iterations are those of ADMMQP.CPP with a constant step size rho and
+no scaling, using the factor of Q+sigma*I+rho*G'*G computed offline. They
+start from the solution of the previous call (call admmcon_reset() to
+start from zero).
+
+The return value is 0 if the tolerances are met, 3 if the maximum number
+of iterations is reached (the last iterate is returned, and the next call
+starts from zero, as the iterates of an infeasible QP diverge).
+
+(C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "admmcon.h"
+#include <math.h>
+
+#if ADMMCON_NCON > 0
+#define ADMMCON_MDIM ADMMCON_NCON
+#else
+#define ADMMCON_MDIM 1
+#endif
+
+static double admmcon_x[ADMMCON_NVAR];   /* primal iterate */
+static double admmcon_z[ADMMCON_MDIM];   /* G*U */
+static double admmcon_y[ADMMCON_MDIM];   /* multipliers */
+static double admmcon_q[ADMMCON_NVAR];
+static double admmcon_b[ADMMCON_MDIM];   /* W+S*th */
+static double admmcon_xt[ADMMCON_NVAR];
+static double admmcon_zt[ADMMCON_MDIM];
+static double admmcon_w[ADMMCON_NVAR];
+
+static void admmcon_reset(void)
+{
+    int i;
+    for (i = 0; i < ADMMCON_NVAR; i++)
+        admmcon_x[i] = 0;
+    for (i = 0; i < ADMMCON_MDIM; i++) {
+        admmcon_z[i] = 0;
+        admmcon_y[i] = 0;
+    }
+}
+
+/* v = inv(L*L')*v, L packed by rows */
+static void admmcon_cholsolve(double *v)
+{
+    int i, k, ii;
+    for (i = 0; i < ADMMCON_NVAR; i++) {
+        double t = v[i];
+        ii = i * (i + 1) / 2;
+        for (k = 0; k < i; k++)
+            t -= ADMMCON_L[ii + k] * v[k];
+        v[i] = t / ADMMCON_L[ii + i];
+    }
+    for (i = ADMMCON_NVAR - 1; i >= 0; i--) {
+        double t = v[i];
+        ii = i * (i + 1) / 2;
+        for (k = i + 1; k < ADMMCON_NVAR; k++)
+            t -= ADMMCON_L[k * (k + 1) / 2 + i] * v[k];
+        v[i] = t / ADMMCON_L[ii + i];
+    }
+}
+
+static int admmcon(double *u, double *th)
+{
+    int i, j, it, status = 3;
+    double t, rp, rd, nGx, nz, nQx, nGy, nq;
+
+    /* q=C*th, b=W+S*th */
+    for (i = 0; i < ADMMCON_NVAR; i++) {
+        t = 0;
+        for (j = 0; j < ADMMCON_NTH; j++)
+            t += ADMMCON_C[i + j * ADMMCON_NVAR] * th[j];
+        admmcon_q[i] = t;
+    }
+    for (i = 0; i < ADMMCON_NCON; i++) {
+        t = ADMMCON_W[i];
+        for (j = 0; j < ADMMCON_NTH; j++)
+            t += ADMMCON_S[i + j * ADMMCON_NCON] * th[j];
+        admmcon_b[i] = t;
+    }
+
+    for (it = 1; it <= ADMMCON_MAXITER; it++) {
+        /* xt = inv(Q+sigma*I+rho*G'*G)*(sigma*x-q+G'*(rho*z-y)) */
+        for (j = 0; j < ADMMCON_NVAR; j++) {
+            t = ADMMCON_SIGMA * admmcon_x[j] - admmcon_q[j];
+            for (i = 0; i < ADMMCON_NCON; i++)
+                t += ADMMCON_G[i + j * ADMMCON_NCON] * (ADMMCON_RHO * admmcon_z[i] - admmcon_y[i]);
+            admmcon_xt[j] = t;
+        }
+        admmcon_cholsolve(admmcon_xt);
+        for (j = 0; j < ADMMCON_NVAR; j++)
+            admmcon_x[j] = ADMMCON_ALPHA * admmcon_xt[j] + (1 - ADMMCON_ALPHA) * admmcon_x[j];
+        for (i = 0; i < ADMMCON_NCON; i++) {
+            double zr, zn;
+            t = 0;
+            for (j = 0; j < ADMMCON_NVAR; j++)
+                t += ADMMCON_G[i + j * ADMMCON_NCON] * admmcon_xt[j];
+            zr = ADMMCON_ALPHA * t + (1 - ADMMCON_ALPHA) * admmcon_z[i];
+            zn = zr + admmcon_y[i] / ADMMCON_RHO;
+            if (zn > admmcon_b[i])
+                zn = admmcon_b[i];
+            admmcon_y[i] += ADMMCON_RHO * (zr - zn);
+            admmcon_z[i] = zn;
+        }
+
+        if (it % ADMMCON_CHECK_EVERY && it < ADMMCON_MAXITER)
+            continue;
+
+        /* primal residual G*x-z, dual residual Q*x+q+G'*y */
+        rp = nGx = nz = 0;
+        for (i = 0; i < ADMMCON_NCON; i++) {
+            t = 0;
+            for (j = 0; j < ADMMCON_NVAR; j++)
+                t += ADMMCON_G[i + j * ADMMCON_NCON] * admmcon_x[j];
+            admmcon_zt[i] = t;
+            rp = fmax(rp, fabs(t - admmcon_z[i]));
+            nGx = fmax(nGx, fabs(t));
+            nz = fmax(nz, fabs(admmcon_z[i]));
+        }
+        rd = nQx = nGy = nq = 0;
+        for (j = 0; j < ADMMCON_NVAR; j++) {
+            double qx = 0, gy = 0;
+            for (i = 0; i < ADMMCON_NVAR; i++)
+                qx += ADMMCON_Q[j + i * ADMMCON_NVAR] * admmcon_x[i];
+            for (i = 0; i < ADMMCON_NCON; i++)
+                gy += ADMMCON_G[i + j * ADMMCON_NCON] * admmcon_y[i];
+            admmcon_w[j] = qx + admmcon_q[j] + gy;
+            rd = fmax(rd, fabs(admmcon_w[j]));
+            nQx = fmax(nQx, fabs(qx));
+            nGy = fmax(nGy, fabs(gy));
+            nq = fmax(nq, fabs(admmcon_q[j]));
+        }
+        if (rp <= ADMMCON_EPS_ABS + ADMMCON_EPS_REL * fmax(nGx, nz)
+            && rd <= ADMMCON_EPS_ABS + ADMMCON_EPS_REL * fmax(fmax(nQx, nGy), nq)) {
+            status = 0;
+            break;
+        }
+    }
+
+    for (i = 0; i < ADMMCON_NU; i++) {
+        t = 0;
+        for (j = 0; j < ADMMCON_NVAR; j++)
+            t += ADMMCON_I1[i + j * ADMMCON_NU] * admmcon_x[j];
+        u[i] = t;
+    }
+    if (status)
+        admmcon_reset();
+    return status;
+}
@@ -0,0 +1,488 @@
+/* ADMM QP solver with offline factorization - implementation
+
+   See ADMMQP.H for the API.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "admmqp.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#define ADMMQP_INF 1e20              /* bounds beyond this are infinite */
+#define ADMMQP_RHO_EQ 1e3            /* rho(equality row)/rho */
+#define ADMMQP_RHO_FREE 1e-6         /* rho of free rows */
+#define ADMMQP_RHO_MIN 1e-6          /* range of the adapted rho */
+#define ADMMQP_RHO_MAX 1e6
+#define ADMMQP_RHO_TOL 5.0           /* refactor if rho changes by more than this factor */
+#define ADMMQP_MIN_SCALING 1e-4      /* range of the scaling factors */
+#define ADMMQP_MAX_SCALING 1e4
+
+enum { ROW_INEQ = 0, ROW_EQ = 1, ROW_FREE = 2 };
+
+struct admmqp_struct {
+    int n, m;
+    admmqp_settings set;
+    std::vector<double> P, A, L;     /* scaled data, L = chol(P+sigma*I+A'*diag(rho)*A), lower */
+    std::vector<double> D, E;        /* P=c*D*P0*D, A=E*A0*D */
+    double c;
+    double rho0;                     /* current rho of inequality rows */
+    std::vector<double> rho;
+    std::vector<int> type;
+    std::vector<double> q, l, u;     /* scaled: c*D*q0, E*l0, E*u0 */
+    std::vector<double> x, z, y;     /* iterates of the scaled problem */
+    std::vector<double> xt, zt, w, Ax, Px, Aty, dx, dy;
+    int nfact;
+};
+
+void admmqp_default_settings(admmqp_settings *s)
+{
+    s->rho = 0.1;
+    s->sigma = 1e-6;
+    s->alpha = 1.6;
+    s->eps_abs = 1e-6;
+    s->eps_rel = 1e-6;
+    s->eps_inf = 1e-7;
+    s->maxiter = 4000;
+    s->check_every = 5;
+    s->scaling = 10;
+    s->adaptive_rho_interval = 25;
+}
+
+static int row_type(double lo, double up)
+{
+    if (lo <= -ADMMQP_INF && up >= ADMMQP_INF)
+        return ROW_FREE;
+    if (std::fabs(up - lo) <= 1e-10 * (1.0 + std::fabs(lo)))
+        return ROW_EQ;
+    return ROW_INEQ;
+}
+
+/* y = M*v, M is m-by-n */
+static void matvec(const std::vector<double> &M, int m, int n, const double *v, double *y)
+{
+    int i, j;
+    for (i = 0; i < m; i++)
+        y[i] = 0.0;
+    for (j = 0; j < n; j++) {
+        const double *c = &M[0] + (size_t) j * m;
+        double vj = v[j];
+        if (vj != 0.0)
+            for (i = 0; i < m; i++)
+                y[i] += c[i] * vj;
+    }
+}
+
+/* y = M'*v, M is m-by-n */
+static void matvec_t(const std::vector<double> &M, int m, int n, const double *v, double *y)
+{
+    for (int j = 0; j < n; j++) {
+        const double *c = &M[0] + (size_t) j * m;
+        double t = 0;
+        for (int i = 0; i < m; i++)
+            t += c[i] * v[i];
+        y[j] = t;
+    }
+}
+
+static double norm_inf(const double *v, int n)
+{
+    double t = 0;
+    for (int i = 0; i < n; i++)
+        t = std::max(t, std::fabs(v[i]));
+    return t;
+}
+
+/* Factor P+sigma*I+A'*diag(rho)*A */
+static bool factor(admmqp_t *qp)
+{
+    int n = qp->n, m = qp->m, i, j, k;
+    std::vector<double> &L = qp->L;
+
+    for (i = 0; i < m; i++)
+        qp->rho[i] = (qp->type[i] == ROW_EQ) ? ADMMQP_RHO_EQ * qp->rho0
+                   : (qp->type[i] == ROW_FREE) ? ADMMQP_RHO_FREE : qp->rho0;
+
+    L = qp->P;
+    for (j = 0; j < n; j++) {
+        L[j + (size_t) j * n] += qp->set.sigma;
+        for (i = j; i < n; i++) {
+            double t = 0;
+            for (k = 0; k < m; k++)
+                t += qp->A[k + (size_t) i * m] * qp->rho[k] * qp->A[k + (size_t) j * m];
+            L[i + (size_t) j * n] += t;
+        }
+    }
+    /* Cholesky, lower triangle */
+    for (j = 0; j < n; j++) {
+        double s = L[j + (size_t) j * n];
+        for (k = 0; k < j; k++)
+            s -= L[j + (size_t) k * n] * L[j + (size_t) k * n];
+        if (!(s > 0))
+            return false;
+        s = std::sqrt(s);
+        L[j + (size_t) j * n] = s;
+        for (i = j + 1; i < n; i++) {
+            double t = L[i + (size_t) j * n];
+            for (k = 0; k < j; k++)
+                t -= L[i + (size_t) k * n] * L[j + (size_t) k * n];
+            L[i + (size_t) j * n] = t / s;
+        }
+    }
+    qp->nfact++;
+    return true;
+}
+
+/* v = inv(L*L')*v */
+static void cholsolve(const std::vector<double> &L, int n, double *v)
+{
+    int i, k;
+    for (i = 0; i < n; i++) {
+        double t = v[i];
+        for (k = 0; k < i; k++)
+            t -= L[i + (size_t) k * n] * v[k];
+        v[i] = t / L[i + (size_t) i * n];
+    }
+    for (i = n - 1; i >= 0; i--) {
+        double t = v[i];
+        for (k = i + 1; k < n; k++)
+            t -= L[k + (size_t) i * n] * v[k];
+        v[i] = t / L[i + (size_t) i * n];
+    }
+}
+
+static double limit_scaling(double t)
+{
+    return t < ADMMQP_MIN_SCALING ? 1.0 : std::min(t, ADMMQP_MAX_SCALING);
+}
+
+/* Ruiz equilibration of the KKT matrix [P A';A 0] as in OSQP, then
+   scaling of the cost by the mean column norm of P */
+static void scale(admmqp_t *qp)
+{
+    int n = qp->n, m = qp->m, i, j, it;
+    std::vector<double> dt(n), et(m);
+
+    qp->D.assign(n, 1.0);
+    qp->E.assign(m, 1.0);
+    qp->c = 1.0;
+    for (it = 0; it < qp->set.scaling; it++) {
+        for (j = 0; j < n; j++) {
+            double t = 0;
+            for (i = 0; i < n; i++)
+                t = std::max(t, std::fabs(qp->P[i + (size_t) j * n]));
+            for (i = 0; i < m; i++)
+                t = std::max(t, std::fabs(qp->A[i + (size_t) j * m]));
+            dt[j] = 1.0 / std::sqrt(limit_scaling(t));
+        }
+        for (i = 0; i < m; i++) {
+            double t = 0;
+            for (j = 0; j < n; j++)
+                t = std::max(t, std::fabs(qp->A[i + (size_t) j * m]));
+            et[i] = 1.0 / std::sqrt(limit_scaling(t));
+        }
+        for (j = 0; j < n; j++) {
+            for (i = 0; i < n; i++)
+                qp->P[i + (size_t) j * n] *= dt[i] * dt[j];
+            for (i = 0; i < m; i++)
+                qp->A[i + (size_t) j * m] *= et[i] * dt[j];
+            qp->D[j] *= dt[j];
+        }
+        for (i = 0; i < m; i++)
+            qp->E[i] *= et[i];
+    }
+    if (qp->set.scaling > 0 && n > 0) {
+        double t = 0;
+        for (j = 0; j < n; j++)
+            t += norm_inf(&qp->P[0] + (size_t) j * n, n);
+        qp->c = 1.0 / limit_scaling(t / n);
+        for (j = 0; j < n * n; j++)
+            qp->P[j] *= qp->c;
+    }
+}
+
+static double scale_bound(double b, double e)
+{
+    return b <= -ADMMQP_INF || b >= ADMMQP_INF ? b : b * e;
+}
+
+static double unscale_bound(double b, double e)
+{
+    return b <= -ADMMQP_INF || b >= ADMMQP_INF ? b : b / e;
+}
+
+admmqp_t *admmqp_new(int n, int m, const double *P, const double *A,
+                     const double *l, const double *u, const admmqp_settings *settings)
+{
+    admmqp_t *qp = new admmqp_struct;
+    int i;
+
+    qp->n = n;
+    qp->m = m;
+    if (settings)
+        qp->set = *settings;
+    else
+        admmqp_default_settings(&qp->set);
+    qp->P.assign(P, P + (size_t) n * n);
+    if (m > 0)
+        qp->A.assign(A, A + (size_t) m * n);
+    qp->rho.resize(m);
+    qp->type.resize(m);
+    qp->q.assign(n, 0.0);
+    qp->l.assign(m, -ADMMQP_INF);
+    qp->u.assign(m, ADMMQP_INF);
+    for (i = 0; i < m; i++) {
+        if (l)
+            qp->l[i] = std::max(l[i], -ADMMQP_INF);
+        if (u)
+            qp->u[i] = std::min(u[i], ADMMQP_INF);
+        qp->type[i] = l || u ? row_type(qp->l[i], qp->u[i]) : ROW_INEQ;
+    }
+    scale(qp);
+    for (i = 0; i < m; i++) {
+        qp->l[i] = scale_bound(qp->l[i], qp->E[i]);
+        qp->u[i] = scale_bound(qp->u[i], qp->E[i]);
+    }
+    qp->rho0 = qp->set.rho;
+    qp->x.assign(n, 0.0);
+    qp->z.assign(m, 0.0);
+    qp->y.assign(m, 0.0);
+    qp->xt.resize(n);
+    qp->zt.resize(m);
+    qp->w.resize(std::max(n, m));
+    qp->Ax.resize(m);
+    qp->Px.resize(n);
+    qp->Aty.resize(n);
+    qp->dx.resize(n);
+    qp->dy.resize(m);
+    qp->nfact = 0;
+    if (!factor(qp)) {
+        delete qp;
+        return NULL;
+    }
+    return qp;
+}
+
+void admmqp_free(admmqp_t *qp)
+{
+    delete qp;
+}
+
+int admmqp_num_factorizations(const admmqp_t *qp)
+{
+    return qp->nfact;
+}
+
+void admmqp_update(admmqp_t *qp, const double *q, const double *l, const double *u)
+{
+    int i, changed = 0;
+    if (q)
+        for (i = 0; i < qp->n; i++)
+            qp->q[i] = qp->c * qp->D[i] * q[i];
+    for (i = 0; i < qp->m; i++) {
+        if (l)
+            qp->l[i] = scale_bound(std::max(l[i], -ADMMQP_INF), qp->E[i]);
+        if (u)
+            qp->u[i] = scale_bound(std::min(u[i], ADMMQP_INF), qp->E[i]);
+        int t = row_type(unscale_bound(qp->l[i], qp->E[i]), unscale_bound(qp->u[i], qp->E[i]));
+        if (t != qp->type[i]) {
+            qp->type[i] = t;
+            changed = 1;
+        }
+    }
+    /* rho depends on the type of the rows: refactor if it changed */
+    if (changed)
+        factor(qp);
+}
+
+void admmqp_warm_start(admmqp_t *qp, const double *x, const double *y)
+{
+    int i;
+    for (i = 0; i < qp->n; i++)
+        qp->x[i] = x ? x[i] / qp->D[i] : 0.0;
+    for (i = 0; i < qp->m; i++)
+        qp->y[i] = y ? qp->c * y[i] / qp->E[i] : 0.0;
+    /* z = projection of A*x on [l,u] */
+    if (qp->m > 0) {
+        matvec(qp->A, qp->m, qp->n, &qp->x[0], &qp->z[0]);
+        for (i = 0; i < qp->m; i++)
+            qp->z[i] = std::min(std::max(qp->z[i], qp->l[i]), qp->u[i]);
+    }
+}
+
+/* Primal infeasibility certificate: A'*dy=0, u'*max(dy,0)+l'*min(dy,0)<0,
+   checked on the unscaled problem (dy0=E*dy) */
+static bool primal_infeasible(admmqp_t *qp)
+{
+    int i, n = qp->n, m = qp->m;
+    double ndy = 0, eps = qp->set.eps_inf, t = 0;
+    for (i = 0; i < m; i++)
+        ndy = std::max(ndy, std::fabs(qp->E[i] * qp->dy[i]));
+    if (m == 0 || ndy <= 0)
+        return false;
+    matvec_t(qp->A, m, n, &qp->dy[0], &qp->w[0]);
+    for (i = 0; i < n; i++)
+        if (std::fabs(qp->w[i] / qp->D[i]) > eps * ndy)
+            return false;
+    for (i = 0; i < m; i++) {
+        if (qp->dy[i] > 0) {
+            if (qp->u[i] >= ADMMQP_INF)
+                return false;
+            t += qp->u[i] * qp->dy[i];
+        }
+        else if (qp->dy[i] < 0) {
+            if (qp->l[i] <= -ADMMQP_INF)
+                return false;
+            t += qp->l[i] * qp->dy[i];
+        }
+    }
+    return t < -eps * ndy;
+}
+
+/* Dual infeasibility certificate: P*dx=0, q'*dx<0, A*dx in recession cone,
+   checked on the unscaled problem (dx0=D*dx) */
+static bool dual_infeasible(admmqp_t *qp)
+{
+    int i, n = qp->n, m = qp->m;
+    double ndx = 0, eps = qp->set.eps_inf, t = 0;
+    for (i = 0; i < n; i++)
+        ndx = std::max(ndx, std::fabs(qp->D[i] * qp->dx[i]));
+    if (ndx <= 0)
+        return false;
+    for (i = 0; i < n; i++)
+        t += qp->q[i] * qp->dx[i];
+    if (t >= -eps * ndx * qp->c)
+        return false;
+    matvec(qp->P, n, n, &qp->dx[0], &qp->w[0]);
+    for (i = 0; i < n; i++)
+        if (std::fabs(qp->w[i] / qp->D[i]) > eps * ndx * qp->c)
+            return false;
+    if (m > 0) {
+        std::vector<double> Adx(m);
+        matvec(qp->A, m, n, &qp->dx[0], &Adx[0]);
+        for (i = 0; i < m; i++) {
+            double a = Adx[i] / qp->E[i];
+            if (qp->u[i] < ADMMQP_INF && a > eps * ndx)
+                return false;
+            if (qp->l[i] > -ADMMQP_INF && a < -eps * ndx)
+                return false;
+        }
+    }
+    return true;
+}
+
+int admmqp_solve(admmqp_t *qp, double *x, double *y, int *iter)
+{
+    int n = qp->n, m = qp->m, i, it, status = ADMMQP_MAXITER;
+    double alpha = qp->set.alpha, sigma = qp->set.sigma;
+
+    if (qp->L.empty() && n > 0)
+        return ADMMQP_NOTPOSDEF;
+
+    for (it = 1; it <= qp->set.maxiter; it++) {
+        /* x-update: (P+sigma*I+A'*rho*A)*xt = sigma*x-q+A'*(rho.*z-y) */
+        for (i = 0; i < m; i++)
+            qp->w[i] = qp->rho[i] * qp->z[i] - qp->y[i];
+        if (m > 0)
+            matvec_t(qp->A, m, n, &qp->w[0], &qp->xt[0]);
+        else
+            std::fill(qp->xt.begin(), qp->xt.end(), 0.0);
+        for (i = 0; i < n; i++)
+            qp->xt[i] += sigma * qp->x[i] - qp->q[i];
+        cholsolve(qp->L, n, &qp->xt[0]);
+        if (m > 0)
+            matvec(qp->A, m, n, &qp->xt[0], &qp->zt[0]);
+
+        /* relaxation, z- and y-update */
+        for (i = 0; i < n; i++) {
+            double xn = alpha * qp->xt[i] + (1.0 - alpha) * qp->x[i];
+            qp->dx[i] = xn - qp->x[i];
+            qp->x[i] = xn;
+        }
+        for (i = 0; i < m; i++) {
+            double zr = alpha * qp->zt[i] + (1.0 - alpha) * qp->z[i];
+            double zn = std::min(std::max(zr + qp->y[i] / qp->rho[i], qp->l[i]), qp->u[i]);
+            qp->dy[i] = qp->rho[i] * (zr - zn);
+            qp->y[i] += qp->dy[i];
+            qp->z[i] = zn;
+        }
+
+        bool adapt = qp->set.adaptive_rho_interval > 0 && m > 0
+            && it % qp->set.adaptive_rho_interval == 0;
+        if (it % qp->set.check_every && it < qp->set.maxiter && !adapt)
+            continue;
+
+        /* residuals of the unscaled problem (r*) and of the scaled one (s*) */
+        double rp = 0, rd = 0, nAx = 0, nz = 0, nPx = 0, nAty = 0, nq = 0;
+        double sp = 0, sd = 0, sAx = 0, sz = 0, sPx = 0, sAty = 0, sq = 0;
+        if (m > 0) {
+            matvec(qp->A, m, n, &qp->x[0], &qp->Ax[0]);
+            matvec_t(qp->A, m, n, &qp->y[0], &qp->Aty[0]);
+        }
+        else
+            std::fill(qp->Aty.begin(), qp->Aty.end(), 0.0);
+        for (i = 0; i < m; i++) {
+            double e = 1.0 / qp->E[i], r = qp->Ax[i] - qp->z[i];
+            rp = std::max(rp, e * std::fabs(r));
+            nAx = std::max(nAx, e * std::fabs(qp->Ax[i]));
+            nz = std::max(nz, e * std::fabs(qp->z[i]));
+            sp = std::max(sp, std::fabs(r));
+            sAx = std::max(sAx, std::fabs(qp->Ax[i]));
+            sz = std::max(sz, std::fabs(qp->z[i]));
+        }
+        matvec(qp->P, n, n, &qp->x[0], &qp->Px[0]);
+        for (i = 0; i < n; i++) {
+            double d = 1.0 / (qp->c * qp->D[i]), r = qp->Px[i] + qp->q[i] + qp->Aty[i];
+            rd = std::max(rd, d * std::fabs(r));
+            nPx = std::max(nPx, d * std::fabs(qp->Px[i]));
+            nAty = std::max(nAty, d * std::fabs(qp->Aty[i]));
+            nq = std::max(nq, d * std::fabs(qp->q[i]));
+            sd = std::max(sd, std::fabs(r));
+            sPx = std::max(sPx, std::fabs(qp->Px[i]));
+            sAty = std::max(sAty, std::fabs(qp->Aty[i]));
+            sq = std::max(sq, std::fabs(qp->q[i]));
+        }
+
+        if (rp <= qp->set.eps_abs + qp->set.eps_rel * std::max(nAx, nz)
+            && rd <= qp->set.eps_abs + qp->set.eps_rel * std::max(std::max(nPx, nAty), nq)) {
+            status = ADMMQP_SOLVED;
+            break;
+        }
+        if (primal_infeasible(qp)) {
+            status = ADMMQP_PRIMAL_INFEASIBLE;
+            break;
+        }
+        if (dual_infeasible(qp)) {
+            status = ADMMQP_DUAL_INFEASIBLE;
+            break;
+        }
+
+        /* adaptive rho as in OSQP: balance the relative residuals */
+        if (adapt) {
+            double t = (sp / (std::max(sAx, sz) + 1e-10))
+                / (sd / (std::max(std::max(sPx, sAty), sq) + 1e-10) + 1e-10);
+            double r = qp->rho0 * std::sqrt(t);
+            r = std::min(std::max(r, ADMMQP_RHO_MIN), ADMMQP_RHO_MAX);
+            if (r > ADMMQP_RHO_TOL * qp->rho0 || r < qp->rho0 / ADMMQP_RHO_TOL) {
+                double r0 = qp->rho0;
+                qp->rho0 = r;
+                if (!factor(qp)) {
+                    qp->rho0 = r0;
+                    factor(qp);
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++)
+        x[i] = qp->D[i] * qp->x[i];
+    if (y)
+        for (i = 0; i < m; i++)
+            y[i] = qp->E[i] * qp->y[i] / qp->c;
+    if (iter)
+        *iter = std::min(it, qp->set.maxiter);
+    if (status == ADMMQP_PRIMAL_INFEASIBLE || status == ADMMQP_DUAL_INFEASIBLE)
+        admmqp_warm_start(qp, NULL, NULL);   /* do not start the next solve from a certificate */
+    return status;
+}
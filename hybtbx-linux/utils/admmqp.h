@@ -0,0 +1,97 @@
+/* ADMM QP solver with offline factorization - C API
+
+   Solves
+
+       min  .5*x'*P*x + q'*x
+       s.t. l <= A*x <= u
+
+   by the alternating direction method of multipliers in the form of
+   OSQP (B. Stellato et al., "OSQP: an operator splitting solver for
+   quadratic programs", Math. Prog. Comp. 12, 2020). Each iteration solves
+   a linear system with the matrix P+sigma*I+A'*diag(rho)*A, which is
+   factored once by admmqp_new. In MPC only q, l and u change with the
+   state: admmqp_update replaces them without refactoring, and
+   admmqp_solve starts from the primal/dual iterates of the previous solve.
+
+   rho is larger for equality rows (l=u) and smaller for free rows
+   (l=-Inf, u=Inf). If an update changes the type of a row, the matrix is
+   refactored.
+
+   As in OSQP, the data are equilibrated by Ruiz scaling of the matrix
+   [P A';A 0] and of the cost, and rho is adapted during the iterations
+   to balance the primal and dual residuals. Each change of rho refactors
+   the matrix; the adapted rho is kept for the following solves, so that
+   in MPC refactoring stops after the first few QPs. Set
+   adaptive_rho_interval=0 to keep rho fixed (a single factorization).
+   Tolerances and infeasibility certificates refer to the unscaled problem.
+
+   Matrices are dense and column-major (MATLAB layout), l and u may
+   contain -Inf/+Inf. See ADMMQPMEX.CPP for the MEX interface,
+   @LINCON/ADMMCODEGEN.M and ADMMCON.C for allocation-free C code for
+   LINCON objects, and python_example/admmqp.py for the Python interface.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef ADMMQP_H
+#define ADMMQP_H
+
+#define ADMMQP_SOLVED             0
+#define ADMMQP_PRIMAL_INFEASIBLE  1
+#define ADMMQP_DUAL_INFEASIBLE    2
+#define ADMMQP_MAXITER            3
+#define ADMMQP_NOTPOSDEF          4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct admmqp_struct admmqp_t;
+
+typedef struct {
+    double rho;        /* step size (default: 0.1) */
+    double sigma;      /* regularization of P (default: 1e-6) */
+    double alpha;      /* relaxation parameter in (0,2) (default: 1.6) */
+    double eps_abs;    /* absolute tolerance (default: 1e-6) */
+    double eps_rel;    /* relative tolerance (default: 1e-6) */
+    double eps_inf;    /* tolerance for infeasibility detection (default: 1e-7) */
+    int maxiter;       /* maximum number of iterations (default: 4000) */
+    int check_every;   /* residuals are checked every check_every iterations (default: 5) */
+    int scaling;       /* number of Ruiz scaling iterations, 0 = no scaling (default: 10) */
+    int adaptive_rho_interval;  /* rho is adapted every adaptive_rho_interval
+                                   iterations, 0 = fixed rho (default: 25) */
+} admmqp_settings;
+
+/* Default settings */
+void admmqp_default_settings(admmqp_settings *s);
+
+/* Create a solver for n variables and m constraints and factor the
+   iteration matrix. P is n-by-n, A is m-by-n, l and u have m elements
+   (they only determine the type of each row, and may be NULL for
+   inequality rows). settings may be NULL. Returns NULL if the matrix is
+   not positive definite. */
+admmqp_t *admmqp_new(int n, int m, const double *P, const double *A,
+                     const double *l, const double *u, const admmqp_settings *settings);
+
+/* Replace q (n), l (m), u (m); NULL pointers leave the vector unchanged */
+void admmqp_update(admmqp_t *qp, const double *q, const double *l, const double *u);
+
+/* Solve, warm-started from the previous iterates. x (n) receives the
+   solution, y (m, may be NULL) the multipliers (y>0 for active upper
+   bounds, y<0 for active lower bounds), iter (may be NULL) the number
+   of iterations. Returns one of the ADMMQP_* codes. */
+int admmqp_solve(admmqp_t *qp, double *x, double *y, int *iter);
+
+/* Set the initial primal and dual iterates (NULL = zero) */
+void admmqp_warm_start(admmqp_t *qp, const double *x, const double *y);
+
+/* Number of factorizations performed so far */
+int admmqp_num_factorizations(const admmqp_t *qp);
+
+void admmqp_free(admmqp_t *qp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+function [xopt,lambda,how,iter]=admmqp(Q,f,A,b,VLB,VUB,x0,display,N,opts)
+% ADMMQP Solve a convex QP by ADMM iterations with a cached factorization
+%
+% [xopt,lambda,how]=ADMMQP(Q,f,A,b,VLB,VUB,x0,display,N) solves
+%
+%               min .5*x'Qx+f'x    subject to:   Ax <= b, VLB <= x <= VUB
+%                x                               A(1:N,:)*x == b(1:N)
+%
+% with the same arguments and outputs as QPSOL (x0 is not used). Q must be
+% positive semidefinite. The solution is accurate up to the tolerances of
+% the method (default: 1e-6, relative).
+%
+% The factor of the iteration matrix is kept between calls as long as Q
+% and A do not change: a sequence of QPs that only differ in f, b, VLB,
+% VUB, such as in receding horizon control, is solved without refactoring,
+% each QP warm-started from the solution of the previous one.
+%
+% [xopt,lambda,how,iter]=ADMMQP(...,opts) also specifies the solver
+% settings (fields rho, sigma, alpha, eps_abs, eps_rel, eps_inf, maxiter,
+% check_every, scaling, adaptive_rho_interval, warm, see ADMMQPMEX) and
+% returns the number of iterations. The data are scaled and rho is adapted
+% as in OSQP; how='unreliable' is returned if the tolerances are not met
+% within maxiter iterations.
+%
+% ADMMQP uses the MEX function ADMMQPMEX (see ADMMQP.CPP and MEXCOMPILE.M).
+% If it is not compiled, QPSOL with the default solver is used instead.
+%
+% See also QPSOL, QPDUAL, QPTYPE.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<5,
+    VLB=[];
+end
+if nargin<6,
+    VUB=[];
+end
+if nargin<7,
+    x0=[];
+end
+if nargin<8 || isempty(display),
+    display=0;
+end
+if nargin<9 || isempty(N),
+    N=0;
+end
+if nargin<10,
+    opts=[];
+end
+
+n=size(Q,1);
+m=size(A,1);
+if isempty(A),
+    A=zeros(0,n);
+    b=zeros(0,1);
+end
+
+if exist('admmqpmex')~=3,
+    [xopt,lambda,how]=qpsol(Q,f,A,b,VLB,VUB,x0,qptype,[],display,N);
+    iter=0;
+    return
+end
+
+% Constraints l<=[A;I]*x<=u, bounds as one row per bounded variable
+l=-Inf(m,1);
+l(1:N)=b(1:N);
+u=b(:);
+if isempty(VLB),
+    VLB=-Inf(n,1);
+end
+if isempty(VUB),
+    VUB=Inf(n,1);
+end
+ib=find(~isinf(VLB(:)) | ~isinf(VUB(:)));
+I=eye(n);
+Ab=[A;I(ib,:)];
+l=[l;VLB(ib)];
+u=[u;VUB(ib)];
+
+[xopt,y,status,iter]=admmqpmex(Q,f(:),full(Ab),l,u,opts);
+
+% Multipliers in the order of QPDUAL: A, lower bounds, upper bounds
+yb=y(m+1:end);
+ilb=~isinf(VLB(ib));
+iub=~isinf(VUB(ib));
+lambda=[y(1:m);max(-yb(ilb),0);max(yb(iub),0)];
+lambda(N+1:m)=max(lambda(N+1:m),0);
+
+switch status
+    case 0
+        how='ok';
+    case 1
+        how='infeasible';
+    case 2
+        how='unbounded';
+    case 3
+        how='unreliable';
+    otherwise
+        error('admmqp:notposdef','Q+sigma*I+A''*diag(rho)*A is not positive definite');
+end
+if display>0 && ~strcmp(how,'ok'),
+    fprintf('ADMMQP: problem is %s (%d iterations)\n',how,iter);
+end
@@ -0,0 +1,148 @@
+/* ADMM QP solver with offline factorization - MEX interface
+
+   [x,y,status,iter]=admmqpmex(P,q,A,l,u,opts)
+
+   Solves min .5*x'*P*x+q'*x s.t. l<=A*x<=u by the solver in ADMMQP.CPP.
+
+   opts   = structure with optional fields rho, sigma, alpha, eps_abs,
+            eps_rel, eps_inf, maxiter, check_every, scaling,
+            adaptive_rho_interval (see ADMMQP.H), and warm (default 1):
+            if 0, start from x=0, y=0
+   y      = multipliers (y>0 for active upper bounds, y<0 for active
+            lower bounds)
+   status = 0 solved, 1 primal infeasible, 2 dual infeasible, 3 maximum
+            number of iterations reached, 4 not positive definite
+
+   The solver, with the factor of P+sigma*I+A'*diag(rho)*A, is kept between
+   calls and rebuilt only when P, A or the settings change. A sequence of
+   QPs that only differ in q, l, u, such as in receding horizon control,
+   is solved without refactoring, each QP starting from the solution of
+   the previous one.
+
+   Compile with MEXCOMPILE.M (or mex -O admmqpmex.cpp admmqp.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "admmqp.h"
+#include <cstring>
+#include <vector>
+
+static admmqp_t *admmqpmex_qp = NULL;
+static std::vector<double> admmqpmex_P, admmqpmex_A;  /* data of admmqpmex_qp */
+static admmqp_settings admmqpmex_set;
+static int admmqpmex_m = -1;
+
+static void admmqpmex_cleanup(void)
+{
+    if (admmqpmex_qp)
+        admmqp_free(admmqpmex_qp);
+    admmqpmex_qp = NULL;
+    admmqpmex_P.clear();
+    admmqpmex_A.clear();
+    admmqpmex_m = -1;
+}
+
+static bool same(const std::vector<double> &v, const double *p, size_t len)
+{
+    return v.size() == len && (len == 0 || !memcmp(&v[0], p, len * sizeof(double)));
+}
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const mxArray *opts;
+    const double *P, *q, *A, *l, *u;
+    double *x, *y;
+    admmqp_settings set;
+    int n, m, status, iter = 0, warm;
+
+    mexAtExit(admmqpmex_cleanup);
+
+    if (nrhs < 5)
+        mexErrMsgTxt("At least five input arguments required.");
+
+    n = (int) mxGetM(prhs[0]);
+    if ((int) mxGetN(prhs[0]) != n || !mxIsDouble(prhs[0]) || mxIsSparse(prhs[0]))
+        mexErrMsgTxt("P must be a full square matrix.");
+    if ((int) mxGetNumberOfElements(prhs[1]) != n)
+        mexErrMsgTxt("q has wrong dimension.");
+    m = (int) mxGetM(prhs[2]);
+    if (m > 0 && (int) mxGetN(prhs[2]) != n)
+        mexErrMsgTxt("A has wrong number of columns.");
+    if (m > 0 && mxIsSparse(prhs[2]))
+        mexErrMsgTxt("A must be a full matrix.");
+    if ((int) mxGetNumberOfElements(prhs[3]) != m || (int) mxGetNumberOfElements(prhs[4]) != m)
+        mexErrMsgTxt("l and u must have as many elements as the rows of A.");
+
+    opts = nrhs > 5 ? prhs[5] : NULL;
+    admmqp_default_settings(&set);
+    set.rho = getopt(opts, "rho", set.rho);
+    set.sigma = getopt(opts, "sigma", set.sigma);
+    set.alpha = getopt(opts, "alpha", set.alpha);
+    set.eps_abs = getopt(opts, "eps_abs", set.eps_abs);
+    set.eps_rel = getopt(opts, "eps_rel", set.eps_rel);
+    set.eps_inf = getopt(opts, "eps_inf", set.eps_inf);
+    set.maxiter = (int) getopt(opts, "maxiter", set.maxiter);
+    set.check_every = (int) getopt(opts, "check_every", set.check_every);
+    if (set.check_every < 1)
+        set.check_every = 1;
+    set.scaling = (int) getopt(opts, "scaling", set.scaling);
+    set.adaptive_rho_interval = (int) getopt(opts, "adaptive_rho_interval", set.adaptive_rho_interval);
+    warm = (int) getopt(opts, "warm", 1);
+
+    P = mxGetPr(prhs[0]);
+    q = mxGetPr(prhs[1]);
+    A = mxGetPr(prhs[2]);
+    l = mxGetPr(prhs[3]);
+    u = mxGetPr(prhs[4]);
+
+    /* Reuse the solver (factor and iterates) if P, A and settings are the same */
+    if (!admmqpmex_qp || admmqpmex_m != m
+        || !same(admmqpmex_P, P, (size_t) n * n)
+        || !same(admmqpmex_A, A, (size_t) m * n)
+        || memcmp(&admmqpmex_set, &set, sizeof(set))) {
+        admmqpmex_cleanup();
+        admmqpmex_qp = admmqp_new(n, m, P, A, l, u, &set);
+        if (admmqpmex_qp) {
+            admmqpmex_P.assign(P, P + (size_t) n * n);
+            admmqpmex_A.assign(A, A + (size_t) m * n);
+            admmqpmex_set = set;
+            admmqpmex_m = m;
+        }
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(n, 1, mxREAL);
+    x = mxGetPr(plhs[0]);
+    if (nlhs > 1) {
+        plhs[1] = mxCreateDoubleMatrix(m, 1, mxREAL);
+        y = mxGetPr(plhs[1]);
+    }
+    else
+        y = NULL;
+
+    if (admmqpmex_qp) {
+        admmqp_update(admmqpmex_qp, q, l, u);
+        if (!warm)
+            admmqp_warm_start(admmqpmex_qp, NULL, NULL);
+        status = admmqp_solve(admmqpmex_qp, x, y, &iter);
+    }
+    else
+        status = ADMMQP_NOTPOSDEF;
+
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(status);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar(iter);
+}
@@ -36,11 +36,54 @@
 #include <string.h>
 #include "mex.h"
 
-#define CDDMEX_VERSION "1.0"
+#define CDDMEX_VERSION "1.1"
 
-mxArray * MB_set_LPsol_MatrixPtr(const dd_LPPtr lp)
+/* In the floating-point build of cddlib mytype is a double[1], so matrix
+   entries can be stored directly instead of going through dd_set_d. */
+#ifdef GMPRATIONAL
+#define CDDMEX_SET_D(a,x) dd_set_d(a,x)
+#else
+#define CDDMEX_SET_D(a,x) ((a)[0]=(x))
+#endif
+
+/* cddlib global constants are set once per MEX load and released when the
+   MEX file is cleared */
+static int cddmex_initialized = 0;
+
+static void cddmex_cleanup(void)
+{
+	if (cddmex_initialized) {
+		dd_free_global_constants();
+		cddmex_initialized = 0;
+	}
+}
+
+static void cddmex_init(void)
+{
+	if (!cddmex_initialized) {
+		dd_set_global_constants();
+		mexAtExit(cddmex_cleanup);
+		cddmex_initialized = 1;
+	}
+}
+
+/* Raw (MATLAB-owned) data describing one H or V polyhedron. It is filled
+   before any cdd computation, so that the MEX API and cddlib calls are not
+   interleaved. */
+typedef struct {
+	int m;          /* number of rows of A (H) or of vertices V (V) */
+	int n;          /* space dimension */
+	double * a;     /* A (H) or V (V), column major */
+	double * b;     /* B (H only) */
+	double * lin;   /* indices of equality constraints (H only) */
+	int nlin;
+	double * obj;   /* LP objective (LP only) */
+	int mr;         /* number of rays (V only) */
+	double * r;     /* rays (V only), column major */
+} FT_PolyData;
+
+void MB_fill_LPsol(mxArray * P, int k, const dd_LPPtr lp)
 {
-	mxArray * P;	
 	mxArray * tmpx;
 	mxArray * tmpy;	
 	mxArray * tmpobj;
@@ -53,139 +96,146 @@ mxArray * MB_set_LPsol_MatrixPtr(const dd_LPPtr lp)
 	double * active;
 	int ii, jj;
 	int nactive;
-	
+
+	/* store primal solution */
+	tmpx = mxCreateDoubleMatrix((lp->d)-1, 1, mxREAL);
+	x = mxGetPr(tmpx);
+	for (ii=1; ii<=(lp->d)-1; ii++)
+		x[ii-1]=(double)(lp->sol[ii])[0];
+	mxSetField(P, k, "xopt", tmpx);
+
+	/* store Lagrange multipliers (i.e. dual solution) */
+	tmpy = mxCreateDoubleMatrix((lp->m)-1, 1, mxREAL);
+	y = mxGetPr(tmpy);
+	for (ii=1; ii<lp->m; ii++)
+		y[ii-1]=0;
+	nactive=0;
+	for (ii=1; ii<lp->d; ii++){
+		if (lp->nbindex[ii+1]>0) {
+			nactive++;
+			y[lp->nbindex[ii+1]-1]=(lp->dsol[ii])[0];
+		}
+	}
+	mxSetField(P, k, "lambda", tmpy);
+
+	/* store objective */
+	tmphow = mxCreateDoubleMatrix(1, 1, mxREAL);
+	how = mxGetPr(tmphow);
+	how[0]=lp->LPS;
+	mxSetField(P, k, "how", tmphow);
+
+	/* store objective value */
+	tmpobj = mxCreateDoubleMatrix(1, 1, mxREAL);
+	obj = mxGetPr(tmpobj);
+	obj[0]=(lp->optvalue)[0];
+	mxSetField(P, k, "objlp", tmpobj);
+
+	/* store nonbasis */
+	tmpactive = mxCreateDoubleMatrix(nactive, 1, mxREAL);
+	active = mxGetPr(tmpactive);
+	jj=0;
+	for (ii=1; ii<lp->d; ii++){
+		if (lp->nbindex[ii+1]>0){
+			active[jj]=(double)lp->nbindex[ii+1];
+			jj++;
+		}
+	}
+	mxSetField(P, k, "active", tmpactive);
+}
+
+mxArray * MB_set_LPsol_MatrixPtr(const dd_LPPtr lp)
+{
+	mxArray * P;	
 
  	if (lp !=NULL) {
     		const char *f[] = {"xopt", "lambda", "how", "objlp", "active"};
     		int dims[] = {1};
 
     		P = mxCreateStructArray(1, dims, 5, f);
-    		
-    		/* store primal solution */
-    		tmpx = mxCreateDoubleMatrix((lp->d)-1, 1, mxREAL);
-    		x = mxGetPr(tmpx);
-    		for (ii=1; ii<=(lp->d)-1; ii++)
-    			x[ii-1]=(double)(lp->sol[ii])[0];
-		mxSetField(P, 0, "xopt", tmpx);
-
-    		/* store Lagrange multipliers (i.e. dual solution) */
-    		tmpy = mxCreateDoubleMatrix((lp->m)-1, 1, mxREAL);
-    		y = mxGetPr(tmpy);
-    		for (ii=1; ii<lp->m; ii++)
-    			y[ii-1]=0;
-    		nactive=0;
-		for (ii=1; ii<lp->d; ii++){
-			if (lp->nbindex[ii+1]>0) {
-				nactive++;
-				y[lp->nbindex[ii+1]-1]=(lp->dsol[ii])[0];
-			}
-		}
-		mxSetField(P, 0, "lambda", tmpy);
-
-		/* store objective */
-		tmphow = mxCreateDoubleMatrix(1, 1, mxREAL);
-    		how = mxGetPr(tmphow);
-		how[0]=lp->LPS;
-      		mxSetField(P, 0, "how", tmphow);
-
-		/* store objective value */
-		tmpobj = mxCreateDoubleMatrix(1, 1, mxREAL);
-    		obj = mxGetPr(tmpobj);
-		obj[0]=(lp->optvalue)[0];
-      		mxSetField(P, 0, "objlp", tmpobj);
-
-		/* store nonbasis */
-    		tmpactive = mxCreateDoubleMatrix(nactive, 1, mxREAL);
-    		active = mxGetPr(tmpactive);
-    		jj=0;
-		for (ii=1; ii<lp->d; ii++){
-			if (lp->nbindex[ii+1]>0){
-				active[jj]=(double)lp->nbindex[ii+1];
-				jj++;
-			}
-		}
-		mxSetField(P, 0, "active", tmpactive);
-
-
+		MB_fill_LPsol(P, 0, lp);
       		return P;
 	}
 	return 0;
 }
 
-	
-dd_MatrixPtr FT_get_H_MatrixPtr(const mxArray * in)
+int FT_get_H_data(const mxArray * in, int k, FT_PolyData * d)
 {
 	mxArray * tmpa;	
 	mxArray * tmpb;	
 	mxArray * tmpl;	
-	dd_MatrixPtr A;
-	int eqsize, m, n, i, j;
-	double * a;
-	double * b;
-	double * lin;
-	
-	if ((tmpa = mxGetField(in, 0, "A")) && 
-	    (tmpb = mxGetField(in, 0, "B")) &&
+	int i;
+
+	memset(d, 0, sizeof(FT_PolyData));
+	if ((tmpa = mxGetField(in, k, "A")) && 
+	    (tmpb = mxGetField(in, k, "B")) &&
 	    (mxGetNumberOfDimensions(tmpa) <= 2) &&
 	    (mxGetNumberOfDimensions(tmpb) <= 2) &&
 	    (mxGetM(tmpa) == mxGetM(tmpb)) &&
 	    (mxGetN(tmpb) == 1)) {
-		m = mxGetM(tmpa);
-		n = mxGetN(tmpa) + 1;
-		a = mxGetPr(tmpa);
-		b = mxGetPr(tmpb);		
-		A = dd_CreateMatrix(m, n);
-		for (i = 0; i < m; i++) {
-			dd_set_d(A->matrix[i][0],b[i]);
-			for (j = 0; j < n - 1; j++) {
-				dd_set_d(A->matrix[i][j + 1],- a[j * m + i]);
-			}
-		}
-		A->representation = dd_Inequality;		
-		A->numbtype = dd_Real;
+		d->m = mxGetM(tmpa);
+		d->n = mxGetN(tmpa);
+		d->a = mxGetPr(tmpa);
+		d->b = mxGetPr(tmpb);
 		/* set lineality if present */
-		if ((tmpl = mxGetField(in, 0, "lin")) &&
+		if ((tmpl = mxGetField(in, k, "lin")) &&
 		    (mxGetNumberOfDimensions(tmpl) <= 2) && 
 		    (mxGetM(tmpl) == 1)) {
-		    	lin = mxGetPr(tmpl);
-		    	eqsize = mxGetN(tmpl);
-		    	for (i = 0; i < eqsize; i++) {
-		    		if (lin[i] <= (double) m) 
-     					set_addelem(A->linset,(long) lin[i]);
-     				else
+		    	d->lin = mxGetPr(tmpl);
+		    	d->nlin = mxGetN(tmpl);
+		    	for (i = 0; i < d->nlin; i++) {
+		    		if (d->lin[i] > (double) d->m) 
      					mexWarnMsgTxt("Error in the lineality vector ");
   			}
   		}
-		return A;
+		return 1;
+	}
+	return 0;
+}
+
+dd_MatrixPtr FT_make_H_MatrixPtr(const FT_PolyData * d)
+{
+	dd_MatrixPtr A;
+	int m, n, i, j;
+
+	m = d->m;
+	n = d->n + 1;
+	A = dd_CreateMatrix(m, n);
+	for (i = 0; i < m; i++) {
+		CDDMEX_SET_D(A->matrix[i][0], d->b[i]);
+		for (j = 0; j < n - 1; j++) {
+			CDDMEX_SET_D(A->matrix[i][j + 1], - d->a[j * m + i]);
+		}
+	}
+	A->representation = dd_Inequality;		
+	A->numbtype = dd_Real;
+	for (i = 0; i < d->nlin; i++) {
+		if (d->lin[i] <= (double) m) 
+			set_addelem(A->linset,(long) d->lin[i]);
 	}
+	return A;
+}
+
+dd_MatrixPtr FT_get_H_MatrixPtr(const mxArray * in)
+{
+	FT_PolyData d;
+
+	if (FT_get_H_data(in, 0, &d))
+		return FT_make_H_MatrixPtr(&d);
 	return 0;
 }
 
 
-dd_LPPtr MB_get_LP_MatrixPtr(const mxArray * in)
+int MB_get_LP_data(const mxArray * in, int k, FT_PolyData * d)
 {
 	mxArray * tmpobj;
-	dd_MatrixPtr A;
-	int j;
-	double * value;
-	dd_ErrorType error=dd_NoError;
-	dd_LPPtr lp;
-	
-	dd_set_global_constants(); /* First, this must be called once to use cddlib. */
-	
-	if (A=FT_get_H_MatrixPtr(in)) {
+
+	if (FT_get_H_data(in, k, d)) {
 		/* set objective */
-		if ((tmpobj = mxGetField(in, 0, "obj")) &&
+		if ((tmpobj = mxGetField(in, k, "obj")) &&
 		    (mxGetNumberOfDimensions(tmpobj) <= 2) && 
 		    (mxGetM(tmpobj) == 1)) {
-		    	value = mxGetPr(tmpobj);
-  			A->objective = dd_LPmin;
-  			dd_set_d(A->rowvec[0], 0.0); /* there is no constant term */
-  			for (j = 1; j < A->colsize; j++)
-  				dd_set_d(A->rowvec[j],value[j-1]);
-  			lp=dd_Matrix2LP(A, &error);
-  			dd_FreeMatrix(A);
-			return lp;
+			d->obj = mxGetPr(tmpobj);
+			return 1;
   		}else{
   			mexErrMsgTxt("Error in the setting of LP objective.");
   		}
@@ -195,9 +245,34 @@ dd_LPPtr MB_get_LP_MatrixPtr(const mxArray * in)
 	return 0;
 }
 
-mxArray * FT_set_V_MatrixPtr(const dd_MatrixPtr M)
+dd_LPPtr MB_make_LP(const FT_PolyData * d, dd_ErrorType * error)
+{
+	dd_MatrixPtr A;
+	dd_LPPtr lp;
+	int j;
+
+	A = FT_make_H_MatrixPtr(d);
+	A->objective = dd_LPmin;
+	CDDMEX_SET_D(A->rowvec[0], 0.0); /* there is no constant term */
+	for (j = 1; j < A->colsize; j++)
+		CDDMEX_SET_D(A->rowvec[j], d->obj[j-1]);
+	lp=dd_Matrix2LP(A, error);
+	dd_FreeMatrix(A);
+	return lp;
+}
+
+dd_LPPtr MB_get_LP_MatrixPtr(const mxArray * in)
+{
+	FT_PolyData d;
+	dd_ErrorType error=dd_NoError;
+	
+	if (MB_get_LP_data(in, 0, &d))
+		return MB_make_LP(&d, &error);
+	return 0;
+}
+
+void FT_fill_V(mxArray * P, int p, const dd_MatrixPtr M)
 {
-	mxArray * P;
 	int mr, mv, m, i, j;
 	int ir, iv;
 	mxArray * tmpv;	
@@ -215,113 +290,135 @@ mxArray * FT_set_V_MatrixPtr(const dd_MatrixPtr M)
 	int k=0;
 	dd_rowrange ii;
 		
+	if (set_card(M->linset)) {
+		tmpl = mxCreateDoubleMatrix(1, set_card(M->linset), mxREAL);
+		l = mxGetPr(tmpl);		
+		for (ii=1; ii<=M->rowsize; ii++) {
+			if (set_member(ii, M->linset)) {
+				l[k] = (double)ii;
+				k ++;
+			}
+		}
+		mxSetField(P, p, "lin", tmpl);
+	}
+	/* Count the rays and vertices */
+	mr = 0;
+	mv = 0;
+	for (i = 0 ; i < (int)(M->rowsize); i++) {
+		if (dd_get_d(M->matrix[i][0]) == 0) {
+			mr++;
+		} else { 
+			mv++;
+		}
+	}
+	m = mr + mv;
+	/* Allocate the space in MATLAB */
+	tmpr = mxCreateDoubleMatrix(mr, M->colsize - 1, mxREAL);
+	r = mxGetPr(tmpr);
+	tmpv = mxCreateDoubleMatrix(mv, M->colsize - 1, mxREAL);
+	v = mxGetPr(tmpv);
+	tmprpos = mxCreateDoubleMatrix(mr, 1, mxREAL);
+	rpos = mxGetPr(tmprpos);
+	tmpvpos = mxCreateDoubleMatrix(mv, 1, mxREAL);
+	vpos = mxGetPr(tmpvpos);
+	ir = 0; iv = 0;
+	for (i = 0 ; i < m; i++) {
+		if (dd_get_d(M->matrix[i][0]) == 0) {
+			/* This is a ray */
+			for (j = 0; j < (int)(M->colsize) - 1; j++) {
+				r[ir + j * mr] = dd_get_d(M->matrix[i][j + 1]);
+			}
+			rpos[ir] = i + 1;
+			ir++;
+		} else { 
+			/* This is a vertex*/
+			for (j = 0; j < (int)(M->colsize) - 1; j++) {
+				v[iv + j * mv] = dd_get_d(M->matrix[i][j + 1]);
+			}
+			vpos[iv] = i + 1;
+			iv++;
+		}
+	}		
+	mxSetField(P, p, "V", tmpv);
+	mxSetField(P, p, "R", tmpr);
+	mxSetField(P, p, "vpos", tmpvpos);
+	mxSetField(P, p, "rpos", tmprpos);
+}
+
+mxArray * FT_set_V_MatrixPtr(const dd_MatrixPtr M)
+{
+	mxArray * P;
+
  	if ((M !=NULL) &&
  	    (M->representation == dd_Generator)) {
     		const char *f[] = {"V", "R", "rpos", "vpos", "lin"};
     		int dims[] = {1};
 
     		P = mxCreateStructArray(1, dims, 5, f);
-		if (set_card(M->linset)) {
-			tmpl = mxCreateDoubleMatrix(1, set_card(M->linset), mxREAL);
-			l = mxGetPr(tmpl);		
-    			for (ii=1; ii<=M->rowsize; ii++) {
-      				if (set_member(ii, M->linset)) {
-      					l[k] = (double)ii;
-      					k ++;
-      				}
-      			}
-      			mxSetField(P, 0, "lin", tmpl);
-		}
-		/* Count the rays and vertices */
-		mr = 0;
-		mv = 0;
-		for (i = 0 ; i < (int)(M->rowsize); i++) {
-			if (dd_get_d(M->matrix[i][0]) == 0) {
-				mr++;
-			} else { 
-				mv++;
-			}
-		}
-		m = mr + mv;
-		/* Allocate the space in MATLAB */
-		tmpr = mxCreateDoubleMatrix(mr, M->colsize - 1, mxREAL);
-		r = mxGetPr(tmpr);
-		tmpv = mxCreateDoubleMatrix(mv, M->colsize - 1, mxREAL);
-		v = mxGetPr(tmpv);
-		tmprpos = mxCreateDoubleMatrix(mr, 1, mxREAL);
-		rpos = mxGetPr(tmprpos);
-		tmpvpos = mxCreateDoubleMatrix(mv, 1, mxREAL);
-		vpos = mxGetPr(tmpvpos);
-		ir = 0; iv = 0;
-	  	for (i = 0 ; i < m; i++) {
-			if (dd_get_d(M->matrix[i][0]) == 0) {
-				/* This is a ray */
-    				for (j = 0; j < (int)(M->colsize) - 1; j++) {
-      					r[ir + j * mr] = dd_get_d(M->matrix[i][j + 1]);
-      				}
-      				rpos[ir] = i + 1;
-				ir++;
-			} else { 
-				/* This is a vertex*/
-    				for (j = 0; j < (int)(M->colsize) - 1; j++) {
-      					v[iv + j * mv] = dd_get_d(M->matrix[i][j + 1]);
-      				}
-      				vpos[iv] = i + 1;
-				iv++;
-			}
-
-      		}		
-      		mxSetField(P, 0, "V", tmpv);
-      		mxSetField(P, 0, "R", tmpr);
-      		mxSetField(P, 0, "vpos", tmpvpos);
-      		mxSetField(P, 0, "rpos", tmprpos);
+		FT_fill_V(P, 0, M);
       		return P;
 	}
 	return 0;
 }
 
 
-dd_MatrixPtr FT_get_V_MatrixPtr(const mxArray * in)
+int FT_get_V_data(const mxArray * in, int k, FT_PolyData * d)
 {
 	mxArray * tmpv;	
 	mxArray * tmpr;	
-	dd_MatrixPtr V;
-	int mr, m, n, i, j;
-	double * v;
-	double * r;
 	
-	if ((tmpv = mxGetField(in, 0, "V")) && 
+	memset(d, 0, sizeof(FT_PolyData));
+	if ((tmpv = mxGetField(in, k, "V")) && 
 	    (mxGetNumberOfDimensions(tmpv) <= 2)) {
 	    	
-		if ((tmpr = mxGetField(in, 0, "R")) && 
+		if ((tmpr = mxGetField(in, k, "R")) && 
 	    	    (mxGetNumberOfDimensions(tmpv) <= 2)) {
-	    	    	mr = mxGetM(tmpr);
-	    	    	r = mxGetPr(tmpr);
-		} else mr = 0;
-	    		    
-		m = mxGetM(tmpv);
-		n = mxGetN(tmpv) + 1;
-		v = mxGetPr(tmpv);
-		V = dd_CreateMatrix(m + mr, n);
-		for (i = 0; i < m; i++) {
-			dd_set_si(V->matrix[i][0],1);
-			for (j = 0; j < n - 1; j++) {
-				dd_set_d(V->matrix[i][j + 1], v[i + j * m]);
-			}
+	    	    	d->mr = mxGetM(tmpr);
+	    	    	d->r = mxGetPr(tmpr);
 		}
-		for (i = m; i < m + mr; i++) {
-			dd_set_si(V->matrix[i][0],0);
-			for (j = 0; j < n - 1; j++) {
-				dd_set_d(V->matrix[i][j + 1], r[(i - m) + j * mr]);
-			}
-		}		
-		V->representation = dd_Generator;	
-		V->numbtype = dd_Real;
-		return V;
+		d->m = mxGetM(tmpv);
+		d->n = mxGetN(tmpv);
+		d->a = mxGetPr(tmpv);
+		return 1;
 	}
 	return 0;
 }
 
+dd_MatrixPtr FT_make_V_MatrixPtr(const FT_PolyData * d)
+{
+	dd_MatrixPtr V;
+	int mr, m, n, i, j;
+
+	m = d->m;
+	mr = d->mr;
+	n = d->n + 1;
+	V = dd_CreateMatrix(m + mr, n);
+	for (i = 0; i < m; i++) {
+		dd_set_si(V->matrix[i][0],1);
+		for (j = 0; j < n - 1; j++) {
+			CDDMEX_SET_D(V->matrix[i][j + 1], d->a[i + j * m]);
+		}
+	}
+	for (i = m; i < m + mr; i++) {
+		dd_set_si(V->matrix[i][0],0);
+		for (j = 0; j < n - 1; j++) {
+			CDDMEX_SET_D(V->matrix[i][j + 1], d->r[(i - m) + j * mr]);
+		}
+	}		
+	V->representation = dd_Generator;	
+	V->numbtype = dd_Real;
+	return V;
+}
+
+dd_MatrixPtr FT_get_V_MatrixPtr(const mxArray * in)
+{
+	FT_PolyData d;
+
+	if (FT_get_V_data(in, 0, &d))
+		return FT_make_V_MatrixPtr(&d);
+	return 0;
+}
+
 mxArray * FT_set_SetFamilyPtr(const dd_SetFamilyPtr F)
 {
 	mxArray * A, * tmp;
@@ -376,9 +473,8 @@ mxArray * FT_set_Set(const set_type S)
 	return 0;
 }
 
-mxArray * FT_set_H_MatrixPtr(const dd_MatrixPtr M)
+void FT_fill_H(mxArray * P, int p, const dd_MatrixPtr M)
 {
-	mxArray * P;	
 	mxArray * tmpa;	
 	mxArray * tmpb;	
 	mxArray * tmpl;
@@ -390,36 +486,43 @@ mxArray * FT_set_H_MatrixPtr(const dd_MatrixPtr M)
 
 	dd_rowrange ii;
 
+	if (set_card(M->linset)) {
+		tmpl = mxCreateDoubleMatrix(1, set_card(M->linset), mxREAL);
+		l = mxGetPr(tmpl);		
+		for (ii=1; ii<=M->rowsize; ii++) {
+			if (set_member(ii, M->linset)) {
+				l[k] = (int)ii;
+				k ++;
+			}
+		}
+		mxSetField(P, p, "lin", tmpl);
+	}
+
+	tmpb = mxCreateDoubleMatrix(M->rowsize, 1, mxREAL);
+	b = mxGetPr(tmpb);
+	tmpa = mxCreateDoubleMatrix(M->rowsize, M->colsize - 1, mxREAL);
+	a = mxGetPr(tmpa);
+	for (i = 0 ; i < (int)(M->rowsize); i++) {
+		b[i] = dd_get_d(M->matrix[i][0]);
+		for (j = 0; j < (int)(M->colsize) - 1; j++) {
+			a[i + j * (int)(M->rowsize)] = - dd_get_d(M->matrix[i][j + 1]);
+		}
+	}
+	mxSetField(P, p, "A", tmpa);
+	mxSetField(P, p, "B", tmpb);
+}
+
+mxArray * FT_set_H_MatrixPtr(const dd_MatrixPtr M)
+{
+	mxArray * P;	
+
  	if ((M !=NULL) &&
  	    (M->representation == dd_Inequality)) {
     		const char *f[] = {"A", "B", "lin"};
     		int dims[] = {1};
 
     		P = mxCreateStructArray(1, dims, 3, f);
-		if (set_card(M->linset)) {
-			tmpl = mxCreateDoubleMatrix(1, set_card(M->linset), mxREAL);
-			l = mxGetPr(tmpl);		
-    			for (ii=1; ii<=M->rowsize; ii++) {
-      				if (set_member(ii, M->linset)) {
-      					l[k] = (int)ii;
-      					k ++;
-      				}
-      			}
-      			mxSetField(P, 0, "lin", tmpl);
-		}
-
-		tmpb = mxCreateDoubleMatrix(M->rowsize, 1, mxREAL);
-		b = mxGetPr(tmpb);
-		tmpa = mxCreateDoubleMatrix(M->rowsize, M->colsize - 1, mxREAL);
-		a = mxGetPr(tmpa);
-	  	for (i = 0 ; i < (int)(M->rowsize); i++) {
-	  		b[i] = dd_get_d(M->matrix[i][0]);
-    			for (j = 0; j < (int)(M->colsize) - 1; j++) {
-      				a[i + j * (int)(M->rowsize)] = - dd_get_d(M->matrix[i][j + 1]);
-      			}
-      		}
-      		mxSetField(P, 0, "A", tmpa);
-      		mxSetField(P, 0, "B", tmpb);
+		FT_fill_H(P, 0, M);
       		return P;
 	}
 	return 0;
@@ -434,7 +537,6 @@ hull(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	
 	if (nrhs  == 1 && nlhs == 1 && mxIsStruct(prhs[0])) {
 		V = FT_get_V_MatrixPtr(prhs[0]);		
-		dd_set_global_constants();  /* First, this must be called. */
 
 		P = dd_DDMatrix2Poly(V, &err); /* compute the second representation */
 		if (err == dd_NoError) {
@@ -462,7 +564,6 @@ v_hull_extreme(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	
 	if (nrhs  == 1 && nlhs == 1 && mxIsStruct(prhs[0])) {
 		V = FT_get_V_MatrixPtr(prhs[0]);		
-		dd_set_global_constants();  /* First, this must be called. */
 
 		P = dd_DDMatrix2Poly(V, &err); /* compute the second representation */
 		if (err == dd_NoError) {
@@ -498,7 +599,6 @@ extreme(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_MatrixPtr H,V;
 	
 	if (nrhs  == 1 && nlhs == 1 && mxIsStruct(prhs[0])) {
-		dd_set_global_constants();  /* First, this must be called. */
 		H = FT_get_H_MatrixPtr(prhs[0]);		
 
 		P = dd_DDMatrix2Poly(H, &err); /* compute the second representation */
@@ -527,7 +627,6 @@ adj_extreme(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_SetFamilyPtr A;
 	
 	if (nrhs  == 1 && nlhs == 2 && mxIsStruct(prhs[0])) {
-		dd_set_global_constants();  /* First, this must be called. */
 		H = FT_get_H_MatrixPtr(prhs[0]);		
 
 		P = dd_DDMatrix2Poly(H, &err); /* compute the second representation */
@@ -558,7 +657,6 @@ reduce_h(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_rowset red;
 	
 	if (nrhs  == 1 && nlhs >= 1 && nlhs <= 2 && mxIsStruct(prhs[0])) {
-		dd_set_global_constants();  /* First, this must be called. */
 		H = FT_get_H_MatrixPtr(prhs[0]);		
 		red = dd_RedundantRows(H, &err); /* find redundant rows */
 		if (err == dd_NoError) {
@@ -589,7 +687,6 @@ reduce_v(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_rowset red;
 	
 	if (nrhs  == 1 && nlhs >= 1 && nlhs <= 2 && mxIsStruct(prhs[0])) {
-		dd_set_global_constants();  /* First, this must be called. */
 		V = FT_get_V_MatrixPtr(prhs[0]);		
 		red = dd_RedundantRows(V, &err); /* find redundant rows */
 		if (err == dd_NoError) {
@@ -618,7 +715,6 @@ copy_v(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_MatrixPtr V;
 	
 	if (nrhs  == 1 && nlhs == 1 && mxIsStruct(prhs[0])) {
-		dd_set_global_constants();  /* First, this must be called. */
 		V = FT_get_V_MatrixPtr(prhs[0]);		
 		plhs[0] = FT_set_V_MatrixPtr(V);
 		dd_FreeMatrix(V);
@@ -634,7 +730,6 @@ copy_h(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_MatrixPtr H;
 	
 	if (nrhs  == 1 && nlhs == 1 && mxIsStruct(prhs[0])) {
-		dd_set_global_constants();  /* First, this must be called. */
 		H = FT_get_H_MatrixPtr(prhs[0]);		
 		plhs[0] = FT_set_H_MatrixPtr(H);
 		dd_FreeMatrix(H);
@@ -661,7 +756,6 @@ solve_lp(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_LPSolverType solver=dd_CrissCross; /* either DualSimplex or CrissCross */
 	dd_LPPtr lp;   /* pointer to LP data structure that is not visible by user. */
   
-	dd_set_global_constants(); /* First, this must be called once to use cddlib. */
 
 
 	/* Input an LP using the cdd library  */
@@ -698,7 +792,6 @@ solve_lp_DS(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_LPSolverType solver=dd_DualSimplex;
 	dd_LPPtr lp;   /* pointer to LP data structure that is not visible by user. */
   
-	dd_set_global_constants(); /* First, this must be called once to use cddlib. */
 
 
 	/* Input an LP using the cdd library  */
@@ -732,7 +825,6 @@ find_interior(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_MatrixPtr A;
 	int j;  
   
-	dd_set_global_constants(); /* First, this must be called once to use cddlib. */
 
 
 	/* Input an LP using the cdd library  */
@@ -779,7 +871,6 @@ find_interior_DS(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_MatrixPtr A;
 	int j;  
   
-	dd_set_global_constants(); /* First, this must be called once to use cddlib. */
 
 
 	/* Input an LP using the cdd library  */
@@ -810,6 +901,191 @@ find_interior_DS(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	dd_FreeLPData(lp1);
 }
 
+/* Batched operations on struct arrays of polyhedra.
+
+   The MATLAB data of all polyhedra is collected first, then the cdd
+   computations (conversion to dd_MatrixPtr included) are run one after
+   the other, and finally the results are copied back into MATLAB arrays.
+   cddlib is not reentrant (global constants, counters and static
+   buffers), so its calls are never made from several threads. */
+
+#define CDDMEX_BATCH_HULL      1
+#define CDDMEX_BATCH_EXTREME   2
+#define CDDMEX_BATCH_REDUCE_H  3
+#define CDDMEX_BATCH_SOLVE_LP  4
+#define CDDMEX_BATCH_ADJACENCY 5
+
+typedef struct {
+	FT_PolyData in;
+	int valid;              /* input data found in the struct element */
+	dd_ErrorType err;
+	dd_MatrixPtr M;         /* H or V result */
+	dd_rowset red;          /* redundant rows (reduce_h) */
+	dd_LPPtr lp;            /* solved LP (solve_lp) */
+	dd_SetFamilyPtr adj;    /* input adjacency (adjacency) */
+} CDD_BatchJob;
+
+typedef struct {
+	CDD_BatchJob * jobs;
+	int njobs;
+	int op;
+} CDD_Batch;
+
+void
+CDD_run_job(CDD_BatchJob * job, int op)
+{
+	dd_PolyhedraPtr P;
+	dd_MatrixPtr A;
+	
+	job->err = dd_NoError;
+	if (!job->valid)
+		return;
+	switch (op) {
+	case CDDMEX_BATCH_HULL:
+		A = FT_make_V_MatrixPtr(&job->in);
+		P = dd_DDMatrix2Poly(A, &job->err);
+		if (job->err == dd_NoError)
+			job->M = dd_CopyInequalities(P);
+		dd_FreeMatrix(A);
+		dd_FreePolyhedra(P);
+		break;
+	case CDDMEX_BATCH_EXTREME:
+		A = FT_make_H_MatrixPtr(&job->in);
+		P = dd_DDMatrix2Poly(A, &job->err);
+		if (job->err == dd_NoError)
+			job->M = dd_CopyGenerators(P);
+		dd_FreeMatrix(A);
+		dd_FreePolyhedra(P);
+		break;
+	case CDDMEX_BATCH_REDUCE_H:
+		A = FT_make_H_MatrixPtr(&job->in);
+		job->red = dd_RedundantRows(A, &job->err);
+		if (job->err == dd_NoError)
+			job->M = dd_MatrixSubmatrix(A, job->red);
+		dd_FreeMatrix(A);
+		break;
+	case CDDMEX_BATCH_SOLVE_LP:
+		job->lp = MB_make_LP(&job->in, &job->err);
+		if (job->err == dd_NoError)
+			dd_LPSolve(job->lp, dd_CrissCross, &job->err);
+		break;
+	case CDDMEX_BATCH_ADJACENCY:
+		A = FT_make_V_MatrixPtr(&job->in);
+		P = dd_DDMatrix2Poly(A, &job->err);
+		if (job->err == dd_NoError)
+			job->adj = dd_CopyInputAdjacency(P);
+		dd_FreeMatrix(A);
+		dd_FreePolyhedra(P);
+		break;
+	}
+}
+
+void
+CDD_run_batch(CDD_Batch * batch)
+{
+	int k;
+	
+	for (k = 0; k < batch->njobs; k++)
+		CDD_run_job(&batch->jobs[k], batch->op);
+}
+
+void
+batch_op(int op, int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
+{
+	const char *fh[] = {"A", "B", "lin"};
+	const char *fv[] = {"V", "R", "rpos", "vpos", "lin"};
+	const char *flp[] = {"xopt", "lambda", "how", "objlp", "active"};
+	CDD_Batch batch;
+	CDD_BatchJob * job;
+	mxArray * red = 0;
+	char msg[128];
+	int k, nerr, firsterr;
+	
+	if (nrhs != 1 || nlhs > 2 || !mxIsStruct(prhs[0]))
+		mexErrMsgTxt("batch operations expect a struct array of polyhedra");
+	if (nlhs == 2 && op != CDDMEX_BATCH_REDUCE_H)
+		mexErrMsgTxt("Too many output arguments.");
+
+	batch.op = op;
+	batch.njobs = (int) mxGetNumberOfElements(prhs[0]);
+	batch.jobs = (CDD_BatchJob *) mxCalloc(batch.njobs > 0 ? batch.njobs : 1, sizeof(CDD_BatchJob));
+	for (k = 0; k < batch.njobs; k++) {
+		job = &batch.jobs[k];
+		switch (op) {
+		case CDDMEX_BATCH_HULL:
+		case CDDMEX_BATCH_ADJACENCY:
+			job->valid = FT_get_V_data(prhs[0], k, &job->in);
+			break;
+		case CDDMEX_BATCH_SOLVE_LP:
+			job->valid = MB_get_LP_data(prhs[0], k, &job->in);
+			break;
+		default:
+			job->valid = FT_get_H_data(prhs[0], k, &job->in);
+		}
+	}
+	
+	CDD_run_batch(&batch);
+	
+	/* Copy results back to MATLAB and release cdd data */
+	switch (op) {
+	case CDDMEX_BATCH_HULL:
+	case CDDMEX_BATCH_REDUCE_H:
+		plhs[0] = mxCreateStructMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), 3, fh);
+		if (op == CDDMEX_BATCH_REDUCE_H && nlhs == 2)
+			red = plhs[1] = mxCreateCellMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]));
+		break;
+	case CDDMEX_BATCH_EXTREME:
+		plhs[0] = mxCreateStructMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), 5, fv);
+		break;
+	case CDDMEX_BATCH_SOLVE_LP:
+		plhs[0] = mxCreateStructMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), 5, flp);
+		break;
+	case CDDMEX_BATCH_ADJACENCY:
+		plhs[0] = mxCreateCellMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]));
+		break;
+	}
+	nerr = 0;
+	firsterr = 0;
+	for (k = 0; k < batch.njobs; k++) {
+		job = &batch.jobs[k];
+		if (!job->valid || job->err != dd_NoError) {
+			if (!nerr++)
+				firsterr = k;
+			if (job->err != dd_NoError)
+				dd_WriteErrorMessages(stdout, job->err);
+		}
+		if (job->M) {
+			if (job->M->representation == dd_Generator)
+				FT_fill_V(plhs[0], k, job->M);
+			else
+				FT_fill_H(plhs[0], k, job->M);
+			dd_FreeMatrix(job->M);
+		}
+		if (job->red) {
+			if (red)
+				mxSetCell(red, k, FT_set_Set(job->red));
+			set_free(job->red);
+		}
+		if (job->lp) {
+			if (job->err == dd_NoError)
+				MB_fill_LPsol(plhs[0], k, job->lp);
+			dd_FreeLPData(job->lp);
+		}
+		if (job->adj) {
+			mxSetCell(plhs[0], k, FT_set_SetFamilyPtr(job->adj));
+			dd_FreeSetFamily(job->adj);
+		}
+	}
+	mxFree(batch.jobs);
+	if (nerr && op != CDDMEX_BATCH_SOLVE_LP) {
+		sprintf(msg, "CDD failed on %d polyhedra (first: element %d), see above(!) for details", nerr, firsterr + 1);
+		mexErrMsgTxt(msg);
+	}
+}
+
+void
+adjacency(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[]);
+
 void
 mexFunction(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 {
@@ -819,6 +1095,7 @@ mexFunction(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 	if (nrhs<1){
 		mexErrMsgTxt("Input 1 must be a row vector string");
 	}
+	cddmex_init();
 		
 	
 	/* 1. input must be a string and row vector */
@@ -877,6 +1154,30 @@ mexFunction(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 			find_interior_DS(nlhs, plhs, nrhs -1, prhs + 1);
 			return;
 		}
+		if (strcmp(input_buf,"adjacency\0") == 0) {
+			adjacency(nlhs, plhs, nrhs -1, prhs + 1);
+			return;
+		}
+		if (strcmp(input_buf,"hull_batch\0") == 0) {
+			batch_op(CDDMEX_BATCH_HULL, nlhs, plhs, nrhs -1, prhs + 1);
+			return;
+		}
+		if (strcmp(input_buf,"extreme_batch\0") == 0) {
+			batch_op(CDDMEX_BATCH_EXTREME, nlhs, plhs, nrhs -1, prhs + 1);
+			return;
+		}
+		if (strcmp(input_buf,"reduce_h_batch\0") == 0) {
+			batch_op(CDDMEX_BATCH_REDUCE_H, nlhs, plhs, nrhs -1, prhs + 1);
+			return;
+		}
+		if (strcmp(input_buf,"solve_lp_batch\0") == 0) {
+			batch_op(CDDMEX_BATCH_SOLVE_LP, nlhs, plhs, nrhs -1, prhs + 1);
+			return;
+		}
+		if (strcmp(input_buf,"adjacency_batch\0") == 0) {
+			batch_op(CDDMEX_BATCH_ADJACENCY, nlhs, plhs, nrhs -1, prhs + 1);
+			return;
+		}
 		if (strcmp(input_buf,"version\0") == 0) {
 			printf("Version %s\n", CDDMEX_VERSION);
 			return;
@@ -898,7 +1199,6 @@ adjacency(int nlhs, mxArray * plhs[], int nrhs, const mxArray * prhs[])
 		
 	if (mxIsStruct(prhs[0])) {
 		V = FT_get_V_MatrixPtr(prhs[0]);		
-		dd_set_global_constants();  /* First, this must be called. */
 
 		P = dd_DDMatrix2Poly(V, &err); /* compute the second representation */
 		if (err == dd_NoError) {
@@ -10,7 +10,7 @@
 % LP solver. The full CDD library is free and availible from:
 % http://www.cs.mcgill.ca/~fukuda/soft/cdd_home/cdd.html
 %
-% Version: cddmex v1.0
+% Version: cddmex v1.1
 %          cddlib v0.93
 %
 % See the bottom of this file for more details.
@@ -26,6 +26,13 @@
 %          'solve_lp_DS'      Solve a Linear Program using Dual-Simplex method
 %          'version'          Version of the mex function
 %
+% Batched actions (one call for a whole struct array of polyhedra):
+%          'hull_batch'       Convex hull of each V polyhedron
+%          'extreme_batch'    Vertex/ray enumeration of each H polyhedron
+%          'reduce_h_batch'   Minimal H representation of each H polyhedron
+%          'solve_lp_batch'   Solve each LP using Criss-Cross method
+%          'adjacency_batch'  Adjacency list of each V polyhedron
+%
 % Further info: see CDDMEX.C
 %
 % Not documented functions:
@@ -35,8 +42,7 @@
 %          'adj_extreme'      Extreme points and adjecancy list of an H polyhedron
 %          'find_interior'    Interior point of an H polyhedron
 %
-% Not compiled functions:
-%          'adjecancy'        Adjacency list of a V polyhedron
+%          'adjacency'        Adjacency list of a V polyhedron
 %                             Note that V has to be in a minimal representation!
 %
 %
@@ -124,6 +130,30 @@
 % 		    objlp: -1
 %
 %
+% Example: Vertex enumeration of all regions of a polyhedral partition
+%
+%    for i=1:nr,
+%        H(i)=struct('A',sol.H(sol.i1(i):sol.i2(i),:),'B',sol.K(sol.i1(i):sol.i2(i)),'lin',[]);
+%    end
+%    V=cddmex('extreme_batch',H);  % V(i).V are the vertices of region #i
+%
+%    [Hred,ind_redrows]=cddmex('reduce_h_batch',H);
+%    % Hred(i) is the minimal representation of H(i), ind_redrows{i} are
+%    % the indices of its redundant rows
+%
+%    The output has the same size of the input struct array. The cdd
+%    library is initialized only once per MEX load, and the polyhedra are
+%    processed one after the other within a single MEX call (cddlib is not
+%    reentrant, so it is never called from several threads). An error is
+%    raised after the whole batch is processed if cdd fails on any of the
+%    polyhedra (for 'solve_lp_batch' the status is returned in the field
+%    .how instead).
+%
+%    To compile on Linux/Mac:
+%       mex cddmex.c -I<cddlib>/include <cddlib>/lib/libcdd.a
+%    The batched actions need a CDDMEX binary compiled from this version of
+%    cddmex.c (v1.1).
+%
 % Note: the projection function is only available in CDDMEX.M. A projection
 % can be obtained here by (1) vertex enumeration, (2) projection of vertices,
 % (3) hull of projected vertices. Example:
@@ -172,5 +202,8 @@
 %		 Zurich, December 2002.
 %
 % cddmex.c v1.0, Revision update by Mato Baotic, Zurich, October 2003.
+%
+% cddmex.c v1.1, cddlib initialized once per MEX load, batched actions on
+%                struct arrays of polyhedra.
 
 
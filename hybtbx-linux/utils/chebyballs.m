@@ -0,0 +1,116 @@
+function [rCheb,xCheb,rFacet,xFacet]=chebyballs(H,K,i1,i2,thmin,thmax,nthreads)
+% CHEBYBALLS Chebychev balls of all regions (and facets) of a polyhedral partition
+%
+% [rCheb,xCheb]=CHEBYBALLS(H,K,i1,i2) returns the radius rCheb(i) and the
+% center xCheb(i,:) of the largest ball contained in the region
+% {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}. rCheb(i)<0 if the region is
+% empty, rCheb(i)=Inf if the region is unbounded.
+%
+% [rCheb,xCheb]=CHEBYBALLS(H,K,i1,i2,thmin,thmax) intersects each region
+% with the box thmin <= th <= thmax.
+%
+% [rCheb,xCheb,rFacet,xFacet]=CHEBYBALLS(...) also returns the radius
+% rFacet(j) and center xFacet(j,:) of the largest ball contained in the
+% facet H(j,:)*th = K(j) of the region to which row j belongs (see FACECHEBY).
+%
+% [...]=CHEBYBALLS(H,K,i1,i2,thmin,thmax,nthreads) uses nthreads worker
+% threads (default: all cores).
+%
+% [...]=CHEBYBALLS(sol) where sol is the output of MPQP, MPLP, or
+% GETCONTROLLER uses sol.H,sol.K,sol.i1,sol.i2,sol.thmin,sol.thmax.
+%
+% All LPs are solved in one call of the MEX function CHEBYMEX, which
+% precomputes row norms, warm-starts each LP from the previous region, and
+% runs on multiple threads. If CHEBYMEX is not compiled, one LP per
+% region/facet is solved through LPSOL and FACECHEBY.
+%
+% See also FACECHEBY, PARTADJACENCY, REDUCE.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if isstruct(H),
+    sol=H;
+    if nargin>=2,
+        nthreads=K;
+    else
+        nthreads=[];
+    end
+    H=sol.H;
+    K=sol.K;
+    i1=sol.i1;
+    i2=sol.i2;
+    if isfield(sol,'thmin'),
+        thmin=sol.thmin;
+        thmax=sol.thmax;
+    else
+        thmin=[];
+        thmax=[];
+    end
+else
+    if nargin<4,
+        error('Not enough input arguments');
+    end
+    if nargin<5,
+        thmin=[];
+    end
+    if nargin<6,
+        thmax=[];
+    end
+    if nargin<7,
+        nthreads=[];
+    end
+end
+thmin=thmin(:);
+thmax=thmax(:);
+
+if nargout>2,
+    facets=(1:size(H,1))';
+else
+    facets=[];
+end
+
+if exist('chebymex')==3,
+    [rCheb,xCheb,rFacet,xFacet]=chebymex(H,K,i1,i2,thmin,thmax,facets,nthreads);
+    return
+end
+
+% MATLAB fallback
+nr=length(i1);
+npar=size(H,2);
+rCheb=zeros(nr,1);
+xCheb=zeros(nr,npar);
+for i=1:nr,
+    Hi=H(i1(i):i2(i),:);
+    Ki=K(i1(i):i2(i));
+    if ~isempty(thmin),
+        Hi=[Hi;eye(npar);-eye(npar)];
+        Ki=[Ki;thmax;-thmin];
+    end
+    qi=size(Hi,1);
+    ECheb=zeros(qi,1);
+    for j=1:qi,
+        ECheb(j)=norm(Hi(j,:));
+    end
+    [xopt,dummy,how]=lpsol(-[zeros(npar,1);1],[Hi,ECheb],Ki);
+    if strcmp(how,'unbounded'),
+        rCheb(i)=Inf;
+    else
+        rCheb(i)=xopt(npar+1);
+    end
+    xCheb(i,:)=xopt(1:npar)';
+end
+
+rFacet=zeros(length(facets),1);
+xFacet=zeros(length(facets),npar);
+for i=1:nr,
+    Hi=H(i1(i):i2(i),:);
+    Ki=K(i1(i):i2(i));
+    if ~isempty(thmin),
+        Hi=[Hi;eye(npar);-eye(npar)];
+        Ki=[Ki;thmax;-thmin];
+    end
+    for j=intersect(facets(:)',i1(i):i2(i)),
+        [rFacet(j),x]=facecheby(Hi,Ki,j-i1(i)+1);
+        xFacet(j,:)=x(:)';
+    end
+end
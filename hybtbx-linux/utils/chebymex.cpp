@@ -0,0 +1,204 @@
+/* Chebychev balls of the regions of a polyhedral partition - MEX interface
+
+   [r,xc,rf,xf]=chebymex(H,K,i1,i2,thmin,thmax,facets,nthreads)
+
+   Region #i is {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, intersected
+   with the box thmin<=th<=thmax if thmin,thmax are not empty.
+
+   r(i), xc(i,:) = radius and center of the largest ball in region #i
+                   (xc(i,:)=NaN if its LP is not solved: r(i)=-Inf if
+                   the region is empty, Inf if it is unbounded)
+   rf(j), xf(j,:) = radius and center of the largest ball contained in
+                    the facet H(facets(j),:)*th=K(facets(j)) of its region
+
+   All LPs are solved by the dense active-set solver in LPDENSE.H on
+   nthreads worker threads (default: all cores). Row norms are computed
+   once, each worker processes blocks of consecutive regions and starts
+   every LP from the center of the previous region (regions generated by
+   MPQP/MPLP are numbered while crossing facets, so consecutive regions
+   are usually neighbors); facet balls start from the projection of the
+   center of their region.
+
+   Compile with MEXCOMPILE.M (or mex -O chebymex.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "lpdense.h"
+#include "mexthreads.h"
+#include "mexpart.h"
+#include <cmath>
+#include <vector>
+#include <limits>
+
+/* Input Arguments */
+
+#define H_IN       prhs[0]
+#define K_IN       prhs[1]
+#define I1_IN      prhs[2]
+#define I2_IN      prhs[3]
+#define THMIN_IN   prhs[4]
+#define THMAX_IN   prhs[5]
+#define FACETS_IN  prhs[6]
+#define NTHREADS_IN prhs[7]
+
+/* Output Arguments */
+
+#define R_OUT   plhs[0]
+#define XC_OUT  plhs[1]
+#define RF_OUT  plhs[2]
+#define XF_OUT  plhs[3]
+
+#define CHEBY_CHUNK 32
+
+/* Build the region LP rows [H_i norm(H_i)] (plus box) directly */
+static int region_ball(DenseLP &lp, const Partition &P, int i, double *x, double *r)
+{
+    int n = P.npar, j, k, m, row;
+    int mi = P.i2[i] - P.i1[i] + 1;
+    double ri, rmin = std::numeric_limits<double>::infinity();
+    std::vector<double> c(n + 1, 0.0), y(n + 1);
+
+    m = mi + (P.thmin ? 2 * n : 0);
+    lp.resize(n + 1, m, 0);
+    for (k = 0; k < mi; k++) {
+        row = P.i1[i] + k;
+        double *a = lp.row(k);
+        for (j = 0; j < n; j++)
+            a[j] = P.h(row, j);
+        a[n] = P.hn[row];
+        lp.b[k] = P.K[row];
+    }
+    if (P.thmin) {
+        for (j = 0; j < n; j++) {
+            double *a = lp.row(mi + 2 * j), *a2 = lp.row(mi + 2 * j + 1);
+            for (k = 0; k <= n; k++)
+                a[k] = a2[k] = 0.0;
+            a[j] = 1.0;   a[n] = 1.0;  lp.b[mi + 2 * j] = P.thmax[j];
+            a2[j] = -1.0; a2[n] = 1.0; lp.b[mi + 2 * j + 1] = -P.thmin[j];
+        }
+    }
+    /* warm start: largest ball centered at x */
+    for (k = 0; k < m; k++) {
+        const double *a = lp.row(k);
+        ri = (lp.b[k] - DenseLP::dot(a, x, n)) / (a[n] > 0 ? a[n] : 1.0);
+        if (ri < rmin)
+            rmin = ri;
+    }
+    for (j = 0; j < n; j++)
+        y[j] = x[j];
+    y[n] = (m > 0) ? rmin : 0.0;
+    c[n] = -1.0;
+    int status = lp.solve(&c[0], &y[0]);
+    if (status == LPDENSE_UNBOUNDED) {
+        *r = std::numeric_limits<double>::infinity();
+        return status;
+    }
+    if (status == LPDENSE_INFEASIBLE) {
+        *r = -std::numeric_limits<double>::infinity();
+        return status;
+    }
+    for (j = 0; j < n; j++)
+        x[j] = y[j];
+    *r = y[n];
+    return status;
+}
+
+/* Largest ball contained in facet H(row,:)*th=K(row) of its region,
+   see FACECHEBY.M */
+static int facet_ball(DenseLP &lp, const Partition &P, int row, const double *xc,
+                      std::vector<double> &rows, std::vector<double> &rhs, double *x, double *r)
+{
+    int n = P.npar, j;
+    std::vector<double> hf(n);
+
+    for (j = 0; j < n; j++)
+        hf[j] = P.h(row, j);
+    rows.clear();
+    rhs.clear();
+    partition_region_rows(P, P.region_of[row], row, rows, rhs);
+    for (j = 0; j < n; j++)
+        x[j] = xc[j];
+    return lpdense_facet_chebyshev(lp, n, &hf[0], P.K[row], (int) rhs.size(),
+                                   rows.data(), rhs.data(), x, r);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    Partition P;
+    double *r, *xc, *rf = NULL, *xf = NULL, *p1;
+    int i, nf = 0, nthreads = 0;
+    std::vector<int> facets;
+
+    /* Check for proper number of arguments */
+
+    if (nrhs < 4) {
+        mexErrMsgTxt("At least four input arguments required (H,K,i1,i2).");
+    }
+    else if (nlhs > 4) {
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    mex_get_partition(P, H_IN, K_IN, I1_IN, I2_IN);
+    if (nrhs >= 6)
+        mex_get_box(P, THMIN_IN, THMAX_IN);
+    if (nrhs >= 7 && !mxIsEmpty(FACETS_IN)) {
+        nf = (int) mxGetNumberOfElements(FACETS_IN);
+        p1 = mxGetPr(FACETS_IN);
+        facets.resize(nf);
+        for (i = 0; i < nf; i++) {
+            facets[i] = (int) p1[i] - 1;
+            if (facets[i] < 0 || facets[i] >= P.nh || P.region_of[facets[i]] < 0)
+                mexErrMsgTxt("Facet indices must be rows of H belonging to a region.");
+        }
+    }
+    if (nrhs >= 8 && !mxIsEmpty(NTHREADS_IN))
+        nthreads = (int) mxGetScalar(NTHREADS_IN);
+    nthreads = mex_num_threads(nthreads);
+
+    /* Create matrices for the return arguments */
+    R_OUT = mxCreateDoubleMatrix(P.nr, 1, mxREAL);
+    XC_OUT = mxCreateDoubleMatrix(P.nr, P.npar, mxREAL);
+    r = mxGetPr(R_OUT);
+    xc = mxGetPr(XC_OUT);
+    if (nlhs > 2) {
+        RF_OUT = mxCreateDoubleMatrix(nf, 1, mxREAL);
+        rf = mxGetPr(RF_OUT);
+    }
+    if (nlhs > 3) {
+        XF_OUT = mxCreateDoubleMatrix(nf, P.npar, mxREAL);
+        xf = mxGetPr(XF_OUT);
+    }
+
+    /* Region balls: one LP object and one warm start per worker */
+    std::vector<DenseLP> lps(nthreads);
+    std::vector<std::vector<double> > last(nthreads, std::vector<double>(P.npar, 0.0));
+    std::vector<double> centers((size_t) P.nr * P.npar);
+    mex_parallel_for(P.nr, nthreads, CHEBY_CHUNK, [&](int i, int t) {
+        double *x = &last[t][0];
+        /* x is not written when the LP fails: output NaN, not the center
+           of the previous region of this worker */
+        bool ok = region_ball(lps[t], P, i, x, &r[i]) == LPDENSE_OPTIMAL;
+        for (int j = 0; j < P.npar; j++) {
+            centers[(size_t) i * P.npar + j] = ok ? x[j] : 0.0;
+            xc[i + (size_t) j * P.nr] = ok ? x[j] : mxGetNaN();
+        }
+    });
+
+    /* Facet balls */
+    if (nf > 0 && nlhs > 2) {
+        std::vector<std::vector<double> > rows(nthreads), rhs(nthreads);
+        mex_parallel_for(nf, nthreads, CHEBY_CHUNK, [&](int k, int t) {
+            int row = facets[k];
+            double rk;
+            std::vector<double> x(P.npar);
+            facet_ball(lps[t], P, row, &centers[(size_t) P.region_of[row] * P.npar],
+                       rows[t], rhs[t], &x[0], &rk);
+            rf[k] = rk;
+            if (xf)
+                for (int j = 0; j < P.npar; j++)
+                    xf[k + (size_t) j * nf] = x[j];
+        });
+    }
+}
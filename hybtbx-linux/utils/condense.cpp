@@ -0,0 +1,603 @@
+/* Condensing of linear MPC problems - implementation
+
+   See CONDENSE.H for the API.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "condense.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+typedef std::vector<double> dvec;
+
+struct condense_struct {
+    int nx, nu, ny, N, Nu;
+    dvec A, B, C, Q, R, P;
+    dvec Apow;          /* A^k, k=0..N (nx-by-nx each) */
+    dvec Psi;           /* A^m*B, m=0..N-1 (nx-by-nu each) */
+    dvec Phi;           /* C*A^m*B, m=0..N-1 (ny-by-nu each) */
+    dvec Theta;         /* C*A^k, k=1..N (ny-by-nx each) */
+    /* time-varying model (condense_new_ltv) */
+    int ltv;
+    dvec Am, Bm, Cm;            /* A(k), B(k), k=0..N-1, C(k), k=1..N */
+    std::vector<dvec> Th;       /* Th[k-1]: C(k)*A(k-1)*...*A(j), j=0..k (ny-by-nx each) */
+    std::vector<dvec> Sy;       /* Sy[k-1]: C(k)*A(k-1)*...*A(j+1)*B(j), j=0..k-1 (ny-by-nu each) */
+    std::vector<dvec> PsiN;     /* A(N-1)*...*A(j), j=0..N (nx-by-nx each) */
+    dvec Hq;                    /* sum_{k=1}^{N-1} Sy(k,i)'*Q*Sy(k,j), N*nu-by-N*nu */
+    dvec H, F, Y, Sbar, Tbar;
+    dvec G, W, S;
+    int nc;             /* number of rows of G */
+    dvec umin, umax, ymin, ymax;
+    std::vector<char> pattern;   /* finite limits of G, W, S */
+    int nmodel, nweights, nconstraints;
+};
+
+/* C(m,n) = beta*C + op(A)*B, op(A) = A (m-by-k) or A' (A is k-by-m) */
+static void gemm(int m, int n, int k, const double *A, int lda, bool transA,
+                 const double *B, int ldb, double *C, int ldc, double beta)
+{
+    int i, j, l;
+    for (j = 0; j < n; j++) {
+        double *cj = C + (size_t) j * ldc;
+        const double *bj = B + (size_t) j * ldb;
+        if (beta == 0.0)
+            for (i = 0; i < m; i++)
+                cj[i] = 0.0;
+        else if (beta != 1.0)
+            for (i = 0; i < m; i++)
+                cj[i] *= beta;
+        if (transA) {
+            for (i = 0; i < m; i++) {
+                const double *ai = A + (size_t) i * lda;
+                double t = 0.0;
+                for (l = 0; l < k; l++)
+                    t += ai[l] * bj[l];
+                cj[i] += t;
+            }
+        }
+        else {
+            for (l = 0; l < k; l++) {
+                const double *al = A + (size_t) l * lda;
+                double t = bj[l];
+                if (t != 0.0)
+                    for (i = 0; i < m; i++)
+                        cj[i] += al[i] * t;
+            }
+        }
+    }
+}
+
+/* Dest(r0:r0+m-1,c0:c0+n-1) += alpha*M (M is m-by-n, Dest has ld rows) */
+static void addblock(double *Dest, int ld, int r0, int c0, const double *M, int m, int n,
+                     double alpha)
+{
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < m; i++)
+            Dest[r0 + i + (size_t) (c0 + j) * ld] += alpha * M[i + (size_t) j * m];
+}
+
+static void compute_weights(condense_t *c);
+static void compute_constraints(condense_t *c);
+static void assemble(condense_t *c, const dvec &Hf, const dvec &Ff);
+static void compute_model_ltv(condense_t *c);
+static void compute_weights_ltv(condense_t *c);
+
+static void compute_model(condense_t *c)
+{
+    if (c->ltv) {
+        compute_model_ltv(c);
+        return;
+    }
+    int nx = c->nx, nu = c->nu, ny = c->ny, N = c->N, Nu = c->Nu, k, j, m;
+    size_t sxx = (size_t) nx * nx, sxu = (size_t) nx * nu, syu = (size_t) ny * nu,
+           syx = (size_t) ny * nx;
+    int nU = nu * Nu;
+
+    c->Apow.assign((N + 1) * sxx, 0.0);
+    for (k = 0; k < nx; k++)
+        c->Apow[k + (size_t) k * nx] = 1.0;
+    for (k = 1; k <= N; k++)
+        gemm(nx, nx, nx, &c->A[0], nx, false, &c->Apow[(k - 1) * sxx], nx,
+             &c->Apow[k * sxx], nx, 0.0);
+
+    c->Psi.resize(N * sxu);
+    c->Phi.resize(N * syu);
+    c->Theta.resize(N * syx);
+    for (m = 0; m < N; m++) {
+        gemm(nx, nu, nx, &c->Apow[m * sxx], nx, false, &c->B[0], nx, &c->Psi[m * sxu], nx, 0.0);
+        gemm(ny, nu, nx, &c->C[0], ny, false, &c->Psi[m * sxu], nx, &c->Phi[m * syu], ny, 0.0);
+        gemm(ny, nx, nx, &c->C[0], ny, false, &c->Apow[(m + 1) * sxx], nx,
+             &c->Theta[m * syx], ny, 0.0);
+    }
+
+    /* Sbar: block (k-1,j) = Phi(k-1-j), the last block column collects
+       the moves j >= Nu-1 */
+    c->Sbar.assign((size_t) ny * N * nU, 0.0);
+    c->Tbar.assign((size_t) ny * N * nx, 0.0);
+    for (k = 1; k <= N; k++) {
+        for (j = 0; j < k; j++)
+            addblock(&c->Sbar[0], ny * N, (k - 1) * ny, std::min(j, Nu - 1) * nu,
+                     &c->Phi[(k - 1 - j) * syu], ny, nu, 1.0);
+        addblock(&c->Tbar[0], ny * N, (k - 1) * ny, 0, &c->Theta[(k - 1) * syx], ny, nx, 1.0);
+    }
+    c->nmodel++;
+
+    compute_weights(c);
+    compute_constraints(c);
+}
+
+/* H, F, Y from the Markov parameters */
+static void compute_weights(condense_t *c)
+{
+    if (c->ltv) {
+        compute_weights_ltv(c);
+        return;
+    }
+    int nx = c->nx, nu = c->nu, ny = c->ny, N = c->N, i, j, k, d, s;
+    size_t sxx = (size_t) nx * nx, sxu = (size_t) nx * nu, syu = (size_t) ny * nu,
+           syx = (size_t) ny * nx, suu = (size_t) nu * nu;
+    int nN = nu * N;
+    dvec QPhi(N * syu), QTheta(N * syx), PPsi(N * sxu), PAN(sxx);
+    dvec Hf((size_t) nN * nN, 0.0), acc(suu), blk(suu), Ff((size_t) nN * nx, 0.0);
+
+    for (s = 0; s < N; s++) {
+        gemm(ny, nu, ny, &c->Q[0], ny, false, &c->Phi[s * syu], ny, &QPhi[s * syu], ny, 0.0);
+        gemm(ny, nx, ny, &c->Q[0], ny, false, &c->Theta[s * syx], ny, &QTheta[s * syx], ny, 0.0);
+        gemm(nx, nu, nx, &c->P[0], nx, false, &c->Psi[s * sxu], nx, &PPsi[s * sxu], nx, 0.0);
+    }
+    gemm(nx, nx, nx, &c->P[0], nx, false, &c->Apow[N * sxx], nx, &PAN[0], nx, 0.0);
+
+    /* Blocks of Sbar'*Qbar*Sbar for all N moves, along the diagonals j-i=d:
+       Hf(i,j) = sum_{s=0}^{N-2-j} Phi(d+s)'*Q*Phi(s) + Psi(N-1-i)'*P*Psi(N-1-j) */
+    for (d = 0; d < N; d++) {
+        std::fill(acc.begin(), acc.end(), 0.0);
+        for (j = N - 1; j >= d; j--) {
+            i = j - d;
+            blk = acc;
+            gemm(nu, nu, nx, &c->Psi[(N - 1 - i) * sxu], nx, true, &PPsi[(N - 1 - j) * sxu], nx,
+                 &blk[0], nu, 1.0);
+            addblock(&Hf[0], nN, i * nu, j * nu, &blk[0], nu, nu, 1.0);
+            if (d > 0)
+                for (k = 0; k < nu; k++)
+                    for (s = 0; s < nu; s++)
+                        Hf[j * nu + k + (size_t) (i * nu + s) * nN] = blk[s + (size_t) k * nu];
+            s = N - 1 - j;
+            if (d + s <= N - 1)
+                gemm(nu, nu, ny, &c->Phi[(d + s) * syu], ny, true, &QPhi[s * syu], ny,
+                     &acc[0], nu, 1.0);
+        }
+    }
+
+    /* F rows for all N moves: sum_{k=i+1}^{N-1} Phi(k-1-i)'*Q*C*A^k + Psi(N-1-i)'*P*A^N */
+    for (i = 0; i < N; i++) {
+        dvec Fi(sxu, 0.0);  /* nu-by-nx */
+        for (k = i + 1; k <= N - 1; k++)
+            gemm(nu, nx, ny, &c->Phi[(k - 1 - i) * syu], ny, true, &QTheta[(k - 1) * syx], ny,
+                 &Fi[0], nu, 1.0);
+        gemm(nu, nx, nx, &c->Psi[(N - 1 - i) * sxu], nx, true, &PAN[0], nx, &Fi[0], nu, 1.0);
+        addblock(&Ff[0], nN, i * nu, 0, &Fi[0], nu, nx, 1.0);
+    }
+
+    /* Y = 2*(sum_{k=1}^{N-1} (C*A^k)'*Q*C*A^k + (A^N)'*P*A^N) */
+    c->Y.assign(sxx, 0.0);
+    for (k = 1; k <= N - 1; k++)
+        gemm(nx, nx, ny, &c->Theta[(k - 1) * syx], ny, true, &QTheta[(k - 1) * syx], ny,
+             &c->Y[0], nx, 1.0);
+    gemm(nx, nx, nx, &c->Apow[N * sxx], nx, true, &PAN[0], nx, &c->Y[0], nx, 1.0);
+
+    assemble(c, Hf, Ff);
+}
+
+/* H, F from the blocks Hf, Ff of all N moves: moves j >= Nu-1 are equal to
+   u(Nu-1), fold their blocks and add R. Scales Y by 2. */
+static void assemble(condense_t *c, const dvec &Hf, const dvec &Ff)
+{
+    int nx = c->nx, nu = c->nu, N = c->N, Nu = c->Nu, i, j, k, s;
+    int nU = nu * Nu, nN = nu * N;
+
+    c->H.assign((size_t) nU * nU, 0.0);
+    c->F.assign((size_t) nU * nx, 0.0);
+    for (i = 0; i < N; i++) {
+        int bi = std::min(i, Nu - 1) * nu;
+        for (j = 0; j < N; j++) {
+            int bj = std::min(j, Nu - 1) * nu;
+            for (k = 0; k < nu; k++)
+                for (s = 0; s < nu; s++)
+                    c->H[bi + s + (size_t) (bj + k) * nU] += Hf[i * nu + s + (size_t) (j * nu + k) * nN];
+        }
+        addblock(&c->H[0], nU, bi, bi, &c->R[0], nu, nu, 1.0);
+        for (k = 0; k < nx; k++)
+            for (s = 0; s < nu; s++)
+                c->F[bi + s + (size_t) k * nU] += Ff[i * nu + s + (size_t) k * nN];
+    }
+    for (size_t l = 0; l < c->H.size(); l++)
+        c->H[l] *= 2.0;
+    for (size_t l = 0; l < c->F.size(); l++)
+        c->F[l] *= 2.0;
+    for (size_t l = 0; l < c->Y.size(); l++)
+        c->Y[l] *= 2.0;
+    c->nweights++;
+}
+
+/* Time-varying model: Sbar, Tbar from the tables Sy, Th */
+static void build_pred_ltv(condense_t *c)
+{
+    int nx = c->nx, nu = c->nu, ny = c->ny, N = c->N, Nu = c->Nu, k, j;
+    size_t syu = (size_t) ny * nu, syx = (size_t) ny * nx;
+
+    c->Sbar.assign((size_t) ny * N * nu * Nu, 0.0);
+    c->Tbar.assign((size_t) ny * N * nx, 0.0);
+    for (k = 1; k <= N; k++) {
+        for (j = 0; j < k; j++)
+            addblock(&c->Sbar[0], ny * N, (k - 1) * ny, std::min(j, Nu - 1) * nu,
+                     &c->Sy[k - 1][j * syu], ny, nu, 1.0);
+        addblock(&c->Tbar[0], ny * N, (k - 1) * ny, 0, &c->Th[k - 1][0 * syx], ny, nx, 1.0);
+    }
+}
+
+/* Time-varying model: row k of the tables from Psi(k,j)=A(k-1)*...*A(j) */
+static void table_row_ltv(condense_t *c, int k, const std::vector<dvec> &Psi)
+{
+    int nx = c->nx, nu = c->nu, ny = c->ny, j;
+    size_t sxu = (size_t) nx * nu, syu = (size_t) ny * nu, syx = (size_t) ny * nx;
+
+    c->Th[k - 1].resize((k + 1) * syx);
+    c->Sy[k - 1].resize(k * syu);
+    for (j = 0; j <= k; j++)
+        gemm(ny, nx, nx, &c->Cm[(k - 1) * syx], ny, false, &Psi[j][0], nx,
+             &c->Th[k - 1][j * syx], ny, 0.0);
+    for (j = 0; j < k; j++)
+        gemm(ny, nu, nx, &c->Th[k - 1][(j + 1) * syx], ny, false, &c->Bm[j * sxu], nx,
+             &c->Sy[k - 1][j * syu], ny, 0.0);
+}
+
+static void compute_model_ltv(condense_t *c)
+{
+    int nx = c->nx, N = c->N, k, j;
+    size_t sxx = (size_t) nx * nx;
+    std::vector<dvec> Psi(1, dvec(sxx, 0.0)), next;
+
+    for (j = 0; j < nx; j++)
+        Psi[0][j + (size_t) j * nx] = 1.0;
+    c->Th.assign(N, dvec());
+    c->Sy.assign(N, dvec());
+    for (k = 1; k <= N; k++) {
+        next.assign(k + 1, dvec(sxx));
+        for (j = 0; j < k; j++)
+            gemm(nx, nx, nx, &c->Am[(k - 1) * sxx], nx, false, &Psi[j][0], nx, &next[j][0], nx, 0.0);
+        for (j = 0; j < nx; j++)
+            next[k][j + (size_t) j * nx] = 1.0;
+        Psi.swap(next);
+        table_row_ltv(c, k, Psi);
+    }
+    c->PsiN = Psi;
+    build_pred_ltv(c);
+    c->nmodel++;
+
+    compute_weights_ltv(c);
+    compute_constraints(c);
+}
+
+/* Time-varying model: H, F, Y from Hq and the last row of the tables */
+static void finish_ltv(condense_t *c)
+{
+    int nx = c->nx, nu = c->nu, ny = c->ny, N = c->N, nN = nu * N, i, j, k;
+    size_t sxx = (size_t) nx * nx, sxu = (size_t) nx * nu, syu = (size_t) ny * nu,
+           syx = (size_t) ny * nx, suu = (size_t) nu * nu;
+    dvec Sx(N * sxu), PSx(N * sxu), PPsi0(sxx), QTh0(N * syx), Hf = c->Hq,
+         Ff((size_t) nN * nx, 0.0), blk(suu), Fi(sxu);
+
+    /* terminal state x(N) = Psi(N,0)*x0 + sum_j Psi(N,j+1)*B(j)*u(j) */
+    for (j = 0; j < N; j++) {
+        gemm(nx, nu, nx, &c->PsiN[j + 1][0], nx, false, &c->Bm[j * sxu], nx, &Sx[j * sxu], nx, 0.0);
+        gemm(nx, nu, nx, &c->P[0], nx, false, &Sx[j * sxu], nx, &PSx[j * sxu], nx, 0.0);
+    }
+    gemm(nx, nx, nx, &c->P[0], nx, false, &c->PsiN[0][0], nx, &PPsi0[0], nx, 0.0);
+    for (i = 0; i < N; i++)
+        for (j = 0; j < N; j++) {
+            gemm(nu, nu, nx, &Sx[i * sxu], nx, true, &PSx[j * sxu], nx, &blk[0], nu, 0.0);
+            addblock(&Hf[0], nN, i * nu, j * nu, &blk[0], nu, nu, 1.0);
+        }
+
+    for (k = 1; k <= N - 1; k++)
+        gemm(ny, nx, ny, &c->Q[0], ny, false, &c->Th[k - 1][0], ny, &QTh0[(k - 1) * syx], ny, 0.0);
+    for (i = 0; i < N; i++) {
+        gemm(nu, nx, nx, &Sx[i * sxu], nx, true, &PPsi0[0], nx, &Fi[0], nu, 0.0);
+        for (k = i + 1; k <= N - 1; k++)
+            gemm(nu, nx, ny, &c->Sy[k - 1][i * syu], ny, true, &QTh0[(k - 1) * syx], ny,
+                 &Fi[0], nu, 1.0);
+        addblock(&Ff[0], nN, i * nu, 0, &Fi[0], nu, nx, 1.0);
+    }
+
+    c->Y.assign(sxx, 0.0);
+    for (k = 1; k <= N - 1; k++)
+        gemm(nx, nx, ny, &c->Th[k - 1][0], ny, true, &QTh0[(k - 1) * syx], ny, &c->Y[0], nx, 1.0);
+    gemm(nx, nx, nx, &c->PsiN[0][0], nx, true, &PPsi0[0], nx, &c->Y[0], nx, 1.0);
+
+    assemble(c, Hf, Ff);
+}
+
+/* Time-varying model: Hq from the tables, O(N^3) block products */
+static void compute_weights_ltv(condense_t *c)
+{
+    int nu = c->nu, ny = c->ny, N = c->N, nN = nu * N, i, j, k;
+    size_t syu = (size_t) ny * nu, suu = (size_t) nu * nu;
+    dvec QSy(N * syu), blk(suu);
+
+    c->Hq.assign((size_t) nN * nN, 0.0);
+    for (k = 1; k <= N - 1; k++) {
+        for (j = 0; j < k; j++)
+            gemm(ny, nu, ny, &c->Q[0], ny, false, &c->Sy[k - 1][j * syu], ny, &QSy[j * syu], ny, 0.0);
+        for (i = 0; i < k; i++)
+            for (j = 0; j < k; j++) {
+                gemm(nu, nu, ny, &c->Sy[k - 1][i * syu], ny, true, &QSy[j * syu], ny, &blk[0], nu, 0.0);
+                addblock(&c->Hq[0], nN, i * nu, j * nu, &blk[0], nu, nu, 1.0);
+            }
+    }
+    finish_ltv(c);
+}
+
+/* Finite limits, in the order of the rows of G */
+static std::vector<char> limit_pattern(const condense_t *c)
+{
+    std::vector<char> p;
+    int j;
+    for (j = 0; j < c->nu; j++)
+        p.push_back((char) std::isfinite(c->umax[j]));
+    for (j = 0; j < c->nu; j++)
+        p.push_back((char) std::isfinite(c->umin[j]));
+    for (j = 0; j < c->ny; j++)
+        p.push_back((char) std::isfinite(c->ymax[j]));
+    for (j = 0; j < c->ny; j++)
+        p.push_back((char) std::isfinite(c->ymin[j]));
+    return p;
+}
+
+/* W: for each k, [umax;-umin] (k=0..Nu-1), then [ymax;-ymin] (k=1..N) */
+static void compute_rhs(condense_t *c)
+{
+    int k, j, r = 0;
+    for (k = 0; k < c->Nu; k++) {
+        for (j = 0; j < c->nu; j++)
+            if (std::isfinite(c->umax[j]))
+                c->W[r++] = c->umax[j];
+        for (j = 0; j < c->nu; j++)
+            if (std::isfinite(c->umin[j]))
+                c->W[r++] = -c->umin[j];
+    }
+    for (k = 1; k <= c->N; k++) {
+        for (j = 0; j < c->ny; j++)
+            if (std::isfinite(c->ymax[j]))
+                c->W[r++] = c->ymax[j];
+        for (j = 0; j < c->ny; j++)
+            if (std::isfinite(c->ymin[j]))
+                c->W[r++] = -c->ymin[j];
+    }
+}
+
+static void compute_constraints(condense_t *c)
+{
+    int nx = c->nx, nu = c->nu, ny = c->ny, N = c->N, Nu = c->Nu, nU = nu * Nu, k, j, l, r;
+    int nyN = ny * N, nuc = 0, nyc = 0;
+
+    c->pattern = limit_pattern(c);
+    for (j = 0; j < 2 * nu; j++)
+        nuc += c->pattern[j];
+    for (j = 0; j < 2 * ny; j++)
+        nyc += c->pattern[2 * nu + j];
+    c->nc = nuc * Nu + nyc * N;
+    c->G.assign((size_t) c->nc * nU, 0.0);
+    c->S.assign((size_t) c->nc * nx, 0.0);
+    c->W.assign(c->nc, 0.0);
+
+    r = 0;
+    for (k = 0; k < Nu; k++)
+        for (l = 0; l < 2; l++)
+            for (j = 0; j < nu; j++)
+                if (c->pattern[l * nu + j])
+                    c->G[r++ + (size_t) (k * nu + j) * c->nc] = l ? -1.0 : 1.0;
+    for (k = 1; k <= N; k++)
+        for (l = 0; l < 2; l++)
+            for (j = 0; j < ny; j++)
+                if (c->pattern[2 * nu + l * ny + j]) {
+                    int row = (k - 1) * ny + j, i;
+                    double sg = l ? -1.0 : 1.0;
+                    for (i = 0; i < nU; i++)
+                        c->G[r + (size_t) i * c->nc] = sg * c->Sbar[row + (size_t) i * nyN];
+                    for (i = 0; i < nx; i++)
+                        c->S[r + (size_t) i * c->nc] = -sg * c->Tbar[row + (size_t) i * nyN];
+                    r++;
+                }
+    compute_rhs(c);
+    c->nconstraints++;
+}
+
+static condense_t *create(int nx, int nu, int ny, int N, int Nu,
+                          const double *A, const double *B, const double *C, int ltv)
+{
+    if (nx < 1 || nu < 1 || N < 1 || Nu < 1 || Nu > N || (C && ny < 1))
+        return NULL;
+    if (!C)
+        ny = nx;
+    condense_t *c = new condense_struct;
+    c->nx = nx;
+    c->nu = nu;
+    c->ny = ny;
+    c->N = N;
+    c->Nu = Nu;
+    c->Q.assign((size_t) ny * ny, 0.0);
+    c->R.assign((size_t) nu * nu, 0.0);
+    c->P.assign((size_t) nx * nx, 0.0);
+    c->umin.assign(nu, -INFINITY);
+    c->umax.assign(nu, INFINITY);
+    c->ymin.assign(ny, -INFINITY);
+    c->ymax.assign(ny, INFINITY);
+    c->nc = 0;
+    c->nmodel = c->nweights = c->nconstraints = 0;
+    c->ltv = ltv;
+    condense_set_model(c, A, B, C);
+    return c;
+}
+
+condense_t *condense_new(int nx, int nu, int ny, int N, int Nu,
+                         const double *A, const double *B, const double *C)
+{
+    return create(nx, nu, ny, N, Nu, A, B, C, 0);
+}
+
+condense_t *condense_new_ltv(int nx, int nu, int ny, int N, int Nu,
+                             const double *A, const double *B, const double *C)
+{
+    return create(nx, nu, ny, N, Nu, A, B, C, 1);
+}
+
+/* Copy n matrices of size r-by-q, C=NULL means identity */
+static void copy_stages(dvec &dest, const double *M, int r, int q, int n)
+{
+    size_t len = (size_t) r * q * n;
+    if (M)
+        dest.assign(M, M + len);
+    else {
+        dest.assign(len, 0.0);
+        for (int k = 0; k < n; k++)
+            for (int i = 0; i < std::min(r, q); i++)
+                dest[(size_t) k * r * q + i + (size_t) i * r] = 1.0;
+    }
+}
+
+void condense_set_model(condense_t *c, const double *A, const double *B, const double *C)
+{
+    int nx = c->nx, nu = c->nu, ny = c->ny;
+    if (c->ltv) {
+        copy_stages(c->Am, A, nx, nx, c->N);
+        copy_stages(c->Bm, B, nx, nu, c->N);
+        copy_stages(c->Cm, C, ny, nx, c->N);
+    }
+    else {
+        copy_stages(c->A, A, nx, nx, 1);
+        copy_stages(c->B, B, nx, nu, 1);
+        copy_stages(c->C, C, ny, nx, 1);
+    }
+    compute_model(c);
+}
+
+int condense_shift(condense_t *c, const double *A, const double *B, const double *C)
+{
+    int nx = c->nx, nu = c->nu, ny = c->ny, N = c->N, nN = nu * N, i, j;
+    size_t sxx = (size_t) nx * nx, sxu = (size_t) nx * nu, syu = (size_t) ny * nu,
+           syx = (size_t) ny * nx, suu = (size_t) nu * nu;
+
+    if (!c->ltv)
+        return -1;
+
+    /* Hq(i,j) <- Hq(i+1,j+1) + Sy(N,i+1)'*Q*Sy(N,j+1): the old stage N
+       becomes stage N-1 (rank-ny update) */
+    dvec Hq((size_t) nN * nN, 0.0), QSy(N * syu), blk(suu);
+    const dvec &SyN = c->Sy[N - 1];
+    for (j = 1; j < N; j++)
+        gemm(ny, nu, ny, &c->Q[0], ny, false, &SyN[j * syu], ny, &QSy[j * syu], ny, 0.0);
+    for (i = 0; i < N - 1; i++)
+        for (j = 0; j < N - 1; j++) {
+            gemm(nu, nu, ny, &SyN[(i + 1) * syu], ny, true, &QSy[(j + 1) * syu], ny, &blk[0], nu, 0.0);
+            for (int q = 0; q < nu; q++)
+                for (int r = 0; r < nu; r++)
+                    Hq[i * nu + r + (size_t) (j * nu + q) * nN] =
+                        c->Hq[(i + 1) * nu + r + (size_t) ((j + 1) * nu + q) * nN] + blk[r + q * nu];
+        }
+    c->Hq.swap(Hq);
+
+    /* Shift the stages and the tables by one step */
+    dvec Cn;
+    copy_stages(Cn, C, ny, nx, 1);
+    c->Am.erase(c->Am.begin(), c->Am.begin() + sxx);
+    c->Bm.erase(c->Bm.begin(), c->Bm.begin() + sxu);
+    c->Cm.erase(c->Cm.begin(), c->Cm.begin() + syx);
+    c->Am.insert(c->Am.end(), A, A + sxx);
+    c->Bm.insert(c->Bm.end(), B, B + sxu);
+    c->Cm.insert(c->Cm.end(), Cn.begin(), Cn.end());
+    for (int k = 1; k < N; k++) {
+        c->Th[k - 1].assign(c->Th[k].begin() + syx, c->Th[k].end());
+        c->Sy[k - 1].assign(c->Sy[k].begin() + syu, c->Sy[k].end());
+    }
+
+    /* New last stage: Psi(N,j) = A(N-1)*Psi(N-1,j), O(N) block products */
+    std::vector<dvec> Psi(N + 1, dvec(sxx, 0.0));
+    for (j = 0; j < N; j++)
+        gemm(nx, nx, nx, &c->Am[(N - 1) * sxx], nx, false, &c->PsiN[j + 1][0], nx, &Psi[j][0], nx, 0.0);
+    for (j = 0; j < nx; j++)
+        Psi[N][j + (size_t) j * nx] = 1.0;
+    c->PsiN.swap(Psi);
+    table_row_ltv(c, N, c->PsiN);
+
+    build_pred_ltv(c);
+    finish_ltv(c);
+    compute_constraints(c);
+    return 0;
+}
+
+void condense_set_weights(condense_t *c, const double *Q, const double *R, const double *P)
+{
+    c->Q.assign(Q, Q + (size_t) c->ny * c->ny);
+    c->R.assign(R, R + (size_t) c->nu * c->nu);
+    if (P)
+        c->P.assign(P, P + (size_t) c->nx * c->nx);
+    else
+        std::fill(c->P.begin(), c->P.end(), 0.0);
+    compute_weights(c);
+}
+
+void condense_set_limits(condense_t *c, const double *umin, const double *umax,
+                         const double *ymin, const double *ymax)
+{
+    int j;
+    for (j = 0; j < c->nu; j++) {
+        c->umin[j] = umin ? umin[j] : -INFINITY;
+        c->umax[j] = umax ? umax[j] : INFINITY;
+    }
+    for (j = 0; j < c->ny; j++) {
+        c->ymin[j] = ymin ? ymin[j] : -INFINITY;
+        c->ymax[j] = ymax ? ymax[j] : INFINITY;
+    }
+    if (limit_pattern(c) == c->pattern)
+        compute_rhs(c);
+    else
+        compute_constraints(c);
+}
+
+const double *condense_get(const condense_t *c, int which, int *rows, int *cols)
+{
+    int nU = c->nu * c->Nu, r = 0, q = 0;
+    const dvec *M = NULL;
+    switch (which) {
+    case CONDENSE_H: M = &c->H; r = nU; q = nU; break;
+    case CONDENSE_F: M = &c->F; r = nU; q = c->nx; break;
+    case CONDENSE_Y: M = &c->Y; r = c->nx; q = c->nx; break;
+    case CONDENSE_G: M = &c->G; r = c->nc; q = nU; break;
+    case CONDENSE_W: M = &c->W; r = c->nc; q = 1; break;
+    case CONDENSE_S: M = &c->S; r = c->nc; q = c->nx; break;
+    case CONDENSE_SBAR: M = &c->Sbar; r = c->ny * c->N; q = nU; break;
+    case CONDENSE_TBAR: M = &c->Tbar; r = c->ny * c->N; q = c->nx; break;
+    }
+    if (rows)
+        *rows = r;
+    if (cols)
+        *cols = q;
+    return (M && !M->empty()) ? &(*M)[0] : NULL;
+}
+
+void condense_counters(const condense_t *c, int *model, int *weights, int *constraints)
+{
+    if (model)
+        *model = c->nmodel;
+    if (weights)
+        *weights = c->nweights;
+    if (constraints)
+        *constraints = c->nconstraints;
+}
+
+void condense_free(condense_t *c)
+{
+    delete c;
+}
@@ -0,0 +1,106 @@
+/* Condensing of linear MPC problems - C API
+
+   For the prediction model
+
+       x(k+1) = A*x(k) + B*u(k),   y(k) = C*x(k)
+
+   with u(k) = u(Nu-1) for k >= Nu, and the cost
+
+       J = sum_{k=1}^{N-1} y(k)'*Q*y(k) + x(N)'*P*x(N) + sum_{k=0}^{N-1} u(k)'*R*u(k)
+
+   builds the condensed QP
+
+       J = .5*U'*H*U + x0'*F'*U + .5*x0'*Y*x0,   G*U <= W + S*x0
+
+   where U = [u(0);...;u(Nu-1)], and the constraints are umin <= u(k) <= umax
+   (k = 0,...,Nu-1) and ymin <= y(k) <= ymax (k = 1,...,N). The output
+   prediction is [y(1);...;y(N)] = Sbar*U + Tbar*x0.
+
+   Sbar is block-Toeplitz: its blocks are the Markov parameters C*A^m*B,
+   computed once. The blocks of H are built by a recursion along the
+   block diagonals, H(i,j) = H(i+1,j+1) + (C*A^(j-i)*B)'*Q*C*B, with
+   O(N^2) block products instead of the O(N^3) of Sbar'*Qbar*Sbar. When
+   only the weights change (condense_set_weights) the Markov parameters
+   are reused; when only the values of the limits change
+   (condense_set_limits) only W is rewritten. For time-varying models
+   (condense_new_ltv), condense_shift moves the prediction window by one
+   step reusing the blocks computed at the previous step.
+
+   Matrices are dense and column-major (MATLAB layout). See CONDENSEMEX.CPP
+   for the MEX interface and python_example/condense.py for the Python
+   interface.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef CONDENSE_API_H
+#define CONDENSE_API_H
+
+/* Matrices returned by condense_get */
+#define CONDENSE_H     0
+#define CONDENSE_F     1
+#define CONDENSE_Y     2
+#define CONDENSE_G     3
+#define CONDENSE_W     4
+#define CONDENSE_S     5
+#define CONDENSE_SBAR  6
+#define CONDENSE_TBAR  7
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct condense_struct condense_t;
+
+/* Create the condensing engine for the model (A,B,C) (nx-by-nx, nx-by-nu,
+   ny-by-nx; C=NULL means C=I, ny=nx), prediction horizon N and control
+   horizon Nu (1 <= Nu <= N). Weights are initially zero and there are no
+   limits. Returns NULL on wrong dimensions. */
+condense_t *condense_new(int nx, int nu, int ny, int N, int Nu,
+                         const double *A, const double *B, const double *C);
+
+/* Same for the time-varying model x(k+1) = A(k)*x(k) + B(k)*u(k), k=0..N-1,
+   y(k) = C(k)*x(k), k=1..N. A, B, C contain the N matrices of each stage
+   one after the other (nx-by-nx-by-N, nx-by-nu-by-N, ny-by-nx-by-N arrays
+   in MATLAB). The weights are the same at all stages. */
+condense_t *condense_new_ltv(int nx, int nu, int ny, int N, int Nu,
+                             const double *A, const double *B, const double *C);
+
+/* Replace the model (same dimensions, N stages for time-varying models):
+   everything is recomputed */
+void condense_set_model(condense_t *c, const double *A, const double *B, const double *C);
+
+/* Time-varying models only: shift the prediction window by one step. The
+   first stage is dropped and the new last stage A(N-1), B(N-1), C(N)
+   (C=NULL means C=I) is appended. The blocks of the predictions are
+   shifted, only the new last block row is computed (O(N) block products),
+   and the stage part of H is updated by the contribution of the stage
+   that moved inside the horizon (rank-ny update) instead of being rebuilt
+   (O(N^3)). Returns -1 if c was not created by condense_new_ltv. */
+int condense_shift(condense_t *c, const double *A, const double *B, const double *C);
+
+/* Replace the weights Q (ny-by-ny), R (nu-by-nu), P (nx-by-nx, NULL =
+   zero): H, F, Y are recomputed from the stored Markov parameters */
+void condense_set_weights(condense_t *c, const double *Q, const double *R, const double *P);
+
+/* Replace the limits (nu or ny elements, +-Inf = no limit, NULL = no
+   limits). If the set of finite limits is the same as before, only W is
+   updated; otherwise G, W, S are rebuilt. */
+void condense_set_limits(condense_t *c, const double *umin, const double *umax,
+                         const double *ymin, const double *ymax);
+
+/* Pointer to one of the CONDENSE_* matrices (valid until the next call
+   that changes c), and its size */
+const double *condense_get(const condense_t *c, int which, int *rows, int *cols);
+
+/* Number of times the Markov parameters (model), H/F/Y (weights) and
+   G/S (constraint matrices) have been computed */
+void condense_counters(const condense_t *c, int *model, int *weights, int *constraints);
+
+void condense_free(condense_t *c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,172 @@
+function [H,F,Y,G,W,S,Sbar,Tbar]=condense(model,N,Nu,weights,limits)
+% CONDENSE Condensed QP of a linear MPC problem
+%
+% [H,F,Y,G,W,S]=CONDENSE(MODEL,N,Nu,WEIGHTS,LIMITS) eliminates the states
+% of the MPC problem
+%
+%   min  sum_{k=1}^{N-1} y(k)'*Q*y(k) + x(N)'*P*x(N) + sum_{k=0}^{N-1} u(k)'*R*u(k)
+%   s.t. x(k+1)=A*x(k)+B*u(k), y(k)=C*x(k), u(k)=u(Nu-1) for k>=Nu
+%        umin<=u(k)<=umax (k=0,...,Nu-1), ymin<=y(k)<=ymax (k=1,...,N)
+%
+% and returns the QP
+%
+%   min .5*U'*H*U+x0'*F'*U (+.5*x0'*Y*x0)  s.t. G*U<=W+S*x0
+%
+% in U=[u(0);...;u(Nu-1)].
+%
+% MODEL   = discrete-time state-space model (or structure with fields A,
+%           B, C; C=[] means C=I)
+% WEIGHTS = structure with fields Q (output weight), R (input weight), P
+%           (terminal state weight, default: 0)
+% LIMITS  = structure with fields umin, umax, ymin, ymax (optional, default:
+%           no limits)
+%
+% [H,F,Y,G,W,S,Sbar,Tbar]=CONDENSE(...) also returns the output prediction
+% [y(1);...;y(N)]=Sbar*U+Tbar*x0.
+%
+% For a time-varying model x(k+1)=A(k)*x(k)+B(k)*u(k), y(k)=C(k)*x(k), MODEL
+% is a cell array of N models (or structures) {model(0),...,model(N-1)},
+% where C(k) is the C matrix of model(k) (C(N) = C of model(N-1)), or of N+1
+% models, where C(N) is the C matrix of model(N).
+%
+% CONDENSE uses the MEX function CONDENSEMEX (see CONDENSE.CPP and
+% MEXCOMPILE.M), which exploits the block-Toeplitz structure of Sbar and
+% keeps the prediction matrices between calls: when only WEIGHTS or LIMITS
+% change, only the matrices that depend on them are recomputed, and when a
+% time-varying MODEL is the one of the previous call shifted by one step
+% (model{k+1} is now model{k}, as in a receding horizon) only the new last
+% stage is computed. If the MEX function is not compiled, the matrices are
+% computed in MATLAB.
+%
+% See also LINCON.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<3 || isempty(Nu),
+    Nu=N;
+end
+if nargin<5,
+    limits=[];
+end
+
+if iscell(model),
+    % Time-varying model: stages as nx-by-nx-by-N, nx-by-nu-by-N and
+    % ny-by-nx-by-N arrays
+    if numel(model)~=N && numel(model)~=N+1,
+        error('A time-varying model must contain N or N+1 models');
+    end
+    nx=size(model{1}.A,1);
+    nu=size(model{1}.B,2);
+    C=model{1}.C;
+    if isempty(C),
+        C=eye(nx);
+    end
+    ny=size(C,1);
+    A=zeros(nx,nx,N);
+    B=zeros(nx,nu,N);
+    C=zeros(ny,nx,N);
+    for k=1:N,
+        A(:,:,k)=model{k}.A;
+        B(:,:,k)=model{k}.B;
+        Ck=model{min(k+1,numel(model))}.C;
+        if isempty(Ck),
+            Ck=eye(nx);
+        end
+        C(:,:,k)=Ck;
+    end
+else
+    A=model.A;
+    B=model.B;
+    C=model.C;
+    nx=size(A,1);
+    nu=size(B,2);
+    if isempty(C),
+        C=eye(nx);
+    end
+    ny=size(C,1);
+    A=repmat(A,[1 1 N]);
+    B=repmat(B,[1 1 N]);
+    C=repmat(C,[1 1 N]);
+end
+
+Q=weights.Q;
+R=weights.R;
+P=[];
+if isfield(weights,'P'),
+    P=weights.P;
+end
+if isempty(P),
+    P=zeros(nx);
+end
+umin=getlim(limits,'umin',-Inf(nu,1));
+umax=getlim(limits,'umax',Inf(nu,1));
+ymin=getlim(limits,'ymin',-Inf(ny,1));
+ymax=getlim(limits,'ymax',Inf(ny,1));
+
+if exist('condensemex')==3,
+    if ~iscell(model),
+        A=A(:,:,1);B=B(:,:,1);C=C(:,:,1);
+    end
+    [H,F,Y,G,W,S,Sbar,Tbar]=condensemex(A,B,C,N,Nu,Q,R,P,umin,umax,ymin,ymax);
+    return
+end
+
+% Prediction of x(1),...,x(N) and y(1),...,y(N)
+M=kron([eye(Nu);ones(N-Nu,1)*[zeros(1,Nu-1) 1]],eye(nu)); % u(k)=u(Nu-1), k>=Nu
+Sx=zeros(nx*N,nu*N);
+Tx=zeros(nx*N,nx);
+Ak=eye(nx);
+Sk=zeros(nx,0);
+for k=1:N,
+    % [x(k) given x(0), u(0),...,u(k-1)] from the one of x(k-1)
+    Sk=[A(:,:,k)*Sk B(:,:,k)];
+    Ak=A(:,:,k)*Ak;
+    Tx((k-1)*nx+1:k*nx,:)=Ak;
+    Sx((k-1)*nx+1:k*nx,1:k*nu)=Sk;
+end
+Sx=Sx*M;
+Cbar=zeros(ny*N,nx*N);
+Qbar=zeros(nx*N);
+for k=1:N,
+    ik=(k-1)*nx+1:k*nx;
+    Cbar((k-1)*ny+1:k*ny,ik)=C(:,:,k);
+    if k<N,
+        Qbar(ik,ik)=C(:,:,k)'*Q*C(:,:,k);
+    else
+        Qbar(ik,ik)=P;
+    end
+end
+Sbar=Cbar*Sx;
+Tbar=Cbar*Tx;
+
+Rbar=M'*kron(eye(N),R)*M;
+H=2*(Sx'*Qbar*Sx+Rbar);
+F=2*Sx'*Qbar*Tx;
+Y=2*Tx'*Qbar*Tx;
+
+% Constraints, in the order of CONDENSEMEX
+G=zeros(0,nu*Nu);
+W=zeros(0,1);
+S=zeros(0,nx);
+Iu=eye(nu*Nu);
+for k=0:Nu-1,
+    iu=k*nu+(1:nu);
+    j=find(isfinite(umax));
+    G=[G;Iu(iu(j),:)];W=[W;umax(j)];S=[S;zeros(numel(j),nx)];
+    j=find(isfinite(umin));
+    G=[G;-Iu(iu(j),:)];W=[W;-umin(j)];S=[S;zeros(numel(j),nx)];
+end
+for k=1:N,
+    iy=(k-1)*ny+(1:ny);
+    j=find(isfinite(ymax));
+    G=[G;Sbar(iy(j),:)];W=[W;ymax(j)];S=[S;-Tbar(iy(j),:)];
+    j=find(isfinite(ymin));
+    G=[G;-Sbar(iy(j),:)];W=[W;-ymin(j)];S=[S;Tbar(iy(j),:)];
+end
+
+%-----------------
+function v=getlim(limits,name,def)
+v=def;
+if isstruct(limits) && isfield(limits,name) && ~isempty(limits.(name)),
+    v=limits.(name)(:).*ones(size(def));
+end
@@ -0,0 +1,184 @@
+/* Condensing of linear MPC problems - MEX interface
+
+   [H,F,Y,G,W,S,Sbar,Tbar]=condensemex(A,B,C,N,Nu,Q,R,P,umin,umax,ymin,ymax)
+
+   Builds the condensed QP .5*U'*H*U+x0'*F'*U+.5*x0'*Y*x0, G*U<=W+S*x0 of
+   the MPC problem with model x(k+1)=A*x(k)+B*u(k), y(k)=C*x(k), cost
+   sum_{k=1}^{N-1} y(k)'*Q*y(k)+x(N)'*P*x(N)+sum_{k=0}^{N-1} u(k)'*R*u(k),
+   and limits umin<=u(k)<=umax, ymin<=y(k)<=ymax, by the engine in
+   CONDENSE.CPP. [y(1);...;y(N)]=Sbar*U+Tbar*x0.
+
+   C=[] means C=eye(nx), P=[] means P=0, empty limits mean no limits.
+
+   For a time-varying model x(k+1)=A(k)*x(k)+B(k)*u(k), y(k)=C(k)*x(k),
+   A(:,:,k+1), B(:,:,k+1) are the matrices of stage k=0,...,N-1 and
+   C(:,:,k) the output matrix of y(k), k=1,...,N (or a single C).
+
+   The engine is kept between calls: if A, B, C, N, Nu are the same as in
+   the previous call only the matrices that depend on the changed weights
+   (H, F, Y) or limits (W, or G, W, S if the set of finite limits
+   changed) are recomputed. If a time-varying model is the model of the
+   previous call shifted by one step (stage k+1 is now stage k), the
+   prediction window is shifted and only the new last stage is computed
+   (see condense_shift in CONDENSE.H).
+
+   Compile with MEXCOMPILE.M (or mex -O condensemex.cpp condense.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "condense.h"
+#include <cstring>
+#include <vector>
+
+static condense_t *condensemex_c = NULL;
+static std::vector<double> condensemex_model;    /* [A(:);B(:);C(:)] */
+static std::vector<double> condensemex_weights;  /* [Q(:);R(:);P(:)] */
+static std::vector<int> condensemex_dims;
+
+static void condensemex_cleanup(void)
+{
+    if (condensemex_c)
+        condense_free(condensemex_c);
+    condensemex_c = NULL;
+    condensemex_model.clear();
+    condensemex_weights.clear();
+    condensemex_dims.clear();
+}
+
+static std::vector<int> dims(int nx, int nu, int ny, int N, int Nu, int ltv, int hasC)
+{
+    int d[] = {nx, nu, ny, N, Nu, ltv, hasC};
+    return std::vector<int>(d, d + 7);
+}
+
+/* True if the stages 1..N-1 of the model are the stages 2..N of the
+   previous call */
+static bool shifted(const std::vector<double> &model, int nx, int nu, int ny, int N, int hasC)
+{
+    const std::vector<double> &old = condensemex_model;
+    size_t len[] = {(size_t) nx * nx, (size_t) nx * nu, (size_t) (hasC ? ny * nx : 0)};
+    size_t off = 0;
+    for (int i = 0; i < 3; i++) {
+        size_t n = len[i] * (N - 1);
+        if (n > 0 && memcmp(&model[off], &old[off + len[i]], n * sizeof(double)))
+            return false;
+        off += len[i] * N;
+    }
+    return true;
+}
+
+static const double *optvec(int nrhs, const mxArray *prhs[], int i, int len, const char *name)
+{
+    if (nrhs <= i || mxIsEmpty(prhs[i]))
+        return NULL;
+    if ((int) mxGetNumberOfElements(prhs[i]) != len)
+        mexErrMsgIdAndTxt("condensemex:dim", "%s has wrong dimension.", name);
+    return mxGetPr(prhs[i]);
+}
+
+static mxArray *getmat(int which)
+{
+    int r, c;
+    const double *p = condense_get(condensemex_c, which, &r, &c);
+    mxArray *M = mxCreateDoubleMatrix(r, c, mxREAL);
+    if (p && r > 0 && c > 0)
+        memcpy(mxGetPr(M), p, (size_t) r * c * sizeof(double));
+    return M;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const double *A, *B, *C, *Q, *R, *P;
+    int nx, nu, ny, N, Nu, k, ltv, nst;
+    std::vector<double> model, weights, Cst;
+    static const int which[] = {CONDENSE_H, CONDENSE_F, CONDENSE_Y, CONDENSE_G, CONDENSE_W,
+                                CONDENSE_S, CONDENSE_SBAR, CONDENSE_TBAR};
+
+    mexAtExit(condensemex_cleanup);
+
+    if (nrhs < 7)
+        mexErrMsgTxt("At least seven input arguments required.");
+    if (nlhs > 8)
+        mexErrMsgTxt("Too many output arguments.");
+    for (k = 0; k < nrhs; k++)
+        if (!mxIsEmpty(prhs[k]) && (!mxIsDouble(prhs[k]) || mxIsSparse(prhs[k])))
+            mexErrMsgTxt("Input arguments must be full double matrices.");
+
+    N = (int) mxGetScalar(prhs[3]);
+    Nu = (nrhs > 4 && !mxIsEmpty(prhs[4])) ? (int) mxGetScalar(prhs[4]) : N;
+    if (N < 1 || Nu < 1 || Nu > N)
+        mexErrMsgTxt("Horizons must satisfy 1<=Nu<=N.");
+
+    /* A is nx-by-nx (time-invariant) or nx-by-nx-by-N (time-varying) */
+    nx = (int) mxGetM(prhs[0]);
+    ltv = (N > 1 && (int) mxGetNumberOfElements(prhs[0]) == nx * nx * N);
+    nst = ltv ? N : 1;
+    if (nx < 1 || (int) mxGetNumberOfElements(prhs[0]) != nx * nx * nst)
+        mexErrMsgTxt("A must be nx-by-nx or nx-by-nx-by-N.");
+    nu = (int) mxGetN(prhs[1]) / nst;
+    if ((int) mxGetM(prhs[1]) != nx || nu < 1 || (int) mxGetN(prhs[1]) != nu * nst)
+        mexErrMsgTxt("B must have as many rows as A (and N pages if A has).");
+    if (mxIsEmpty(prhs[2]))
+        ny = nx;
+    else {
+        ny = (int) mxGetM(prhs[2]);
+        if ((int) mxGetN(prhs[2]) != nx && (int) mxGetN(prhs[2]) != nx * nst)
+            mexErrMsgTxt("C must have as many columns as A (and 1 or N pages).");
+    }
+
+    A = mxGetPr(prhs[0]);
+    B = mxGetPr(prhs[1]);
+    C = mxIsEmpty(prhs[2]) ? NULL : mxGetPr(prhs[2]);
+    if (C && ltv && (int) mxGetN(prhs[2]) == nx) {
+        /* same C at all stages */
+        for (k = 0; k < N; k++)
+            Cst.insert(Cst.end(), C, C + ny * nx);
+        C = &Cst[0];
+    }
+    Q = optvec(nrhs, prhs, 5, ny * ny, "Q");
+    R = optvec(nrhs, prhs, 6, nu * nu, "R");
+    P = optvec(nrhs, prhs, 7, nx * nx, "P");
+    if (!Q || !R)
+        mexErrMsgTxt("Q and R must be given.");
+
+    model.assign(A, A + nx * nx * nst);
+    model.insert(model.end(), B, B + nx * nu * nst);
+    if (C)
+        model.insert(model.end(), C, C + ny * nx * nst);
+    weights.assign(Q, Q + ny * ny);
+    weights.insert(weights.end(), R, R + nu * nu);
+    if (P)
+        weights.insert(weights.end(), P, P + nx * nx);
+
+    /* Reuse the engine if the model and the horizons are the same. If a
+       time-varying model is the previous one shifted by one step, only
+       the new last stage is computed. */
+    if (!condensemex_c || condensemex_dims != dims(nx, nu, ny, N, Nu, ltv, C != NULL)) {
+        condensemex_cleanup();
+        condensemex_c = ltv ? condense_new_ltv(nx, nu, ny, N, Nu, A, B, C)
+                            : condense_new(nx, nu, ny, N, Nu, A, B, C);
+        if (!condensemex_c)
+            mexErrMsgTxt("Wrong dimensions.");
+        condensemex_dims = dims(nx, nu, ny, N, Nu, ltv, C != NULL);
+    }
+    else if (model != condensemex_model) {
+        if (ltv && weights == condensemex_weights && shifted(model, nx, nu, ny, N, C != NULL))
+            condense_shift(condensemex_c, A + nx * nx * (N - 1), B + nx * nu * (N - 1),
+                           C ? C + ny * nx * (N - 1) : NULL);
+        else
+            condense_set_model(condensemex_c, A, B, C);
+    }
+    condensemex_model = model;
+    if (weights != condensemex_weights) {
+        condense_set_weights(condensemex_c, Q, R, P);
+        condensemex_weights = weights;
+    }
+    condense_set_limits(condensemex_c,
+                        optvec(nrhs, prhs, 8, nu, "umin"), optvec(nrhs, prhs, 9, nu, "umax"),
+                        optvec(nrhs, prhs, 10, ny, "ymin"), optvec(nrhs, prhs, 11, ny, "ymax"));
+
+    for (k = 0; k < (nlhs > 0 ? nlhs : 1); k++)
+        plhs[k] = getmat(which[k]);
+}
@@ -11,6 +11,20 @@ function [r,x,how]=facecheby(A,B,index,lpsolver);
 if nargin<4,
     lpsolver=[]; %use default LP solver in lpsol
 end
+
+if isempty(lpsolver) && exist('chebymex')==3,
+    % Native dense LP solver, see CHEBYBALLS
+    [dummy1,dummy2,r,x]=chebymex(A,B,1,q,[],[],index);
+    x=x(:);
+    if r==Inf,
+        how='unbounded';
+    elseif r==-Inf,
+        how='infeasible';
+    else
+        how='ok';
+    end
+    return
+end
 eqA=A(index,:);
 eqB=B(index);
 A=A([1:index-1,index+1:q],:);
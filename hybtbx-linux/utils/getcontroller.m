@@ -97,7 +97,22 @@ if join && nr>1,
     thmin=mpqpsol.thmin;
     
     fprintf('Trying to join regions ...\n\n');
-    removed=1;
+    if exist('joinmex')==3,
+        % Native join: regions are bucketed by quantized gain, and only
+        % regions in the same bucket are compared (see JOINMEX)
+        nr0=nr;
+        [H,K,i1,i2,keep,rCheb]=joinmex(H,K,i1,i2,[F G],nu,uniteeps,thmin,thmax,rCheb);
+        nr=length(keep);
+        P=P(keep);
+        for i=1:nr,
+            P(i).H=H(i1(i):i2(i),:);
+            P(i).K=K(i1(i):i2(i),:);
+        end
+        fprintf(' %d regions joined\n',nr0-nr);
+        removed=0;
+    else
+        removed=1;
+    end
     while removed % While regions keep to be joined
         removed=0; % Assume no region will be joined
         
@@ -129,15 +144,19 @@ if join && nr>1,
                         % contained in the region. Note that r indicates how 'flat' is P (r<0 if P is empty).
                         
                         [qC,nC]=size(H);
-                        xlam0=zeros(nC+1,1);% Initial guess
-                        ECheb=zeros(qC,1);
-                        for ii=1:qC,
-                            ECheb(ii)=norm(H(ii,:));
+                        if exist('chebymex')==3,
+                            rCheb(i)=chebymex(H,K,1,qC,thmin,thmax);
+                        else
+                            xlam0=zeros(nC+1,1);% Initial guess
+                            ECheb=zeros(qC,1);
+                            for ii=1:qC,
+                                ECheb(ii)=norm(H(ii,:));
+                            end
+                            [xopt,dummy,how]=lpsol(-[zeros(nC,1);1],[H,ECheb;eye(nC),ones(nC,1);...
+                                -eye(nC),ones(nC,1)],[K;thmax;-thmin],[],[],xlam0);
+                            
+                            rCheb(i)=xopt(nC+1);
                         end
-                        [xopt,dummy,how]=lpsol(-[zeros(nC,1);1],[H,ECheb;eye(nC),ones(nC,1);...
-                            -eye(nC),ones(nC,1)],[K;thmax;-thmin],[],[],xlam0);
-                        
-                        rCheb(i)=xopt(nC+1);
                         %aux=xopt(1:nC);
                         %cCheb(i,:)=aux(:)';
                         
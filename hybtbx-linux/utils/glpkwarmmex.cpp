@@ -0,0 +1,383 @@
+/* GLPK with a persistent problem object - MEX interface
+
+   [xmin,fmin,status]=glpkwarmmex(sense,c,A,b,ctype,lb,ub,vartype,param,x0)
+
+   Solves the LP/MILP
+
+       min (sense=1) or max (sense=-1)  c'*x
+       s.t. A(i,:)*x <= b(i) (ctype(i)='U'), >= b(i) ('L'), = b(i) ('S'),
+            free ('F'),  lb <= x <= ub,  x(i) integer if vartype(i)='I'
+
+   by the GLPK library, with the same arguments and status codes as
+   GLPKMEX (A may be sparse, lb=[] means 0, ub=[] means Inf). param is a
+   structure with optional fields msglev (0-3, default 1) and tmlim (time
+   limit in seconds, -1 = none).
+
+   The GLPK problem object is kept between calls and rebuilt only when
+   sense, c or A change; the entries of b, ctype, lb, ub and vartype that
+   changed are set in place. When only b, lb and ub change
+   (e.g. the MILP of a hybrid MPC controller at consecutive sampling
+   steps), the new bounds are set in place and the LP relaxation is
+   solved by the dual simplex method starting from the optimal basis of
+   the previous call, and the branch and bound starts from that LP
+   solution. The problem is freed by "clear glpkwarmmex".
+
+   If x0 is not empty, it is passed to the branch and bound as a
+   candidate incumbent (e.g. the previous optimal solution shifted by
+   one step), provided it satisfies all constraints (tolerance 1e-7).
+
+   status = 171 integer optimal, 172 integer feasible (time limit
+            reached), 173 no integer feasible solution, 208 time limit
+            reached without an integer solution; for LPs 180 optimal,
+            183 infeasible, 184 unbounded (see GLPKMEX)
+
+   Requires GLPK 4.49 or later. Compile with MEXCOMPILE({'glpkwarmmex'})
+   (or mex -O glpkwarmmex.cpp -lglpk)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include <glpk.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+static glp_prob *glpkwarmmex_lp = NULL;
+static int glpkwarmmex_m = -1, glpkwarmmex_n = -1, glpkwarmmex_sense = 0;
+static std::vector<double> glpkwarmmex_c, glpkwarmmex_A;  /* data of glpkwarmmex_lp */
+static std::vector<mwIndex> glpkwarmmex_jc, glpkwarmmex_ir;
+static std::vector<char> glpkwarmmex_ctype, glpkwarmmex_vartype;
+static std::vector<double> glpkwarmmex_b, glpkwarmmex_lb, glpkwarmmex_ub;
+static std::vector<double> glpkwarmmex_x0;                /* incumbent, 1-based */
+static bool glpkwarmmex_hint = false;
+
+static void glpkwarmmex_cleanup(void)
+{
+    if (glpkwarmmex_lp)
+        glp_delete_prob(glpkwarmmex_lp);
+    glpkwarmmex_lp = NULL;
+    glpkwarmmex_m = glpkwarmmex_n = -1;
+    glpkwarmmex_c.clear();
+    glpkwarmmex_A.clear();
+    glpkwarmmex_jc.clear();
+    glpkwarmmex_ir.clear();
+}
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+static void setrow(int i, char type, double b)
+{
+    switch (type) {
+    case 'U':
+        if (mxIsInf(b) && b > 0)
+            glp_set_row_bnds(glpkwarmmex_lp, i + 1, GLP_FR, 0.0, 0.0);
+        else
+            glp_set_row_bnds(glpkwarmmex_lp, i + 1, GLP_UP, 0.0, b);
+        break;
+    case 'L':
+        if (mxIsInf(b) && b < 0)
+            glp_set_row_bnds(glpkwarmmex_lp, i + 1, GLP_FR, 0.0, 0.0);
+        else
+            glp_set_row_bnds(glpkwarmmex_lp, i + 1, GLP_LO, b, 0.0);
+        break;
+    case 'S':
+        glp_set_row_bnds(glpkwarmmex_lp, i + 1, GLP_FX, b, b);
+        break;
+    default:
+        glp_set_row_bnds(glpkwarmmex_lp, i + 1, GLP_FR, 0.0, 0.0);
+    }
+}
+
+static void setcol(int j, double lb, double ub)
+{
+    int type;
+    if (mxIsInf(lb) && mxIsInf(ub))
+        type = GLP_FR;
+    else if (mxIsInf(ub))
+        type = GLP_LO;
+    else if (mxIsInf(lb))
+        type = GLP_UP;
+    else if (lb == ub)
+        type = GLP_FX;
+    else
+        type = GLP_DB;
+    glp_set_col_bnds(glpkwarmmex_lp, j + 1, type, lb, ub);
+}
+
+/* True if the sparse or full matrix a has the same data as the cache */
+static bool sameA(const mxArray *a, int m, int n)
+{
+    size_t nz;
+    if (mxIsSparse(a)) {
+        nz = mxGetJc(a)[n];
+        return glpkwarmmex_jc.size() == (size_t) n + 1 && glpkwarmmex_A.size() == nz &&
+               std::memcmp(glpkwarmmex_jc.data(), mxGetJc(a), (n + 1) * sizeof(mwIndex)) == 0 &&
+               std::memcmp(glpkwarmmex_ir.data(), mxGetIr(a), nz * sizeof(mwIndex)) == 0 &&
+               std::memcmp(glpkwarmmex_A.data(), mxGetPr(a), nz * sizeof(double)) == 0;
+    }
+    nz = (size_t) m * n;
+    return glpkwarmmex_jc.empty() && glpkwarmmex_A.size() == nz &&
+           std::memcmp(glpkwarmmex_A.data(), mxGetPr(a), nz * sizeof(double)) == 0;
+}
+
+static void build(int sense, int m, int n, const double *c, const mxArray *a)
+{
+    std::vector<int> ia(1), ja(1);
+    std::vector<double> ar(1);
+    const double *pr = mxGetPr(a);
+    int i, j;
+    mwIndex k;
+
+    glpkwarmmex_cleanup();
+    glpkwarmmex_lp = glp_create_prob();
+    glp_set_obj_dir(glpkwarmmex_lp, sense == -1 ? GLP_MAX : GLP_MIN);
+    if (m > 0)
+        glp_add_rows(glpkwarmmex_lp, m);
+    if (n > 0)
+        glp_add_cols(glpkwarmmex_lp, n);
+    for (j = 0; j < n; j++)
+        glp_set_obj_coef(glpkwarmmex_lp, j + 1, c[j]);
+
+    if (mxIsSparse(a)) {
+        const mwIndex *jc = mxGetJc(a), *ir = mxGetIr(a);
+        for (j = 0; j < n; j++)
+            for (k = jc[j]; k < jc[j + 1]; k++)
+                if (pr[k] != 0.0) {
+                    ia.push_back((int) ir[k] + 1);
+                    ja.push_back(j + 1);
+                    ar.push_back(pr[k]);
+                }
+        glpkwarmmex_jc.assign(jc, jc + n + 1);
+        glpkwarmmex_ir.assign(ir, ir + jc[n]);
+        glpkwarmmex_A.assign(pr, pr + jc[n]);
+    } else {
+        for (j = 0; j < n; j++)
+            for (i = 0; i < m; i++)
+                if (pr[i + (size_t) m * j] != 0.0) {
+                    ia.push_back(i + 1);
+                    ja.push_back(j + 1);
+                    ar.push_back(pr[i + (size_t) m * j]);
+                }
+        glpkwarmmex_A.assign(pr, pr + (size_t) m * n);
+    }
+    glp_load_matrix(glpkwarmmex_lp, (int) ar.size() - 1, ia.data(), ja.data(), ar.data());
+
+    glpkwarmmex_m = m;
+    glpkwarmmex_n = n;
+    glpkwarmmex_sense = sense;
+    glpkwarmmex_c.assign(c, c + n);
+    /* Bounds are set by the caller */
+    glpkwarmmex_ctype.assign(m, 0);
+    glpkwarmmex_vartype.assign(n, 0);
+    glpkwarmmex_b.assign(m, mxGetNaN());
+    glpkwarmmex_lb.assign(n, mxGetNaN());
+    glpkwarmmex_ub.assign(n, mxGetNaN());
+}
+
+/* True if x satisfies the constraints of the cached problem */
+static bool feasible(const double *x, double tol)
+{
+    int m = glpkwarmmex_m, n = glpkwarmmex_n, i, j;
+    std::vector<double> ax(m, 0.0);
+    mwIndex k;
+    char t;
+
+    for (j = 0; j < n; j++) {
+        if (!(x[j] >= glpkwarmmex_lb[j] - tol && x[j] <= glpkwarmmex_ub[j] + tol))
+            return false;
+        if (glpkwarmmex_vartype[j] == 'I' && std::fabs(x[j] - std::floor(x[j] + 0.5)) > tol)
+            return false;
+        if (glpkwarmmex_jc.empty())
+            for (i = 0; i < m; i++)
+                ax[i] += glpkwarmmex_A[i + (size_t) m * j] * x[j];
+        else
+            for (k = glpkwarmmex_jc[j]; k < glpkwarmmex_jc[j + 1]; k++)
+                ax[glpkwarmmex_ir[k]] += glpkwarmmex_A[k] * x[j];
+    }
+    for (i = 0; i < m; i++) {
+        t = glpkwarmmex_ctype[i];
+        if (((t == 'U' || t == 'S') && ax[i] > glpkwarmmex_b[i] + tol * (1.0 + std::fabs(glpkwarmmex_b[i]))) ||
+            ((t == 'L' || t == 'S') && ax[i] < glpkwarmmex_b[i] - tol * (1.0 + std::fabs(glpkwarmmex_b[i]))))
+            return false;
+    }
+    return true;
+}
+
+static void heuristic(glp_tree *T, void *info)
+{
+    (void) info;
+    if (glp_ios_reason(T) == GLP_IHEUR && glpkwarmmex_hint) {
+        glpkwarmmex_hint = false;
+        glp_ios_heur_sol(T, glpkwarmmex_x0.data());  /* rejected if not feasible */
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const mxArray *par = NULL;
+    const double *c, *b, *lb = NULL, *ub = NULL, *x0 = NULL;
+    std::vector<char> ctype, vartype;
+    double *x, fmin = mxGetNaN(), tmlim, lbj, ubj;
+    int sense, m, n, i, j, msglev, ret, lpstat, status;
+    bool mip = false;
+    glp_smcp smcp;
+    glp_iocp iocp;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    mexAtExit(glpkwarmmex_cleanup);
+
+    if (nrhs < 5)
+        mexErrMsgTxt("At least five input arguments required.");
+
+    sense = (int) mxGetScalar(prhs[0]);
+    n = (int) mxGetNumberOfElements(prhs[1]);
+    m = (int) mxGetM(prhs[2]);
+    if (!mxIsDouble(prhs[1]) || !mxIsDouble(prhs[2]) || (int) mxGetN(prhs[2]) != n)
+        mexErrMsgIdAndTxt("glpkwarmmex:dim", "A must be a %d-by-%d matrix.", m, n);
+    if (!mxIsDouble(prhs[3]) || (int) mxGetNumberOfElements(prhs[3]) != m)
+        mexErrMsgIdAndTxt("glpkwarmmex:dim", "b must have %d elements.", m);
+    if (!mxIsChar(prhs[4]) || (int) mxGetNumberOfElements(prhs[4]) != m)
+        mexErrMsgIdAndTxt("glpkwarmmex:dim", "ctype must be a string of %d characters.", m);
+    c = mxGetPr(prhs[1]);
+    b = mxGetPr(prhs[3]);
+    ctype.resize(m + 1);
+    mxGetString(prhs[4], ctype.data(), m + 1);
+    for (i = 0; i < m; i++)
+        if (!std::strchr("FULS", ctype[i]))
+            mexErrMsgIdAndTxt("glpkwarmmex:ctype", "ctype(%d)='%c' is not supported.", i + 1, ctype[i]);
+    if (nrhs > 5 && !mxIsEmpty(prhs[5])) {
+        if ((int) mxGetNumberOfElements(prhs[5]) != n)
+            mexErrMsgIdAndTxt("glpkwarmmex:dim", "lb must have %d elements.", n);
+        lb = mxGetPr(prhs[5]);
+    }
+    if (nrhs > 6 && !mxIsEmpty(prhs[6])) {
+        if ((int) mxGetNumberOfElements(prhs[6]) != n)
+            mexErrMsgIdAndTxt("glpkwarmmex:dim", "ub must have %d elements.", n);
+        ub = mxGetPr(prhs[6]);
+    }
+    vartype.assign(n + 1, 'C');
+    if (nrhs > 7 && !mxIsEmpty(prhs[7])) {
+        if (!mxIsChar(prhs[7]) || (int) mxGetNumberOfElements(prhs[7]) != n)
+            mexErrMsgIdAndTxt("glpkwarmmex:dim", "vartype must be a string of %d characters.", n);
+        mxGetString(prhs[7], vartype.data(), n + 1);
+    }
+    if (nrhs > 8)
+        par = prhs[8];
+    if (nrhs > 9 && !mxIsEmpty(prhs[9])) {
+        if ((int) mxGetNumberOfElements(prhs[9]) != n)
+            mexErrMsgIdAndTxt("glpkwarmmex:dim", "x0 must have %d elements.", n);
+        x0 = mxGetPr(prhs[9]);
+    }
+    msglev = (int) getopt(par, "msglev", 1);
+    tmlim = getopt(par, "tmlim", -1);
+
+    /* Rebuild the problem if its structure changed, otherwise update the bounds */
+    if (!glpkwarmmex_lp || m != glpkwarmmex_m || n != glpkwarmmex_n || sense != glpkwarmmex_sense ||
+        std::memcmp(glpkwarmmex_c.data(), c, n * sizeof(double)) != 0 || !sameA(prhs[2], m, n))
+        build(sense, m, n, c, prhs[2]);
+    for (i = 0; i < m; i++)
+        if (ctype[i] != glpkwarmmex_ctype[i] || !(b[i] == glpkwarmmex_b[i])) {
+            setrow(i, ctype[i], b[i]);
+            glpkwarmmex_ctype[i] = ctype[i];
+            glpkwarmmex_b[i] = b[i];
+        }
+    for (j = 0; j < n; j++) {
+        lbj = lb ? lb[j] : 0.0;
+        ubj = ub ? ub[j] : mxGetInf();
+        if (!(lbj == glpkwarmmex_lb[j]) || !(ubj == glpkwarmmex_ub[j])) {
+            setcol(j, lbj, ubj);
+            glpkwarmmex_lb[j] = lbj;
+            glpkwarmmex_ub[j] = ubj;
+        }
+        if (vartype[j] != glpkwarmmex_vartype[j]) {
+            glp_set_col_kind(glpkwarmmex_lp, j + 1, vartype[j] == 'I' ? GLP_IV : GLP_CV);
+            glpkwarmmex_vartype[j] = vartype[j];
+        }
+        mip = mip || vartype[j] == 'I';
+    }
+
+    /* LP relaxation, dual simplex from the basis of the previous call */
+    glp_init_smcp(&smcp);
+    smcp.msg_lev = msglev <= 0 ? GLP_MSG_OFF : msglev == 1 ? GLP_MSG_ERR : msglev == 2 ? GLP_MSG_ON : GLP_MSG_ALL;
+    smcp.meth = GLP_DUALP;
+    if (tmlim >= 0)
+        smcp.tm_lim = (int) (tmlim * 1000.0);
+    ret = glp_simplex(glpkwarmmex_lp, &smcp);
+    if (ret == GLP_EBADB || ret == GLP_ESING || ret == GLP_ECOND) {
+        glp_std_basis(glpkwarmmex_lp);
+        ret = glp_simplex(glpkwarmmex_lp, &smcp);
+    }
+    lpstat = glp_get_status(glpkwarmmex_lp);
+
+    plhs[0] = mxCreateDoubleMatrix(n, 1, mxREAL);
+    x = mxGetPr(plhs[0]);
+    for (j = 0; j < n; j++)
+        x[j] = mxGetNaN();
+
+    if (ret == GLP_ETMLIM)
+        status = 208;
+    else if (lpstat == GLP_NOFEAS)
+        status = mip ? 173 : 183;
+    else if (lpstat == GLP_UNBND)
+        status = 184;
+    else if (lpstat != GLP_OPT)
+        status = mip ? 170 : 185;
+    else if (!mip) {
+        status = 180;
+        fmin = glp_get_obj_val(glpkwarmmex_lp);
+        for (j = 0; j < n; j++)
+            x[j] = glp_get_col_prim(glpkwarmmex_lp, j + 1);
+    } else {
+        /* Branch and bound from the LP solution above */
+        glp_init_iocp(&iocp);
+        iocp.msg_lev = smcp.msg_lev;
+        iocp.presolve = GLP_OFF;
+        if (tmlim >= 0)
+            iocp.tm_lim = (int) std::max(0.0, tmlim * 1000.0 - std::chrono::duration<double, std::milli>(
+                                                                  std::chrono::steady_clock::now() - t0).count());
+        glpkwarmmex_hint = false;
+        if (x0 && feasible(x0, 1e-7)) {
+            glpkwarmmex_x0.assign(1, 0.0);
+            glpkwarmmex_x0.insert(glpkwarmmex_x0.end(), x0, x0 + n);
+            glpkwarmmex_hint = true;
+            iocp.cb_func = heuristic;
+        }
+        ret = glp_intopt(glpkwarmmex_lp, &iocp);
+        glpkwarmmex_hint = false;
+        switch (glp_mip_status(glpkwarmmex_lp)) {
+        case GLP_OPT:
+            status = 171;
+            break;
+        case GLP_FEAS:
+            status = 172;
+            break;
+        case GLP_NOFEAS:
+            status = 173;
+            break;
+        default:
+            status = ret == GLP_ETMLIM ? 208 : 170;
+        }
+        if (status == 171 || status == 172) {
+            fmin = glp_mip_obj_val(glpkwarmmex_lp);
+            for (j = 0; j < n; j++)
+                x[j] = glp_mip_col_val(glpkwarmmex_lp, j + 1);
+        }
+    }
+
+    if (nlhs > 1)
+        plhs[1] = mxCreateDoubleScalar(fmin);
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(status);
+}
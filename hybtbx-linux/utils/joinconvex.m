@@ -10,6 +10,9 @@ function [sol1,lpsolved,colors]=joinconvex(sol,type,varindex,uniteeps,lpsolver)
 %           comparison when type = 'optimizer'. The other variables will be
 %           eliminated from the final solution
 %
+% If the MEX function JOINMEX is compiled, regions are joined natively and
+% lpsolved is not counted.
+%
 % See also EXPCON/PRIVATE/GETCONTROLLER
 
 % (C) 2003 by A. Bemporad
@@ -70,6 +73,31 @@ end
 
 fprintf('Trying to join regions ...\n\n');
 removed=1;
+if exist('joinmex')==3,
+   % Native join: regions are bucketed by quantized function, and only
+   % regions in the same bucket are compared (see JOINMEX)
+   if cost,
+      FG=[f g];
+      nf=1;
+   else
+      rows=kron(nvar*(0:nr-1),ones(1,nu))+kron(ones(1,nr),varindex(:)');
+      FG=[F0(rows,:) G0(rows,:)];
+      nf=nu;
+   end
+   [H,K,i1,i2,keep,rCheb,group]=joinmex(H,K,i1,i2,FG,nf,uniteeps,[],[],rCheb);
+   fprintf(' %d regions joined\n',nr-length(keep));
+   nr=length(keep);
+   if cost,
+      f=f(keep,:);
+      g=g(keep,:);
+   else
+      rows=kron(nvar*(keep(:)'-1),ones(1,nvar))+kron(ones(1,nr),1:nvar);
+      F0=F0(rows,:);
+      G0=G0(rows,:);
+   end
+   colors=colors(group,:); % same color for regions where the function is the same
+   removed=0;
+end
 while removed % While regions keep to be joined
    removed=0; % Assume no region will be joined
    
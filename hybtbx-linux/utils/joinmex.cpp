@@ -0,0 +1,329 @@
+/* Join regions of a polyhedral partition with the same gain - MEX interface
+
+   [Hj,Kj,i1j,i2j,keep,rCheb,group]=joinmex(H,K,i1,i2,FG,nu,uniteeps,thmin,thmax,rCheb,nthreads)
+
+   Region #i is {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, the gain of
+   region #i is FG(nu*(i-1)+1:nu*i,:) = [F G]. Regions whose gains differ
+   by at most uniteeps (infinity norm) are joined whenever their union is
+   convex, as in GETCONTROLLER.M:
+
+   - two regions are joined as by POLYUNION(Hi,Ki,Hj,Kj,1,uniteeps,1)
+     (see POLYDENSE.H), the joined region takes the place and the gain of
+     the region with the smaller index;
+   - joins are repeated until no pair of regions can be joined.
+
+   Instead of comparing all pairs of regions, the gain entries with the
+   largest spread (at most 4 of them) are quantized on a grid of size
+   uniteeps and hashed, and each region is only compared with the regions
+   in the same or in one of the 3^4 neighboring cells. Two gains within
+   uniteeps differ by at most uniteeps in every entry, so they always fall
+   in neighboring cells and no pair joined by the pairwise search is
+   missed. The regions are so split into groups that share no close gain,
+   and each group is processed on its own by one of the nthreads worker
+   threads (default: all cores).
+
+   Hj,Kj,i1j,i2j is the joined partition, keep the indices of the original
+   regions whose place (and gain) the joined regions take, rCheb the
+   Chebychev radii (rCheb(keep) for the regions that were not joined,
+   recomputed in the box thmin<=th<=thmax for the joined ones), group the
+   index of the group of close gains each joined region belongs to.
+
+   Compile with MEXCOMPILE.M (or mex -O joinmex.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "lpdense.h"
+#include "polydense.h"
+#include "mexthreads.h"
+#include "mexpart.h"
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <stdint.h>
+
+/* Input Arguments */
+
+#define H_IN        prhs[0]
+#define K_IN        prhs[1]
+#define I1_IN       prhs[2]
+#define I2_IN       prhs[3]
+#define FG_IN       prhs[4]
+#define NU_IN       prhs[5]
+#define UNITEEPS_IN prhs[6]
+#define THMIN_IN    prhs[7]
+#define THMAX_IN    prhs[8]
+#define RCHEB_IN    prhs[9]
+#define NTHREADS_IN prhs[10]
+
+/* Output Arguments */
+
+#define H_OUT      plhs[0]
+#define K_OUT      plhs[1]
+#define I1_OUT     plhs[2]
+#define I2_OUT     plhs[3]
+#define KEEP_OUT   plhs[4]
+#define RCHEB_OUT  plhs[5]
+#define GROUP_OUT  plhs[6]
+
+#define JOIN_HASHTOL 1e-9  /* cell size margin, relative to uniteeps */
+#define JOIN_HASHDIM 4     /* max number of hashed gain entries */
+
+struct Gains {
+    int nr, nu, nc;      /* nc = npar+1 columns */
+    const double *FG;    /* (nu*nr)-by-nc, column-major */
+
+    double at(int i, int r, int c) const { return FG[nu * i + r + (size_t) c * nu * nr]; }
+
+    /* norm(FGi-FGj,'inf') as computed by MATLAB */
+    double dist(int i, int j) const
+    {
+        double d = 0, s;
+        int r, c;
+        if (nu == 1) {
+            for (c = 0; c < nc; c++)
+                d = std::max(d, std::fabs(at(i, 0, c) - at(j, 0, c)));
+            return d;
+        }
+        for (r = 0; r < nu; r++) {
+            s = 0;
+            for (c = 0; c < nc; c++)
+                s += std::fabs(at(i, r, c) - at(j, r, c));
+            d = std::max(d, s);
+        }
+        return d;
+    }
+};
+
+struct Joined {
+    int keep;             /* original index of the region */
+    int group;
+    Polytope P;
+    double rCheb;
+    bool changed;
+};
+
+static uint64_t hash_cells(const std::vector<int64_t> &cell)
+{
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t k = 0; k < cell.size(); k++) {
+        h ^= (uint64_t) cell[k] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static int find_root(std::vector<int> &parent, int i)
+{
+    while (parent[i] != i)
+        i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+/* Join loop of GETCONTROLLER.M on the regions of one group */
+static void join_group(DenseLP &lp, const Gains &G, double uniteeps,
+                       const double *thmin, const double *thmax, std::vector<Joined> &R)
+{
+    bool removed = true;
+    size_t i, j;
+
+    while (removed) {
+        removed = false;
+        for (i = 0; i < R.size(); i++) {
+            j = i + 1;
+            while (j < R.size()) {
+                Polytope U;
+                if (G.dist(R[i].keep, R[j].keep) <= uniteeps &&
+                    poly_union(lp, R[i].P, R[j].P, uniteeps, U)) {
+                    R[i].P = U;
+                    R[i].changed = true;
+                    R.erase(R.begin() + j);
+                    removed = true;
+                }
+                else
+                    j++;
+            }
+        }
+    }
+    for (i = 0; i < R.size(); i++)
+        if (R[i].changed) {
+            std::vector<double> x(R[i].P.n, 0.0);
+            poly_chebyshev(lp, R[i].P, thmin, thmax, &x[0], &R[i].rCheb);
+        }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    Partition P;
+    Gains G;
+    double uniteeps, q, *p, *p2;
+    const double *rCheb0 = NULL;
+    int i, j, k, nthreads = 0, d;
+
+    /* Check for proper number of arguments */
+
+    if (nrhs < 7) {
+        mexErrMsgTxt("At least seven input arguments required (H,K,i1,i2,FG,nu,uniteeps).");
+    }
+    else if (nlhs > 7) {
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    mex_get_partition(P, H_IN, K_IN, I1_IN, I2_IN);
+    if (nrhs >= 9)
+        mex_get_box(P, THMIN_IN, THMAX_IN);
+    G.nr = P.nr;
+    G.nu = (int) mxGetScalar(NU_IN);
+    G.nc = P.npar + 1;
+    G.FG = mxGetPr(FG_IN);
+    if (G.nu < 1 || (int) mxGetM(FG_IN) != G.nu * P.nr || (int) mxGetN(FG_IN) != G.nc)
+        mexErrMsgTxt("FG must have nu*nr rows and npar+1 columns.");
+    uniteeps = mxGetScalar(UNITEEPS_IN);
+    if (uniteeps <= 0)
+        mexErrMsgTxt("uniteeps must be positive.");
+    if (nrhs >= 10 && !mxIsEmpty(RCHEB_IN)) {
+        if ((int) mxGetNumberOfElements(RCHEB_IN) != P.nr)
+            mexErrMsgTxt("rCheb must have one entry per region.");
+        rCheb0 = mxGetPr(RCHEB_IN);
+    }
+    if (nrhs >= 11 && !mxIsEmpty(NTHREADS_IN))
+        nthreads = (int) mxGetScalar(NTHREADS_IN);
+    nthreads = mex_num_threads(nthreads);
+
+    /* Hash the quantized gain entries with the largest spread */
+    d = G.nu * G.nc;
+    q = uniteeps * (1.0 + JOIN_HASHTOL);
+    std::vector<std::pair<double, int> > spread(d);
+    for (k = 0; k < d; k++) {
+        double lo = 0, hi = 0;
+        for (i = 0; i < P.nr; i++) {
+            double v = G.at(i, k % G.nu, k / G.nu);
+            lo = (i == 0) ? v : std::min(lo, v);
+            hi = (i == 0) ? v : std::max(hi, v);
+        }
+        spread[k] = std::make_pair(-(hi - lo), k);
+    }
+    std::sort(spread.begin(), spread.end());
+    int dh = std::min(d, JOIN_HASHDIM), nprobe = 1;
+    std::vector<int> hk(dh);
+    for (k = 0; k < dh; k++) {
+        hk[k] = spread[k].second;
+        nprobe *= 3;
+    }
+    std::unordered_map<uint64_t, std::vector<int> > table;
+    std::vector<std::vector<int64_t> > cells(P.nr, std::vector<int64_t>(dh));
+    for (i = 0; i < P.nr; i++) {
+        for (k = 0; k < dh; k++)
+            cells[i][k] = (int64_t) std::floor(G.at(i, hk[k] % G.nu, hk[k] / G.nu) / q);
+        table[hash_cells(cells[i])].push_back(i);
+    }
+
+    /* Candidate pairs, probing the 3^dh cells around each region */
+    std::vector<std::vector<int> > close(P.nr);
+    mex_parallel_for(P.nr, nthreads, 64, [&](int i, int) {
+        std::vector<int64_t> probe(dh);
+        for (int code = 0; code < nprobe; code++) {
+            int c = code;
+            for (int l = 0; l < dh; l++, c /= 3)
+                probe[l] = cells[i][l] + (c % 3) - 1;
+            std::unordered_map<uint64_t, std::vector<int> >::const_iterator it =
+                table.find(hash_cells(probe));
+            if (it == table.end())
+                continue;
+            for (size_t m = 0; m < it->second.size(); m++) {
+                int j = it->second[m];
+                if (j != i && G.dist(i, j) <= uniteeps &&
+                    std::find(close[i].begin(), close[i].end(), j) == close[i].end())
+                    close[i].push_back(j);
+            }
+        }
+    });
+
+    /* Groups = connected components of the candidate pairs */
+    std::vector<int> parent(P.nr);
+    for (i = 0; i < P.nr; i++)
+        parent[i] = i;
+    for (i = 0; i < P.nr; i++)
+        for (k = 0; k < (int) close[i].size(); k++) {
+            int a = find_root(parent, i), b = find_root(parent, close[i][k]);
+            if (a != b)
+                parent[std::max(a, b)] = std::min(a, b);
+        }
+    std::vector<std::vector<int> > groups;
+    std::vector<int> gid(P.nr, -1);
+    for (i = 0; i < P.nr; i++) {
+        int r = find_root(parent, i);
+        if (gid[r] < 0) {
+            gid[r] = (int) groups.size();
+            groups.push_back(std::vector<int>());
+        }
+        groups[gid[r]].push_back(i);   /* ascending region index */
+    }
+    /* largest groups first, for load balancing */
+    std::vector<int> order(groups.size());
+    for (k = 0; k < (int) groups.size(); k++)
+        order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return groups[a].size() > groups[b].size();
+    });
+
+    /* Join inside each group */
+    std::vector<std::vector<Joined> > result(groups.size());
+    std::vector<DenseLP> lps(nthreads);
+    mex_parallel_for((int) groups.size(), nthreads, 1, [&](int g, int t) {
+        const std::vector<int> &members = groups[order[g]];
+        std::vector<Joined> &R = result[order[g]];
+        R.resize(members.size());
+        for (size_t m = 0; m < members.size(); m++) {
+            int i = members[m];
+            R[m].keep = i;
+            R[m].group = order[g];
+            R[m].P = Polytope(P.npar);
+            R[m].P.add_rows_colmajor(P.H, P.K, P.nh, P.i1[i], P.i2[i]);
+            R[m].rCheb = rCheb0 ? rCheb0[i] : 0.0;
+            R[m].changed = false;
+        }
+        if (R.size() > 1)
+            join_group(lps[t], G, uniteeps, P.thmin, P.thmax, R);
+    });
+
+    /* Collect the regions in the original order */
+    std::vector<const Joined *> all;
+    for (k = 0; k < (int) result.size(); k++)
+        for (size_t m = 0; m < result[k].size(); m++)
+            all.push_back(&result[k][m]);
+    std::sort(all.begin(), all.end(), [](const Joined *a, const Joined *b) {
+        return a->keep < b->keep;
+    });
+    int nr = (int) all.size(), nh = 0;
+    for (k = 0; k < nr; k++)
+        nh += all[k]->P.rows();
+
+    H_OUT = mxCreateDoubleMatrix(nh, P.npar, mxREAL);
+    K_OUT = mxCreateDoubleMatrix(nh, 1, mxREAL);
+    I1_OUT = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    I2_OUT = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    KEEP_OUT = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    RCHEB_OUT = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    if (nlhs > 6)
+        GROUP_OUT = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    p = mxGetPr(H_OUT);
+    p2 = mxGetPr(K_OUT);
+    int row = 0;
+    for (k = 0; k < nr; k++) {
+        const Polytope &Pk = all[k]->P;
+        mxGetPr(I1_OUT)[k] = row + 1;
+        for (i = 0; i < Pk.rows(); i++, row++) {
+            for (j = 0; j < P.npar; j++)
+                p[row + (size_t) j * nh] = Pk.row(i)[j];
+            p2[row] = Pk.b[i];
+        }
+        mxGetPr(I2_OUT)[k] = row;
+        mxGetPr(KEEP_OUT)[k] = all[k]->keep + 1;
+        mxGetPr(RCHEB_OUT)[k] = all[k]->rCheb;
+        if (nlhs > 6)
+            mxGetPr(GROUP_OUT)[k] = all[k]->group + 1;
+    }
+}
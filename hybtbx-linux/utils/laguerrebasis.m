@@ -0,0 +1,36 @@
+function T=laguerrebasis(Nu,a,nb)
+% LAGUERREBASIS Discrete-time Laguerre functions as input basis
+%
+% T=LAGUERREBASIS(Nu,a,nb) returns the Nu-by-nb matrix whose column j
+% contains the j-th discrete Laguerre function l_j(k), k=0,...,Nu-1, with
+% pole a (0<=a<1). The functions are orthonormal over an infinite horizon
+% and decay as a^k: a=0 gives the first nb unit pulses (nb free moves), a
+% closer to 1 gives slower functions, so that a long control horizon Nu is
+% described by few coefficients.
+%
+% Use T as INTERVAL.basis in LINCON: the sequence of each input (or input
+% increment, for tracking controllers) is T*v, with nb free coefficients v.
+%
+% See also LINCON.
+%
+% Reference: L. Wang, "Discrete model predictive controller design using
+% Laguerre functions", J. Process Control 14(2), 2004.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if a<0 || a>=1,
+    error('The pole a must be in [0,1)');
+end
+beta=1-a^2;
+Al=a*eye(nb);
+for i=2:nb,
+    for j=1:i-1,
+        Al(i,j)=(-a)^(i-j-1)*beta;
+    end
+end
+l=sqrt(beta)*(-a).^(0:nb-1)';
+T=zeros(Nu,nb);
+for k=1:Nu,
+    T(k,:)=l';
+    l=Al*l;
+end
@@ -1,12 +1,29 @@
-function [w,z,how] = lcpsol(M,q,solver)
-%LCPSOL Solve Linear Complementary Problems via Quadratic Programming 
-%    [w,z,how]=LCP_QP(M,q,solver) solves the LCP problem:
+function [w,z,how,basis] = lcpsol(M,q,solver,basis0)
+%LCPSOL Solve Linear Complementary Problems
+%    [w,z,how]=LCPSOL(M,q) solves the LCP problem:
 % 
 %                      w - M*z  = q                                                 
 %                      w(i)z(i) = 0                                                 
 %                      w >= 0, z >= 0                                               
 %
-%    via the QP problem
+%    by Lemke's complementary pivoting method (MEX function LEMKEMEX, see
+%    LEMKE.CPP and MEXCOMPILE.M). M need not be symmetric: a solution is
+%    found for P-matrices and, if one exists, for positive semidefinite M.
+%
+%    how = 'ok'           solution found
+%          'infeasible'   secondary ray (for M positive semidefinite, the
+%                         LCP has no solution)
+%          'unreliable'   maximum number of pivots reached
+%
+%    [w,z,how,basis]=LCPSOL(M,q,[],basis0) starts from the complementary
+%    basis where z(i) is basic for basis0(i)~=0 (warm start) and returns
+%    the basis of the solution. Without basis0, the basis of the previous
+%    call is used if M did not change. If q is a matrix, the LCPs with
+%    right-hand sides q(:,k) are solved in sequence (each warm started
+%    from the previous one, in parallel blocks), w,z and basis have as
+%    many columns as q and how is a cell array.
+%
+%    [w,z,how]=LCPSOL(M,q,solver) solves instead the QP problem
 %
 %                      min  z'(Mz+q)
 %                      s.t. z>=0
@@ -17,9 +34,10 @@ function [w,z,how] = lcpsol(M,q,solver)
 %      z>=0
 %      w>=0
 %
-%    QPSOL.M is used to solve QP.
+%    QPSOL.M is used to solve QP. This is also done if LEMKEMEX is not
+%    compiled.
 %
-%    The algorithm requires that M=M'>0 to work properly.
+%    The QP algorithm requires that M=M'>0 to work properly.
 %
 % Type "help qptype" for a list of available solvers
 
@@ -30,15 +48,36 @@ if m~=n,
     error('M must be square');
 end
 
-q=q(:);
-if length(q)~=n,
+if size(q,1)~=n,
+    q=q(:);
+end
+if size(q,1)~=n,
     error('M and q must have the same number of rows');
 end
 
 if nargin<3,
    solver=[];
 end
+if nargin<4,
+   basis0=[];
+end
 
-[z,w,how]=qpsol(M,q,-eye(n),zeros(n,1),[],[],zeros(n,1),solver);
+K=size(q,2);
+if isempty(solver) && exist('lemkemex')==3,
+    [w,z,status,iter,basis]=lemkemex(full(M),full(q),double(basis0(:)));
+    hows={'ok','infeasible','unreliable'};
+    how=hows(status+1);
+else
+    w=zeros(n,K);
+    z=zeros(n,K);
+    how=cell(1,K);
+    for k=1:K,
+        [z(:,k),w(:,k),how{k}]=qpsol(M,q(:,k),-eye(n),zeros(n,1),[],[],zeros(n,1),solver);
+    end
+    basis=double(z>0);
+end
+if K==1,
+    how=how{1};
+end
 
-%w=M*z+q;
\ No newline at end of file
+%w=M*z+q;
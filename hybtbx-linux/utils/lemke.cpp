@@ -0,0 +1,331 @@
+/* Lemke's complementary pivoting LCP solver - implementation
+
+   See LEMKE.H for the API.
+
+   The method (C.E. Lemke, "Bimatrix equilibrium points and mathematical
+   programming", Management Science 11, 1965) solves
+
+       w - M*z - d*z0 = q
+
+   starting from a complementary basis B with z0 chosen so that all basic
+   variables are nonnegative, and then pivots in the complement of the
+   variable that left the basis until z0 leaves. With B=I and d=ones
+   this is the classical start; with a warm basis B, d=B*ones makes
+   B\(q+d*z0) = B\q+z0*ones, so the path starts from B.
+
+   Variables are labeled w(i)=i, z(i)=n+i, z0=2n. inv(B) is stored
+   row-major, so that the pivot updates and the lexicographic ratio test
+   run along contiguous rows.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "lemke.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#define LEMKE_PIVTOL   1e-11
+#define LEMKE_FEASTOL  1e-10
+
+struct lemke_struct {
+    int n;
+    std::vector<double> M;      /* column-major */
+    std::vector<int> warm;      /* z(i) basic in the last solution */
+    int maxiter;
+
+    /* workspace */
+    std::vector<double> Binv, xb, d, a, col, T;
+    std::vector<int> bas;
+};
+
+/* row-major access */
+#define BI(i, j) Binv[(size_t) (i) * n + (j)]
+
+lemke_t *lemke_new(int n, const double *M)
+{
+    lemke_t *lcp = new lemke_struct;
+    lcp->n = n;
+    lcp->maxiter = 0;
+    lcp->M.assign(M, M + (size_t) n * n);
+    lcp->warm.assign(n, 0);
+    lcp->Binv.resize((size_t) n * n);
+    lcp->xb.resize(n);
+    lcp->d.resize(n);
+    lcp->a.resize(n);
+    lcp->col.resize(n);
+    lcp->bas.resize(n);
+    return lcp;
+}
+
+void lemke_free(lemke_t *lcp)
+{
+    delete lcp;
+}
+
+void lemke_set_maxiter(lemke_t *lcp, int maxiter)
+{
+    lcp->maxiter = maxiter > 0 ? maxiter : 0;
+}
+
+void lemke_get_basis(const lemke_t *lcp, int *basis)
+{
+    for (int i = 0; i < lcp->n; i++)
+        basis[i] = lcp->warm[i];
+}
+
+void lemke_set_basis(lemke_t *lcp, const int *basis)
+{
+    for (int i = 0; i < lcp->n; i++)
+        lcp->warm[i] = (basis && basis[i]) ? 1 : 0;
+}
+
+/* Column of the variable with the given label in [I -M -d] */
+static void column(const lemke_t *lcp, int label, double *a)
+{
+    int n = lcp->n, i;
+    const double *Mj;
+
+    if (label < n) {
+        for (i = 0; i < n; i++)
+            a[i] = 0.0;
+        a[label] = 1.0;
+    }
+    else if (label < 2 * n) {
+        Mj = &lcp->M[(size_t) (label - n) * n];
+        for (i = 0; i < n; i++)
+            a[i] = -Mj[i];
+    }
+    else
+        for (i = 0; i < n; i++)
+            a[i] = -lcp->d[i];
+}
+
+/* col = inv(B)*a */
+static void ftran(lemke_t *lcp, const double *a)
+{
+    int n = lcp->n, i, j;
+    const std::vector<double> &Binv = lcp->Binv;
+    double s;
+
+    for (i = 0; i < n; i++) {
+        s = 0.0;
+        for (j = 0; j < n; j++)
+            s += BI(i, j) * a[j];
+        lcp->col[i] = s;
+    }
+}
+
+/* inv(B) of the basis lcp->bas by Gauss-Jordan elimination with partial
+   pivoting; d=B*ones. Returns false if B is singular. */
+static bool factor(lemke_t *lcp)
+{
+    int n = lcp->n, n2 = 2 * n, i, j, k, p;
+    std::vector<double> &T = lcp->T, &Binv = lcp->Binv;
+    double s, piv;
+
+    /* T = [B I], row-major */
+    T.assign((size_t) n * n2, 0.0);
+    std::fill(lcp->d.begin(), lcp->d.end(), 0.0);
+    for (j = 0; j < n; j++) {
+        column(lcp, lcp->bas[j], &lcp->a[0]);
+        for (i = 0; i < n; i++) {
+            T[(size_t) i * n2 + j] = lcp->a[i];
+            lcp->d[i] += lcp->a[i];
+        }
+        T[(size_t) j * n2 + n + j] = 1.0;
+    }
+    for (k = 0; k < n; k++) {
+        p = k;
+        for (i = k + 1; i < n; i++)
+            if (std::fabs(T[(size_t) i * n2 + k]) > std::fabs(T[(size_t) p * n2 + k]))
+                p = i;
+        piv = T[(size_t) p * n2 + k];
+        if (std::fabs(piv) < LEMKE_PIVTOL)
+            return false;
+        if (p != k)
+            std::swap_ranges(T.begin() + (size_t) k * n2, T.begin() + (size_t) (k + 1) * n2,
+                             T.begin() + (size_t) p * n2);
+        for (j = k; j < n2; j++)
+            T[(size_t) k * n2 + j] /= piv;
+        for (i = 0; i < n; i++) {
+            s = T[(size_t) i * n2 + k];
+            if (i == k || s == 0.0)
+                continue;
+            for (j = k; j < n2; j++)
+                T[(size_t) i * n2 + j] -= s * T[(size_t) k * n2 + j];
+        }
+    }
+    for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+            BI(i, j) = T[(size_t) i * n2 + n + j];
+    return true;
+}
+
+/* Pivot on row r with the column lcp->col of the entering variable */
+static void pivot(lemke_t *lcp, int r)
+{
+    int n = lcp->n, i, j;
+    std::vector<double> &Binv = lcp->Binv, &xb = lcp->xb, &col = lcp->col;
+    double p = col[r], c;
+    double *rowr = &Binv[(size_t) r * n];
+
+    for (j = 0; j < n; j++)
+        rowr[j] /= p;
+    xb[r] /= p;
+    for (i = 0; i < n; i++) {
+        c = col[i];
+        if (i == r || c == 0.0)
+            continue;
+        for (j = 0; j < n; j++)
+            BI(i, j) -= c * rowr[j];
+        xb[i] -= c * xb[r];
+    }
+}
+
+/* Row i precedes row r in the lexicographic ratio test */
+static bool lexless(const lemke_t *lcp, int i, int r)
+{
+    int n = lcp->n, j;
+    const std::vector<double> &Binv = lcp->Binv;
+    double ci = lcp->col[i], cr = lcp->col[r], u, v;
+
+    for (j = 0; j < n; j++) {
+        u = BI(i, j) / ci;
+        v = BI(r, j) / cr;
+        if (u < v - LEMKE_PIVTOL)
+            return true;
+        if (u > v + LEMKE_PIVTOL)
+            return false;
+    }
+    return false;
+}
+
+/* Leaving row for the entering column lcp->col, -1 if none (ray) */
+static int ratiotest(const lemke_t *lcp)
+{
+    int n = lcp->n, i, r = -1;
+    double cmax = 0.0, tol, best = 0.0, t;
+
+    for (i = 0; i < n; i++)
+        cmax = std::max(cmax, lcp->col[i]);
+    tol = LEMKE_PIVTOL * std::max(1.0, cmax);
+    for (i = 0; i < n; i++) {
+        if (lcp->col[i] <= tol)
+            continue;
+        t = lcp->xb[i] / lcp->col[i];
+        if (r < 0 || t < best - LEMKE_PIVTOL * (1.0 + std::fabs(best))) {
+            r = i;
+            best = t;
+        }
+        else if (t <= best + LEMKE_PIVTOL * (1.0 + std::fabs(best))) {
+            /* Tie: z0 leaves if possible, otherwise lexicographic rule */
+            if (lcp->bas[r] == 2 * n)
+                continue;
+            if (lcp->bas[i] == 2 * n || lexless(lcp, i, r)) {
+                r = i;
+                best = std::min(best, t);
+            }
+        }
+    }
+    return r;
+}
+
+int lemke_solve(lemke_t *lcp, const double *q, double *w, double *z, int *iter)
+{
+    int n = lcp->n, i, j, r, it = 0, status, enter, leave, maxiter;
+    std::vector<double> &Binv = lcp->Binv, &xb = lcp->xb;
+    bool cold = true;
+    double s, qmax = 0.0;
+
+    for (i = 0; i < n; i++) {
+        lcp->bas[i] = lcp->warm[i] ? n + i : i;
+        cold = cold && !lcp->warm[i];
+        qmax = std::max(qmax, std::fabs(q[i]));
+    }
+    if (!cold && !factor(lcp)) {
+        /* Singular warm basis */
+        cold = true;
+        for (i = 0; i < n; i++)
+            lcp->bas[i] = i;
+    }
+    if (cold) {
+        std::fill(Binv.begin(), Binv.end(), 0.0);
+        for (i = 0; i < n; i++) {
+            BI(i, i) = 1.0;
+            lcp->d[i] = 1.0;
+        }
+    }
+    for (i = 0; i < n; i++) {
+        s = 0.0;
+        for (j = 0; j < n; j++)
+            s += BI(i, j) * q[j];
+        xb[i] = s;
+    }
+
+    maxiter = lcp->maxiter > 0 ? lcp->maxiter : 50 * (n + 1);
+    status = LEMKE_OK;
+
+    /* The start basis is feasible unless some xb(i)<0: then z0 enters
+       and the most negative variable leaves */
+    r = -1;
+    for (i = 0; i < n; i++)
+        if (xb[i] < -LEMKE_FEASTOL * (1.0 + qmax) && (r < 0 || xb[i] < xb[r]))
+            r = i;
+    if (r >= 0) {
+        column(lcp, 2 * n, &lcp->a[0]);
+        ftran(lcp, &lcp->a[0]);
+        leave = lcp->bas[r];
+        pivot(lcp, r);
+        lcp->bas[r] = 2 * n;
+        it = 1;
+        while (1) {
+            enter = leave < n ? leave + n : leave - n;
+            column(lcp, enter, &lcp->a[0]);
+            ftran(lcp, &lcp->a[0]);
+            r = ratiotest(lcp);
+            if (r < 0) {
+                status = LEMKE_RAY;
+                break;
+            }
+            if (it >= maxiter) {
+                status = LEMKE_MAXITER;
+                break;
+            }
+            leave = lcp->bas[r];
+            pivot(lcp, r);
+            lcp->bas[r] = enter;
+            it++;
+            if (leave == 2 * n)
+                break;
+        }
+    }
+
+    /* Solution: z from the basis, w=M*z+q on the basic w */
+    for (i = 0; i < n; i++)
+        z[i] = 0.0;
+    for (i = 0; i < n; i++)
+        if (lcp->bas[i] >= n && lcp->bas[i] < 2 * n)
+            z[lcp->bas[i] - n] = std::max(xb[i], 0.0);
+    for (i = 0; i < n; i++)
+        w[i] = 0.0;
+    for (i = 0; i < n; i++) {
+        if (lcp->bas[i] >= n)
+            continue;
+        s = q[lcp->bas[i]];
+        for (j = 0; j < n; j++)
+            s += lcp->M[lcp->bas[i] + (size_t) j * n] * z[j];
+        w[lcp->bas[i]] = std::max(s, 0.0);
+    }
+
+    for (i = 0; i < n; i++)
+        lcp->warm[i] = 0;
+    if (status == LEMKE_OK)
+        for (i = 0; i < n; i++)
+            if (lcp->bas[i] >= n && lcp->bas[i] < 2 * n)
+                lcp->warm[lcp->bas[i] - n] = 1;
+
+    if (iter)
+        *iter = it;
+    return status;
+}
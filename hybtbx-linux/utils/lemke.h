@@ -0,0 +1,67 @@
+/* Lemke's complementary pivoting LCP solver - C API
+
+   Finds w,z such that
+
+       w - M*z = q,   w >= 0,  z >= 0,  w'*z = 0
+
+   for a square (not necessarily symmetric) matrix M, by Lemke's method
+   with an artificial variable z0 and covering vector d. The method
+   terminates with a solution for P-matrices (unique solution) and for
+   positive semidefinite M whenever the LCP is feasible; otherwise it
+   ends on a secondary ray.
+
+   A basis is described by the set of indices i for which z(i) (rather
+   than w(i)) is basic. The solver object remembers the basis of the last
+   solution. The next solve starts from that basis B: if B\q >= 0 it is
+   the solution and no pivot is made, otherwise the covering vector
+   d=B*ones(n,1) is used, so that Lemke's path starts at B (warm start).
+   When a sequence of LCPs with neighboring solutions is solved, such as
+   those of the critical regions explored by mpQP, only a few pivots are
+   needed per problem.
+
+   The inverse of the basis matrix is kept explicitly and updated by
+   rank-one pivots; ties in the ratio test are broken lexicographically.
+   Matrices are column-major (MATLAB layout). See LEMKEMEX.CPP for the
+   MEX interface and LCPSOL.M for the MATLAB wrapper.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef LEMKE_H
+#define LEMKE_H
+
+#define LEMKE_OK        0
+#define LEMKE_RAY       1
+#define LEMKE_MAXITER   2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct lemke_struct lemke_t;
+
+/* Create a solver for the n-by-n matrix M (copied) */
+lemke_t *lemke_new(int n, const double *M);
+
+/* Solve the LCP for the vector q. w and z (n) receive the solution,
+   iter (may be NULL) the number of pivots. Returns one of the LEMKE_*
+   codes; on LEMKE_RAY and LEMKE_MAXITER w and z are the last iterate
+   without the artificial variable and the warm-start basis is reset. */
+int lemke_solve(lemke_t *lcp, const double *q, double *w, double *z, int *iter);
+
+/* Basis of the last solution: basis[i]=1 if z(i) is basic, 0 otherwise */
+void lemke_get_basis(const lemke_t *lcp, int *basis);
+
+/* Replace the warm-start basis (NULL = all w basic, cold start) */
+void lemke_set_basis(lemke_t *lcp, const int *basis);
+
+/* Maximum number of pivots (0 = automatic) */
+void lemke_set_maxiter(lemke_t *lcp, int maxiter);
+
+void lemke_free(lemke_t *lcp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
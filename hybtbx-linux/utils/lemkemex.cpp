@@ -0,0 +1,155 @@
+/* Lemke's complementary pivoting LCP solver - MEX interface
+
+   [w,z,status,iter,basis]=lemkemex(M,q,basis0,maxiter,nthreads)
+
+   Solves w-M*z=q, w>=0, z>=0, w'*z=0 by the solver in LEMKE.CPP.
+
+   q       = n-by-K matrix: the K LCPs with columns q(:,k) are solved
+             (batch mode), and w,z are n-by-K
+   basis0  = n-by-1 vector, basis0(i)~=0 if z(i) is basic in the start
+             basis (warm start). If omitted or empty, the basis of the
+             previous call is used, provided M is the same.
+   maxiter = maximum number of pivots per LCP (optional, 0 = automatic)
+   nthreads = number of worker threads in batch mode (default: all cores)
+   status  = 1-by-K, 0 solved, 1 secondary ray (no solution found: the
+             LCP is infeasible if M is positive semidefinite), 2 maximum
+             number of pivots reached
+   iter    = 1-by-K number of pivots
+   basis   = n-by-K, basis(i,k)=1 if z(i) is basic in the solution of LCP #k
+
+   In batch mode each worker solves a block of consecutive columns and
+   starts each LCP from the basis of the previous one, so columns should
+   be ordered so that neighbors have similar solutions (e.g. parameter
+   values in adjacent critical regions).
+
+   The solver is kept between calls and rebuilt only when M changes.
+
+   Compile with MEXCOMPILE.M (or mex -O lemkemex.cpp lemke.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "lemke.h"
+#include "mexthreads.h"
+#include <cstring>
+#include <vector>
+
+static lemke_t *lemkemex_lcp = NULL;
+static std::vector<double> lemkemex_M;  /* M of lemkemex_lcp */
+
+static void lemkemex_cleanup(void)
+{
+    if (lemkemex_lcp)
+        lemke_free(lemkemex_lcp);
+    lemkemex_lcp = NULL;
+    lemkemex_M.clear();
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const double *M, *q, *b0;
+    double *w, *z, *st, *it, *bas;
+    std::vector<int> basis0;
+    int n, K, k, i, maxiter = 0, nthreads = 0;
+
+    mexAtExit(lemkemex_cleanup);
+
+    if (nrhs < 2)
+        mexErrMsgTxt("At least two input arguments required.");
+
+    n = (int) mxGetM(prhs[0]);
+    if ((int) mxGetN(prhs[0]) != n || !mxIsDouble(prhs[0]) || mxIsSparse(prhs[0]))
+        mexErrMsgTxt("M must be a full square matrix.");
+    if ((int) mxGetM(prhs[1]) != n || !mxIsDouble(prhs[1]) || mxIsSparse(prhs[1]))
+        mexErrMsgTxt("q must be a full matrix with as many rows as M.");
+    K = (int) mxGetN(prhs[1]);
+    if (nrhs > 3 && !mxIsEmpty(prhs[3]))
+        maxiter = (int) mxGetScalar(prhs[3]);
+    if (nrhs > 4 && !mxIsEmpty(prhs[4]))
+        nthreads = (int) mxGetScalar(prhs[4]);
+
+    M = mxGetPr(prhs[0]);
+    q = mxGetPr(prhs[1]);
+
+    /* Reuse the solver (and its warm-start basis) if M is the same */
+    if (!lemkemex_lcp || lemkemex_M.size() != (size_t) n * n
+        || (n > 0 && memcmp(&lemkemex_M[0], M, (size_t) n * n * sizeof(double)))) {
+        lemkemex_cleanup();
+        lemkemex_lcp = lemke_new(n, M);
+        lemkemex_M.assign(M, M + (size_t) n * n);
+    }
+    lemke_set_maxiter(lemkemex_lcp, maxiter);
+
+    basis0.resize(n);
+    if (nrhs > 2 && !mxIsEmpty(prhs[2])) {
+        if ((int) mxGetNumberOfElements(prhs[2]) != n || !mxIsDouble(prhs[2]))
+            mexErrMsgTxt("basis0 must be a vector with as many elements as the rows of M.");
+        b0 = mxGetPr(prhs[2]);
+        for (i = 0; i < n; i++)
+            basis0[i] = b0[i] != 0.0;
+        lemke_set_basis(lemkemex_lcp, &basis0[0]);
+    }
+    else if (n > 0)
+        lemke_get_basis(lemkemex_lcp, &basis0[0]);
+
+    plhs[0] = mxCreateDoubleMatrix(n, K, mxREAL);
+    plhs[1] = mxCreateDoubleMatrix(n, K, mxREAL);
+    w = mxGetPr(plhs[0]);
+    z = mxGetPr(plhs[1]);
+    std::vector<double> status(K), iters(K), bases((size_t) n * K);
+
+    /* Worker #0 uses the persistent solver, the others a copy started
+       from the same basis. Each worker takes a block of columns. */
+    nthreads = mex_num_threads(nthreads);
+    if (nthreads > K)
+        nthreads = K > 0 ? K : 1;
+    std::vector<lemke_t *> lcps(nthreads, lemkemex_lcp);
+    for (k = 1; k < nthreads; k++) {
+        lcps[k] = lemke_new(n, M);
+        lemke_set_maxiter(lcps[k], maxiter);
+        lemke_set_basis(lcps[k], n > 0 ? &basis0[0] : NULL);
+    }
+    std::vector<std::vector<int> > b(nthreads, std::vector<int>(n));
+
+    mex_parallel_for(K, nthreads, (K + nthreads - 1) / nthreads, [&](int j, int t) {
+        int iter = 0, l;
+        status[j] = lemke_solve(lcps[t], q + (size_t) j * n, w + (size_t) j * n,
+                                z + (size_t) j * n, &iter);
+        iters[j] = iter;
+        if (n > 0) {
+            lemke_get_basis(lcps[t], &b[t][0]);
+            for (l = 0; l < n; l++)
+                bases[(size_t) j * n + l] = b[t][l];
+        }
+    });
+
+    for (k = 1; k < nthreads; k++)
+        lemke_free(lcps[k]);
+
+    /* Next call starts from the basis of the last LCP */
+    if (K > 0 && n > 0) {
+        for (i = 0; i < n; i++)
+            basis0[i] = bases[(size_t) (K - 1) * n + i] != 0.0;
+        lemke_set_basis(lemkemex_lcp, &basis0[0]);
+    }
+
+    if (nlhs > 2) {
+        plhs[2] = mxCreateDoubleMatrix(1, K, mxREAL);
+        st = mxGetPr(plhs[2]);
+        for (k = 0; k < K; k++)
+            st[k] = status[k];
+    }
+    if (nlhs > 3) {
+        plhs[3] = mxCreateDoubleMatrix(1, K, mxREAL);
+        it = mxGetPr(plhs[3]);
+        for (k = 0; k < K; k++)
+            it[k] = iters[k];
+    }
+    if (nlhs > 4) {
+        plhs[4] = mxCreateDoubleMatrix(n, K, mxREAL);
+        bas = mxGetPr(plhs[4]);
+        for (size_t l = 0; l < bases.size(); l++)
+            bas[l] = bases[l];
+    }
+}
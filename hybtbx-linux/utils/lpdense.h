@@ -0,0 +1,457 @@
+/* Dense LP solver for small polyhedral problems - C++ header
+
+   Solves
+
+       min  c'x
+       s.t. A(i,:)*x  = b(i),   i=0,...,me-1
+            A(i,:)*x <= b(i),   i=me,...,m-1
+
+   with free variables x by a primal active-set (inequality-form simplex)
+   method. The problems arising in the toolbox (Chebychev balls, redundancy
+   and inclusion checks, facet crossing in mpQP/mpLP) have few variables
+   and many rows, so the method works directly on the n-dimensional
+   vertices of the polyhedron and never forms a tableau.
+
+   The solver is warm-started from a point x: if x is feasible, phase 1 is
+   skipped and the constraints active at x form the initial working set.
+   A DenseLP object keeps its workspace, so it can be reused for sequences
+   of LPs of similar size without new allocations. One object must be used
+   by one thread at a time.
+
+   Rows are stored row-major (A[i*n+j]); use setRowsColMajor() to load
+   MATLAB (column-major) data.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef LPDENSE_H
+#define LPDENSE_H
+
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#define LPDENSE_OPTIMAL     0
+#define LPDENSE_INFEASIBLE  1
+#define LPDENSE_UNBOUNDED   2
+#define LPDENSE_MAXITER     3
+
+class DenseLP {
+public:
+    /* tolerances */
+    double feastol;   /* primal feasibility */
+    double opttol;    /* dual feasibility (multipliers) */
+    double pivtol;    /* minimum pivot in the ratio test */
+    int maxiter;      /* 0 = automatic */
+
+    /* problem data */
+    int n, m, me;
+    std::vector<double> A;   /* m-by-n, row-major */
+    std::vector<double> b;
+
+    /* solution */
+    double fval;
+    int iter;
+    std::vector<int> W;           /* working set at the solution */
+    std::vector<double> lambda;   /* multipliers, one per row (0 if inactive) */
+
+    DenseLP() : feastol(1e-9), opttol(1e-9), pivtol(1e-11), maxiter(0),
+                n(0), m(0), me(0), fval(0), iter(0) {}
+
+    void resize(int n_, int m_, int me_ = 0)
+    {
+        n = n_; m = m_; me = me_;
+        A.resize((size_t) m * n);
+        b.resize(m);
+    }
+
+    double *row(int i) { return &A[(size_t) i * n]; }
+    const double *row(int i) const { return &A[(size_t) i * n]; }
+
+    /* Load rows from a column-major matrix M with leading dimension ld */
+    void setRowsColMajor(int i0, const double *M, int ld, int nrows, const double *rhs)
+    {
+        for (int i = 0; i < nrows; i++) {
+            double *a = row(i0 + i);
+            for (int j = 0; j < n; j++)
+                a[j] = M[i + (size_t) j * ld];
+            b[i0 + i] = rhs[i];
+        }
+    }
+
+    /* Solve the LP. On input x is the warm-start point (any point, e.g.
+       zeros), on output the optimal solution. */
+    int solve(const double *c, double *x)
+    {
+        int status, k;
+
+        iter = 0;
+        lambda.assign(m, 0.0);
+        project_equalities(x);
+        if (max_violation(x) > feastol) {
+            status = phase1(x);
+            if (status != LPDENSE_OPTIMAL)
+                return status;
+        }
+        status = active_set(n, m, me, A.data(), b.data(), c, x, -1);
+        fval = 0;
+        for (k = 0; k < n; k++)
+            fval += c[k] * x[k];
+        return status;
+    }
+
+    /* Largest constraint violation at x */
+    double max_violation(const double *x) const
+    {
+        double v = 0, r;
+        for (int i = 0; i < m; i++) {
+            r = dot(row(i), x, n) - b[i];
+            if (i < me)
+                r = std::fabs(r);
+            if (r > v)
+                v = r;
+        }
+        return v;
+    }
+
+    static double dot(const double *u, const double *v, int len)
+    {
+        double s = 0;
+        for (int j = 0; j < len; j++)
+            s += u[j] * v[j];
+        return s;
+    }
+
+private:
+    /* workspace */
+    std::vector<double> Qw, Rw, d, g, A1, b1, c1, x1;
+    std::vector<char> inW;
+
+    /* Move x onto the affine set of equality constraints (least squares) */
+    void project_equalities(double *x)
+    {
+        int i, j, k;
+        if (me == 0)
+            return;
+        W.clear();
+        for (i = 0; i < me; i++)
+            W.push_back(i);
+        int nq = factor(n, A.data(), W);
+        /* x += Q*R^{-T}*(b_E - A_E*x) restricted to independent rows */
+        std::vector<double> y(nq, 0.0);
+        for (k = 0; k < nq; k++) {
+            double s = b[W[k]] - dot(row(W[k]), x, n);
+            for (j = 0; j < k; j++)
+                s -= Rw[(size_t) j * n + k] * y[j];
+            y[k] = s / Rw[(size_t) k * n + k];
+        }
+        for (k = 0; k < nq; k++)
+            for (i = 0; i < n; i++)
+                x[i] += Qw[(size_t) k * n + i] * y[k];
+    }
+
+    /* Phase 1: min t s.t. A_I*x - t <= b_I, A_E*x = b_E, t >= -1, starting
+       from (x, max violation). Stops as soon as t <= 0. */
+    int phase1(double *x)
+    {
+        int i, j, status;
+        int n1 = n + 1, m1 = m + 1;
+        double t0 = max_violation(x);
+
+        A1.assign((size_t) m1 * n1, 0.0);
+        b1.resize(m1);
+        for (i = 0; i < m; i++) {
+            for (j = 0; j < n; j++)
+                A1[(size_t) i * n1 + j] = A[(size_t) i * n + j];
+            A1[(size_t) i * n1 + n] = (i < me) ? 0.0 : -1.0;
+            b1[i] = b[i];
+        }
+        A1[(size_t) m * n1 + n] = -1.0;
+        b1[m] = 1.0;
+        c1.assign(n1, 0.0);
+        c1[n] = 1.0;
+        x1.resize(n1);
+        for (j = 0; j < n; j++)
+            x1[j] = x[j];
+        x1[n] = t0;
+        status = active_set(n1, m1, me, &A1[0], &b1[0], &c1[0], &x1[0], n);
+        for (j = 0; j < n; j++)
+            x[j] = x1[j];
+        if (status == LPDENSE_MAXITER)
+            return status;
+        if (x1[n] > feastol)
+            return LPDENSE_INFEASIBLE;
+        return LPDENSE_OPTIMAL;
+    }
+
+    /* Orthonormal basis Q (columns, n-by-k) and triangular R of the rows of
+       A listed in S, by modified Gram-Schmidt with reorthogonalization.
+       Rows that are linearly dependent on the previous ones are removed
+       from S. Returns the number of rows kept. */
+    int factor(int nv, const double *M, std::vector<int> &S)
+    {
+        int k, j, i, pass, kept = 0;
+        Qw.resize((size_t) nv * (nv + 1));
+        Rw.assign((size_t) nv * (nv + 1), 0.0);
+        for (k = 0; k < (int) S.size() && kept < nv; k++) {
+            double *q = &Qw[(size_t) kept * nv];
+            const double *a = M + (size_t) S[k] * nv;
+            double na = std::sqrt(dot(a, a, nv));
+            for (i = 0; i < nv; i++)
+                q[i] = a[i];
+            for (j = 0; j < kept; j++)
+                Rw[(size_t) j * nv + kept] = 0;
+            for (pass = 0; pass < 2; pass++) {
+                for (j = 0; j < kept; j++) {
+                    const double *qj = &Qw[(size_t) j * nv];
+                    double s = dot(qj, q, nv);
+                    Rw[(size_t) j * nv + kept] += s;
+                    for (i = 0; i < nv; i++)
+                        q[i] -= s * qj[i];
+                }
+            }
+            double nq = std::sqrt(dot(q, q, nv));
+            if (nq <= 1e-10 * (na > 1 ? na : 1))
+                continue; /* dependent row, drop it */
+            for (i = 0; i < nv; i++)
+                q[i] /= nq;
+            Rw[(size_t) kept * nv + kept] = nq;
+            S[kept++] = S[k];
+        }
+        S.resize(kept);
+        return kept;
+    }
+
+    /* Primal active-set iterations from a feasible point x. If stopvar>=0,
+       return as soon as x[stopvar]<=0 (used by phase 1). */
+    int active_set(int nv, int mv, int mev, const double *M, const double *rhs,
+                   const double *c, double *x, int stopvar)
+    {
+        int i, j, k, nq, imin, iblock, degenerate = 0;
+        int itmax = maxiter > 0 ? maxiter : 50 * (mv + nv) + 100;
+        double cnorm = 0, s, ad, step, lmin;
+
+        for (j = 0; j < nv; j++)
+            cnorm = std::fmax(cnorm, std::fabs(c[j]));
+        d.resize(nv);
+        g.resize(nv);
+        inW.assign(mv, 0);
+
+        /* initial working set: equalities, then inequalities active at x */
+        W.clear();
+        for (i = 0; i < mv; i++) {
+            if (i < mev || std::fabs(dot(M + (size_t) i * nv, x, nv) - rhs[i]) <= feastol * (1 + std::fabs(rhs[i])))
+                W.push_back(i);
+        }
+        factor(nv, M, W);
+        for (k = 0; k < (int) W.size(); k++)
+            inW[W[k]] = 1;
+
+        for (; iter < itmax; iter++) {
+            if (stopvar >= 0 && x[stopvar] <= 0)
+                return LPDENSE_OPTIMAL;
+            /* Numerically dependent rows are dropped from W but stay in
+               inW, out of the ratio test: a row that differs from an
+               active one by rounding would otherwise block at step 0
+               again and again. They are released with the next row
+               leaving W. */
+            nq = factor(nv, M, W);
+
+            /* projected steepest descent direction d = -(I-QQ')c */
+            for (i = 0; i < nv; i++)
+                d[i] = -c[i];
+            for (k = 0; k < nq; k++) {
+                const double *q = &Qw[(size_t) k * nv];
+                s = dot(q, &d[0], nv);
+                g[k] = -s; /* g = Q'c */
+                for (i = 0; i < nv; i++)
+                    d[i] -= s * q[i];
+            }
+            double dn = 0;
+            for (i = 0; i < nv; i++)
+                dn = std::fmax(dn, std::fabs(d[i]));
+
+            if (dn <= opttol * (1 + cnorm)) {
+                /* c in the row space of the working set: multipliers solve
+                   A_W'*lambda = -c, i.e. R*lambda = -Q'c */
+                std::vector<double> lam(nq);
+                for (k = nq - 1; k >= 0; k--) {
+                    s = -g[k];
+                    for (j = k + 1; j < nq; j++)
+                        s -= Rw[(size_t) k * nv + j] * lam[j];
+                    lam[k] = s / Rw[(size_t) k * nv + k];
+                }
+                imin = -1;
+                lmin = -opttol * (1 + cnorm);
+                for (k = 0; k < nq; k++) {
+                    if (W[k] < mev)
+                        continue;
+                    if (degenerate > nv) {
+                        /* Bland's rule against cycling */
+                        if (lam[k] < lmin && (imin < 0 || W[k] < W[imin]))
+                            imin = k;
+                    } else if (lam[k] < lmin) {
+                        lmin = lam[k];
+                        imin = k;
+                    }
+                }
+                if (imin < 0) {
+                    if (M == A.data())
+                        for (k = 0; k < nq; k++)
+                            lambda[W[k]] = lam[k];
+                    return LPDENSE_OPTIMAL;
+                }
+                W.erase(W.begin() + imin);
+                inW.assign(mv, 0);
+                for (k = 0; k < (int) W.size(); k++)
+                    inW[W[k]] = 1;
+                continue;
+            }
+
+            /* ratio test */
+            iblock = -1;
+            step = std::numeric_limits<double>::infinity();
+            for (i = mev; i < mv; i++) {
+                if (inW[i])
+                    continue;
+                const double *a = M + (size_t) i * nv;
+                ad = dot(a, &d[0], nv);
+                if (ad <= pivtol * dn * (1 + std::sqrt(dot(a, a, nv))))
+                    continue;
+                s = (rhs[i] - dot(a, x, nv)) / ad;
+                if (s < 0)
+                    s = 0;
+                if (s < step) {
+                    step = s;
+                    iblock = i;
+                }
+            }
+            if (iblock < 0)
+                return LPDENSE_UNBOUNDED;
+            if (stopvar >= 0 && d[stopvar] < 0 && x[stopvar] + step * d[stopvar] <= 0) {
+                /* reach t=0 and stop there */
+                step = -x[stopvar] / d[stopvar];
+                for (i = 0; i < nv; i++)
+                    x[i] += step * d[i];
+                x[stopvar] = 0;
+                return LPDENSE_OPTIMAL;
+            }
+            for (i = 0; i < nv; i++)
+                x[i] += step * d[i];
+            degenerate = (step * dn <= feastol) ? degenerate + 1 : 0;
+            W.push_back(iblock);
+            inW[iblock] = 1;
+        }
+        return LPDENSE_MAXITER;
+    }
+};
+
+/* Chebychev ball of {x: H*x <= K}, i.e.
+
+      max r  s.t.  H(i,:)*x + norm(H(i,:))*r <= K(i)
+
+   H (m-by-n, column-major with leading dimension ld) and K are MATLAB
+   data, hn are precomputed row norms (hn=NULL computes them). x is the
+   warm start on input and the center on output, r the radius (r<0: empty
+   polyhedron, r=Inf: unbounded polyhedron). The LP is built in lp. */
+inline int lpdense_chebyshev(DenseLP &lp, int n, int m, const double *H, int ld,
+                             const double *K, const double *hn, double *x, double *r)
+{
+    int i, j, status;
+    double ri, rmin = std::numeric_limits<double>::infinity();
+    std::vector<double> c(n + 1, 0.0), y(n + 1);
+
+    lp.resize(n + 1, m, 0);
+    for (i = 0; i < m; i++) {
+        double *a = lp.row(i), s = 0;
+        for (j = 0; j < n; j++) {
+            a[j] = H[i + (size_t) j * ld];
+            s += a[j] * a[j];
+        }
+        a[n] = hn ? hn[i] : std::sqrt(s);
+        lp.b[i] = K[i];
+        /* warm start: largest ball centered at x */
+        ri = (K[i] - DenseLP::dot(a, x, n)) / (a[n] > 0 ? a[n] : 1.0);
+        if (ri < rmin)
+            rmin = ri;
+    }
+    for (j = 0; j < n; j++)
+        y[j] = x[j];
+    y[n] = (m > 0) ? rmin : 0;
+    c[n] = -1.0;
+    status = lp.solve(&c[0], &y[0]);
+    if (status == LPDENSE_UNBOUNDED) {
+        *r = std::numeric_limits<double>::infinity();
+        return status;
+    }
+    for (j = 0; j < n; j++)
+        x[j] = y[j];
+    *r = y[n];
+    return status;
+}
+
+/* Chebychev ball of the facet {x: h'*x = k} of the polyhedron
+   {x: A(i,:)*x <= b(i), i=0,...,m-1} (A row-major, facet row excluded),
+   i.e. the largest ball of the hyperplane contained in the polyhedron
+   (see FACECHEBY.M). Each row is weighted by the norm of its component
+   orthogonal to h. x is the warm start (projected onto the hyperplane) on
+   input and the center on output, r the radius (r=-Inf: the hyperplane
+   does not intersect the polyhedron). */
+inline int lpdense_facet_chebyshev(DenseLP &lp, int n, const double *h, double k,
+                                   int m, const double *A, const double *b,
+                                   double *x, double *r)
+{
+    int i, j, status;
+    double s, e, nh = DenseLP::dot(h, h, n);
+    double rmin = std::numeric_limits<double>::infinity();
+    std::vector<double> c(n + 1, 0.0), y(n + 1);
+
+    if (nh <= 0) {
+        *r = -std::numeric_limits<double>::infinity();
+        return LPDENSE_INFEASIBLE;
+    }
+    lp.resize(n + 1, m + 1, 1);
+    double *a = lp.row(0);
+    for (j = 0; j < n; j++)
+        a[j] = h[j];
+    a[n] = 0.0;
+    lp.b[0] = k;
+
+    /* warm start: projection of x onto the hyperplane */
+    s = (k - DenseLP::dot(h, x, n)) / nh;
+    for (j = 0; j < n; j++)
+        y[j] = x[j] + s * h[j];
+
+    for (i = 0; i < m; i++) {
+        const double *ai = A + (size_t) i * n;
+        a = lp.row(i + 1);
+        s = DenseLP::dot(ai, h, n) / nh;
+        e = 0;
+        for (j = 0; j < n; j++) {
+            a[j] = ai[j];
+            e += (ai[j] - s * h[j]) * (ai[j] - s * h[j]);
+        }
+        a[n] = std::sqrt(e);
+        lp.b[i + 1] = b[i];
+        if (a[n] > 1e-12) {
+            s = (b[i] - DenseLP::dot(ai, &y[0], n)) / a[n];
+            if (s < rmin)
+                rmin = s;
+        }
+    }
+    y[n] = std::isinf(rmin) ? 0.0 : rmin;
+    c[n] = -1.0;
+    status = lp.solve(&c[0], &y[0]);
+    if (status == LPDENSE_UNBOUNDED)
+        *r = std::numeric_limits<double>::infinity();
+    else if (status == LPDENSE_INFEASIBLE)
+        *r = -std::numeric_limits<double>::infinity();
+    else
+        *r = y[n];
+    for (j = 0; j < n; j++)
+        x[j] = y[j];
+    return status;
+}
+
+#endif
@@ -0,0 +1,71 @@
+function mexcompile(names)
+% MEXCOMPILE Compile the native (C++) MEX functions of the Hybrid Toolbox
+%
+% MEXCOMPILE compiles all native MEX functions in the utils/ folder.
+% MEXCOMPILE(NAMES) only compiles the MEX functions listed in the cell
+% array of strings NAMES, e.g. MEXCOMPILE({'chebymex'}).
+%
+% The native functions only depend on the C++ standard library (C++11)
+% and on the headers LPDENSE.H, POLYDENSE.H, MEXTHREADS.H, MEXPART.H,
+% RICCATIQP.H and the sources listed in EXTRASRC below, in the utils/
+% folder.
+% Worker threads use std::thread; on platforms where it is not available
+% compile with -DMEX_NO_THREADS.
+%
+% GLPKWARMMEX also requires the GLPK library (4.49 or later) and its
+% headers, and is compiled only when listed in NAMES, e.g.
+% MEXCOMPILE({'glpkwarmmex'}).
+%
+% See also MEXDOWNLOAD.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+allnames={'chebymex','adjmex','joinmex','polymex','qpdualmex','riccatimex','admmqpmex',...
+    'condensemex','rtqpmex','lemkemex','mpqpparmex','mplpparmex','miqpbbmex','mld2pwaparmex',...
+    'pwadpmex'};
+
+% Additional sources linked with each MEX function
+extrasrc=struct('qpdualmex',{{'qpdual.cpp'}},'admmqpmex',{{'admmqp.cpp'}},...
+    'condensemex',{{'condense.cpp'}},'rtqpmex',{{'rtqp.cpp'}},...
+    'lemkemex',{{'lemke.cpp'}},'mpqpparmex',{{'mpqppar.cpp','qpdual.cpp'}},...
+    'mplpparmex',{{'mplppar.cpp'}},'miqpbbmex',{{'miqpbb.cpp','qpdual.cpp'}},...
+    'mld2pwaparmex',{{'mld2pwapar.cpp'}},'pwadpmex',{{'pwadp.cpp','mplppar.cpp'}});
+
+% Additional libraries linked with each MEX function
+extralib=struct('glpkwarmmex',{{'-lglpk'}});
+
+if nargin<1 || isempty(names),
+    names=allnames;
+end
+if ischar(names),
+    names={names};
+end
+
+filename='mexcompile.m'; % This file
+path=which(filename);
+path=path(1:end-length(filename));
+
+mypath=pwd;
+cd(path);
+try
+    for i=1:numel(names),
+        fprintf('Compiling %s ...\n',names{i});
+        srcs={[names{i} '.cpp']};
+        if isfield(extrasrc,names{i}),
+            srcs=[srcs,extrasrc.(names{i})];
+        end
+        if isfield(extralib,names{i}),
+            srcs=[srcs,extralib.(names{i})];
+        end
+        if isunix,
+            mex('-O','-largeArrayDims','CXXFLAGS=$CXXFLAGS -std=c++11 -pthread',...
+                'LDFLAGS=$LDFLAGS -pthread',srcs{:});
+        else
+            mex('-O','-largeArrayDims',srcs{:});
+        end
+    end
+catch me
+    cd(mypath);
+    rethrow(me);
+end
+cd(mypath);
@@ -0,0 +1,112 @@
+/* Polyhedral partitions in MEX functions - C++ header
+
+   A partition is given in the format returned by MPQP, MPLP and
+   GETCONTROLLER: region #i is {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))},
+   intersected with the box thmin<=th<=thmax if thmin,thmax are not empty.
+
+   mex_get_partition() and mex_get_box() read the MATLAB arrays in the
+   MATLAB thread; the Partition object can then be shared by the workers
+   of mex_parallel_for (see MEXTHREADS.H).
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef MEXPART_H
+#define MEXPART_H
+
+#include "mex.h"
+#include <cmath>
+#include <vector>
+
+struct Partition {
+    int npar, nh, nr;
+    const double *H, *K;              /* H is column-major, nh-by-npar */
+    std::vector<int> i1, i2;          /* 0-based, inclusive */
+    std::vector<double> hn;           /* row norms of H */
+    const double *thmin, *thmax;      /* NULL if no box */
+    std::vector<int> region_of;       /* region of each row of H (-1: none) */
+
+    double h(int row, int j) const { return H[row + (size_t) j * nh]; }
+};
+
+/* Read H,K,i1,i2 (1-based) and precompute the row norms of H */
+inline void mex_get_partition(Partition &P, const mxArray *H, const mxArray *K,
+                              const mxArray *I1, const mxArray *I2)
+{
+    int i, j;
+    double *p1, *p2;
+
+    P.nh = (int) mxGetM(H);
+    P.npar = (int) mxGetN(H);
+    P.H = mxGetPr(H);
+    P.K = mxGetPr(K);
+    if ((int) mxGetNumberOfElements(K) != P.nh)
+        mexErrMsgTxt("H and K must have the same number of rows.");
+    P.nr = (int) mxGetNumberOfElements(I1);
+    if ((int) mxGetNumberOfElements(I2) != P.nr)
+        mexErrMsgTxt("i1 and i2 must have the same length.");
+    p1 = mxGetPr(I1);
+    p2 = mxGetPr(I2);
+    P.i1.resize(P.nr);
+    P.i2.resize(P.nr);
+    P.region_of.assign(P.nh, -1);
+    for (i = 0; i < P.nr; i++) {
+        P.i1[i] = (int) p1[i] - 1;
+        P.i2[i] = (int) p2[i] - 1;
+        if (P.i1[i] < 0 || P.i2[i] >= P.nh || P.i2[i] < P.i1[i] - 1)
+            mexErrMsgTxt("Invalid region delimiters i1,i2.");
+        for (j = P.i1[i]; j <= P.i2[i]; j++)
+            P.region_of[j] = i;
+    }
+    P.hn.resize(P.nh);
+    for (i = 0; i < P.nh; i++) {
+        double s = 0;
+        for (j = 0; j < P.npar; j++)
+            s += P.h(i, j) * P.h(i, j);
+        P.hn[i] = std::sqrt(s);
+    }
+    P.thmin = P.thmax = NULL;
+}
+
+/* Optional box thmin<=th<=thmax (ignored if either one is empty) */
+inline void mex_get_box(Partition &P, const mxArray *thmin, const mxArray *thmax)
+{
+    if (mxIsEmpty(thmin) || mxIsEmpty(thmax))
+        return;
+    if ((int) mxGetNumberOfElements(thmin) != P.npar ||
+        (int) mxGetNumberOfElements(thmax) != P.npar)
+        mexErrMsgTxt("thmin and thmax must have as many entries as the columns of H.");
+    P.thmin = mxGetPr(thmin);
+    P.thmax = mxGetPr(thmax);
+}
+
+/* Append the rows of region #i except row 'skip' (and the box, if any) to
+   the row-major array A and to b */
+inline void partition_region_rows(const Partition &P, int i, int skip,
+                                  std::vector<double> &A, std::vector<double> &b)
+{
+    int n = P.npar, j, k;
+    size_t q;
+
+    for (k = P.i1[i]; k <= P.i2[i]; k++) {
+        if (k == skip)
+            continue;
+        q = A.size();
+        A.resize(q + n);
+        for (j = 0; j < n; j++)
+            A[q + j] = P.h(k, j);
+        b.push_back(P.K[k]);
+    }
+    if (P.thmin) {
+        for (j = 0; j < n; j++) {
+            q = A.size();
+            A.resize(q + 2 * n, 0.0);
+            A[q + j] = 1.0;
+            b.push_back(P.thmax[j]);
+            A[q + n + j] = -1.0;
+            b.push_back(-P.thmin[j]);
+        }
+    }
+}
+
+#endif
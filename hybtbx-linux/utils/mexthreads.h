@@ -0,0 +1,192 @@
+/* Worker threads for MEX functions - C++ header
+
+   mex_parallel_for(n,nthreads,chunk,f) calls f(i,tid) for i=0,...,n-1 on
+   nthreads worker threads (tid=0,...,nthreads-1). Indices are handed out
+   in blocks of chunk consecutive values, so that a worker processes
+   neighboring items in sequence (useful for warm starts).
+
+   The MEX API is not thread safe: f must not call mx* or mex* functions.
+   Read the inputs and create the outputs in the MATLAB thread.
+
+   MexExplorer<Item> runs an exploration where processing an item may
+   create new items (e.g. crossing the facets of a critical region). Each
+   worker owns a deque: it pushes and pops its own items at the back
+   (depth first, so that consecutive items are neighbors) and, when its
+   deque is empty, steals from the front of the deque of another worker.
+   The exploration ends when no item is queued or being processed, or
+   when stop() is called.
+
+   nthreads<=0 uses all available cores. Compile with -DMEX_NO_THREADS to
+   run everything in the MATLAB thread.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef MEXTHREADS_H
+#define MEXTHREADS_H
+
+#include <vector>
+#include <deque>
+#ifndef MEX_NO_THREADS
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+/* mex_cond waits on a locked mex_mutex: cv.wait(m) */
+#ifndef MEX_NO_THREADS
+typedef std::mutex mex_mutex;
+typedef std::atomic<long> mex_counter;
+typedef std::condition_variable_any mex_cond;
+#else
+struct mex_mutex {
+    void lock() {}
+    void unlock() {}
+};
+typedef long mex_counter;
+struct mex_cond {
+    void wait(mex_mutex &) {}
+    void notify_all() {}
+};
+#endif
+
+struct mex_lock {
+    mex_mutex &m;
+    mex_lock(mex_mutex &m_) : m(m_) { m.lock(); }
+    ~mex_lock() { m.unlock(); }
+};
+
+inline int mex_num_threads(int nthreads)
+{
+#ifdef MEX_NO_THREADS
+    return 1;
+#else
+    if (nthreads <= 0) {
+        nthreads = (int) std::thread::hardware_concurrency();
+        if (nthreads <= 0)
+            nthreads = 1;
+    }
+    return nthreads;
+#endif
+}
+
+template <class F>
+void mex_parallel_for(int n, int nthreads, int chunk, F f)
+{
+    int i;
+
+    if (chunk < 1)
+        chunk = 1;
+    nthreads = mex_num_threads(nthreads);
+    if (nthreads > (n + chunk - 1) / chunk)
+        nthreads = (n + chunk - 1) / chunk;
+#ifndef MEX_NO_THREADS
+    if (nthreads > 1) {
+        std::atomic<int> next(0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < nthreads; t++) {
+            workers.push_back(std::thread([&next, &f, n, chunk, t]() {
+                int i0, i;
+                while ((i0 = next.fetch_add(chunk)) < n)
+                    for (i = i0; i < i0 + chunk && i < n; i++)
+                        f(i, t);
+            }));
+        }
+        for (int t = 0; t < nthreads; t++)
+            workers[t].join();
+        return;
+    }
+#endif
+    for (i = 0; i < n; i++)
+        f(i, 0);
+}
+
+template <class Item>
+class MexExplorer {
+public:
+    explicit MexExplorer(int nthreads)
+        : nt(mex_num_threads(nthreads)), q(nt), pending(0), halted(0) {}
+
+    int num_threads() const { return nt; }
+
+    /* Queue an item on the deque of worker tid (0 before run()) */
+    void push(int tid, const Item &it)
+    {
+        pending++;
+        mex_lock l(q[tid].m);
+        q[tid].d.push_back(it);
+    }
+
+    void stop() { halted = 1; }
+    bool stopped() const { return halted != 0; }
+
+    /* Call f(item,tid) for all items, including those pushed by f */
+    template <class F>
+    void run(F f)
+    {
+#ifndef MEX_NO_THREADS
+        if (nt > 1) {
+            std::vector<std::thread> workers;
+            for (int t = 0; t < nt; t++)
+                workers.push_back(std::thread([this, &f, t]() { work(f, t); }));
+            for (int t = 0; t < nt; t++)
+                workers[t].join();
+            return;
+        }
+#endif
+        work(f, 0);
+    }
+
+private:
+    struct Deque {
+        std::deque<Item> d;
+        mex_mutex m;
+    };
+    int nt;
+    std::vector<Deque> q;
+    mex_counter pending;   /* items queued or being processed */
+    mex_counter halted;
+
+    bool pop(int t, Item &it)
+    {
+        {
+            mex_lock l(q[t].m);
+            if (!q[t].d.empty()) {
+                it = q[t].d.back();
+                q[t].d.pop_back();
+                return true;
+            }
+        }
+        for (int k = 1; k < nt; k++) {
+            Deque &v = q[(t + k) % nt];
+            mex_lock l(v.m);
+            if (!v.d.empty()) {
+                it = v.d.front();
+                v.d.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <class F>
+    void work(F &f, int t)
+    {
+        Item it;
+        while (!halted) {
+            if (pop(t, it)) {
+                f(it, t);
+                pending--;
+            }
+            else if (pending == 0)
+                break;
+#ifndef MEX_NO_THREADS
+            else
+                std::this_thread::yield();
+#endif
+        }
+    }
+};
+
+#endif
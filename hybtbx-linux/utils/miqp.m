@@ -16,7 +16,12 @@ function [xmin, fmin, flag, Extendedflag] = ...
 %             lb <= x <= ub
 %
 %          is imposed. If x0 is supplied, then x0 is taken as initial condition
-%          for the search of the optimum xmin.
+%          for the search of the optimum xmin. If moreover x0(vartype) is
+%          binary (e.g. the optimizer of the previous step of a receding
+%          horizon controller, shifted by one step), x0 is used as a hint:
+%          the relaxed problem with x(vartype)=x0(vartype) is solved first,
+%          so that its solution is the first incumbent, and when branching
+%          on x(i) the subproblem with x(i)=x0(i) is solved first.
 %          The variables indexed by vartype are binary, or more precisely
 %
 %             x(vartype) in {0,1} 
@@ -184,6 +189,22 @@ function [xmin, fmin, flag, Extendedflag] = ...
 %                       it is rounded to the next integer value
 %                    (default : 1)
 %
+%          Options.native {0|1}
+%
+%                    1: if MIQPBBMEX is compiled and H is positive definite,
+%                       the branch and bound runs natively (MIQPBB.CPP):
+%                       the relaxed QPs are solved by QPDUAL, warm started
+%                       from the active set of the parent node, and the
+%                       nodes are processed in parallel. Options.solver,
+%                       inftol, postol and optimset are then not used.
+%                    0: always use the solver specified by Options.solver
+%                    (default : 0)
+%
+%          Options.nthreads {nonnegative integer}
+%
+%                    number of threads of the native branch and bound
+%                    (default : 0 = all cores)
+%
 %          Calling miqp.m without input arguments reports the version number
 %
 % Outputs: xmin:  minimizer of the MIQP
@@ -265,6 +286,8 @@ default_maxQPiter  = 1000;       % specify here the default maxQPiter
 default_solverlp   = 'linprog';  % specify here the default solver for LPs
 default_round      = 1;          % specify here the default round-flag
 default_xxmax      = 1e7;        % specify here the default xmax for qpact
+default_native     = 0;          % specify here the default native-flag
+default_nthreads   = 0;          % specify here the default nthreads
 
 % handle the different fields of 'Options'
 % ----------------------------------------
@@ -411,6 +434,18 @@ if isfield(Options,'round')
 else
     rounding = default_round;  
 end
+
+if isfield(Options,'native')
+    native = Options.native;
+else
+    native = default_native;
+end
+
+if isfield(Options,'nthreads')
+    nthreads = Options.nthreads;
+else
+    nthreads = default_nthreads;
+end
 % checking dimensions  
 % -------------------
 
@@ -530,6 +565,11 @@ end
 if isempty(ub),
     ub = inf*ones(nx,1);
 end
+hint = ~isempty(x0) && ~isempty(vartype) && all(isfinite(x0));
+if hint
+    x0hint = x0(vartype);
+    hint   = all(x0hint==0 | x0hint==1);
+end
 if isempty(x0),
     x0  = zeros(nx,1);
 end
@@ -613,6 +653,46 @@ index2       = find(aux2>1);
 aux2(index2) = 1;
 ub(vartype)  = aux2;
 
+if hint
+    hintOK = all(x0hint>=lb(vartype) & x0hint<=ub(vartype)); % hint node allowed
+end
+
+% Native branch and bound
+% -----------------------
+
+if native && exist('miqpbbmex')~=3,
+    warning('MIQPBBMEX is not compiled, using MIQP.M');
+end
+if native && (nx > 0) && ~any(strcmp(solver,{'lp','linprog','lpnag'})) && ...
+        exist('miqpbbmex')==3,
+    [R,p] = chol(H);
+    if p == 0
+        if isempty(Aeq)
+            Aeq = zeros(0,nx);
+        end
+        bbopts = struct('method',find(strcmp(method,{'depth','breadth','best','bestdepth'}))-1, ...
+            'branchrule',find(strcmp(branchrule,{'first','max','min'}))-1, ...
+            'order',order,'maxqp',maxqp,'integtol',integtol,'round',rounding, ...
+            'maxQPiter',maxQPiter,'nthreads',nthreads);
+        if hint
+            bbx0 = x0;
+        else
+            bbx0 = [];
+        end
+        [xmin,fmin,flag,QPiter,optQP] = miqpbbmex(full(H),f,full(A),b,full(Aeq),beq(:), ...
+            vartype,lb,ub,bbx0,bbopts);
+        if verbose >= 1
+            disp('QPiter = ') , disp(QPiter)
+            disp('zstar  = ') , disp(fmin)
+            disp('xstar  = ') , disp(xmin')
+        end
+        Extendedflag.QPiter = QPiter;
+        Extendedflag.optQP  = optQP;
+        Extendedflag.time   = toc;
+        return
+    end
+end
+
 % The variable STACK is used to store the relaxed QP problems, that are
 % generated during the Branch and Bound algorithm. 
 % It's global to allow the subroutines at the end of the m-file to access it.
@@ -648,6 +728,15 @@ end
 STACKCOST = 0;    % Array storing the cost of the father problem, ordered in
 % decreasing fashion (STACKCOST(1)=largest value)
 
+% The subproblem with the binary variables fixed by the hint x0 is solved
+% first
+if hint && hintOK
+    subprob = STACK(1);
+    subprob.lb(vartype) = x0hint;
+    subprob.ub(vartype) = x0hint;
+    push(subprob,-inf);
+end
+
 % ==============================================================================
 % Main Loop
 % ==============================================================================
@@ -915,7 +1004,14 @@ while (STACKSIZE > 0)&(QPiter < maxqp)&(flag ~= -1)
                     case 'bestdepth' 
                         cost = zpi/(subprob.level+1); % This privilegiates deep nodes
                 end
-                if order == 0
+                if hint
+                    % the subproblem agreeing with the hint goes first
+                    ifree    = find(subprob.ivalues==-1);
+                    firstval = x0hint(ifree(branchvar));
+                else
+                    firstval = order;
+                end
+                if firstval == 0
                     if oneOK
                         push(p1,cost);
                     end
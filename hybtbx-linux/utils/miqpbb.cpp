@@ -0,0 +1,392 @@
+/* Parallel branch and bound MIQP solver - implementation
+
+   See MIQPBB.H for the API.
+
+   The relaxed QPs have the constraint rows [Aeq; A; I(iu,:); -I(il,:)],
+   where iu, il are the variables with finite upper and lower bounds (all
+   the binary variables are among them). A node only changes the right
+   hand side of the bound rows of the binary variables it fixes, so the
+   row indices of an active set keep their meaning from a node to its
+   children and can be passed to QPDUAL_SET_ACTIVE.
+
+   The pool of nodes is a heap ordered by the cost used by MIQP.M to
+   insert a node in its stack and, for equal costs, by the reverse
+   insertion order (the stack is last in, first out). The pool, the
+   incumbent and the counters share one lock, which is held only between
+   QPs. Each worker owns its QP solver.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "miqpbb.h"
+#include "qpdual.h"
+#include "mexthreads.h"
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+struct BBNode {
+    std::vector<signed char> fix;   /* per binary: -1 free, 0 or 1 */
+    std::vector<int> act;           /* active set of the parent QP */
+    double bound;                   /* cost of the parent QP */
+    double key;                     /* position in the stack of MIQP.M */
+    long seq;
+    int level;
+};
+
+/* a comes after b */
+static bool bb_later(const BBNode &a, const BBNode &b)
+{
+    if (a.key != b.key)
+        return a.key > b.key;
+    return a.seq < b.seq;
+}
+
+struct miqpbb_struct {
+    int n, m;                       /* variables, constraint rows */
+    int meq;
+    std::vector<double> H, f;
+    std::vector<double> A, b;       /* m-by-n column-major, m */
+    std::vector<int> ivar;
+    std::vector<int> urow, lrow;    /* bound rows of the binary variables */
+    std::vector<double> lb, ub;     /* bounds of the binary variables */
+    std::vector<signed char> hint;  /* per binary, empty if no hint */
+    qpdual_t *qp;                   /* solver of worker 0 */
+};
+
+struct BBSearch {
+    const miqpbb_struct *mi;
+    const miqpbb_settings *set;
+    std::vector<BBNode> heap;
+    mex_mutex mx;
+    mex_cond idle;                  /* signaled when busy drops or halted is set */
+    long seq, nqp, optqp;
+    int busy;                       /* nodes being processed */
+    bool halted, feasible;
+    double zstar;
+    std::vector<double> xstar;
+
+    void push(BBNode &nd)
+    {
+        nd.seq = seq++;
+        heap.push_back(nd);
+        std::push_heap(heap.begin(), heap.end(), bb_later);
+    }
+
+    /* Take the next node to solve. Returns false when the search is over.
+       With the heap empty, waits until a node being processed is done (and
+       may have pushed its children). */
+    bool next(BBNode &nd, long &k)
+    {
+        mex_lock l(mx);
+        for (;;) {
+            if (halted)
+                return false;
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), bb_later);
+                nd = heap.back();
+                heap.pop_back();
+                if (nd.bound > zstar)
+                    continue;
+                if (nqp >= set->maxqp) {
+                    halted = true;
+                    idle.notify_all();
+                    return false;
+                }
+                k = ++nqp;
+                busy++;
+                return true;
+            }
+            if (busy == 0)
+                return false;
+            idle.wait(mx);
+        }
+    }
+
+    /* Node done, called with mx locked. The waiting workers resume when
+       mx is released, after the children are pushed. */
+    void done()
+    {
+        busy--;
+        idle.notify_all();
+    }
+
+    void process(qpdual_t *qp, BBNode &nd, long k, std::vector<double> &bn,
+                 std::vector<double> &x, std::vector<int> &act);
+};
+
+void miqpbb_default_settings(miqpbb_settings *set)
+{
+    set->nthreads = 0;
+    set->method = MIQPBB_DEPTH;
+    set->branchrule = MIQPBB_FIRST;
+    set->order = 0;
+    set->maxqp = std::numeric_limits<double>::infinity();
+    set->integtol = 1e-4;
+    set->round = 1;
+    set->maxqpiter = 0;
+}
+
+miqpbb_t *miqpbb_new(int n, const double *H, const double *f, int m, const double *A,
+                     const double *b, int meq, const double *Aeq, const double *beq,
+                     int nivar, const int *ivar, const double *lb, const double *ub)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> l(n, -inf), u(n, inf);
+    std::vector<int> iu, il, ubin(n, -1), lbin(n, -1);
+    miqpbb_t *mi;
+    int i, j, k, r;
+
+    qpdual_t *qp = qpdual_new(n, H);
+    if (!qp)
+        return NULL;
+
+    for (i = 0; i < n; i++) {
+        if (lb)
+            l[i] = lb[i];
+        if (ub)
+            u[i] = ub[i];
+    }
+    for (k = 0; k < nivar; k++) {
+        i = ivar[k];
+        l[i] = std::max(l[i], 0.0);
+        u[i] = std::min(u[i], 1.0);
+    }
+    for (i = 0; i < n; i++) {
+        if (u[i] < inf)
+            iu.push_back(i);
+        if (l[i] > -inf)
+            il.push_back(i);
+    }
+
+    mi = new miqpbb_struct;
+    mi->n = n;
+    mi->meq = meq;
+    mi->m = meq + m + (int) iu.size() + (int) il.size();
+    mi->H.assign(H, H + (size_t) n * n);
+    mi->f.assign(f, f + n);
+    mi->ivar.assign(ivar, ivar + nivar);
+    mi->qp = qp;
+
+    mi->A.assign((size_t) mi->m * n, 0.0);
+    mi->b.resize(mi->m);
+    for (r = 0; r < meq; r++) {
+        for (j = 0; j < n; j++)
+            mi->A[r + (size_t) j * mi->m] = Aeq[r + (size_t) j * meq];
+        mi->b[r] = beq[r];
+    }
+    for (i = 0; i < m; i++, r++) {
+        for (j = 0; j < n; j++)
+            mi->A[r + (size_t) j * mi->m] = A[i + (size_t) j * m];
+        mi->b[r] = b[i];
+    }
+    for (k = 0; k < (int) iu.size(); k++, r++) {
+        mi->A[r + (size_t) iu[k] * mi->m] = 1.0;
+        mi->b[r] = u[iu[k]];
+        ubin[iu[k]] = r;
+    }
+    for (k = 0; k < (int) il.size(); k++, r++) {
+        mi->A[r + (size_t) il[k] * mi->m] = -1.0;
+        mi->b[r] = -l[il[k]];
+        lbin[il[k]] = r;
+    }
+    for (k = 0; k < nivar; k++) {
+        i = ivar[k];
+        mi->urow.push_back(ubin[i]);
+        mi->lrow.push_back(lbin[i]);
+        mi->lb.push_back(l[i]);
+        mi->ub.push_back(u[i]);
+    }
+    return mi;
+}
+
+void BBSearch::process(qpdual_t *qp, BBNode &nd, long k, std::vector<double> &bn,
+                       std::vector<double> &x, std::vector<int> &act)
+{
+    const int n = mi->n, nb = (int) mi->ivar.size();
+    int i, j, kb, br, first, status;
+    double z, frac, fbest, fmax;
+
+    bn = mi->b;
+    for (kb = 0; kb < nb; kb++)
+        if (nd.fix[kb] >= 0) {
+            bn[mi->urow[kb]] = nd.fix[kb];
+            bn[mi->lrow[kb]] = -nd.fix[kb];
+        }
+    qpdual_set_active(qp, (int) nd.act.size(), nd.act.data());
+    status = qpdual_solve(qp, mi->m, mi->meq, mi->A.data(), bn.data(), mi->f.data(),
+                          x.data(), NULL, NULL);
+
+    if (status != QPDUAL_OK) {
+        /* node fathomed */
+        mex_lock l(mx);
+        done();
+        return;
+    }
+
+    z = 0.0;
+    for (j = 0; j < n; j++) {
+        double hx = 0.0;
+        for (i = 0; i < n; i++)
+            hx += mi->H[i + (size_t) j * n] * x[i];
+        z += (.5 * hx + mi->f[j]) * x[j];
+    }
+
+    /* branching variable (position in ivar), -1 if x is integer feasible.
+       As in MIQP.M, the rules choose among all the free variables. */
+    br = -1;
+    fmax = 0.0;
+    fbest = 0.0;
+    for (kb = 0; kb < nb; kb++) {
+        if (nd.fix[kb] >= 0)
+            continue;
+        frac = std::fabs(x[mi->ivar[kb]] - std::floor(x[mi->ivar[kb]] + .5));
+        fmax = std::max(fmax, frac);
+        if (br < 0 || (set->branchrule == MIQPBB_MAXFRAC && frac > fbest)
+            || (set->branchrule == MIQPBB_MINFRAC && frac < fbest)) {
+            br = kb;
+            fbest = frac;
+        }
+    }
+    if (fmax < set->integtol)
+        br = -1;
+
+    if (br >= 0) {
+        act.resize(mi->m);
+        act.resize(qpdual_get_active(qp, act.data()));
+    }
+
+    mex_lock l(mx);
+    done();
+    feasible = true;
+    if (z > zstar)
+        return;
+    if (br < 0) {
+        zstar = z;
+        optqp = k;
+        xstar = x;
+        for (kb = 0; kb < nb; kb++) {
+            i = mi->ivar[kb];
+            if (nd.fix[kb] >= 0)
+                xstar[i] = nd.fix[kb];
+            else if (set->round)
+                xstar[i] = std::floor(x[i] + .5);
+        }
+        return;
+    }
+
+    BBNode c;
+    c.act = act;
+    c.bound = z;
+    c.level = nd.level + 1;
+    switch (set->method) {
+    case MIQPBB_BREADTH:
+        c.key = nd.level + 1;
+        break;
+    case MIQPBB_BEST:
+        c.key = z;
+        break;
+    case MIQPBB_BESTDEPTH:
+        c.key = z / (nd.level + 1);
+        break;
+    default:
+        c.key = 1.0 / (nd.level + 1);
+    }
+    /* the child pushed last is solved first */
+    first = mi->hint.empty() ? set->order : mi->hint[br];
+    for (i = 0; i < 2; i++) {
+        int v = first ? i : 1 - i;
+        if (mi->lb[br] > v || mi->ub[br] < v)
+            continue;
+        c.fix = nd.fix;
+        c.fix[br] = (signed char) v;
+        push(c);
+    }
+}
+
+void miqpbb_set_hint(miqpbb_t *mi, const double *x0)
+{
+    mi->hint.clear();
+    if (x0)
+        for (size_t k = 0; k < mi->ivar.size(); k++)
+            mi->hint.push_back(x0[mi->ivar[k]] > .5 ? 1 : 0);
+}
+
+int miqpbb_solve(miqpbb_t *mi, const miqpbb_settings *set, double *x, double *fmin,
+                 long *nqp, long *optqp)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    int nt = mex_num_threads(set->nthreads), t, k, flag;
+    std::vector<qpdual_t *> qp(nt, (qpdual_t *) NULL);
+    BBSearch S;
+    BBNode root;
+
+    S.mi = mi;
+    S.set = set;
+    S.seq = S.nqp = S.optqp = 0;
+    S.busy = 0;
+    S.halted = S.feasible = false;
+    S.zstar = inf;
+    S.xstar.assign(mi->n, std::numeric_limits<double>::quiet_NaN());
+
+    root.fix.assign(mi->ivar.size(), -1);
+    root.bound = -inf;
+    root.key = 0.0;
+    root.level = 0;
+    S.push(root);
+    if (!mi->hint.empty()) {
+        /* the bounds of a fixed binary are replaced, so a hint outside
+           them would give a wrong incumbent */
+        for (k = 0; k < (int) mi->hint.size(); k++)
+            if (mi->lb[k] > mi->hint[k] || mi->ub[k] < mi->hint[k])
+                break;
+        if (k == (int) mi->hint.size()) {
+            root.fix = mi->hint;
+            S.push(root);
+        }
+    }
+
+    qp[0] = mi->qp;
+    for (t = 1; t < nt; t++)
+        qp[t] = qpdual_new(mi->n, mi->H.data());
+    for (t = 0; t < nt; t++)
+        qpdual_set_maxiter(qp[t], set->maxqpiter);
+
+    mex_parallel_for(nt, nt, 1, [&S, &qp](int, int t) {
+        std::vector<double> bn, x(S.mi->n);
+        std::vector<int> act;
+        BBNode nd;
+        long k;
+        while (S.next(nd, k))
+            S.process(qp[t], nd, k, bn, x, act);
+    });
+
+    for (t = 1; t < nt; t++)
+        qpdual_free(qp[t]);
+
+    if (S.optqp > 0)
+        flag = MIQPBB_INTFEAS;
+    else if (S.feasible)
+        flag = MIQPBB_FEASIBLE;
+    else
+        flag = MIQPBB_INFEASIBLE;
+    if (S.nqp >= set->maxqp && flag != MIQPBB_INFEASIBLE)
+        flag += MIQPBB_MAXQP;
+
+    std::copy(S.xstar.begin(), S.xstar.end(), x);
+    *fmin = S.zstar;
+    if (nqp)
+        *nqp = S.nqp;
+    if (optqp)
+        *optqp = S.optqp;
+    return flag;
+}
+
+void miqpbb_free(miqpbb_t *mi)
+{
+    if (mi) {
+        qpdual_free(mi->qp);
+        delete mi;
+    }
+}
@@ -0,0 +1,98 @@
+/* Parallel branch and bound MIQP solver - C API
+
+   Solves the mixed-integer QP
+
+       min  .5*x'*H*x + f'*x
+       s.t. A*x <= b,  Aeq*x = beq,  lb <= x <= ub,  x(ivar) in {0,1}
+
+   (H positive definite) by the branch and bound algorithm of MIQP.M. A
+   node of the tree fixes some of the binary variables; its relaxation
+   keeps all n variables and fixes x(i)=v by setting both bounds of x(i)
+   to v, so that all relaxed QPs have the same constraint rows and only
+   the right hand side changes. Each QP is solved by the dual active-set
+   solver in QPDUAL.CPP, warm started from the active set of the parent
+   node (a child differs from its parent by one bound).
+
+   Nodes wait in a pool ordered as the stack of MIQP.M (same methods,
+   branching rules and order of the children), so that with one thread
+   the tree is explored in the same order. With several threads each
+   worker takes the first node of the pool; the incumbent solution is
+   shared, and nodes whose parent bound is worse than the incumbent are
+   discarded without solving their QP.
+
+   A hint on the binary variables (e.g. the solution of the previous
+   sampling step, shifted by one step) can be supplied: the QP with the
+   binaries fixed to the hint is solved first and gives the first
+   incumbent, and when branching the child that agrees with the hint is
+   explored first.
+
+   Matrices are column-major (MATLAB layout). See MIQPBBMEX.CPP for the
+   MEX interface; MIQP.M calls it when it is compiled.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef MIQPBB_H
+#define MIQPBB_H
+
+/* Flags, as in MIQP.M */
+#define MIQPBB_INTFEAS         1   /* integer feasible (optimal) */
+#define MIQPBB_FEASIBLE        5   /* feasible, no integer feasible solution */
+#define MIQPBB_INFEASIBLE      7
+#define MIQPBB_MAXQP          10   /* added to 1 or 5 if maxqp was reached */
+
+#define MIQPBB_DEPTH           0
+#define MIQPBB_BREADTH         1
+#define MIQPBB_BEST            2
+#define MIQPBB_BESTDEPTH       3
+
+#define MIQPBB_FIRST           0
+#define MIQPBB_MAXFRAC         1
+#define MIQPBB_MINFRAC         2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct miqpbb_struct miqpbb_t;
+
+typedef struct {
+    int nthreads;       /* worker threads (<=0: all cores) */
+    int method;         /* MIQPBB_DEPTH, ... (depth first) */
+    int branchrule;     /* MIQPBB_FIRST, ... (first free variable) */
+    int order;          /* 0: child with x(i)=0 first, 1: x(i)=1 first */
+    double maxqp;       /* maximum number of relaxed QPs (inf) */
+    double integtol;    /* tolerance to recognize integers (1e-4) */
+    int round;          /* round the binary variables of the solution (1) */
+    int maxqpiter;      /* iterations of each QP (0: automatic). A QP that
+                           does not converge fathoms its node. */
+} miqpbb_settings;
+
+void miqpbb_default_settings(miqpbb_settings *set);
+
+/* Create the problem (data are copied) with n variables, m inequalities
+   and meq equalities. ivar (nivar 0-based indices) are the binary
+   variables; lb, ub (n, may be NULL, +/-inf allowed) are clipped to [0,1]
+   on them. Returns NULL if H is not positive definite. */
+miqpbb_t *miqpbb_new(int n, const double *H, const double *f, int m, const double *A,
+                     const double *b, int meq, const double *Aeq, const double *beq,
+                     int nivar, const int *ivar, const double *lb, const double *ub);
+
+/* Set the hint from x0 (n, the entries of the binary variables must be
+   0 or 1), or clear it if x0 is NULL */
+void miqpbb_set_hint(miqpbb_t *mi, const double *x0);
+
+/* Run the branch and bound. x (n) receives the best solution found
+   (NaN if none), fmin its cost (inf if none). nqp and optqp (may be NULL)
+   receive the number of QPs solved and the number of the QP where the
+   best solution was found. Returns one of the MIQPBB_* flags. */
+int miqpbb_solve(miqpbb_t *mi, const miqpbb_settings *set, double *x, double *fmin,
+                 long *nqp, long *optqp);
+
+void miqpbb_free(miqpbb_t *mi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
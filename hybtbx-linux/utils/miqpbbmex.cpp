@@ -0,0 +1,135 @@
+/* Parallel branch and bound MIQP solver - MEX interface
+
+   [xmin,fmin,flag,nqp,optqp]=miqpbbmex(H,f,A,b,Aeq,beq,vartype,lb,ub,x0,opts)
+
+   Solves the MIQP
+
+       min  .5*x'*H*x + f'*x
+       s.t. A*x <= b,  Aeq*x = beq,  lb <= x <= ub,  x(vartype) in {0,1}
+
+   by the solver in MIQPBB.CPP (H positive definite). vartype contains the
+   1-based indices of the binary variables, lb and ub are empty or have
+   one entry per variable (+/-Inf allowed). The outputs are as in MIQP:
+   flag = 1 integer feasible, 5 feasible but not integer feasible, 7
+   infeasible, 11 or 15 if the limit maxqp was reached; nqp is the number
+   of QPs solved and optqp the QP where xmin was found.
+
+   If x0 is not empty, x0(vartype) (0 or 1) is a hint: the QP with
+   x(vartype)=x0(vartype) is solved first, and when branching on x(i) the
+   child x(i)=x0(i) is explored first (instead of the one set by order).
+
+   opts is a structure with optional fields
+       nthreads   = number of worker threads (default: all cores)
+       method     = 0 depth, 1 breadth, 2 best, 3 bestdepth first (0)
+       branchrule = 0 first free, 1 max fractional part, 2 min (0)
+       order      = 0 child x(i)=0 first, 1 child x(i)=1 first (0)
+       maxqp      = maximum number of QPs (Inf)
+       integtol   = tolerance to recognize integers (1e-4)
+       round      = round the binary variables of xmin (1)
+       maxQPiter  = maximum number of iterations of each QP (automatic)
+
+   Compile with MEXCOMPILE.M (or mex -O miqpbbmex.cpp miqpbb.cpp qpdual.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "miqpbb.h"
+#include <vector>
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+static void getfull(const mxArray *a, const char *name, int m, int n)
+{
+    if (!mxIsDouble(a) || mxIsSparse(a) || (int) mxGetM(a) != m || (int) mxGetN(a) != n)
+        mexErrMsgIdAndTxt("miqpbbmex:dim", "%s must be a full %d-by-%d matrix.", name, m, n);
+}
+
+static const double *getvec(const mxArray *a, const char *name, int n)
+{
+    if (mxIsEmpty(a))
+        return NULL;
+    if (!mxIsDouble(a) || mxIsSparse(a) || (int) mxGetNumberOfElements(a) != n)
+        mexErrMsgIdAndTxt("miqpbbmex:dim", "%s must have %d elements.", name, n);
+    return mxGetPr(a);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    miqpbb_settings set;
+    miqpbb_t *mi;
+    int n, m, meq, nivar, i, flag;
+    long nqp = 0, optqp = 0;
+    double fmin;
+    std::vector<int> ivar;
+    const double *v;
+
+    if (nrhs < 9)
+        mexErrMsgTxt("At least nine input arguments required.");
+
+    n = (int) mxGetM(prhs[0]);
+    m = (int) mxGetM(prhs[2]);
+    meq = (int) mxGetM(prhs[4]);
+    getfull(prhs[0], "H", n, n);
+    if (!getvec(prhs[1], "f", n))
+        mexErrMsgTxt("f must have as many elements as the columns of H.");
+    getfull(prhs[2], "A", m, n);
+    if (m > 0 && !getvec(prhs[3], "b", m))
+        mexErrMsgTxt("b has wrong dimension.");
+    if (meq > 0) {
+        getfull(prhs[4], "Aeq", meq, n);
+        if (!getvec(prhs[5], "beq", meq))
+            mexErrMsgTxt("beq has wrong dimension.");
+    }
+
+    nivar = (int) mxGetNumberOfElements(prhs[6]);
+    v = mxGetPr(prhs[6]);
+    for (i = 0; i < nivar; i++) {
+        if (v[i] < 1 || v[i] > n)
+            mexErrMsgTxt("Index in vartype out of range.");
+        ivar.push_back((int) v[i] - 1);
+    }
+
+    miqpbb_default_settings(&set);
+    if (nrhs > 10) {
+        set.nthreads = (int) getopt(prhs[10], "nthreads", set.nthreads);
+        set.method = (int) getopt(prhs[10], "method", set.method);
+        set.branchrule = (int) getopt(prhs[10], "branchrule", set.branchrule);
+        set.order = (int) getopt(prhs[10], "order", set.order);
+        set.maxqp = getopt(prhs[10], "maxqp", set.maxqp);
+        set.integtol = getopt(prhs[10], "integtol", set.integtol);
+        set.round = (int) getopt(prhs[10], "round", set.round);
+        set.maxqpiter = (int) getopt(prhs[10], "maxQPiter", set.maxqpiter);
+    }
+
+    mi = miqpbb_new(n, mxGetPr(prhs[0]), mxGetPr(prhs[1]), m, mxGetPr(prhs[2]),
+                    mxGetPr(prhs[3]), meq, mxGetPr(prhs[4]), mxGetPr(prhs[5]), nivar,
+                    ivar.data(), getvec(prhs[7], "lb", n), getvec(prhs[8], "ub", n));
+    if (!mi)
+        mexErrMsgIdAndTxt("miqpbbmex:notposdef", "H is not positive definite.");
+
+    if (nrhs > 9)
+        miqpbb_set_hint(mi, getvec(prhs[9], "x0", n));
+
+    plhs[0] = mxCreateDoubleMatrix(n, 1, mxREAL);
+    flag = miqpbb_solve(mi, &set, mxGetPr(plhs[0]), &fmin, &nqp, &optqp);
+    miqpbb_free(mi);
+
+    if (nlhs > 1)
+        plhs[1] = mxCreateDoubleScalar(fmin);
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(flag);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar((double) nqp);
+    if (nlhs > 4)
+        plhs[4] = mxCreateDoubleScalar((double) optqp);
+}
@@ -0,0 +1,430 @@
+/* Parallel enumeration of the modes of an MLD system - implementation
+
+   See MLD2PWAPAR.H for the API.
+
+   At a leaf (b fixed, rhs r = g - Gb*b) the implicit equalities E are
+   found by solving
+
+       max  t
+       s.t. Gy(E,:)*y = r(E)
+            Gy(i,:)*y + t*norm(Gy(i,:)) <= r(i),   i not in E
+            t <= 1
+
+   If t > eqtol the set is full-dimensional in the affine subspace of E.
+   Otherwise the rows with a positive multiplier cannot be strict and are
+   moved to E, and the LP is solved again. z is then eliminated through
+   E by Gauss-Jordan elimination with complete pivoting on the z columns:
+   rows of E left without a pivot must vanish, otherwise the mode is flat
+   in v.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mld2pwapar.h"
+#include "lpdense.h"
+#include "polydense.h"
+#include "mexthreads.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+struct MWRegion {
+    std::vector<double> b, H, K, Zv, Zc, xc;
+    double rcheb;
+};
+
+/* Node of the binary tree: the first b.size() binaries are fixed */
+struct MWItem {
+    std::vector<double> b;
+};
+
+struct mld2pwapar_struct {
+    int nv, nz, ny, nb, m;
+    std::vector<double> Gy, Gb;    /* m-by-ny, m-by-nb, row-major */
+    std::vector<double> g, gnorm;
+    std::vector<MWRegion> regions;
+};
+
+struct MWWorker {
+    DenseLP lp;
+    std::vector<MWRegion> out;
+    std::vector<double> r, x, c;
+    long nnodes, nlp;
+};
+
+struct MWShared {
+    mld2pwapar_t *mp;
+    const mld2pwapar_settings *set;
+    std::vector<MWWorker *> workers;
+    MexExplorer<MWItem> *ex;
+    mex_counter illposed;
+};
+
+void mld2pwapar_default_settings(mld2pwapar_settings *set)
+{
+    set->nthreads = 0;
+    set->flattol = 1e-8;
+    set->eqtol = 1e-7;
+    set->feastol = 1e-9;
+    set->pivtol = 1e-9;
+    set->removetol = 1e-9;
+}
+
+mld2pwapar_t *mld2pwapar_new(int nv, int nz, int nb, int m, const double *Gy,
+                             const double *Gb, const double *g)
+{
+    int i, j, ny = nv + nz;
+    mld2pwapar_t *mp = new mld2pwapar_struct;
+
+    mp->nv = nv;
+    mp->nz = nz;
+    mp->ny = ny;
+    mp->nb = nb;
+    mp->m = m;
+    mp->Gy.resize((size_t) m * ny);
+    mp->Gb.resize((size_t) m * nb);
+    mp->g.assign(g, g + m);
+    mp->gnorm.assign(m, 0.0);
+    for (i = 0; i < m; i++) {
+        double s = 0;
+        for (j = 0; j < ny; j++) {
+            mp->Gy[(size_t) i * ny + j] = Gy[i + (size_t) j * m];
+            s += Gy[i + (size_t) j * m] * Gy[i + (size_t) j * m];
+        }
+        for (j = 0; j < nb; j++)
+            mp->Gb[(size_t) i * nb + j] = Gb[i + (size_t) j * m];
+        mp->gnorm[i] = std::sqrt(s);
+    }
+    return mp;
+}
+
+void mld2pwapar_free(mld2pwapar_t *mp)
+{
+    delete mp;
+}
+
+int mld2pwapar_num_regions(const mld2pwapar_t *mp)
+{
+    return (int) mp->regions.size();
+}
+
+void mld2pwapar_get_region(const mld2pwapar_t *mp, int i, mld2pwapar_region *r)
+{
+    const MWRegion &R = mp->regions[i];
+    r->nrows = (int) R.K.size();
+    r->b = R.b.empty() ? NULL : &R.b[0];
+    r->H = R.H.empty() ? NULL : &R.H[0];
+    r->K = R.K.empty() ? NULL : &R.K[0];
+    r->Zv = R.Zv.empty() ? NULL : &R.Zv[0];
+    r->Zc = R.Zc.empty() ? NULL : &R.Zc[0];
+    r->xc = R.xc.empty() ? NULL : &R.xc[0];
+    r->rcheb = R.rcheb;
+}
+
+/* rhs g - Gb(:,0:k-1)*b of the rows for the prefix b of length k */
+static void prefix_rhs(const mld2pwapar_t *mp, const std::vector<double> &b,
+                       std::vector<double> &r)
+{
+    int i, j, k = (int) b.size();
+
+    r.resize(mp->m);
+    for (i = 0; i < mp->m; i++) {
+        const double *a = &mp->Gb[(size_t) i * mp->nb];
+        double s = mp->g[i];
+        for (j = 0; j < k; j++)
+            s -= a[j] * b[j];
+        r[i] = s;
+    }
+}
+
+/* Is the LP relaxation of the node feasible? The variables are y and the
+   free binaries b(k:nb-1) in [0,1]. */
+static bool relaxed_feasible(const mld2pwapar_t *mp, MWWorker &w, const MWItem &it)
+{
+    int i, j, k = (int) it.b.size(), ny = mp->ny, nf = mp->nb - k, n = ny + nf;
+    DenseLP &lp = w.lp;
+
+    prefix_rhs(mp, it.b, w.r);
+    lp.resize(n, mp->m + 2 * nf, 0);
+    for (i = 0; i < mp->m; i++) {
+        double *a = lp.row(i);
+        for (j = 0; j < ny; j++)
+            a[j] = mp->Gy[(size_t) i * ny + j];
+        for (j = 0; j < nf; j++)
+            a[ny + j] = mp->Gb[(size_t) i * mp->nb + k + j];
+        lp.b[i] = w.r[i];
+    }
+    for (j = 0; j < nf; j++) {
+        double *a1 = lp.row(mp->m + 2 * j), *a2 = lp.row(mp->m + 2 * j + 1);
+        for (i = 0; i < n; i++)
+            a1[i] = a2[i] = 0.0;
+        a1[ny + j] = 1.0;
+        a2[ny + j] = -1.0;
+        lp.b[mp->m + 2 * j] = 1.0;
+        lp.b[mp->m + 2 * j + 1] = 0.0;
+    }
+    w.c.assign(n, 0.0);
+    w.x.assign(n, 0.0);
+    for (j = 0; j < nf; j++)
+        w.x[ny + j] = .5;
+    w.nlp++;
+    /* Do not prune when the LP fails for numerical reasons */
+    return lp.solve(&w.c[0], &w.x[0]) != LPDENSE_INFEASIBLE;
+}
+
+/* Analyze the mode b (a leaf). Returns false if the mode is discarded. */
+static bool leaf(MWShared &sh, MWWorker &w, const MWItem &it, MWRegion &R)
+{
+    const mld2pwapar_t *mp = sh.mp;
+    const mld2pwapar_settings *set = sh.set;
+    int i, j, l, p, ny = mp->ny, nv = mp->nv, nz = mp->nz, m = mp->m;
+    DenseLP &lp = w.lp;
+    std::vector<char> eq(m, 0), used(m, 0);
+    std::vector<int> rows, pivrow(nz, -1);
+
+    prefix_rhs(mp, it.b, w.r);
+    for (i = 0; i < m; i++) {
+        if (mp->gnorm[i] <= 1e-12) {
+            if (w.r[i] < -set->feastol)
+                return false;
+            used[i] = 1;   /* rows 0*y <= r(i) play no role */
+        }
+    }
+
+    /* Implicit equalities */
+    for (;;) {
+        int me = 0, mi = 0;
+        rows.clear();
+        for (i = 0; i < m; i++)
+            if (!used[i] && eq[i])
+                rows.push_back(i), me++;
+        for (i = 0; i < m; i++)
+            if (!used[i] && !eq[i])
+                rows.push_back(i), mi++;
+        lp.resize(ny + 1, me + mi + 1, me);
+        for (l = 0; l < me + mi; l++) {
+            double *a = lp.row(l);
+            i = rows[l];
+            for (j = 0; j < ny; j++)
+                a[j] = mp->Gy[(size_t) i * ny + j];
+            a[ny] = (l < me) ? 0.0 : mp->gnorm[i];
+            lp.b[l] = w.r[i];
+        }
+        double *a = lp.row(me + mi);
+        for (j = 0; j < ny; j++)
+            a[j] = 0.0;
+        a[ny] = 1.0;
+        lp.b[me + mi] = 1.0;
+
+        /* Start from y=0 and the largest feasible t */
+        w.x.assign(ny + 1, 0.0);
+        w.x[ny] = 1.0;
+        for (l = me; l < me + mi; l++)
+            w.x[ny] = std::min(w.x[ny], lp.b[l] / lp.row(l)[ny]);
+        w.c.assign(ny + 1, 0.0);
+        w.c[ny] = -1.0;
+        w.nlp++;
+        if (lp.solve(&w.c[0], &w.x[0]) != LPDENSE_OPTIMAL)
+            return false;
+        if (w.x[ny] < -set->eqtol)
+            return false;   /* infeasible mode */
+        if (w.x[ny] > set->eqtol)
+            break;
+        int added = 0;
+        for (l = me; l < me + mi; l++)
+            if (lp.lambda[l] > lp.opttol) {
+                eq[rows[l]] = 1;
+                added++;
+            }
+        if (!added)
+            return false;
+    }
+
+    /* Eliminate z through the equalities: rows [Gy_z Gy_v | r] of E */
+    int me = 0;
+    std::vector<double> M;
+    for (i = 0; i < m; i++)
+        if (!used[i] && eq[i]) {
+            const double *a = &mp->Gy[(size_t) i * ny];
+            for (j = 0; j < nz; j++)
+                M.push_back(a[nv + j]);
+            for (j = 0; j < nv; j++)
+                M.push_back(a[j]);
+            M.push_back(w.r[i]);
+            me++;
+        }
+    int nc = nz + nv + 1;
+    std::vector<char> pivoted(me, 0), colpiv(nz, 0);
+    for (p = 0; p < nz; p++) {
+        int bi = -1, bj = -1;
+        double best = set->pivtol;
+        for (i = 0; i < me; i++) {
+            if (pivoted[i])
+                continue;
+            for (j = 0; j < nz; j++)
+                if (!colpiv[j] && std::fabs(M[(size_t) i * nc + j]) > best) {
+                    best = std::fabs(M[(size_t) i * nc + j]);
+                    bi = i;
+                    bj = j;
+                }
+        }
+        if (bi < 0) {
+            sh.illposed++;   /* z is not unique */
+            return false;
+        }
+        pivoted[bi] = 1;
+        colpiv[bj] = 1;
+        pivrow[bj] = bi;
+        double *pr = &M[(size_t) bi * nc], piv = pr[bj];
+        for (j = 0; j < nc; j++)
+            pr[j] /= piv;
+        for (i = 0; i < me; i++) {
+            if (i == bi)
+                continue;
+            double *ri = &M[(size_t) i * nc], f = ri[bj];
+            if (f != 0.0)
+                for (j = 0; j < nc; j++)
+                    ri[j] -= f * pr[j];
+        }
+    }
+    for (i = 0; i < me; i++) {
+        if (pivoted[i])
+            continue;
+        const double *ri = &M[(size_t) i * nc];
+        for (j = nz; j < nz + nv; j++)
+            if (std::fabs(ri[j]) > set->pivtol)
+                return false;   /* flat in v */
+    }
+
+    /* z(j) = r - Gv*v from its pivot row */
+    R.Zv.resize((size_t) nz * nv);
+    R.Zc.resize(nz);
+    for (j = 0; j < nz; j++) {
+        const double *pr = &M[(size_t) pivrow[j] * nc];
+        for (l = 0; l < nv; l++)
+            R.Zv[(size_t) j * nv + l] = -pr[nz + l];
+        R.Zc[j] = pr[nz + nv];
+    }
+
+    /* Region in v: the other rows with z substituted */
+    Polytope P(nv);
+    std::vector<double> h(nv);
+    for (i = 0; i < m; i++) {
+        if (used[i] || eq[i])
+            continue;
+        const double *a = &mp->Gy[(size_t) i * ny];
+        double k = w.r[i], s = 0;
+        for (l = 0; l < nv; l++)
+            h[l] = a[l];
+        for (j = 0; j < nz; j++) {
+            if (a[nv + j] == 0.0)
+                continue;
+            for (l = 0; l < nv; l++)
+                h[l] += a[nv + j] * R.Zv[(size_t) j * nv + l];
+            k -= a[nv + j] * R.Zc[j];
+        }
+        for (l = 0; l < nv; l++)
+            s += h[l] * h[l];
+        s = std::sqrt(s);
+        if (s <= 1e-12) {
+            if (k < -set->feastol)
+                return false;
+            continue;
+        }
+        for (l = 0; l < nv; l++)
+            h[l] /= s;
+        P.add_row(&h[0], k / s);
+    }
+    int lpsolved = 0;
+    std::vector<double> x0;
+    if (poly_reduce(lp, P, set->removetol, x0, 1e-8, NULL, &lpsolved)) {
+        w.nlp += lpsolved;
+        return false;
+    }
+    w.nlp += lpsolved + 1;
+    R.xc = x0;
+    R.xc.resize(nv, 0.0);
+    if (nv > 0)
+        poly_chebyshev(lp, P, NULL, NULL, &R.xc[0], &R.rcheb);
+    else
+        R.rcheb = std::numeric_limits<double>::infinity();
+    if (!(R.rcheb > set->flattol))
+        return false;
+    R.H = P.A;
+    R.K = P.b;
+    R.b = it.b;
+    return true;
+}
+
+static void process(MWShared &sh, int tid, const MWItem &it)
+{
+    const mld2pwapar_t *mp = sh.mp;
+    MWWorker &w = *sh.workers[tid];
+
+    w.nnodes++;
+    if ((int) it.b.size() < mp->nb) {
+        if (!relaxed_feasible(mp, w, it))
+            return;
+        MWItem it2 = it;
+        it2.b.push_back(0.0);
+        sh.ex->push(tid, it2);
+        it2.b.back() = 1.0;
+        sh.ex->push(tid, it2);
+    }
+    else {
+        MWRegion R;
+        if (leaf(sh, w, it, R))
+            w.out.push_back(R);
+    }
+}
+
+int mld2pwapar_solve(mld2pwapar_t *mp, const mld2pwapar_settings *set, int nprefix,
+                     int depth, const double *prefix, long *nnodes, long *nlp)
+{
+    int nt, t, k;
+    MWShared sh;
+
+    mp->regions.clear();
+    if (nnodes)
+        *nnodes = 0;
+    if (nlp)
+        *nlp = 0;
+    if (depth > mp->nb)
+        return MLD2PWAPAR_OK;
+
+    MexExplorer<MWItem> ex(set->nthreads);
+    nt = ex.num_threads();
+    sh.mp = mp;
+    sh.set = set;
+    sh.ex = &ex;
+    sh.illposed = 0;
+    for (t = 0; t < nt; t++) {
+        MWWorker *w = new MWWorker;
+        w->nnodes = w->nlp = 0;
+        sh.workers.push_back(w);
+    }
+    /* Queue the prefixes round robin, so that idle workers steal less */
+    for (k = 0; k < nprefix; k++) {
+        MWItem it;
+        it.b.assign(prefix + (size_t) k * depth, prefix + (size_t) (k + 1) * depth);
+        ex.push(k % nt, it);
+    }
+    ex.run([&sh](const MWItem &item, int tid) { process(sh, tid, item); });
+
+    for (t = 0; t < nt; t++) {
+        MWWorker *w = sh.workers[t];
+        for (size_t l = 0; l < w->out.size(); l++)
+            mp->regions.push_back(w->out[l]);
+        if (nnodes)
+            *nnodes += w->nnodes;
+        if (nlp)
+            *nlp += w->nlp;
+        delete w;
+    }
+
+    /* The order in which modes are found depends on the threads */
+    std::sort(mp->regions.begin(), mp->regions.end(), [](const MWRegion &a, const MWRegion &c) {
+        return a.b < c.b;
+    });
+    return sh.illposed ? MLD2PWAPAR_ILLPOSED : MLD2PWAPAR_OK;
+}
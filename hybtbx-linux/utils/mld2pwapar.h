@@ -0,0 +1,86 @@
+/* Parallel enumeration of the modes of an MLD system - C API
+
+   The constraints of an MLD system, with the continuous variables
+   y=[v;z], v=[xr;ur], and the binary variables b=[xb;ub;delta], read
+
+       Gy*y + Gb*b <= g
+
+   (the bounds on v are rows of Gy as well). A mode is a value of b for
+   which the set of feasible v is full-dimensional. In each mode z is a
+   unique affine function z = Zv*v + Zc of v (the MLD is well posed),
+   and the feasible v form the region {v: H*v <= K}.
+
+   Modes are enumerated by a depth-first search on the binary tree of
+   b(1),b(2),...: a node fixes a prefix of b and is pruned if the LP
+   relaxation (the free binaries in [0,1]) is infeasible. At the leaves
+   the implicit equalities of the constraints are detected by LPs, z is
+   eliminated through them and the region is reduced. Subtrees are
+   processed by several worker threads (MexExplorer in MEXTHREADS.H).
+
+   The search starts from a list of prefixes, so that a large tree can
+   be processed in batches. Matrices are column-major (MATLAB layout).
+   See MLD2PWAPARMEX.CPP for the MEX interface and MLD2PWAPAR.M for the
+   MATLAB wrapper.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef MLD2PWAPAR_H
+#define MLD2PWAPAR_H
+
+#define MLD2PWAPAR_OK         0
+#define MLD2PWAPAR_ILLPOSED   1   /* z is not unique in some modes (skipped) */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mld2pwapar_struct mld2pwapar_t;
+
+typedef struct {
+    int nthreads;       /* worker threads (<=0: all cores) */
+    double flattol;     /* regions with smaller Chebychev radius are
+                           discarded (1e-8) */
+    double eqtol;       /* rows that cannot be strictly satisfied by more
+                           than eqtol are implicit equalities (1e-7) */
+    double feastol;     /* feasibility tolerance of the LPs (1e-9) */
+    double pivtol;      /* minimum pivot when eliminating z (1e-9) */
+    double removetol;   /* tolerance for removing redundant rows (1e-9) */
+} mld2pwapar_settings;
+
+typedef struct {
+    int nrows;          /* rows of H,K */
+    const double *b;    /* binaries of the mode (nb) */
+    const double *H;    /* nrows-by-nv, row-major, rows of unit norm */
+    const double *K;
+    const double *Zv;   /* nz-by-nv, row-major */
+    const double *Zc;   /* nz */
+    const double *xc;   /* Chebychev center (nv) */
+    double rcheb;       /* Chebychev radius (Inf if unbounded) */
+} mld2pwapar_region;
+
+void mld2pwapar_default_settings(mld2pwapar_settings *set);
+
+/* Create the problem (data are copied) with nv+nz continuous and nb
+   binary variables and m constraints. Gy is m-by-(nv+nz), Gb m-by-nb. */
+mld2pwapar_t *mld2pwapar_new(int nv, int nz, int nb, int m, const double *Gy,
+                             const double *Gb, const double *g);
+
+/* Enumerate the modes below the nprefix prefixes of length depth stored
+   in the columns of prefix (depth-by-nprefix, 0/1 entries). Returns one
+   of the MLD2PWAPAR_* codes. nnodes and nlp (may be NULL) receive the
+   number of tree nodes visited and of LPs solved. */
+int mld2pwapar_solve(mld2pwapar_t *mp, const mld2pwapar_settings *set, int nprefix,
+                     int depth, const double *prefix, long *nnodes, long *nlp);
+
+/* Modes of the last solve, in lexicographic order of b */
+int mld2pwapar_num_regions(const mld2pwapar_t *mp);
+void mld2pwapar_get_region(const mld2pwapar_t *mp, int i, mld2pwapar_region *r);
+
+void mld2pwapar_free(mld2pwapar_t *mp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
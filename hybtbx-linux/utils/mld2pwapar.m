@@ -0,0 +1,216 @@
+function [P,options]=mld2pwapar(S,xmax,umax,options)
+% MLD2PWAPAR Convert an MLD system to PWA form by parallel mode enumeration
+%
+% [P,options]=MLD2PWAPAR(S,xmax,umax,options) returns the PWA system P
+% equivalent to the MLD system S in the box -xmax <= x <= xmax,
+% -umax <= u <= umax, with the same fields as MLD2PWA. It is called by
+% PWA when options.method='parallel'.
+%
+% The modes (combinations of [xb;ub;delta] with a full-dimensional set of
+% continuous states and inputs) are enumerated by the native solver
+% MLD2PWAPARMEX (see MLD2PWAPAR.CPP and MEXCOMPILE.M): a search on the
+% tree of binary variables prunes the prefixes whose LP relaxation is
+% infeasible, and subtrees are explored by several worker threads. Each
+% mode gives one region of P, and logic{i} is the [xb;ub;delta] vector of
+% the mode (dynamics of different modes are not merged).
+%
+% options.verbose    =1: show the progress of the enumeration (default: 0)
+% options.nthreads   number of worker threads (default: all cores)
+% options.flattol    regions with Chebychev radius smaller than flattol
+%                    are discarded (default: 1e-8)
+% options.splitdepth the tree is split into the 2^splitdepth subtrees of
+%                    the first splitdepth binary variables (default: 6)
+% options.checkpoint name of a MAT file where the modes found are saved
+%                    after each batch of options.batch subtrees (default:
+%                    8). If the file exists and was written for the same
+%                    MLD system, bounds and splitdepth, the conversion
+%                    resumes from it. Default: '' (no checkpoints).
+% options.lpsolver, options.milpsolver are stored in P (see PWA).
+%
+% See also PWA, MLD2PWA.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<2,
+    xmax=[];
+end
+if nargin<3,
+    umax=[];
+end
+if nargin<4 || isempty(options),
+    options=struct;
+end
+if ~isfield(options,'verbose'),
+    options.verbose=0;
+end
+if ~isfield(options,'nthreads'),
+    options.nthreads=[];
+end
+if ~isfield(options,'flattol') || isempty(options.flattol),
+    options.flattol=1e-8;
+end
+if ~isfield(options,'splitdepth') || isempty(options.splitdepth),
+    options.splitdepth=6;
+end
+if ~isfield(options,'checkpoint'),
+    options.checkpoint='';
+end
+if ~isfield(options,'batch') || isempty(options.batch),
+    options.batch=8;
+end
+if ~isfield(options,'lpsolver') || isempty(options.lpsolver),
+    options.lpsolver='glpk';
+end
+if ~isfield(options,'milpsolver') || isempty(options.milpsolver),
+    options.milpsolver=S.milpsolver;
+    if isempty(options.milpsolver),
+        options.milpsolver='glpk';
+    end
+end
+if exist('mld2pwaparmex')~=3,
+    error('mld2pwapar:nomex','MLD2PWAPARMEX is not compiled (type "mexcompile(''mld2pwaparmex'')"), use options.method=''sequential''.');
+end
+
+nx=S.nx;nxr=S.nxr;nxb=S.nxb;
+nu=S.nu;nur=S.nur;nub=S.nub;
+nyr=S.nyr;nd=S.nd;nz=S.nz;
+nv=nxr+nur;
+nb=nxb+nub+nd;
+
+xmax=boxbound(xmax,nx,nxr,'xmax');
+umax=boxbound(umax,nu,nur,'umax');
+
+% E2*d+E3*z <= E1*u+E4*x+E5 as Gy*[xr;ur;z]+Gb*[xb;ub;d] <= g, plus the box
+Gy=[-S.E4(:,1:nxr),-S.E1(:,1:nur),S.E3];
+Gb=[-S.E4(:,nxr+1:nx),-S.E1(:,nur+1:nu),S.E2];
+g=S.E5;
+vmax=[xmax;umax];
+Iv=eye(nv,nv+nz);
+ib=find(isfinite(vmax));
+Gy=full([Gy;Iv(ib,:);-Iv(ib,:)]);
+Gb=full([Gb;zeros(2*length(ib),nb)]);
+g=full([g;vmax(ib);vmax(ib)]);
+
+% Prefixes of the subtrees, in the order of the binary tree
+depth=min(options.splitdepth,nb);
+np=2^depth;
+prefix=zeros(depth,np);
+for k=1:depth,
+    prefix(k,:)=bitget(0:np-1,depth-k+1);
+end
+
+sig=struct('Gy',Gy,'Gb',Gb,'g',g,'nv',nv,'depth',depth);
+ck=[];
+if ~isempty(options.checkpoint) && exist(options.checkpoint,'file'),
+    ck=load(options.checkpoint);
+    if ~isfield(ck,'sig') || ~isequal(ck.sig,sig),
+        warning('mld2pwapar:checkpoint','Checkpoint %s was saved for another problem, starting over',options.checkpoint);
+        ck=[];
+    elseif options.verbose,
+        fprintf('Resuming from %s: %d of %d subtrees done, %d modes\n',...
+            options.checkpoint,sum(ck.done),np,size(ck.B,2));
+    end
+end
+if isempty(ck),
+    ck=struct('sig',sig,'done',false(1,np),'B',zeros(nb,0),'H',zeros(0,nv),...
+        'K',zeros(0,1),'i1',zeros(0,1),'i2',zeros(0,1),'Zv',zeros(0,nv),...
+        'Zc',zeros(0,1),'rCheb',zeros(0,1),'nnodes',0,'nlp',0);
+end
+
+opts=struct('nthreads',options.nthreads,'flattol',options.flattol);
+todo=find(~ck.done);
+if isempty(options.checkpoint),
+    batch=max(length(todo),1);
+else
+    batch=options.batch;
+end
+illposed=0;
+for k0=1:batch:length(todo),
+    ik=todo(k0:min(k0+batch-1,end));
+    [B,H,K,i1,i2,Zv,Zc,rCheb,status,nnodes,nlp]=mld2pwaparmex(Gy,Gb,g,nv,prefix(:,ik),opts);
+    illposed=illposed|status==1;
+    nh=size(ck.H,1);
+    ck.B=[ck.B,B];
+    ck.H=[ck.H;H];
+    ck.K=[ck.K;K];
+    ck.i1=[ck.i1;i1+nh];
+    ck.i2=[ck.i2;i2+nh];
+    ck.Zv=[ck.Zv;Zv];
+    ck.Zc=[ck.Zc;Zc];
+    ck.rCheb=[ck.rCheb;rCheb];
+    ck.nnodes=ck.nnodes+nnodes;
+    ck.nlp=ck.nlp+nlp;
+    ck.done(ik)=true;
+    if ~isempty(options.checkpoint),
+        save(options.checkpoint,'-struct','ck');
+    end
+    if options.verbose,
+        fprintf('%d of %d subtrees done, %d modes, %d nodes, %d LPs\n',...
+            sum(ck.done),np,size(ck.B,2),ck.nnodes,ck.nlp);
+    end
+end
+if illposed,
+    warning('mld2pwapar:illposed','The z variables are not unique for some modes (MLD system not well posed), those modes were discarded');
+end
+
+% Sort the modes as in the binary tree, whatever the order of the batches
+[aux,isort]=sortrows(ck.B');
+nr=length(isort);
+
+P=mld2pwa;
+P.A=cell(1,nr);P.B=P.A;P.f=P.A;P.Hx=P.A;P.Hu=P.A;P.K=P.A;
+P.LA=P.A;P.LB=P.A;P.Lf=P.A;P.C=P.A;P.D=P.A;P.g=P.A;
+P.LC=P.A;P.LD=P.A;P.Lg=P.A;P.logic=P.A;
+ix=1:nxr;ixb=nxr+1:nx;iy=1:nyr;iyb=nyr+1:S.ny;
+for i=1:nr,
+    j=isort(i);
+    b=ck.B(:,j);
+    xb=b(1:nxb);
+    ub=b(nxb+1:nxb+nub);
+    d=b(nxb+nub+1:nb);
+    iz=(j-1)*nz+1:j*nz;
+    Zx=ck.Zv(iz,1:nxr);
+    Zu=ck.Zv(iz,nxr+1:nv);
+    zc=ck.Zc(iz);
+    Ax=S.A(:,ix)+S.B3*Zx;
+    Bx=S.B1(:,1:nur)+S.B3*Zu;
+    fx=S.A(:,ixb)*xb+S.B1(:,nur+1:nu)*ub+S.B2*d+S.B3*zc;
+    Cy=S.C(:,ix)+S.D3*Zx;
+    Dy=S.D1(:,1:nur)+S.D3*Zu;
+    gy=S.C(:,ixb)*xb+S.D1(:,nur+1:nu)*ub+S.D2*d+S.D3*zc;
+    P.A{i}=Ax(ix,:);P.B{i}=Bx(ix,:);P.f{i}=fx(ix);
+    P.LA{i}=Ax(ixb,:);P.LB{i}=Bx(ixb,:);P.Lf{i}=fx(ixb);
+    P.C{i}=Cy(iy,:);P.D{i}=Dy(iy,:);P.g{i}=gy(iy);
+    P.LC{i}=Cy(iyb,:);P.LD{i}=Dy(iyb,:);P.Lg{i}=gy(iyb);
+
+    % Region of the continuous variables, and xb, ub fixed by the rows
+    % x(j)<=1/2 (value 0) or -x(j)<=-1/2 (value 1)
+    ih=ck.i1(j):ck.i2(j);
+    nh=length(ih);
+    sx=1-2*xb;
+    su=1-2*ub;
+    P.Hx{i}=[ck.H(ih,1:nxr),zeros(nh,nxb);zeros(nxb,nxr),diag(sx);zeros(nub,nx)];
+    P.Hu{i}=[ck.H(ih,nxr+1:nv),zeros(nh,nub);zeros(nxb,nu);zeros(nub,nur),diag(su)];
+    P.K{i}=[ck.K(ih);sx/2;su/2];
+    P.logic{i}=b;
+end
+P.nr=nr;
+P.nx=nx;P.nxr=nxr;P.nxb=nxb;
+P.nu=nu;P.nur=nur;P.nub=nub;
+P.ny=S.ny;P.nyr=nyr;P.nyb=S.nyb;
+
+%-----------------
+function v=boxbound(v,n,nr,name)
+% Bounds of the first nr (continuous) components, Inf if not given
+if isempty(v),
+    v=Inf(nr,1);
+    return
+end
+v=v(:);
+if length(v)==1,
+    v=v*ones(n,1);
+end
+if length(v)~=n,
+    error(sprintf('%s must be a scalar or a vector of dimension %d',name,n));
+end
+v=v(1:nr);
@@ -0,0 +1,139 @@
+/* Parallel enumeration of the modes of an MLD system - MEX interface
+
+   [B,H,K,i1,i2,Zv,Zc,rCheb,status,nnodes,nlp]=mld2pwaparmex(Gy,Gb,g,nv,prefix,opts)
+
+   Enumerates the modes b (binary vectors) of the constraints
+
+       Gy*[v;z] + Gb*b <= g
+
+   for which the set of feasible v is full-dimensional, by the solver in
+   MLD2PWAPAR.CPP. Only the modes whose first size(prefix,1) binaries are
+   a column of prefix are returned (prefix=zeros(0,1) for all the modes).
+   Mode #i is b=B(:,i), where z=Zv((i-1)*nz+1:i*nz,:)*v+Zc((i-1)*nz+1:i*nz)
+   on the region {v: H(i1(i):i2(i),:)*v <= K(i1(i):i2(i))}.
+
+   opts is a structure with optional fields
+       nthreads  = number of worker threads (default: all cores)
+       flattol   = regions with smaller Chebychev radius are discarded (1e-8)
+       eqtol     = tolerance for detecting implicit equalities (1e-7)
+       feastol   = feasibility tolerance of the LPs (1e-9)
+       pivtol    = minimum pivot when eliminating z (1e-9)
+       removetol = tolerance for removing redundant rows (1e-9)
+
+   status = 0 solved, 1 z is not unique in some modes (the MLD system is
+            not well posed, those modes are not returned)
+   nnodes,nlp = number of tree nodes visited and of LPs solved
+
+   Compile with MEXCOMPILE.M (or mex -O mld2pwaparmex.cpp mld2pwapar.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "mld2pwapar.h"
+#include <vector>
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+static void getfull(const mxArray *a, const char *name, int m, int n)
+{
+    if (!mxIsDouble(a) || mxIsSparse(a) || (int) mxGetM(a) != m || (int) mxGetN(a) != n)
+        mexErrMsgIdAndTxt("mld2pwaparmex:dim", "%s must be a full %d-by-%d matrix.", name, m, n);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    mld2pwapar_settings set;
+    mld2pwapar_region R;
+    mld2pwapar_t *mp;
+    int m, ny, nv, nz, nb, depth, nprefix, nr, nh = 0, i, j, k, r, status;
+    long nnodes = 0, nlp = 0;
+    double *H, *K, *Zv, *Zc;
+
+    if (nrhs < 5)
+        mexErrMsgTxt("At least five input arguments required.");
+
+    m = (int) mxGetM(prhs[0]);
+    ny = (int) mxGetN(prhs[0]);
+    nb = (int) mxGetN(prhs[1]);
+    nv = (int) mxGetScalar(prhs[3]);
+    nz = ny - nv;
+    if (nv < 0 || nz < 0)
+        mexErrMsgTxt("nv must be between 0 and the number of columns of Gy.");
+    getfull(prhs[0], "Gy", m, ny);
+    getfull(prhs[1], "Gb", m, nb);
+    if (!mxIsDouble(prhs[2]) || (int) mxGetNumberOfElements(prhs[2]) != m)
+        mexErrMsgTxt("g has wrong dimension.");
+    depth = (int) mxGetM(prhs[4]);
+    nprefix = (int) mxGetN(prhs[4]);
+    if (!mxIsDouble(prhs[4]) || mxIsSparse(prhs[4]) || depth > nb)
+        mexErrMsgTxt("prefix must be a full matrix with at most as many rows as the columns of Gb.");
+
+    mld2pwapar_default_settings(&set);
+    if (nrhs > 5) {
+        set.nthreads = (int) getopt(prhs[5], "nthreads", set.nthreads);
+        set.flattol = getopt(prhs[5], "flattol", set.flattol);
+        set.eqtol = getopt(prhs[5], "eqtol", set.eqtol);
+        set.feastol = getopt(prhs[5], "feastol", set.feastol);
+        set.pivtol = getopt(prhs[5], "pivtol", set.pivtol);
+        set.removetol = getopt(prhs[5], "removetol", set.removetol);
+    }
+
+    mp = mld2pwapar_new(nv, nz, nb, m, mxGetPr(prhs[0]), mxGetPr(prhs[1]), mxGetPr(prhs[2]));
+    status = mld2pwapar_solve(mp, &set, nprefix, depth, mxGetPr(prhs[4]), &nnodes, &nlp);
+
+    nr = mld2pwapar_num_regions(mp);
+    for (r = 0; r < nr; r++) {
+        mld2pwapar_get_region(mp, r, &R);
+        nh += R.nrows;
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(nb, nr, mxREAL);
+    plhs[1] = mxCreateDoubleMatrix(nh, nv, mxREAL);
+    plhs[2] = mxCreateDoubleMatrix(nh, 1, mxREAL);
+    plhs[3] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[4] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[5] = mxCreateDoubleMatrix(nr * nz, nv, mxREAL);
+    plhs[6] = mxCreateDoubleMatrix(nr * nz, 1, mxREAL);
+    plhs[7] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    H = mxGetPr(plhs[1]);
+    K = mxGetPr(plhs[2]);
+    Zv = mxGetPr(plhs[5]);
+    Zc = mxGetPr(plhs[6]);
+
+    for (r = 0, k = 0; r < nr; r++) {
+        mld2pwapar_get_region(mp, r, &R);
+        for (i = 0; i < nb; i++)
+            mxGetPr(plhs[0])[(size_t) r * nb + i] = R.b[i];
+        mxGetPr(plhs[3])[r] = k + 1;
+        for (i = 0; i < R.nrows; i++, k++) {
+            for (j = 0; j < nv; j++)
+                H[k + (size_t) j * nh] = R.H[(size_t) i * nv + j];
+            K[k] = R.K[i];
+        }
+        mxGetPr(plhs[4])[r] = k;
+        for (i = 0; i < nz; i++) {
+            for (j = 0; j < nv; j++)
+                Zv[(size_t) r * nz + i + (size_t) j * nr * nz] = R.Zv[(size_t) i * nv + j];
+            Zc[(size_t) r * nz + i] = R.Zc[i];
+        }
+        mxGetPr(plhs[7])[r] = R.rcheb;
+    }
+    mld2pwapar_free(mp);
+
+    if (nlhs > 8)
+        plhs[8] = mxCreateDoubleScalar(status);
+    if (nlhs > 9)
+        plhs[9] = mxCreateDoubleScalar((double) nnodes);
+    if (nlhs > 10)
+        plhs[10] = mxCreateDoubleScalar((double) nlp);
+}
@@ -0,0 +1,659 @@
+/* Parallel multiparametric LP solver - implementation
+
+   See MPLPPAR.H for the API.
+
+   Rows m,...,m+2n-1 are the bounds x(k) <= bigM (row m+2k) and
+   -x(k) <= bigM (row m+2k+1). The first basis B0 has one bound per
+   variable, with sign s(k) chosen so that its multipliers are >= 0.
+
+   For a basis B with inverse Binv = inv(A_B) (the column i of Binv goes
+   with row B(i)), the multipliers are lambda = -Binv'*c. The ratio test
+   compares the rows of Lambda = [lambda, Binv'*diag(s)], i.e. the
+   multipliers of the cost c - sum_k eps^k*s(k)*e_k, lexicographically.
+   All rows of Lambda are lexicographically positive for B0 and remain so
+   after each pivot, which rules out cycling and makes the optimal basis
+   unique where the LP is primal nondegenerate.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mplppar.h"
+#include "lpdense.h"
+#include "polydense.h"
+#include "mexthreads.h"
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <algorithm>
+#include <cmath>
+
+#define MPLPPAR_SHARDS 64
+#define MPLPPAR_FIRST_TRIES 8     /* perturbations of a degenerate first point */
+
+struct MLRegion {
+    std::vector<double> H, K, F, g, xc;
+    std::vector<int> act, basis;   /* basis sorted, with the bounds */
+    double rcheb;
+    int depth;
+};
+
+/* Point to visit: x + step*d, starting the pivots from basis B */
+struct MLItem {
+    std::vector<int> B;
+    std::vector<double> x, d;
+    double step;
+    int tries, depth;
+};
+
+struct mplppar_struct {
+    int n, m, npar, mt;            /* mt = m+2n rows including the bounds */
+    std::vector<double> A, S;      /* mt-by-n, mt-by-npar, row-major */
+    std::vector<double> b, anorm, c, s, thmin, thmax;
+    std::vector<int> B0;
+    std::vector<MLRegion> regions;
+};
+
+/* Basis and workspace of the dual simplex */
+struct MLBasis {
+    int n;
+    std::vector<int> B;
+    std::vector<char> inB;
+    std::vector<double> Binv;     /* n-by-n, row-major */
+    std::vector<double> Lambda;   /* n-by-(n+1), row-major */
+    std::vector<double> x, rhs, alpha, tmp;
+};
+
+struct MLWorker {
+    DenseLP lp;
+    MLBasis bs;
+    std::vector<MLRegion> out;
+    long npiv, nlp;
+};
+
+struct MLSeen {
+    std::unordered_set<std::string> set[MPLPPAR_SHARDS];
+    mex_mutex mx[MPLPPAR_SHARDS];
+
+    bool insert(const std::vector<int> &B)
+    {
+        std::string key((const char *) B.data(), B.size() * sizeof(int));
+        size_t s = std::hash<std::string>()(key) % MPLPPAR_SHARDS;
+        mex_lock l(mx[s]);
+        return set[s].insert(key).second;
+    }
+};
+
+struct MLShared {
+    mplppar_t *mp;
+    const mplppar_settings *set;
+    std::vector<MLWorker *> workers;
+    MLSeen seen;
+    MexExplorer<MLItem> *ex;
+    mex_counter nreg;
+    mex_counter unbounded;
+};
+
+void mplppar_default_settings(mplppar_settings *set)
+{
+    set->nthreads = 0;
+    set->maxregions = 0;
+    set->step = 1e-6;
+    set->flattol = 1e-8;
+    set->feastol = 1e-9;
+    set->pivtol = 1e-10;
+    set->removetol = 1e-9;
+    set->bigM = 1e6;
+}
+
+mplppar_t *mplppar_new(int n, int m, int npar, const double *c, const double *A,
+                       const double *b, const double *S, const double *thmin,
+                       const double *thmax)
+{
+    int i, j, k;
+    mplppar_t *mp = new mplppar_struct;
+
+    mp->n = n;
+    mp->m = m;
+    mp->npar = npar;
+    mp->mt = m + 2 * n;
+    mp->A.assign((size_t) mp->mt * n, 0.0);
+    mp->S.assign((size_t) mp->mt * npar, 0.0);
+    mp->b.assign(mp->mt, 0.0);
+    mp->anorm.assign(mp->mt, 1.0);
+    for (i = 0; i < m; i++) {
+        double s = 0;
+        for (j = 0; j < n; j++) {
+            mp->A[(size_t) i * n + j] = A[i + (size_t) j * m];
+            s += A[i + (size_t) j * m] * A[i + (size_t) j * m];
+        }
+        for (j = 0; j < npar; j++)
+            mp->S[(size_t) i * npar + j] = S[i + (size_t) j * m];
+        mp->b[i] = b[i];
+        mp->anorm[i] = s > 0 ? std::sqrt(s) : 0.0;
+    }
+    mp->c.assign(c, c + n);
+    mp->s.resize(n);
+    mp->B0.resize(n);
+    for (k = 0; k < n; k++) {
+        mp->A[(size_t) (m + 2 * k) * n + k] = 1.0;
+        mp->A[(size_t) (m + 2 * k + 1) * n + k] = -1.0;
+        mp->s[k] = c[k] < 0 ? 1.0 : -1.0;
+        mp->B0[k] = c[k] < 0 ? m + 2 * k : m + 2 * k + 1;
+    }
+    mp->thmin.assign(thmin, thmin + npar);
+    mp->thmax.assign(thmax, thmax + npar);
+    return mp;
+}
+
+void mplppar_free(mplppar_t *mp)
+{
+    delete mp;
+}
+
+int mplppar_num_regions(const mplppar_t *mp)
+{
+    return (int) mp->regions.size();
+}
+
+void mplppar_get_region(const mplppar_t *mp, int i, mplppar_region *r)
+{
+    const MLRegion &R = mp->regions[i];
+    r->nrows = (int) R.K.size();
+    r->nact = (int) R.act.size();
+    r->H = R.H.empty() ? NULL : &R.H[0];
+    r->K = R.K.empty() ? NULL : &R.K[0];
+    r->F = R.F.empty() ? NULL : &R.F[0];
+    r->g = R.g.empty() ? NULL : &R.g[0];
+    r->act = R.act.empty() ? NULL : &R.act[0];
+    r->xc = R.xc.empty() ? NULL : &R.xc[0];
+    r->rcheb = R.rcheb;
+    r->depth = R.depth;
+}
+
+/* Binv = inv(A_B) by Gauss-Jordan elimination with partial pivoting.
+   Returns false if A_B is singular. */
+static bool factor(const mplppar_t *mp, MLBasis &bs, double pivtol)
+{
+    int n = mp->n, i, j, k, p;
+    std::vector<double> &M = bs.tmp;
+    std::vector<double> &X = bs.Binv;
+
+    M.resize((size_t) n * n);
+    X.assign((size_t) n * n, 0.0);
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++)
+            M[(size_t) i * n + j] = mp->A[(size_t) bs.B[i] * n + j];
+        X[(size_t) i * n + i] = 1.0;
+    }
+    for (k = 0; k < n; k++) {
+        p = k;
+        for (i = k + 1; i < n; i++)
+            if (std::fabs(M[(size_t) i * n + k]) > std::fabs(M[(size_t) p * n + k]))
+                p = i;
+        if (std::fabs(M[(size_t) p * n + k]) <= pivtol)
+            return false;
+        if (p != k)
+            for (j = 0; j < n; j++) {
+                std::swap(M[(size_t) p * n + j], M[(size_t) k * n + j]);
+                std::swap(X[(size_t) p * n + j], X[(size_t) k * n + j]);
+            }
+        double piv = M[(size_t) k * n + k];
+        for (j = 0; j < n; j++) {
+            M[(size_t) k * n + j] /= piv;
+            X[(size_t) k * n + j] /= piv;
+        }
+        for (i = 0; i < n; i++) {
+            double f = M[(size_t) i * n + k];
+            if (i == k || f == 0.0)
+                continue;
+            for (j = 0; j < n; j++) {
+                M[(size_t) i * n + j] -= f * M[(size_t) k * n + j];
+                X[(size_t) i * n + j] -= f * X[(size_t) k * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+/* x = Binv*(b_B + S_B*th) and Lambda */
+static void update(const mplppar_t *mp, MLBasis &bs, const double *th)
+{
+    int n = mp->n, np = mp->npar, i, k;
+
+    bs.rhs.resize(n);
+    bs.x.assign(n, 0.0);
+    for (i = 0; i < n; i++)
+        bs.rhs[i] = mp->b[bs.B[i]] + DenseLP::dot(&mp->S[(size_t) bs.B[i] * np], th, np);
+    for (k = 0; k < n; k++)
+        bs.x[k] = DenseLP::dot(&bs.Binv[(size_t) k * n], &bs.rhs[0], n);
+    bs.Lambda.assign((size_t) n * (n + 1), 0.0);
+    for (i = 0; i < n; i++) {
+        double *L = &bs.Lambda[(size_t) i * (n + 1)];
+        for (k = 0; k < n; k++) {
+            L[0] -= bs.Binv[(size_t) k * n + i] * mp->c[k];
+            L[1 + k] = bs.Binv[(size_t) k * n + i] * mp->s[k];
+        }
+    }
+}
+
+/* Is Lambda(i,:)/ai lexicographically smaller than Lambda(l,:)/al? */
+static bool lexless(const MLBasis &bs, int i, double ai, int l, double al)
+{
+    int n = bs.n;
+    const double *Li = &bs.Lambda[(size_t) i * (n + 1)];
+    const double *Ll = &bs.Lambda[(size_t) l * (n + 1)];
+    for (int k = 0; k <= n; k++) {
+        double u = Li[k] / ai, v = Ll[k] / al;
+        if (std::fabs(u - v) > 1e-9 * (1.0 + std::max(std::fabs(u), std::fabs(v))))
+            return u < v;
+    }
+    return bs.B[i] < bs.B[l];
+}
+
+#define MLDUAL_OPTIMAL     0
+#define MLDUAL_INFEASIBLE  1
+#define MLDUAL_FAILED      2
+
+/* Dual simplex at th from the basis in bs.B, lexicographic ratio test */
+static int dual_simplex(const mplppar_t *mp, const mplppar_settings *set, MLBasis &bs,
+                        const double *th, long *npiv)
+{
+    int n = mp->n, np = mp->npar, mt = mp->mt, i, j, k, r, l, it;
+    int maxiter = 50 * (mt + n);
+    double v, vmax, piv;
+
+    bs.n = n;
+    bs.inB.assign(mt, 0);
+    for (i = 0; i < n; i++)
+        bs.inB[bs.B[i]] = 1;
+    if (!factor(mp, bs, set->pivtol))
+        return MLDUAL_FAILED;
+    bs.alpha.resize(n);
+
+    for (it = 0; it < maxiter; it++) {
+        update(mp, bs, th);
+
+        /* Entering row: largest normalized violation */
+        r = -1;
+        vmax = set->feastol;
+        for (j = 0; j < mt; j++) {
+            if (bs.inB[j] || mp->anorm[j] == 0.0)
+                continue;
+            v = (DenseLP::dot(&mp->A[(size_t) j * n], &bs.x[0], n) - mp->b[j]
+                 - DenseLP::dot(&mp->S[(size_t) j * np], th, np)) / mp->anorm[j];
+            if (v > vmax) {
+                vmax = v;
+                r = j;
+            }
+        }
+        if (r < 0)
+            return MLDUAL_OPTIMAL;
+
+        /* alpha = A(r,:)*Binv, leaving row by lexicographic ratio test */
+        const double *ar = &mp->A[(size_t) r * n];
+        for (i = 0; i < n; i++) {
+            v = 0;
+            for (k = 0; k < n; k++)
+                v += ar[k] * bs.Binv[(size_t) k * n + i];
+            bs.alpha[i] = v;
+        }
+        l = -1;
+        for (i = 0; i < n; i++)
+            if (bs.alpha[i] > set->pivtol * mp->anorm[r]
+                && (l < 0 || lexless(bs, i, bs.alpha[i], l, bs.alpha[l])))
+                l = i;
+        if (l < 0)
+            return MLDUAL_INFEASIBLE;
+
+        /* Replace B(l) by r and update Binv */
+        piv = bs.alpha[l];
+        for (k = 0; k < n; k++)
+            bs.Binv[(size_t) k * n + l] /= piv;
+        for (i = 0; i < n; i++) {
+            if (i == l || bs.alpha[i] == 0.0)
+                continue;
+            for (k = 0; k < n; k++)
+                bs.Binv[(size_t) k * n + i] -= bs.alpha[i] * bs.Binv[(size_t) k * n + l];
+        }
+        bs.inB[bs.B[l]] = 0;
+        bs.inB[r] = 1;
+        bs.B[l] = r;
+        (*npiv)++;
+
+        /* Refactor now and then to limit the accumulation of errors */
+        if (it % 50 == 49 && !factor(mp, bs, set->pivtol))
+            return MLDUAL_FAILED;
+    }
+    return MLDUAL_FAILED;
+}
+
+/* Region of the basis in bs (factored at the current point), with the
+   rows of A not in the basis and the box. origin[k] = row of A giving
+   row k of P, -1 for the box. Returns false if the region is empty. */
+static bool critical_region(const mplppar_t *mp, const MLBasis &bs, MLRegion &R,
+                            Polytope &P, std::vector<int> &origin)
+{
+    int n = mp->n, m = mp->m, np = mp->npar, i, j, k, a;
+    double s, kk, nh;
+    std::vector<double> h(np);
+
+    /* F = Binv*S_B, g = Binv*b_B */
+    R.F.assign((size_t) n * np, 0.0);
+    R.g.assign(n, 0.0);
+    for (k = 0; k < n; k++) {
+        for (i = 0; i < n; i++) {
+            double bi = bs.Binv[(size_t) k * n + i];
+            if (bi == 0.0)
+                continue;
+            for (j = 0; j < np; j++)
+                R.F[(size_t) k * np + j] += bi * mp->S[(size_t) bs.B[i] * np + j];
+            R.g[k] += bi * mp->b[bs.B[i]];
+        }
+    }
+
+    P = Polytope(np);
+    origin.clear();
+    for (a = 0; a < m + 2 * np; a++) {
+        if (a < m) {
+            if (bs.inB[a])
+                continue;
+            const double *ai = &mp->A[(size_t) a * n];
+            for (j = 0; j < np; j++) {
+                s = -mp->S[(size_t) a * np + j];
+                for (k = 0; k < n; k++)
+                    s += ai[k] * R.F[(size_t) k * np + j];
+                h[j] = s;
+            }
+            kk = mp->b[a] - DenseLP::dot(ai, &R.g[0], n);
+        }
+        else {
+            int l = (a - m) / 2;
+            for (j = 0; j < np; j++)
+                h[j] = 0.0;
+            if ((a - m) % 2 == 0) {
+                h[l] = 1.0;
+                kk = mp->thmax[l];
+            }
+            else {
+                h[l] = -1.0;
+                kk = -mp->thmin[l];
+            }
+        }
+        nh = std::sqrt(DenseLP::dot(&h[0], &h[0], np));
+        if (nh <= 1e-10) {
+            if (kk < -1e-9)
+                return false;
+            continue;
+        }
+        for (j = 0; j < np; j++)
+            h[j] /= nh;
+        P.add_row(&h[0], kk / nh);
+        origin.push_back(a < m ? a : -1);
+    }
+
+    R.act.clear();
+    for (i = 0; i < n; i++)
+        if (bs.B[i] < m)
+            R.act.push_back(bs.B[i]);
+    std::sort(R.act.begin(), R.act.end());
+    return true;
+}
+
+static double max_violation(const Polytope &P, const std::vector<double> &th)
+{
+    double v = 0;
+    for (int i = 0; i < P.rows(); i++)
+        v = std::max(v, DenseLP::dot(P.row(i), &th[0], P.n) - P.b[i]);
+    return v;
+}
+
+/* Flat or degenerate region at it: try again further from the facet, or,
+   for the first point (depth 0), at a perturbation of it in a direction
+   that changes at each try */
+static void retry(MLShared &sh, int t, const MLItem &it)
+{
+    const mplppar_t *mp = sh.mp;
+    MLItem it2 = it;
+
+    it2.tries++;
+    if (it.depth > 0) {
+        if (it.tries >= 3)
+            return;
+        it2.step *= 10;
+    }
+    else {
+        if (it.tries >= MPLPPAR_FIRST_TRIES)
+            return;
+        unsigned int r = 2654435761u * (unsigned int) it2.tries;
+        for (int j = 0; j < mp->npar; j++) {
+            r = r * 1103515245u + 12345u;
+            it2.d[j] = ((r >> 8) / 8388608.0 - 1.0) * .5 * (mp->thmax[j] - mp->thmin[j]);
+        }
+        it2.step = .01 * (1 << it.tries);
+    }
+    sh.ex->push(t, it2);
+}
+
+static void process(MLShared &sh, int t, const MLItem &it)
+{
+    mplppar_t *mp = sh.mp;
+    MLWorker &w = *sh.workers[t];
+    MLBasis &bs = w.bs;
+    const mplppar_settings *set = sh.set;
+    int n = mp->n, np = mp->npar, i, j, status;
+    std::vector<double> th(np), x0;
+    std::vector<int> origin, kept, key;
+    Polytope P;
+    MLRegion R;
+    bool ok, bounded = true;
+
+    for (j = 0; j < np; j++) {
+        th[j] = it.x[j] + it.step * it.d[j];
+        if (th[j] > mp->thmax[j] || th[j] < mp->thmin[j]) {
+            if (it.depth == 0)
+                retry(sh, t, it);
+            return;
+        }
+    }
+
+    bs.B = it.B;
+    if (dual_simplex(mp, set, bs, &th[0], &w.npiv) != MLDUAL_OPTIMAL) {
+        if (it.depth == 0)
+            retry(sh, t, it);
+        return;   /* th outside the feasible set */
+    }
+
+    key = bs.B;
+    std::sort(key.begin(), key.end());
+    if (it.depth > 0) {
+        /* Still the basis of the region whose facet was crossed: the
+           crossed row is violated by less than feastol at this step
+           (rows nearly parallel to an active one), go further */
+        std::vector<int> from(it.B);
+        std::sort(from.begin(), from.end());
+        if (from == key) {
+            retry(sh, t, it);
+            return;
+        }
+    }
+    if (!sh.seen.insert(key))
+        return;   /* region already explored */
+
+    /* A bound in the basis with a positive multiplier: the LP is unbounded
+       here. The region is crossed but not stored. */
+    for (i = 0; i < n; i++)
+        if (bs.B[i] >= mp->m && bs.Lambda[(size_t) i * (n + 1)] > set->feastol)
+            bounded = false;
+    if (!bounded)
+        sh.unbounded = 1;
+
+    ok = critical_region(mp, bs, R, P, origin);
+    if (ok) {
+        int lps = 0;
+        x0 = th;
+        ok = !poly_reduce(w.lp, P, set->removetol, x0, 1e-10, &kept, &lps, 1);
+        w.nlp += lps;
+    }
+    if (ok) {
+        R.xc = th;
+        poly_chebyshev(w.lp, P, NULL, NULL, &R.xc[0], &R.rcheb);
+        w.nlp++;
+        ok = R.rcheb > set->flattol;
+    }
+    if (!ok || max_violation(P, th) > 1e-7) {
+        retry(sh, t, it);
+        if (!ok)
+            return;
+    }
+
+    R.H = P.A;
+    R.K = P.b;
+    R.basis = key;
+    R.depth = it.depth;
+    if (bounded) {
+        w.out.push_back(R);
+        if (set->maxregions > 0 && ++sh.nreg >= set->maxregions) {
+            sh.ex->stop();
+            return;
+        }
+    }
+
+    /* Cross the facets that are not on the box */
+    std::vector<double> Ao, bo, xf;
+    for (int r = 0; r < P.rows(); r++) {
+        if (origin[kept[r]] < 0)
+            continue;
+        Ao.clear();
+        bo.clear();
+        for (i = 0; i < P.rows(); i++) {
+            if (i == r)
+                continue;
+            Ao.insert(Ao.end(), P.row(i), P.row(i) + np);
+            bo.push_back(P.b[i]);
+        }
+        double rf;
+        xf = R.xc;
+        status = lpdense_facet_chebyshev(w.lp, np, P.row(r), P.b[r], P.rows() - 1,
+                                         Ao.empty() ? NULL : &Ao[0],
+                                         bo.empty() ? NULL : &bo[0], &xf[0], &rf);
+        w.nlp++;
+        /* unbounded: the facet is a point (npar=1) or an unbounded slice
+           of a region with parallel rows, xf is still on the facet */
+        if ((status != LPDENSE_OPTIMAL && status != LPDENSE_UNBOUNDED) || !(rf > set->flattol))
+            continue;
+        MLItem it2;
+        it2.B = bs.B;
+        it2.x = xf;
+        it2.d.assign(P.row(r), P.row(r) + np);
+        it2.step = set->step;
+        it2.tries = 0;
+        it2.depth = it.depth + 1;
+        sh.ex->push(t, it2);
+    }
+}
+
+/* A parameter vector in the interior of the set of th for which the LP is
+   feasible: the Chebychev center of {(x,th): A*x-S*th <= b, thmin <= th <=
+   thmax}, i.e. max r s.t. A*x - S*th + |[A -S]|*r <= b, thmin+r <= th <=
+   thmax-r. r is bounded by the box. */
+static bool first_point(mplppar_t *mp, DenseLP &lp, std::vector<double> &th)
+{
+    int n = mp->n, m = mp->m, np = mp->npar, nv = n + np + 1, i, j;
+    std::vector<double> c(nv, 0.0), y(nv, 0.0);
+
+    lp.resize(nv, m + 2 * np, 0);
+    for (i = 0; i < m; i++) {
+        double *a = lp.row(i), s = 0;
+        for (j = 0; j < n; j++)
+            a[j] = mp->A[(size_t) i * n + j];
+        for (j = 0; j < np; j++)
+            a[n + j] = -mp->S[(size_t) i * np + j];
+        for (j = 0; j < n + np; j++)
+            s += a[j] * a[j];
+        a[nv - 1] = std::sqrt(s);
+        lp.b[i] = mp->b[i];
+    }
+    for (j = 0; j < np; j++) {
+        double *a = lp.row(m + 2 * j), *a2 = lp.row(m + 2 * j + 1);
+        for (i = 0; i < nv; i++)
+            a[i] = a2[i] = 0.0;
+        a[n + j] = 1.0;
+        a[nv - 1] = 1.0;
+        lp.b[m + 2 * j] = mp->thmax[j];
+        a2[n + j] = -1.0;
+        a2[nv - 1] = 1.0;
+        lp.b[m + 2 * j + 1] = -mp->thmin[j];
+        y[n + j] = .5 * (mp->thmin[j] + mp->thmax[j]);
+    }
+    y[nv - 1] = -1e6;
+    c[nv - 1] = -1.0;
+    if (lp.solve(&c[0], &y[0]) != LPDENSE_OPTIMAL || !(y[nv - 1] > -1e-9))
+        return false;
+    th.assign(y.begin() + n, y.begin() + n + np);
+    return true;
+}
+
+int mplppar_solve(mplppar_t *mp, const mplppar_settings *set, long *npiv, long *nlp)
+{
+    int n = mp->n, np = mp->npar, nt, t, k, status;
+    MLShared sh;
+    MLItem it;
+
+    mp->regions.clear();
+    if (npiv)
+        *npiv = 0;
+    if (nlp)
+        *nlp = 0;
+
+    /* Bounds of the first basis */
+    for (k = 0; k < n; k++) {
+        mp->b[mp->m + 2 * k] = set->bigM;
+        mp->b[mp->m + 2 * k + 1] = set->bigM;
+    }
+
+    MexExplorer<MLItem> ex(set->nthreads);
+    nt = ex.num_threads();
+    sh.mp = mp;
+    sh.set = set;
+    sh.ex = &ex;
+    sh.nreg = 0;
+    sh.unbounded = 0;
+    for (t = 0; t < nt; t++) {
+        MLWorker *w = new MLWorker;
+        w->npiv = w->nlp = 0;
+        sh.workers.push_back(w);
+    }
+    if (!first_point(mp, sh.workers[0]->lp, it.x))
+        status = MPLPPAR_NOFEASIBLE;
+    else {
+        it.B = mp->B0;
+        it.d.assign(np, 0.0);
+        it.step = 0;
+        it.tries = 0;
+        it.depth = 0;
+        ex.push(0, it);
+        ex.run([&sh](const MLItem &item, int tid) { process(sh, tid, item); });
+        status = ex.stopped() ? MPLPPAR_MAXREGIONS : MPLPPAR_OK;
+    }
+
+    for (t = 0; t < nt; t++) {
+        MLWorker *w = sh.workers[t];
+        for (size_t l = 0; l < w->out.size(); l++)
+            mp->regions.push_back(w->out[l]);
+        if (npiv)
+            *npiv += w->npiv;
+        if (nlp)
+            *nlp += w->nlp;
+        delete w;
+    }
+    if (status == MPLPPAR_OK && sh.unbounded)
+        status = MPLPPAR_UNBOUNDED;
+    if (status == MPLPPAR_OK && mp->regions.empty())
+        status = MPLPPAR_NOFEASIBLE;
+
+    /* The order in which regions are found depends on the threads */
+    std::sort(mp->regions.begin(), mp->regions.end(), [](const MLRegion &a, const MLRegion &c) {
+        return a.basis < c.basis;
+    });
+    return status;
+}
@@ -0,0 +1,95 @@
+/* Parallel multiparametric LP solver - C API
+
+   Computes the explicit solution of
+
+       min  c'*x
+       s.t. A*x <= b + S*th,     thmin <= th <= thmax
+
+   as a partition of the parameter box into critical regions
+   {th: H*th <= K}. Each region is the set of parameters for which a
+   basis B (n linearly independent rows of A) is optimal, and there
+   x = F*th + g with F = inv(A_B)*S_B, g = inv(A_B)*b_B.
+
+   The optimality of a basis does not depend on th (dual feasibility),
+   so regions are enumerated by parametric dual simplex steps: beyond
+   each facet of a region the basis of the region is pivoted (dual
+   simplex at a parameter just outside the facet) until it is primal
+   feasible again, and no LP is solved from scratch. Ties in the ratio
+   test (dual degeneracy) are broken by the lexicographic rule, i.e. the
+   cost vector is implicitly perturbed, so that the optimal basis is
+   unique for almost all th and the regions do not overlap. The first
+   basis is found by the same dual simplex iterations from the bounds
+   -bigM <= x <= bigM, which are not part of the regions.
+
+   The exploration runs on several worker threads as in MPQPPAR.H
+   (MexExplorer in MEXTHREADS.H). Matrices are column-major (MATLAB
+   layout). See MPLPPARMEX.CPP for the MEX interface and MPLPPAR.M for
+   the MATLAB wrapper.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef MPLPPAR_H
+#define MPLPPAR_H
+
+#define MPLPPAR_OK           0
+#define MPLPPAR_NOFEASIBLE   1   /* no parameter with a feasible LP (or flat set) */
+#define MPLPPAR_MAXREGIONS   2   /* exploration stopped at maxregions */
+#define MPLPPAR_UNBOUNDED    3   /* the LP is unbounded for some parameters */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mplppar_struct mplppar_t;
+
+typedef struct {
+    int nthreads;       /* worker threads (<=0: all cores) */
+    int maxregions;     /* stop after this number of regions (0 = no limit) */
+    double step;        /* distance of the pivoting point beyond a facet (1e-6) */
+    double flattol;     /* regions with smaller Chebychev radius are
+                           discarded (1e-8) */
+    double feastol;     /* primal feasibility tolerance of the pivots (1e-9) */
+    double pivtol;      /* minimum pivot (1e-10) */
+    double removetol;   /* tolerance of the redundancy LPs (1e-9) */
+    double bigM;        /* bounds on x of the first basis (1e6) */
+} mplppar_settings;
+
+typedef struct {
+    int nrows;          /* rows of H,K */
+    int nact;           /* rows of A in the basis (n unless x is on the
+                           bounds -bigM <= x <= bigM) */
+    const double *H;    /* nrows-by-npar, row-major, rows of unit norm */
+    const double *K;
+    const double *F;    /* n-by-npar, row-major */
+    const double *g;    /* n */
+    const int *act;     /* 0-based, increasing */
+    const double *xc;   /* Chebychev center (npar) */
+    double rcheb;       /* Chebychev radius */
+    int depth;          /* number of facet crossings from the first region */
+} mplppar_region;
+
+void mplppar_default_settings(mplppar_settings *set);
+
+/* Create the problem (data are copied) with n variables, m constraints
+   and npar parameters. c is n-by-1, A m-by-n, b m, S m-by-npar. */
+mplppar_t *mplppar_new(int n, int m, int npar, const double *c, const double *A,
+                       const double *b, const double *S, const double *thmin,
+                       const double *thmax);
+
+/* Compute the partition. Returns one of the MPLPPAR_* codes. npiv and
+   nlp (may be NULL) receive the number of pivots and of LPs solved (for
+   removing redundant rows and Chebychev balls). */
+int mplppar_solve(mplppar_t *mp, const mplppar_settings *set, long *npiv, long *nlp);
+
+/* Regions of the last solve, ordered by basis */
+int mplppar_num_regions(const mplppar_t *mp);
+void mplppar_get_region(const mplppar_t *mp, int i, mplppar_region *r);
+
+void mplppar_free(mplppar_t *mp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+function [mplpsol,lpsolved]=mplppar(c,A,b,S,thmin,thmax,verbose,flattol,nthreads,maxregions)
+% MPLPPAR Multiparametric linear optimization by parametric pivoting
+%
+% mplpsol=MPLPPAR(c,A,b,S,thmin,thmax) parametrically solves
+%
+%    min  c'*x
+%    s.t. A*x <= b + S*th,    thmin <= th <= thmax
+%
+% like MPLP, and returns the solution in a structure with the same fields:
+%
+%  H,K,i1,i2:    Region #i is stored in H(i1(i):i2(i),:),K(i1(i):i2(i),:)
+%  F,G:          Gain #i is stored in F((i-1)*n+1:i*n,:), G((i-1)*n+1:i*n)
+%  rCheb:        Chebychev radius of region #i
+%  act,i3,i4:    Rows of A in the optimal basis of region #i, stored in act(i3(i):i4(i),:)
+%  nr:           Number of regions=length(i1)
+%  c,A,b,S:      Original mpLP problem matrices
+%
+% The optimal bases are enumerated by the native solver MPLPPARMEX (see
+% MPLPPAR.CPP and MEXCOMPILE.M): beyond each facet of a critical region
+% the basis is updated by dual simplex pivots, instead of solving a new
+% LP. Dual degeneracy is resolved by the lexicographic rule, so that the
+% regions do not overlap even when the optimizer is not unique (then the
+% solution is one of the optimizers, and the cost is the same as MPLP's).
+% Regions are explored by several worker threads.
+%
+% mplpsol=MPLPPAR(c,A,b,S,thmin,thmax,verbose,flattol,nthreads,maxregions)
+% also specifies
+%
+%  verbose    =1 shows the number of regions, pivots and LPs (default: 0)
+%  flattol    regions with Chebychev radius smaller than flattol are
+%             discarded (default: 1e-8)
+%  nthreads   number of worker threads (default: all cores)
+%  maxregions stop after maxregions regions (default: no limit)
+%
+% [mplpsol,lpsolved]=MPLPPAR(...) also returns the number of LPs solved
+% (for removing redundant constraints and Chebychev balls).
+%
+% Envelopes and restrictions {th: H*th<=K} of the parameter set are not
+% supported, use MPLP.
+%
+% See also MPLP, MPLPJOIN.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<7 || isempty(verbose),
+    verbose=0;
+end
+if nargin<8 || isempty(flattol),
+    flattol=1e-8;
+end
+if nargin<9,
+    nthreads=[];
+end
+if nargin<10,
+    maxregions=[];
+end
+if exist('mplpparmex')~=3,
+    error('mplppar:nomex','MPLPPARMEX is not compiled (type "mexcompile(''mplpparmex'')"), use MPLP.');
+end
+
+npar=length(thmin);
+nvar=length(c);
+if isempty(S),
+    S=zeros(size(A,1),npar);
+end
+
+opts=struct('nthreads',nthreads,'maxregions',maxregions,'flattol',flattol);
+[H,K,i1,i2,F,G,rCheb,act,i3,i4,status,npiv,lpsolved]=mplpparmex(full(c(:)),full(A),...
+    full(b(:)),full(S),thmin(:),thmax(:),opts);
+
+switch status
+    case 1
+        warning('mplppar:infeasible','The LP is infeasible for all parameters in the given range');
+    case 2
+        warning('mplppar:maxregions','Exploration stopped after %d regions',length(i1));
+    case 3
+        warning('mplppar:unbounded','The LP is unbounded for some parameters in the given range');
+end
+if verbose>0,
+    fprintf('%d regions, %d pivots, %d LPs solved\n',length(i1),npiv,lpsolved);
+end
+
+mplpsol=struct('H',H,'K',K,'i1',i1,'i2',i2,'F',F,'G',G,'rCheb',rCheb,...
+    'act',act,'i3',i3,'i4',i4,'nr',length(i1),'nvar',nvar,'c',c(:),'A',A,'b',b(:),...
+    'S',S,'thmin',thmin(:),'thmax',thmax(:));
@@ -0,0 +1,146 @@
+/* Parallel multiparametric LP solver - MEX interface
+
+   [H,K,i1,i2,F,G,rCheb,act,i3,i4,status,npiv,nlp]=mplpparmex(c,A,b,S,thmin,thmax,opts)
+
+   Solves the mpLP
+
+       min  c'*x
+       s.t. A*x <= b + S*th,     thmin <= th <= thmax
+
+   by the solver in MPLPPAR.CPP. The outputs have the format of MPLP:
+   region #i is {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, where
+   x = F((i-1)*n+1:i*n,:)*th + G((i-1)*n+1:i*n), and act(i3(i):i4(i)) are
+   the rows of A in the optimal basis.
+
+   opts is a structure with optional fields
+       nthreads   = number of worker threads (default: all cores)
+       maxregions = stop after this number of regions (default: no limit)
+       step       = distance beyond a facet where the pivots are done (1e-6)
+       flattol    = regions with smaller Chebychev radius are discarded (1e-8)
+       feastol    = primal feasibility tolerance of the pivots (1e-9)
+       pivtol     = minimum pivot (1e-10)
+       removetol  = tolerance for removing redundant rows (1e-9)
+       bigM       = bounds -bigM <= x <= bigM of the first basis (1e6)
+
+   status = 0 solved, 1 no feasible parameter, 2 stopped at maxregions,
+            3 the LP is unbounded for some parameters (those regions are
+            not returned)
+   npiv,nlp = number of simplex pivots and of LPs solved
+
+   Compile with MEXCOMPILE.M (or mex -O mplpparmex.cpp mplppar.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "mplppar.h"
+#include <vector>
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+static void getfull(const mxArray *a, const char *name, int m, int n)
+{
+    if (!mxIsDouble(a) || mxIsSparse(a) || (int) mxGetM(a) != m || (int) mxGetN(a) != n)
+        mexErrMsgIdAndTxt("mplpparmex:dim", "%s must be a full %d-by-%d matrix.", name, m, n);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    mplppar_settings set;
+    mplppar_region R;
+    mplppar_t *mp;
+    int n, m, npar, nr, nh = 0, na = 0, i, j, k, r, status;
+    long npiv = 0, nlp = 0;
+    double *H, *K, *F, *G;
+
+    if (nrhs < 6)
+        mexErrMsgTxt("At least six input arguments required.");
+
+    n = (int) mxGetNumberOfElements(prhs[0]);
+    m = (int) mxGetM(prhs[1]);
+    npar = (int) mxGetN(prhs[3]);
+    if (!mxIsDouble(prhs[0]) || mxIsSparse(prhs[0]))
+        mexErrMsgTxt("c must be a full vector.");
+    getfull(prhs[1], "A", m, n);
+    if (!mxIsDouble(prhs[2]) || (int) mxGetNumberOfElements(prhs[2]) != m)
+        mexErrMsgTxt("b has wrong dimension.");
+    getfull(prhs[3], "S", m, npar);
+    if ((int) mxGetNumberOfElements(prhs[4]) != npar || (int) mxGetNumberOfElements(prhs[5]) != npar)
+        mexErrMsgTxt("thmin and thmax must have as many elements as the columns of S.");
+
+    mplppar_default_settings(&set);
+    if (nrhs > 6) {
+        set.nthreads = (int) getopt(prhs[6], "nthreads", set.nthreads);
+        set.maxregions = (int) getopt(prhs[6], "maxregions", set.maxregions);
+        set.step = getopt(prhs[6], "step", set.step);
+        set.flattol = getopt(prhs[6], "flattol", set.flattol);
+        set.feastol = getopt(prhs[6], "feastol", set.feastol);
+        set.pivtol = getopt(prhs[6], "pivtol", set.pivtol);
+        set.removetol = getopt(prhs[6], "removetol", set.removetol);
+        set.bigM = getopt(prhs[6], "bigM", set.bigM);
+    }
+
+    mp = mplppar_new(n, m, npar, mxGetPr(prhs[0]), mxGetPr(prhs[1]), mxGetPr(prhs[2]),
+                     mxGetPr(prhs[3]), mxGetPr(prhs[4]), mxGetPr(prhs[5]));
+    status = mplppar_solve(mp, &set, &npiv, &nlp);
+
+    nr = mplppar_num_regions(mp);
+    for (r = 0; r < nr; r++) {
+        mplppar_get_region(mp, r, &R);
+        nh += R.nrows;
+        na += R.nact;
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(nh, npar, mxREAL);
+    plhs[1] = mxCreateDoubleMatrix(nh, 1, mxREAL);
+    plhs[2] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[3] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[4] = mxCreateDoubleMatrix(nr * n, npar, mxREAL);
+    plhs[5] = mxCreateDoubleMatrix(nr * n, 1, mxREAL);
+    plhs[6] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[7] = mxCreateDoubleMatrix(na, 1, mxREAL);
+    plhs[8] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[9] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    H = mxGetPr(plhs[0]);
+    K = mxGetPr(plhs[1]);
+    F = mxGetPr(plhs[4]);
+    G = mxGetPr(plhs[5]);
+
+    for (r = 0, k = 0, na = 0; r < nr; r++) {
+        mplppar_get_region(mp, r, &R);
+        mxGetPr(plhs[2])[r] = k + 1;
+        for (i = 0; i < R.nrows; i++, k++) {
+            for (j = 0; j < npar; j++)
+                H[k + (size_t) j * nh] = R.H[(size_t) i * npar + j];
+            K[k] = R.K[i];
+        }
+        mxGetPr(plhs[3])[r] = k;
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < npar; j++)
+                F[(size_t) r * n + i + (size_t) j * nr * n] = R.F[(size_t) i * npar + j];
+            G[(size_t) r * n + i] = R.g[i];
+        }
+        mxGetPr(plhs[6])[r] = R.rcheb;
+        mxGetPr(plhs[8])[r] = na + 1;
+        for (i = 0; i < R.nact; i++)
+            mxGetPr(plhs[7])[na++] = R.act[i] + 1;
+        mxGetPr(plhs[9])[r] = na;
+    }
+    mplppar_free(mp);
+
+    if (nlhs > 10)
+        plhs[10] = mxCreateDoubleScalar(status);
+    if (nlhs > 11)
+        plhs[11] = mxCreateDoubleScalar((double) npiv);
+    if (nlhs > 12)
+        plhs[12] = mxCreateDoubleScalar((double) nlp);
+}
@@ -0,0 +1,627 @@
+/* Parallel multiparametric QP solver - implementation
+
+   See MPQPPAR.H for the API.
+
+   With Q = L*L', Rinv = inv(L') and the active set A (rows of A linearly
+   independent), the KKT conditions give (Z = A*Rinv, D = Rinv'*C)
+
+       lambda_A = Fl*th + gl,   Fl = -inv(Z_A*Z_A')*(S_A + Z_A*D),
+                                gl = -inv(Z_A*Z_A')*b_A
+       x        = F*th + g,     F = -Rinv*(D + Z_A'*Fl),  g = -Rinv*Z_A'*gl
+
+   and the critical region is {th: A_I*x <= b_I + S_I*th, lambda_A >= 0},
+   intersected with the box. Each row of the region remembers where it
+   comes from; only the facets that are not on the box are crossed.
+
+   The shared problem data are read-only during the exploration. Each
+   worker owns its QP solver, LP workspace and list of regions, which are
+   merged at the end.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mpqppar.h"
+#include "qpdual.h"
+#include "lpdense.h"
+#include "polydense.h"
+#include "mexthreads.h"
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <algorithm>
+#include <cmath>
+
+#define MPQPPAR_SHARDS 64
+
+struct MPRegion {
+    std::vector<double> H, K, F, g, xc;
+    std::vector<int> act;
+    double rcheb;
+    int depth;
+};
+
+/* Point to visit: x + step*d (d = outward normal of the facet crossed) */
+struct MPItem {
+    std::vector<double> x, d;
+    double step;
+    int tries, depth;
+};
+
+struct mpqppar_struct {
+    int n, m, npar;
+    std::vector<double> Acm;       /* A, column-major (for QPDUAL) */
+    std::vector<double> A, S, C;   /* row-major */
+    std::vector<double> Q, b, thmin, thmax;
+    std::vector<double> Rinv;      /* inv(L'), row-major */
+    std::vector<double> Z;         /* A*Rinv, m-by-n row-major */
+    std::vector<double> D;         /* Rinv'*C, n-by-npar row-major */
+    std::vector<MPRegion> regions;
+};
+
+struct MPWorker {
+    DenseLP lp;
+    qpdual_t *qp;
+    std::vector<MPRegion> out;
+    std::vector<double> x, lambda, bth, f;
+    long nqp, nlp;
+};
+
+/* Active sets explored so far */
+struct MPSeen {
+    std::unordered_set<std::string> set[MPQPPAR_SHARDS];
+    mex_mutex mx[MPQPPAR_SHARDS];
+
+    bool insert(const std::vector<int> &act)
+    {
+        std::string key((const char *) act.data(), act.size() * sizeof(int));
+        size_t s = std::hash<std::string>()(key) % MPQPPAR_SHARDS;
+        mex_lock l(mx[s]);
+        return set[s].insert(key).second;
+    }
+};
+
+struct MPShared {
+    mpqppar_t *mp;
+    const mpqppar_settings *set;
+    std::vector<MPWorker *> workers;
+    MPSeen seen;
+    MexExplorer<MPItem> *ex;
+    mex_counter nreg;
+};
+
+void mpqppar_default_settings(mpqppar_settings *set)
+{
+    set->nthreads = 0;
+    set->maxregions = 0;
+    set->step = 1e-6;
+    set->flattol = 1e-8;
+    set->acttol = 1e-9;
+    set->removetol = 1e-9;
+}
+
+mpqppar_t *mpqppar_new(int n, int m, int npar, const double *Q, const double *C,
+                       const double *A, const double *b, const double *S,
+                       const double *thmin, const double *thmax)
+{
+    int i, j, k;
+    double s;
+    std::vector<double> L((size_t) n * n, 0.0);
+
+    /* Q = L*L' (column-major L) */
+    for (j = 0; j < n; j++) {
+        s = Q[j + (size_t) j * n];
+        for (k = 0; k < j; k++)
+            s -= L[j + (size_t) k * n] * L[j + (size_t) k * n];
+        if (!(s > 0))
+            return NULL;
+        L[j + (size_t) j * n] = std::sqrt(s);
+        for (i = j + 1; i < n; i++) {
+            s = Q[i + (size_t) j * n];
+            for (k = 0; k < j; k++)
+                s -= L[i + (size_t) k * n] * L[j + (size_t) k * n];
+            L[i + (size_t) j * n] = s / L[j + (size_t) j * n];
+        }
+    }
+
+    mpqppar_t *mp = new mpqppar_struct;
+    mp->n = n;
+    mp->m = m;
+    mp->npar = npar;
+    mp->Q.assign(Q, Q + (size_t) n * n);
+    mp->Acm.assign(A, A + (size_t) m * n);
+    mp->b.assign(b, b + m);
+    mp->thmin.assign(thmin, thmin + npar);
+    mp->thmax.assign(thmax, thmax + npar);
+    mp->A.resize((size_t) m * n);
+    mp->S.resize((size_t) m * npar);
+    mp->C.resize((size_t) n * npar);
+    for (i = 0; i < m; i++) {
+        for (j = 0; j < n; j++)
+            mp->A[(size_t) i * n + j] = A[i + (size_t) j * m];
+        for (j = 0; j < npar; j++)
+            mp->S[(size_t) i * npar + j] = S[i + (size_t) j * m];
+    }
+    for (i = 0; i < n; i++)
+        for (j = 0; j < npar; j++)
+            mp->C[(size_t) i * npar + j] = C[i + (size_t) j * n];
+
+    /* Rinv = inv(L') upper triangular: solve L'*Rinv = I */
+    mp->Rinv.assign((size_t) n * n, 0.0);
+    for (j = 0; j < n; j++)
+        for (i = j; i >= 0; i--) {
+            s = (i == j) ? 1.0 : 0.0;
+            for (k = i + 1; k <= j; k++)
+                s -= L[k + (size_t) i * n] * mp->Rinv[(size_t) k * n + j];
+            mp->Rinv[(size_t) i * n + j] = s / L[i + (size_t) i * n];
+        }
+
+    mp->Z.assign((size_t) m * n, 0.0);
+    for (i = 0; i < m; i++)
+        for (j = 0; j < n; j++) {
+            s = 0;
+            for (k = 0; k <= j; k++)
+                s += mp->A[(size_t) i * n + k] * mp->Rinv[(size_t) k * n + j];
+            mp->Z[(size_t) i * n + j] = s;
+        }
+    mp->D.assign((size_t) n * npar, 0.0);
+    for (i = 0; i < n; i++)
+        for (j = 0; j < npar; j++) {
+            s = 0;
+            for (k = 0; k <= i; k++)
+                s += mp->Rinv[(size_t) k * n + i] * mp->C[(size_t) k * npar + j];
+            mp->D[(size_t) i * npar + j] = s;
+        }
+    return mp;
+}
+
+void mpqppar_free(mpqppar_t *mp)
+{
+    delete mp;
+}
+
+int mpqppar_num_regions(const mpqppar_t *mp)
+{
+    return (int) mp->regions.size();
+}
+
+void mpqppar_get_region(const mpqppar_t *mp, int i, mpqppar_region *r)
+{
+    const MPRegion &R = mp->regions[i];
+    r->nrows = (int) R.K.size();
+    r->nact = (int) R.act.size();
+    r->H = R.H.empty() ? NULL : &R.H[0];
+    r->K = R.K.empty() ? NULL : &R.K[0];
+    r->F = R.F.empty() ? NULL : &R.F[0];
+    r->g = R.g.empty() ? NULL : &R.g[0];
+    r->act = R.act.empty() ? NULL : &R.act[0];
+    r->xc = R.xc.empty() ? NULL : &R.xc[0];
+    r->rcheb = R.rcheb;
+    r->depth = R.depth;
+}
+
+/* Cholesky factorization of the k-by-k matrix M in place (lower part,
+   row-major). Returns false if M is not positive definite. */
+static bool chol(std::vector<double> &M, int k)
+{
+    int i, j, l;
+    double s;
+
+    for (j = 0; j < k; j++) {
+        s = M[(size_t) j * k + j];
+        for (l = 0; l < j; l++)
+            s -= M[(size_t) j * k + l] * M[(size_t) j * k + l];
+        if (!(s > 1e-14))
+            return false;
+        M[(size_t) j * k + j] = std::sqrt(s);
+        for (i = j + 1; i < k; i++) {
+            s = M[(size_t) i * k + j];
+            for (l = 0; l < j; l++)
+                s -= M[(size_t) i * k + l] * M[(size_t) j * k + l];
+            M[(size_t) i * k + j] = s / M[(size_t) j * k + j];
+        }
+    }
+    return true;
+}
+
+/* Solve L*L'*y = v in place */
+static void cholsolve(const std::vector<double> &M, int k, double *v)
+{
+    int i, l;
+    for (i = 0; i < k; i++) {
+        for (l = 0; l < i; l++)
+            v[i] -= M[(size_t) i * k + l] * v[l];
+        v[i] /= M[(size_t) i * k + i];
+    }
+    for (i = k - 1; i >= 0; i--) {
+        for (l = i + 1; l < k; l++)
+            v[i] -= M[(size_t) l * k + i] * v[l];
+        v[i] /= M[(size_t) i * k + i];
+    }
+}
+
+/* Active set of the QP solution: constraints with positive multipliers,
+   largest first, as long as the rows of Z stay linearly independent */
+static void active_set(const mpqppar_t *mp, const mpqppar_settings *set,
+                       const std::vector<double> &lambda, std::vector<int> &act)
+{
+    int n = mp->n, i, j, l;
+    double lmax = 1.0, s, nz, nr;
+    std::vector<int> cand;
+    std::vector<double> basis, r(n);
+
+    for (i = 0; i < mp->m; i++)
+        lmax = std::max(lmax, lambda[i]);
+    for (i = 0; i < mp->m; i++)
+        if (lambda[i] > set->acttol * lmax)
+            cand.push_back(i);
+    std::sort(cand.begin(), cand.end(), [&](int a, int c) { return lambda[a] > lambda[c]; });
+
+    act.clear();
+    for (l = 0; l < (int) cand.size() && (int) act.size() < n; l++) {
+        const double *z = &mp->Z[(size_t) cand[l] * n];
+        nz = 0;
+        for (j = 0; j < n; j++) {
+            r[j] = z[j];
+            nz += z[j] * z[j];
+        }
+        for (i = 0; i < (int) act.size(); i++) {
+            const double *q = &basis[(size_t) i * n];
+            s = DenseLP::dot(q, &r[0], n);
+            for (j = 0; j < n; j++)
+                r[j] -= s * q[j];
+        }
+        nr = std::sqrt(DenseLP::dot(&r[0], &r[0], n));
+        if (nr <= 1e-9 * std::sqrt(nz))
+            continue;
+        for (j = 0; j < n; j++)
+            r[j] /= nr;
+        basis.insert(basis.end(), r.begin(), r.end());
+        act.push_back(cand[l]);
+    }
+    std::sort(act.begin(), act.end());
+}
+
+/* Critical region and affine optimizer of the active set act. origin[k]
+   = constraint whose primal (0..m-1) or dual (m..2m-1) feasibility gives
+   row k of P, -1 for the box. Returns false if the active set is
+   degenerate or the region is empty. */
+static bool critical_region(const mpqppar_t *mp, const std::vector<int> &act, MPRegion &R,
+                            Polytope &P, std::vector<int> &origin)
+{
+    int n = mp->n, m = mp->m, np = mp->npar, k = (int) act.size(), i, j, l, a;
+    double s, nh;
+    std::vector<double> M((size_t) k * k), T((size_t) k * np), gl(k), W((size_t) n * np),
+        w(n), h(np);
+    std::vector<char> isact(m, 0);
+
+    for (i = 0; i < k; i++)
+        isact[act[i]] = 1;
+
+    /* M = Z_A*Z_A', T = S_A + Z_A*D */
+    for (i = 0; i < k; i++) {
+        const double *zi = &mp->Z[(size_t) act[i] * n];
+        for (l = 0; l <= i; l++) {
+            s = DenseLP::dot(zi, &mp->Z[(size_t) act[l] * n], n);
+            M[(size_t) i * k + l] = s;
+            M[(size_t) l * k + i] = s;
+        }
+        for (j = 0; j < np; j++) {
+            s = mp->S[(size_t) act[i] * np + j];
+            for (l = 0; l < n; l++)
+                s += zi[l] * mp->D[(size_t) l * np + j];
+            T[(size_t) i * np + j] = s;
+        }
+        gl[i] = mp->b[act[i]];
+    }
+    if (!chol(M, k))
+        return false;
+
+    /* Fl = -inv(M)*T (stored in T), gl = -inv(M)*b_A */
+    std::vector<double> v(k);
+    for (j = 0; j < np; j++) {
+        for (i = 0; i < k; i++)
+            v[i] = T[(size_t) i * np + j];
+        cholsolve(M, k, &v[0]);
+        for (i = 0; i < k; i++)
+            T[(size_t) i * np + j] = -v[i];
+    }
+    cholsolve(M, k, &gl[0]);
+    for (i = 0; i < k; i++)
+        gl[i] = -gl[i];
+
+    /* W = D + Z_A'*Fl, w = Z_A'*gl; F = -Rinv*W, g = -Rinv*w */
+    for (l = 0; l < n; l++) {
+        for (j = 0; j < np; j++) {
+            s = mp->D[(size_t) l * np + j];
+            for (i = 0; i < k; i++)
+                s += mp->Z[(size_t) act[i] * n + l] * T[(size_t) i * np + j];
+            W[(size_t) l * np + j] = s;
+        }
+        s = 0;
+        for (i = 0; i < k; i++)
+            s += mp->Z[(size_t) act[i] * n + l] * gl[i];
+        w[l] = s;
+    }
+    R.F.assign((size_t) n * np, 0.0);
+    R.g.assign(n, 0.0);
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < np; j++) {
+            s = 0;
+            for (l = i; l < n; l++)
+                s += mp->Rinv[(size_t) i * n + l] * W[(size_t) l * np + j];
+            R.F[(size_t) i * np + j] = -s;
+        }
+        s = 0;
+        for (l = i; l < n; l++)
+            s += mp->Rinv[(size_t) i * n + l] * w[l];
+        R.g[i] = -s;
+    }
+
+    /* Rows of the region, normalized */
+    P = Polytope(np);
+    origin.clear();
+    for (a = 0; a < 2 * m + 2 * np; a++) {
+        double kk;
+        if (a < m) {
+            if (isact[a])
+                continue;
+            /* A_i*(F*th+g) <= b_i + S_i*th */
+            const double *ai = &mp->A[(size_t) a * n];
+            for (j = 0; j < np; j++) {
+                s = -mp->S[(size_t) a * np + j];
+                for (l = 0; l < n; l++)
+                    s += ai[l] * R.F[(size_t) l * np + j];
+                h[j] = s;
+            }
+            kk = mp->b[a] - DenseLP::dot(ai, &R.g[0], n);
+        }
+        else if (a < 2 * m) {
+            if (!isact[a - m])
+                continue;
+            /* lambda >= 0 */
+            i = (int) (std::lower_bound(act.begin(), act.end(), a - m) - act.begin());
+            for (j = 0; j < np; j++)
+                h[j] = -T[(size_t) i * np + j];
+            kk = gl[i];
+        }
+        else {
+            l = (a - 2 * m) / 2;
+            for (j = 0; j < np; j++)
+                h[j] = 0.0;
+            if ((a - 2 * m) % 2 == 0) {
+                h[l] = 1.0;
+                kk = mp->thmax[l];
+            }
+            else {
+                h[l] = -1.0;
+                kk = -mp->thmin[l];
+            }
+        }
+        nh = std::sqrt(DenseLP::dot(&h[0], &h[0], np));
+        if (nh <= 1e-10) {
+            if (kk < -1e-9)
+                return false;
+            continue;
+        }
+        for (j = 0; j < np; j++)
+            h[j] /= nh;
+        P.add_row(&h[0], kk / nh);
+        origin.push_back(a < 2 * m ? a : -1);
+    }
+    R.act = act;
+    return true;
+}
+
+static double max_violation(const Polytope &P, const std::vector<double> &th)
+{
+    double v = 0;
+    for (int i = 0; i < P.rows(); i++)
+        v = std::max(v, DenseLP::dot(P.row(i), &th[0], P.n) - P.b[i]);
+    return v;
+}
+
+static void process(MPShared &sh, int t, const MPItem &it)
+{
+    mpqppar_t *mp = sh.mp;
+    MPWorker &w = *sh.workers[t];
+    const mpqppar_settings *set = sh.set;
+    int n = mp->n, m = mp->m, np = mp->npar, i, j, status;
+    std::vector<double> th(np), x0;
+    std::vector<int> act, origin, kept;
+    Polytope P;
+    MPRegion R;
+    bool ok;
+
+    for (j = 0; j < np; j++) {
+        th[j] = it.x[j] + it.step * it.d[j];
+        if (th[j] > mp->thmax[j] || th[j] < mp->thmin[j])
+            return;
+    }
+
+    /* QP at th */
+    for (i = 0; i < m; i++)
+        w.bth[i] = mp->b[i] + DenseLP::dot(&mp->S[(size_t) i * np], &th[0], np);
+    for (i = 0; i < n; i++)
+        w.f[i] = DenseLP::dot(&mp->C[(size_t) i * np], &th[0], np);
+    status = qpdual_solve(w.qp, m, 0, m > 0 ? &mp->Acm[0] : NULL, m > 0 ? &w.bth[0] : NULL,
+                          &w.f[0], &w.x[0], m > 0 ? &w.lambda[0] : NULL, NULL);
+    w.nqp++;
+    if (status != QPDUAL_OK)
+        return;   /* th outside the feasible set */
+
+    active_set(mp, set, w.lambda, act);
+    if (!sh.seen.insert(act))
+        return;   /* region already explored */
+
+    ok = critical_region(mp, act, R, P, origin);
+    if (ok) {
+        int lps = 0;
+        x0 = th;
+        ok = !poly_reduce(w.lp, P, set->removetol, x0, 1e-10, &kept, &lps, 1);
+        w.nlp += lps;
+    }
+    if (ok) {
+        R.xc = th;
+        poly_chebyshev(w.lp, P, NULL, NULL, &R.xc[0], &R.rcheb);
+        w.nlp++;
+        ok = R.rcheb > set->flattol;
+    }
+    if (!ok || max_violation(P, th) > 1e-7) {
+        /* Flat or degenerate: try further from the facet */
+        if (it.tries < 3 && it.step > 0) {
+            MPItem it2 = it;
+            it2.step *= 10;
+            it2.tries++;
+            sh.ex->push(t, it2);
+        }
+        if (!ok)
+            return;
+    }
+
+    R.H = P.A;
+    R.K = P.b;
+    R.depth = it.depth;
+    w.out.push_back(R);
+    if (set->maxregions > 0 && ++sh.nreg >= set->maxregions) {
+        sh.ex->stop();
+        return;
+    }
+
+    /* Cross the facets that are not on the box */
+    std::vector<double> Ao, bo, xf;
+    for (int r = 0; r < P.rows(); r++) {
+        if (origin[kept[r]] < 0)
+            continue;
+        Ao.clear();
+        bo.clear();
+        for (i = 0; i < P.rows(); i++) {
+            if (i == r)
+                continue;
+            Ao.insert(Ao.end(), P.row(i), P.row(i) + np);
+            bo.push_back(P.b[i]);
+        }
+        double rf;
+        xf = R.xc;
+        status = lpdense_facet_chebyshev(w.lp, np, P.row(r), P.b[r], P.rows() - 1,
+                                         Ao.empty() ? NULL : &Ao[0],
+                                         bo.empty() ? NULL : &bo[0], &xf[0], &rf);
+        w.nlp++;
+        /* unbounded: the facet is a point (npar=1) or an unbounded slice
+           of a region with parallel rows, xf is still on the facet */
+        if ((status != LPDENSE_OPTIMAL && status != LPDENSE_UNBOUNDED) || !(rf > set->flattol))
+            continue;
+        MPItem it2;
+        it2.x = xf;
+        it2.d.assign(P.row(r), P.row(r) + np);
+        it2.step = set->step;
+        it2.tries = 0;
+        it2.depth = it.depth + 1;
+        sh.ex->push(t, it2);
+    }
+}
+
+/* A parameter vector in the interior of the set of th for which the QP is
+   feasible: max r s.t. A*x - S*th + r <= b, thmin+r <= th <= thmax-r */
+static bool first_point(mpqppar_t *mp, DenseLP &lp, std::vector<double> &th)
+{
+    int n = mp->n, m = mp->m, np = mp->npar, nv = n + np + 1, i, j;
+    std::vector<double> c(nv, 0.0), y(nv, 0.0);
+
+    lp.resize(nv, m + 2 * np + 1, 0);
+    for (i = 0; i < m; i++) {
+        double *a = lp.row(i);
+        for (j = 0; j < n; j++)
+            a[j] = mp->A[(size_t) i * n + j];
+        for (j = 0; j < np; j++)
+            a[n + j] = -mp->S[(size_t) i * np + j];
+        a[nv - 1] = 1.0;
+        lp.b[i] = mp->b[i];
+    }
+    for (j = 0; j < np; j++) {
+        double *a = lp.row(m + 2 * j), *a2 = lp.row(m + 2 * j + 1);
+        for (i = 0; i < nv; i++)
+            a[i] = a2[i] = 0.0;
+        a[n + j] = 1.0;
+        a[nv - 1] = 1.0;
+        lp.b[m + 2 * j] = mp->thmax[j];
+        a2[n + j] = -1.0;
+        a2[nv - 1] = 1.0;
+        lp.b[m + 2 * j + 1] = -mp->thmin[j];
+        y[n + j] = .5 * (mp->thmin[j] + mp->thmax[j]);
+    }
+    double *a = lp.row(m + 2 * np);
+    for (i = 0; i < nv; i++)
+        a[i] = 0.0;
+    a[nv - 1] = 1.0;
+    lp.b[m + 2 * np] = 1.0;   /* r <= 1 keeps the LP bounded */
+    y[nv - 1] = -1e6;
+    c[nv - 1] = -1.0;
+    if (lp.solve(&c[0], &y[0]) != LPDENSE_OPTIMAL || !(y[nv - 1] > 0))
+        return false;
+    th.assign(y.begin() + n, y.begin() + n + np);
+    return true;
+}
+
+int mpqppar_solve(mpqppar_t *mp, const mpqppar_settings *set, long *nqp, long *nlp)
+{
+    int n = mp->n, m = mp->m, np = mp->npar, nt, t, status;
+    MPShared sh;
+    MPItem it;
+
+    mp->regions.clear();
+    if (nqp)
+        *nqp = 0;
+    if (nlp)
+        *nlp = 0;
+
+    MexExplorer<MPItem> ex(set->nthreads);
+    nt = ex.num_threads();
+    sh.mp = mp;
+    sh.set = set;
+    sh.ex = &ex;
+    sh.nreg = 0;
+    for (t = 0; t < nt; t++) {
+        MPWorker *w = new MPWorker;
+        w->qp = qpdual_new(n, &mp->Q[0]);
+        w->x.resize(n);
+        w->f.resize(n);
+        w->lambda.resize(m);
+        w->bth.resize(m);
+        w->nqp = w->nlp = 0;
+        sh.workers.push_back(w);
+    }
+    if (!sh.workers[0]->qp)
+        status = MPQPPAR_NOTPOSDEF;
+    else if (!first_point(mp, sh.workers[0]->lp, it.x))
+        status = MPQPPAR_NOFEASIBLE;
+    else {
+        it.d.assign(np, 0.0);
+        it.step = 0;
+        it.tries = 0;
+        it.depth = 0;
+        ex.push(0, it);
+        ex.run([&sh](const MPItem &item, int tid) { process(sh, tid, item); });
+        status = ex.stopped() ? MPQPPAR_MAXREGIONS : MPQPPAR_OK;
+    }
+
+    for (t = 0; t < nt; t++) {
+        MPWorker *w = sh.workers[t];
+        for (size_t k = 0; k < w->out.size(); k++)
+            mp->regions.push_back(w->out[k]);
+        if (nqp)
+            *nqp += w->nqp;
+        if (nlp)
+            *nlp += w->nlp;
+        if (w->qp)
+            qpdual_free(w->qp);
+        delete w;
+    }
+    if (status == MPQPPAR_OK && mp->regions.empty())
+        status = MPQPPAR_NOFEASIBLE;
+
+    /* The order in which regions are found depends on the threads */
+    std::sort(mp->regions.begin(), mp->regions.end(), [](const MPRegion &a, const MPRegion &c) {
+        return a.act < c.act;
+    });
+    return status;
+}
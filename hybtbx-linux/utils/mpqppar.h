@@ -0,0 +1,92 @@
+/* Parallel multiparametric QP solver - C API
+
+   Computes the explicit solution of
+
+       min  .5*x'*Q*x + th'*C'*x
+       s.t. A*x <= b + S*th,     thmin <= th <= thmax
+
+   (Q positive definite) as a partition of the parameter box into
+   critical regions {th: H*th <= K}, in each of which the optimizer is
+   affine, x = F*th + g, and a fixed combination of constraints is active.
+
+   Regions are explored by crossing their facets: the QP is solved at a
+   point just beyond the Chebychev center of each facet, the critical
+   region of its active set is built from the KKT conditions, redundant
+   rows are removed and its facets are crossed in turn. The exploration
+   runs on several worker threads. Each worker keeps a deque of points to
+   visit, takes work from the back of its own deque (depth first, so that
+   consecutive QPs are warm started from neighboring active sets) and,
+   when idle, steals from the front of the deque of another worker. Active
+   sets already explored are recorded in a hash set shared by the workers
+   (split in shards with their own lock), so that each critical region is
+   built once.
+
+   QPs are solved by the dual active-set solver in QPDUAL.CPP, LPs by
+   LPDENSE.H. Matrices are column-major (MATLAB layout). See MPQPPARMEX.CPP
+   for the MEX interface and MPQPPAR.M for the MATLAB wrapper.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef MPQPPAR_H
+#define MPQPPAR_H
+
+#define MPQPPAR_OK           0
+#define MPQPPAR_NOFEASIBLE   1   /* no parameter with a feasible QP (or flat set) */
+#define MPQPPAR_MAXREGIONS   2   /* exploration stopped at maxregions */
+#define MPQPPAR_NOTPOSDEF    3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mpqppar_struct mpqppar_t;
+
+typedef struct {
+    int nthreads;       /* worker threads (<=0: all cores) */
+    int maxregions;     /* stop after this number of regions (0 = no limit) */
+    double step;        /* distance of the QP point beyond a facet (1e-6) */
+    double flattol;     /* regions with smaller Chebychev radius are
+                           discarded (1e-8) */
+    double acttol;      /* multipliers > acttol*max(1,max(lambda)) define
+                           the active set (1e-9) */
+    double removetol;   /* tolerance of the redundancy LPs (1e-9) */
+} mpqppar_settings;
+
+typedef struct {
+    int nrows;          /* rows of H,K */
+    int nact;           /* number of active constraints */
+    const double *H;    /* nrows-by-npar, row-major, rows of unit norm */
+    const double *K;
+    const double *F;    /* n-by-npar, row-major */
+    const double *g;    /* n */
+    const int *act;     /* 0-based, increasing */
+    const double *xc;   /* Chebychev center (npar) */
+    double rcheb;       /* Chebychev radius */
+    int depth;          /* number of facet crossings from the first region */
+} mpqppar_region;
+
+void mpqppar_default_settings(mpqppar_settings *set);
+
+/* Create the problem (data are copied) with n variables, m constraints
+   and npar parameters. Q is n-by-n, C n-by-npar, A m-by-n, b m, S
+   m-by-npar. Returns NULL if Q is not positive definite. */
+mpqppar_t *mpqppar_new(int n, int m, int npar, const double *Q, const double *C,
+                       const double *A, const double *b, const double *S,
+                       const double *thmin, const double *thmax);
+
+/* Compute the partition. Returns one of the MPQPPAR_* codes. nqp and nlp
+   (may be NULL) receive the number of QPs and LPs solved. */
+int mpqppar_solve(mpqppar_t *mp, const mpqppar_settings *set, long *nqp, long *nlp);
+
+/* Regions of the last solve, ordered by active set */
+int mpqppar_num_regions(const mpqppar_t *mp);
+void mpqppar_get_region(const mpqppar_t *mp, int i, mpqppar_region *r);
+
+void mpqppar_free(mpqppar_t *mp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+function mpqpsol=mpqppar(Q,C,A,b,S,thmin,thmax,verbose,flattol,nthreads,maxregions)
+% MPQPPAR Multiparametric quadratic optimization on several threads
+%
+% mpqpsol=MPQPPAR(Q,C,A,b,S,thmin,thmax) parametrically solves
+%
+%    min  .5*x'Qx+th'*C'*x
+%    s.t. A*x <= b + S*th,    thmin <= th <= thmax
+%
+% (Q positive definite) like MPQP, and returns the solution in a structure
+% with the same fields:
+%
+%  H,K,i1,i2:    Region #i is stored in H(i1(i):i2(i),:),K(i1(i):i2(i),:)
+%  F,G:          Gain #i is stored in F((i-1)*n+1:i*n,:), G((i-1)*n+1:i*n)
+%  rCheb:        Chebychev radius of region #i
+%  act,i3,i4:    Combination of active constraints of region #i is stored in act(i3(i):i4(i),:)
+%  unconstr_num: Region number for the region where no constraints are active
+%  nr:           Number of regions
+%
+% The critical regions are explored by the native solver MPQPPARMEX (see
+% MPQPPAR.CPP and MEXCOMPILE.M): the facets of each region are crossed
+% by worker threads that share a hash set of the active sets already
+% explored, and idle workers steal work from the others. The partition
+% does not depend on the number of threads.
+%
+% mpqpsol=MPQPPAR(Q,C,A,b,S,thmin,thmax,verbose,flattol,nthreads,maxregions)
+% also specifies
+%
+%  verbose    =1 shows the number of regions, QPs and LPs (default: 0)
+%  flattol    regions with Chebychev radius smaller than flattol are
+%             discarded (default: 1e-8). Unlike MPQP, the other regions
+%             are not enlarged to cover them.
+%  nthreads   number of worker threads (default: all cores)
+%  maxregions stop after maxregions regions (default: no limit)
+%
+% Envelopes and restrictions {th: Hth*th<=Kth} of the parameter set are
+% not supported, use MPQP.
+%
+% See also MPQP, GETCONTROLLER.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<8 || isempty(verbose),
+    verbose=0;
+end
+if nargin<9 || isempty(flattol),
+    flattol=1e-8;
+end
+if nargin<10,
+    nthreads=[];
+end
+if nargin<11,
+    maxregions=[];
+end
+if exist('mpqpparmex')~=3,
+    error('mpqppar:nomex','MPQPPARMEX is not compiled (type "mexcompile(''mpqpparmex'')"), use MPQP.');
+end
+
+npar=length(thmin);
+nvar=size(Q,1);
+if isempty(C),
+    C=zeros(nvar,npar);
+end
+if isempty(S),
+    S=zeros(size(A,1),npar);
+end
+
+opts=struct('nthreads',nthreads,'maxregions',maxregions,'flattol',flattol);
+[H,K,i1,i2,F,G,rCheb,act,i3,i4,status,nqp,nlp]=mpqpparmex(full(Q),full(C),full(A),...
+    full(b(:)),full(S),thmin(:),thmax(:),opts);
+
+switch status
+    case 1
+        warning('mpqppar:infeasible','The QP is infeasible for all parameters in the given range');
+    case 2
+        warning('mpqppar:maxregions','Exploration stopped after %d regions',length(i1));
+    case 3
+        error('mpqppar:posdef','Q must be positive definite');
+end
+if verbose,
+    fprintf('%d regions, %d QPs, %d LPs solved\n',length(i1),nqp,nlp);
+end
+
+unconstr_num=find(i4<i3);
+mpqpsol=struct('H',H,'K',K,'i1',i1,'i2',i2,'F',F,'G',G,'rCheb',rCheb,...
+    'act',act,'i3',i3,'i4',i4,'unconstr_num',unconstr_num(:)','nr',length(i1),...
+    'nvar',nvar,'flattol',flattol,'thmin',thmin(:),'thmax',thmax(:));
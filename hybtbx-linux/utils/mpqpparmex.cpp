@@ -0,0 +1,145 @@
+/* Parallel multiparametric QP solver - MEX interface
+
+   [H,K,i1,i2,F,G,rCheb,act,i3,i4,status,nqp,nlp]=mpqpparmex(Q,C,A,b,S,thmin,thmax,opts)
+
+   Solves the mpQP
+
+       min  .5*x'*Q*x + th'*C'*x
+       s.t. A*x <= b + S*th,     thmin <= th <= thmax
+
+   by the solver in MPQPPAR.CPP. The outputs have the format of MPQP:
+   region #i is {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, where
+   x = F((i-1)*n+1:i*n,:)*th + G((i-1)*n+1:i*n), and act(i3(i):i4(i)) are
+   the active constraints (i4(i)=i3(i)-1 if none).
+
+   opts is a structure with optional fields
+       nthreads   = number of worker threads (default: all cores)
+       maxregions = stop after this number of regions (default: no limit)
+       step       = distance beyond a facet where the QP is solved (1e-6)
+       flattol    = regions with smaller Chebychev radius are discarded (1e-8)
+       acttol     = relative tolerance on multipliers for the active set (1e-9)
+       removetol  = tolerance for removing redundant rows (1e-9)
+
+   status = 0 solved, 1 no feasible parameter, 2 stopped at maxregions,
+            3 Q not positive definite
+   nqp,nlp = number of QPs and LPs solved
+
+   Compile with MEXCOMPILE.M (or mex -O mpqpparmex.cpp mpqppar.cpp qpdual.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "mpqppar.h"
+#include <vector>
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+static void getfull(const mxArray *a, const char *name, int m, int n)
+{
+    if (!mxIsDouble(a) || mxIsSparse(a) || (int) mxGetM(a) != m || (int) mxGetN(a) != n)
+        mexErrMsgIdAndTxt("mpqpparmex:dim", "%s must be a full %d-by-%d matrix.", name, m, n);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    mpqppar_settings set;
+    mpqppar_region R;
+    mpqppar_t *mp;
+    int n, m, npar, nr, nh = 0, na = 0, i, j, k, r, status;
+    long nqp = 0, nlp = 0;
+    double *H, *K, *F, *G;
+
+    if (nrhs < 7)
+        mexErrMsgTxt("At least seven input arguments required.");
+
+    n = (int) mxGetM(prhs[0]);
+    m = (int) mxGetM(prhs[2]);
+    npar = (int) mxGetN(prhs[1]);
+    getfull(prhs[0], "Q", n, n);
+    getfull(prhs[1], "C", n, npar);
+    getfull(prhs[2], "A", m, n);
+    if (!mxIsDouble(prhs[3]) || (int) mxGetNumberOfElements(prhs[3]) != m)
+        mexErrMsgTxt("b has wrong dimension.");
+    getfull(prhs[4], "S", m, npar);
+    if ((int) mxGetNumberOfElements(prhs[5]) != npar || (int) mxGetNumberOfElements(prhs[6]) != npar)
+        mexErrMsgTxt("thmin and thmax must have as many elements as the columns of C.");
+
+    mpqppar_default_settings(&set);
+    if (nrhs > 7) {
+        set.nthreads = (int) getopt(prhs[7], "nthreads", set.nthreads);
+        set.maxregions = (int) getopt(prhs[7], "maxregions", set.maxregions);
+        set.step = getopt(prhs[7], "step", set.step);
+        set.flattol = getopt(prhs[7], "flattol", set.flattol);
+        set.acttol = getopt(prhs[7], "acttol", set.acttol);
+        set.removetol = getopt(prhs[7], "removetol", set.removetol);
+    }
+
+    mp = mpqppar_new(n, m, npar, mxGetPr(prhs[0]), mxGetPr(prhs[1]), mxGetPr(prhs[2]),
+                     mxGetPr(prhs[3]), mxGetPr(prhs[4]), mxGetPr(prhs[5]), mxGetPr(prhs[6]));
+    if (mp)
+        status = mpqppar_solve(mp, &set, &nqp, &nlp);
+    else
+        status = MPQPPAR_NOTPOSDEF;
+
+    nr = mp ? mpqppar_num_regions(mp) : 0;
+    for (r = 0; r < nr; r++) {
+        mpqppar_get_region(mp, r, &R);
+        nh += R.nrows;
+        na += R.nact;
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(nh, npar, mxREAL);
+    plhs[1] = mxCreateDoubleMatrix(nh, 1, mxREAL);
+    plhs[2] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[3] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[4] = mxCreateDoubleMatrix(nr * n, npar, mxREAL);
+    plhs[5] = mxCreateDoubleMatrix(nr * n, 1, mxREAL);
+    plhs[6] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[7] = mxCreateDoubleMatrix(na, 1, mxREAL);
+    plhs[8] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[9] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    H = mxGetPr(plhs[0]);
+    K = mxGetPr(plhs[1]);
+    F = mxGetPr(plhs[4]);
+    G = mxGetPr(plhs[5]);
+
+    for (r = 0, k = 0, na = 0; r < nr; r++) {
+        mpqppar_get_region(mp, r, &R);
+        mxGetPr(plhs[2])[r] = k + 1;
+        for (i = 0; i < R.nrows; i++, k++) {
+            for (j = 0; j < npar; j++)
+                H[k + (size_t) j * nh] = R.H[(size_t) i * npar + j];
+            K[k] = R.K[i];
+        }
+        mxGetPr(plhs[3])[r] = k;
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < npar; j++)
+                F[(size_t) r * n + i + (size_t) j * nr * n] = R.F[(size_t) i * npar + j];
+            G[(size_t) r * n + i] = R.g[i];
+        }
+        mxGetPr(plhs[6])[r] = R.rcheb;
+        mxGetPr(plhs[8])[r] = na + 1;
+        for (i = 0; i < R.nact; i++)
+            mxGetPr(plhs[7])[na++] = R.act[i] + 1;
+        mxGetPr(plhs[9])[r] = na;
+    }
+    if (mp)
+        mpqppar_free(mp);
+
+    if (nlhs > 10)
+        plhs[10] = mxCreateDoubleScalar(status);
+    if (nlhs > 11)
+        plhs[11] = mxCreateDoubleScalar((double) nqp);
+    if (nlhs > 12)
+        plhs[12] = mxCreateDoubleScalar((double) nlp);
+}
@@ -0,0 +1,128 @@
+function [E,A,bnd]=partadjacency(H,K,i1,i2,thmin,thmax,tol,nthreads)
+% PARTADJACENCY Adjacency graph of the regions of a polyhedral partition
+%
+% [E,A,bnd]=PARTADJACENCY(H,K,i1,i2) computes which regions of the
+% partition {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, i=1,...,nr, share
+% a facet.
+%
+% E   = ne-by-4 matrix. Each row [i,a,j,b] means that regions #i and #j
+%       (i<j) are adjacent through the facet H(a,:)*th=K(a) of region #i,
+%       which lies on the facet H(b,:)*th=K(b) of region #j (a,b are row
+%       indices of H). A facet can have several neighbors.
+% A   = nr-by-nr sparse symmetric adjacency matrix of the regions.
+% bnd = rows of H with no neighboring region, i.e. facets on the boundary
+%       of the union of the regions (or redundant rows).
+%
+% [E,A,bnd]=PARTADJACENCY(H,K,i1,i2,thmin,thmax) intersects each region
+% with the box thmin <= th <= thmax.
+%
+% [E,A,bnd]=PARTADJACENCY(H,K,i1,i2,thmin,thmax,tol,nthreads) also sets
+% the tolerance on the normalized hyperplanes and on the radius of the
+% common facet (default: 1e-6) and the number of worker threads (default:
+% all cores).
+%
+% [E,A,bnd]=PARTADJACENCY(sol,tol,nthreads) where sol is the output of MPQP,
+% MPLP, or GETCONTROLLER uses sol.H,sol.K,sol.i1,sol.i2,sol.thmin,sol.thmax.
+%
+% Normalized facet hyperplanes are hashed, so that only facets lying on the
+% same hyperplane are compared, and each candidate pair is confirmed by at
+% most one small LP in the MEX function ADJMEX. If ADJMEX is not compiled,
+% candidate pairs are found by comparing normalized rows and confirmed
+% through FACECHEBY.
+%
+% See also CHEBYBALLS, FACECHEBY.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if isstruct(H),
+    sol=H;
+    if nargin>=2,
+        tol=K;
+    else
+        tol=[];
+    end
+    if nargin>=3,
+        nthreads=i1;
+    else
+        nthreads=[];
+    end
+    H=sol.H;
+    K=sol.K;
+    i1=sol.i1;
+    i2=sol.i2;
+    if isfield(sol,'thmin'),
+        thmin=sol.thmin;
+        thmax=sol.thmax;
+    else
+        thmin=[];
+        thmax=[];
+    end
+else
+    if nargin<4,
+        error('Not enough input arguments');
+    end
+    if nargin<5,
+        thmin=[];
+    end
+    if nargin<6,
+        thmax=[];
+    end
+    if nargin<7,
+        tol=[];
+    end
+    if nargin<8,
+        nthreads=[];
+    end
+end
+if isempty(tol),
+    tol=1e-6;
+end
+thmin=thmin(:);
+thmax=thmax(:);
+i1=i1(:);
+i2=i2(:);
+nr=length(i1);
+[nh,npar]=size(H);
+
+if exist('adjmex')==3,
+    E=adjmex(H,K,i1,i2,thmin,thmax,tol,nthreads);
+else
+    % MATLAB fallback
+    region=zeros(nh,1);
+    for i=1:nr,
+        region(i1(i):i2(i))=i;
+    end
+    hn=sqrt(sum(H.^2,2));
+    hn(hn<=tol)=NaN;
+    HK=[H,K(:)]./(hn*ones(1,npar+1));
+    E=zeros(0,4);
+    for a=1:nh,
+        i=region(a);
+        if i==0 || isnan(hn(a)),
+            continue
+        end
+        cand=find(max(abs(HK+ones(nh,1)*HK(a,:)),[],2)<=tol & region>i);
+        for b=cand(:)',
+            j=region(b);
+            ia=[a,i1(i):a-1,a+1:i2(i)];
+            jb=[i1(j):b-1,b+1:i2(j)];
+            Hab=H([ia,jb],:);
+            Kab=K([ia,jb]);
+            if ~isempty(thmin),
+                Hab=[Hab;eye(npar);-eye(npar)];
+                Kab=[Kab(:);thmax;-thmin];
+            end
+            if facecheby(Hab,Kab,1)>tol,
+                E(end+1,:)=[i,a,j,b];
+            end
+        end
+    end
+end
+
+if nargout>=2,
+    A=sparse([E(:,1);E(:,3)],[E(:,3);E(:,1)],1,nr,nr);
+    A=spones(A);
+end
+if nargout>=3,
+    bnd=setdiff((1:nh)',[E(:,2);E(:,4)]);
+end
@@ -0,0 +1,540 @@
+/* Operations on polyhedra {x: A*x <= b} in dense form - C++ header
+
+   Native counterparts of the toolbox functions POLYREDUCE, POLYUNION,
+   POLYINCL, POLYMINUS, POLYVOLUME and of the Chebychev ball LP, built on
+   the dense LP solver in LPDENSE.H. Rows are stored row-major. All
+   functions take the DenseLP object to work in, so that each worker
+   thread can reuse its own workspace; they are sequential, see POLYMEX.CPP
+   for their parallel use.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef POLYDENSE_H
+#define POLYDENSE_H
+
+#include "lpdense.h"
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <algorithm>
+
+struct Polytope {
+    int n;
+    std::vector<double> A;   /* rows-by-n, row-major */
+    std::vector<double> b;
+
+    Polytope(int n_ = 0) : n(n_) {}
+
+    int rows() const { return (int) b.size(); }
+    double *row(int i) { return &A[(size_t) i * n]; }
+    const double *row(int i) const { return &A[(size_t) i * n]; }
+
+    void add_row(const double *a, double bi)
+    {
+        A.insert(A.end(), a, a + n);
+        b.push_back(bi);
+    }
+    void remove_row(int i)
+    {
+        A.erase(A.begin() + (size_t) i * n, A.begin() + (size_t) (i + 1) * n);
+        b.erase(b.begin() + i);
+    }
+    /* Rows k0,...,k1 (inclusive) of the column-major matrix H (ld rows) */
+    void add_rows_colmajor(const double *H, const double *K, int ld, int k0, int k1)
+    {
+        for (int k = k0; k <= k1; k++) {
+            for (int j = 0; j < n; j++)
+                A.push_back(H[k + (size_t) j * ld]);
+            b.push_back(K[k]);
+        }
+    }
+};
+
+/* Load the rows of P into lp, skipping row 'skip' (-1: none) */
+inline void poly_load(DenseLP &lp, const Polytope &P, int skip = -1)
+{
+    int i, k = 0, m = P.rows() - (skip >= 0 ? 1 : 0);
+
+    lp.resize(P.n, m, 0);
+    for (i = 0; i < P.rows(); i++) {
+        if (i == skip)
+            continue;
+        const double *a = P.row(i);
+        double *r = lp.row(k);
+        for (int j = 0; j < P.n; j++)
+            r[j] = a[j];
+        lp.b[k++] = P.b[i];
+    }
+}
+
+/* max f'*x over P. x is the warm start on input, the optimizer on output.
+   Returns the LPDENSE_* status, *val = f'*x (Inf if unbounded). */
+inline int poly_maximize(DenseLP &lp, const Polytope &P, const double *f,
+                         double *x, double *val, int skip = -1)
+{
+    std::vector<double> c(f, f + P.n);
+    int status;
+
+    for (int j = 0; j < P.n; j++)
+        c[j] = -c[j];
+    poly_load(lp, P, skip);
+    status = lp.solve(&c[0], x);
+    if (status == LPDENSE_UNBOUNDED)
+        *val = std::numeric_limits<double>::infinity();
+    else
+        *val = DenseLP::dot(f, x, P.n);
+    return status;
+}
+
+/* Remove redundant rows of P (see POLYREDUCE.M): row j is removed if
+   max A(j,:)*x over the other rows is <= b(j)+removetol. Rows 0*x<=b are
+   removed first. x0 is a point of P on output, keptrows (if not NULL) the
+   original indices of the rows left, *lpsolved is incremented by the
+   number of LPs. Returns 1 if P is empty (P is then left unchanged). With
+   checkempty=0, P is assumed not to be empty and x0 must be a point of P
+   on input. */
+inline int poly_reduce(DenseLP &lp, Polytope &P, double removetol,
+                       std::vector<double> &x0, double zerotol = 1e-8,
+                       std::vector<int> *keptrows = NULL, int *lpsolved = NULL,
+                       int checkempty = 1)
+{
+    int i, j, n = P.n;
+    double val;
+    std::vector<double> c(n, 0.0);
+    std::vector<int> kept(P.rows());
+
+    for (i = 0; i < P.rows(); i++)
+        kept[i] = i;
+    if (keptrows)
+        *keptrows = kept;
+    if (checkempty || (int) x0.size() != n)
+        x0.assign(n, 0.0);
+    for (i = 0; i < P.rows(); i++) {
+        double s = 0;
+        for (j = 0; j < n; j++)
+            s += std::fabs(P.row(i)[j]);
+        if (s <= zerotol && P.b[i] < -zerotol)
+            return 1;
+    }
+    for (i = P.rows() - 1; i >= 0; i--) {
+        double s = 0;
+        for (j = 0; j < n; j++)
+            s += std::fabs(P.row(i)[j]);
+        if (s <= zerotol) {
+            P.remove_row(i);
+            kept.erase(kept.begin() + i);
+        }
+    }
+    if (keptrows)
+        *keptrows = kept;
+    if (P.rows() == 0)
+        return 0;
+
+    if (checkempty) {
+        /* x0 is used as warm start for the following LPs */
+        poly_load(lp, P);
+        if (lpsolved)
+            (*lpsolved)++;
+        if (lp.solve(&c[0], &x0[0]) == LPDENSE_INFEASIBLE)
+            return 1;
+    }
+
+    j = 0;
+    while (j < P.rows()) {
+        if (P.rows() == 1)
+            break;   /* only one constraint left */
+        std::vector<double> f(P.row(j), P.row(j) + n), x(x0);
+        int status = poly_maximize(lp, P, &f[0], &x[0], &val, j);
+        if (lpsolved)
+            (*lpsolved)++;
+        if (status != LPDENSE_OPTIMAL || val - P.b[j] > removetol)
+            j++;   /* kept unless the LP shows that it is redundant */
+        else {
+            P.remove_row(j);
+            kept.erase(kept.begin() + j);
+        }
+    }
+    if (keptrows)
+        *keptrows = kept;
+    return 0;
+}
+
+/* Row [a b] scaled by its largest entry in absolute value */
+inline void poly_scaled_row(const Polytope &P, int i, std::vector<double> &r)
+{
+    double s = std::fabs(P.b[i]);
+    int j;
+
+    r.resize(P.n + 1);
+    for (j = 0; j < P.n; j++)
+        if (std::fabs(P.row(i)[j]) > s)
+            s = std::fabs(P.row(i)[j]);
+    if (s <= 0)
+        s = 1;
+    for (j = 0; j < P.n; j++)
+        r[j] = P.row(i)[j] / s;
+    r[P.n] = P.b[i] / s;
+}
+
+/* Convex union of P1 and P2 (see POLYUNION.M with checkmin=1): P1, P2
+   must be minimal and have disjoint interiors. Returns 1 and the reduced
+   union in P3 if P1 U P2 is convex, 0 otherwise. With check=0 the
+   convexity of the union is not verified by LPs and P3 is not reduced. */
+inline int poly_union(DenseLP &lp, const Polytope &P1, const Polytope &P2,
+                      double tol, Polytope &P3, int check = 1, int *lpsolved = NULL)
+{
+    int i, j, k, n = P1.n, pairs = 0, i1 = -1, j1 = -1;
+    int m1 = P1.rows(), m2 = P2.rows();
+    double val;
+    std::vector<double> r1, r2, x(n, 0.0);
+    std::vector<int> i2, j2;
+    std::vector<char> drop1(m1, 0), drop2(m2, 0);
+
+    /* Look for pairs of rows which are opposite in sign */
+    for (i = 0; i < m1; i++) {
+        poly_scaled_row(P1, i, r1);
+        for (j = 0; j < m2; j++) {
+            poly_scaled_row(P2, j, r2);
+            bool opp = true, same = true;
+            for (k = 0; k <= n; k++) {
+                if (std::fabs(r1[k] + r2[k]) >= tol)
+                    opp = false;
+                if (std::fabs(r1[k] - r2[k]) >= tol)
+                    same = false;
+            }
+            if (opp) {
+                if (++pairs > 1)
+                    return 0;   /* the union is not convex */
+                i1 = i;
+                j1 = j;
+            }
+            if (same) {
+                i2.push_back(i);
+                j2.push_back(j);
+            }
+        }
+    }
+    if (pairs != 1)
+        return 0;
+
+    /* P3 = [~P1; ~P2; common rows] */
+    drop1[i1] = drop2[j1] = 1;
+    for (k = 0; k < (int) i2.size(); k++)
+        drop1[i2[k]] = drop2[j2[k]] = 1;
+    P3 = Polytope(n);
+    for (i = 0; i < m1; i++)
+        if (!drop1[i])
+            P3.add_row(P1.row(i), P1.b[i]);
+    for (j = 0; j < m2; j++)
+        if (!drop2[j])
+            P3.add_row(P2.row(j), P2.b[j]);
+    std::vector<double> a(n);
+    for (k = 0; k < (int) i2.size(); k++) {
+        for (j = 0; j < n; j++)
+            a[j] = .5 * (P1.row(i2[k])[j] + P2.row(j2[k])[j]);
+        P3.add_row(&a[0], .5 * (P1.b[i2[k]] + P2.b[j2[k]]));
+    }
+    if (!check)
+        return 1;
+
+    /* Every remaining row of P2 must be valid for P1, and vice versa */
+    for (i = 0; i < m2; i++) {
+        if (i == j1)
+            continue;
+        for (k = 0; k < (int) j2.size() && j2[k] != i; k++)
+            ;
+        if (k < (int) j2.size())
+            continue;
+        int status = poly_maximize(lp, P1, P2.row(i), &x[0], &val);
+        if (lpsolved)
+            (*lpsolved)++;
+        if (status == LPDENSE_INFEASIBLE || status == LPDENSE_UNBOUNDED ||
+            val - P2.b[i] > tol)
+            return 0;
+    }
+    for (j = 0; j < m1; j++) {
+        if (j == i1)
+            continue;
+        for (k = 0; k < (int) i2.size() && i2[k] != j; k++)
+            ;
+        if (k < (int) i2.size())
+            continue;
+        int status = poly_maximize(lp, P2, P1.row(j), &x[0], &val);
+        if (lpsolved)
+            (*lpsolved)++;
+        if (status == LPDENSE_INFEASIBLE || status == LPDENSE_UNBOUNDED ||
+            val - P1.b[j] > tol)
+            return 0;
+    }
+    poly_reduce(lp, P3, tol / 100, x, 1e-8, NULL, lpsolved);
+    return 1;
+}
+
+/* Chebychev ball of P, intersected with thmin<=x<=thmax if thmin,thmax
+   are not NULL. x is the warm start on input and the center on output,
+   r the radius (r<0: empty, r=Inf: unbounded). */
+inline int poly_chebyshev(DenseLP &lp, const Polytope &P, const double *thmin,
+                          const double *thmax, double *x, double *r)
+{
+    int i, j, n = P.n, m = P.rows(), mb = thmin ? 2 * n : 0, status;
+    double ri, rmin = std::numeric_limits<double>::infinity();
+    std::vector<double> c(n + 1, 0.0), y(n + 1);
+
+    lp.resize(n + 1, m + mb, 0);
+    for (i = 0; i < m + mb; i++) {
+        double *a = lp.row(i), s = 0;
+        if (i < m) {
+            for (j = 0; j < n; j++) {
+                a[j] = P.row(i)[j];
+                s += a[j] * a[j];
+            }
+            a[n] = std::sqrt(s);
+            lp.b[i] = P.b[i];
+        }
+        else {
+            int l = (i - m) / 2;
+            bool up = ((i - m) % 2 == 0);
+            for (j = 0; j < n; j++)
+                a[j] = 0.0;
+            a[l] = up ? 1.0 : -1.0;
+            a[n] = 1.0;
+            lp.b[i] = up ? thmax[l] : -thmin[l];
+        }
+        ri = (lp.b[i] - DenseLP::dot(a, x, n)) / (a[n] > 0 ? a[n] : 1.0);
+        if (ri < rmin)
+            rmin = ri;
+    }
+    for (j = 0; j < n; j++)
+        y[j] = x[j];
+    y[n] = (m + mb > 0) ? rmin : 0;
+    c[n] = -1.0;
+    status = lp.solve(&c[0], &y[0]);
+    if (status == LPDENSE_UNBOUNDED) {
+        *r = std::numeric_limits<double>::infinity();
+        return status;
+    }
+    if (status == LPDENSE_INFEASIBLE) {
+        *r = -std::numeric_limits<double>::infinity();
+        return status;
+    }
+    for (j = 0; j < n; j++)
+        x[j] = y[j];
+    *r = y[n];
+    return status;
+}
+
+/* Does row i of P2 hold on P1?  (one LP of POLYINCL.M) */
+inline int poly_row_valid(DenseLP &lp, const Polytope &P1, const Polytope &P2, int i,
+                          double *x, double tol = 1e-9)
+{
+    double val;
+    int status = poly_maximize(lp, P1, P2.row(i), x, &val);
+
+    if (status == LPDENSE_INFEASIBLE)
+        return 1;   /* P1 is empty */
+    return status != LPDENSE_UNBOUNDED && val - P2.b[i] <= tol;
+}
+
+/* P1 included in P2 (see POLYINCL.M) */
+inline int poly_incl(DenseLP &lp, const Polytope &P1, const Polytope &P2,
+                     int *lpsolved = NULL, double tol = 1e-9)
+{
+    std::vector<double> x(P1.n, 0.0);
+
+    for (int i = 0; i < P2.rows(); i++) {
+        if (lpsolved)
+            (*lpsolved)++;
+        if (!poly_row_valid(lp, P1, P2, i, &x[0], tol))
+            return 0;
+    }
+    return 1;
+}
+
+/* Chebychev radius of P intersected with {x: A2(j,:)*x >= B2(j)}, used by
+   POLYMINUS.M to order the rows of P2 */
+inline double poly_minus_radius(DenseLP &lp, const Polytope &P1, const Polytope &P2, int j)
+{
+    Polytope Pt(P1);
+    std::vector<double> a(P2.row(j), P2.row(j) + P2.n), x(P1.n, 0.0);
+    double r;
+
+    for (int k = 0; k < P2.n; k++)
+        a[k] = -a[k];
+    Pt.add_row(&a[0], -P2.b[j]);
+    poly_chebyshev(lp, Pt, NULL, NULL, &x[0], &r);
+    return r;
+}
+
+/* P1 \ P2 as a list of polytopes (see POLYMINUS.M). rcheby(j) is the
+   radius computed by poly_minus_radius() for row j of P2. Rows of P2 are
+   processed by decreasing radius; the pieces are not reduced. */
+inline void poly_minus(DenseLP &lp, const Polytope &P1, const Polytope &P2,
+                       const std::vector<double> &rcheby, std::vector<Polytope> &pieces,
+                       int *lpsolved = NULL)
+{
+    int k, j, n = P1.n, M = P2.rows();
+    std::vector<int> order(M);
+    std::vector<double> a(n), c(n, 0.0), x(n, 0.0);
+    Polytope P(P1);
+
+    for (j = 0; j < M; j++)
+        order[j] = j;
+    std::stable_sort(order.begin(), order.end(), [&](int p, int q) {
+        return rcheby[p] > rcheby[q];
+    });
+    pieces.clear();
+    for (k = 0; k < M; k++) {
+        j = order[k];
+        if (rcheby[j] <= 0)
+            continue;
+        Polytope Pt(P);
+        for (int l = 0; l < n; l++)
+            a[l] = -P2.row(j)[l];
+        Pt.add_row(&a[0], -P2.b[j]);
+        if (k > 0) {
+            /* still the intersection may be empty */
+            poly_load(lp, Pt);
+            if (lpsolved)
+                (*lpsolved)++;
+            if (lp.solve(&c[0], &x[0]) == LPDENSE_INFEASIBLE)
+                continue;
+        }
+        pieces.push_back(Pt);
+        P.add_row(P2.row(j), P2.b[j]);
+    }
+}
+
+/* Facet i of P as a polytope F in the n-1 coordinates y of the hyperplane
+   A(i,:)*x=b(i), x = p+U*y, where p is the projection of x0 and U an
+   orthonormal basis (from a Householder reflection). Returns the distance
+   of x0 from the hyperplane. */
+inline double poly_facet_slice(const Polytope &P, int i, const double *x0, Polytope &F)
+{
+    int j, k, l, n = P.n, kmax = 0;
+    const double *a = P.row(i);
+    double na = std::sqrt(DenseLP::dot(a, a, n)), h, uu = 0;
+    std::vector<double> v(n), u(n), U((size_t) n * (n - 1)), p(n), w(n - 1);
+
+    for (j = 0; j < n; j++) {
+        v[j] = a[j] / na;
+        if (std::fabs(v[j]) > std::fabs(v[kmax]))
+            kmax = j;
+    }
+    h = (P.b[i] - DenseLP::dot(a, x0, n)) / na;
+    for (j = 0; j < n; j++) {
+        p[j] = x0[j] + h * v[j];
+        u[j] = v[j];
+    }
+    u[kmax] += (v[kmax] >= 0) ? 1.0 : -1.0;
+    uu = DenseLP::dot(&u[0], &u[0], n);
+    /* columns of I-2*u*u'/(u'*u) except kmax */
+    for (l = 0, k = 0; k < n; k++) {
+        if (k == kmax)
+            continue;
+        for (j = 0; j < n; j++)
+            U[(size_t) j * (n - 1) + l] = (j == k ? 1.0 : 0.0) - 2.0 * u[j] * u[k] / uu;
+        l++;
+    }
+    F = Polytope(n - 1);
+    for (k = 0; k < P.rows(); k++) {
+        if (k == i)
+            continue;
+        const double *ak = P.row(k);
+        for (l = 0; l < n - 1; l++) {
+            w[l] = 0;
+            for (j = 0; j < n; j++)
+                w[l] += ak[j] * U[(size_t) j * (n - 1) + l];
+        }
+        F.add_row(&w[0], P.b[k] - DenseLP::dot(ak, &p[0], n));
+    }
+    return h;
+}
+
+/* Exact volume of P by recursive decomposition into pyramids over the
+   facets (Lasserre): vol(P) = 1/n * sum_i dist(x0,facet i)*vol(facet i).
+   The cost grows quickly with the dimension. */
+inline double poly_volume_exact(DenseLP &lp, Polytope P)
+{
+    int i, n = P.n;
+    double r, v = 0;
+    std::vector<double> x0;
+
+    if (n == 1) {
+        double lo = -std::numeric_limits<double>::infinity(), hi = -lo;
+        for (i = 0; i < P.rows(); i++) {
+            double a = P.row(i)[0];
+            if (std::fabs(a) <= 1e-12) {
+                if (P.b[i] < -1e-12)
+                    return 0;
+            }
+            else if (a > 0)
+                hi = std::min(hi, P.b[i] / a);
+            else
+                lo = std::max(lo, P.b[i] / a);
+        }
+        return hi > lo ? hi - lo : 0;
+    }
+    if (poly_reduce(lp, P, 1e-10, x0))
+        return 0;
+    poly_chebyshev(lp, P, NULL, NULL, &x0[0], &r);
+    if (std::isinf(r) && r > 0)
+        return r;
+    if (!(r > 1e-10))
+        return 0;
+    for (i = 0; i < P.rows(); i++) {
+        Polytope F;
+        double h = poly_facet_slice(P, i, &x0[0], F);
+        v += h * poly_volume_exact(lp, F);
+    }
+    return v / n;
+}
+
+/* One step of hit-and-run in {x: A*x<=b, norm(x-xc)<=R} from x */
+template <class RNG>
+inline void poly_hit_and_run(const Polytope &P, const double *xc, double R,
+                             double *x, double *d, RNG &rng)
+{
+    int i, j, n = P.n;
+    double tlo = -std::numeric_limits<double>::infinity(), thi = -tlo, s = 0, ad, slack;
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+
+    for (j = 0; j < n; j++) {
+        d[j] = gauss(rng);
+        s += d[j] * d[j];
+    }
+    s = std::sqrt(s);
+    for (j = 0; j < n; j++)
+        d[j] /= s;
+    for (i = 0; i < P.rows(); i++) {
+        ad = DenseLP::dot(P.row(i), d, n);
+        slack = P.b[i] - DenseLP::dot(P.row(i), x, n);
+        if (slack < 0)
+            slack = 0;
+        if (ad > 1e-14)
+            thi = std::min(thi, slack / ad);
+        else if (ad < -1e-14)
+            tlo = std::max(tlo, slack / ad);
+    }
+    /* |x-xc+t*d|^2 <= R^2 */
+    double bq = 0, cq = -R * R;
+    for (j = 0; j < n; j++) {
+        bq += d[j] * (x[j] - xc[j]);
+        cq += (x[j] - xc[j]) * (x[j] - xc[j]);
+    }
+    double disc = bq * bq - cq;
+    if (disc < 0)
+        disc = 0;
+    disc = std::sqrt(disc);
+    tlo = std::max(tlo, -bq - disc);
+    thi = std::min(thi, -bq + disc);
+    if (!(thi > tlo))
+        return;
+    s = tlo + (thi - tlo) * unif(rng);
+    for (j = 0; j < n; j++)
+        x[j] += s * d[j];
+}
+
+#endif
@@ -5,12 +5,21 @@ function [yesno,lpsolved]=polyincl(A1,B1,A2,B2,LPsolver)
 %                    yesno = 1  if {A1 x <= B1} \subseteq {A2 x <= B2}
 %                    yesno = 0  otherwise
 %
+% If the MEX function POLYMEX is compiled, the native implementation is used
+% (LPsolver is then ignored) and the LPs run on multiple threads, see
+% POLYMEX.CPP.
+%
 %(C) 2003 by A. Bemporad
 
 if nargin<5,
     LPsolver=[];
 end
 
+if exist('polymex')==3,
+    [yesno,lpsolved]=polymex('incl',A1,B1,A2,B2);
+    return
+end
+
 m2=size(A2,1);
 m1=size(A1,1);
 n=size(A2,2);
@@ -0,0 +1,474 @@
+/* Polytope operations - MEX interface
+
+   [At,Bt,isemptypoly,keptrows,lpsolved,x0]=polymex('reduce',A,B,removetol,checkempty,x0,zerotol)
+   [A3,B3,ok,lpsolved]=polymex('union',A1,B1,A2,B2,check,tol,checkmin)
+   [yesno,lpsolved]=polymex('incl',A1,B1,A2,B2)
+   [Acell,Bcell,disjoint,lpsolved]=polymex('minus',A1,B1,A2,B2,check,reduce,Aint,Bint)
+   v=polymex('volume',A,B,method,nsamples)
+   polymex('nthreads',n)
+   polymex('clear')
+
+   Native implementation of POLYREDUCE, POLYUNION, POLYINCL, POLYMINUS and
+   POLYVOLUME (see the help of these functions for the meaning of the
+   arguments), based on POLYDENSE.H. All LPs are solved by the dense
+   active-set solver in LPDENSE.H, warm-started from the solution of the
+   previous LP on the same polytope.
+
+   'reduce' keeps a cache of the minimal representations it computed: the
+   reduction of a polytope that was already reduced (e.g., the same region
+   subtracted from or joined with many others) costs no LP. 'clear' empties
+   the cache.
+
+   Independent LPs run on worker threads: the rows of P2 in 'incl', the
+   ordering LPs and the reduction of the pieces in 'minus', the facets in
+   'volume'. 'nthreads' sets the number of threads (default: all cores).
+
+   'volume' is exact for dimension <= 4 (method=1 forces it), by recursive
+   decomposition into pyramids over the facets. In higher dimension
+   (method=2 forces it) the volume is estimated by a multiphase Monte Carlo
+   method: P is intersected with balls of growing radius around its
+   Chebychev center, and the ratio of consecutive volumes is estimated by
+   nsamples (default: 4000) hit-and-run samples per phase.
+
+   Compile with MEXCOMPILE.M (or mex -O polymex.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "lpdense.h"
+#include "polydense.h"
+#include "mexthreads.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <atomic>
+#include <random>
+#include <unordered_map>
+#include <stdint.h>
+
+#define POLYMEX_CACHE_SIZE 512
+#define POLYMEX_EXACT_DIM 4
+#define POLYMEX_NSAMPLES 4000
+
+static int polymex_threads = 0;
+
+/* Cache of the reductions computed by 'reduce' */
+struct ReduceEntry {
+    Polytope P;                /* input */
+    double removetol, zerotol;
+    int checkempty;
+    Polytope Pt;               /* output */
+    int isempty;
+    std::vector<int> kept;
+    std::vector<double> x0;
+};
+
+static std::unordered_map<uint64_t, ReduceEntry> reduce_cache;
+
+static void polymex_cleanup(void)
+{
+    reduce_cache.clear();
+}
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t len)
+{
+    const unsigned char *p = (const unsigned char *) data;
+    for (size_t k = 0; k < len; k++) {
+        h ^= p[k];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static Polytope get_polytope(const mxArray *A, const mxArray *B)
+{
+    int m = (int) mxGetM(A), n = (int) mxGetN(A);
+    Polytope P(n);
+
+    if ((int) mxGetNumberOfElements(B) != m)
+        mexErrMsgTxt("A and B must have the same number of rows.");
+    if (m > 0)
+        P.add_rows_colmajor(mxGetPr(A), mxGetPr(B), m, 0, m - 1);
+    return P;
+}
+
+static void put_polytope(const Polytope &P, mxArray **A, mxArray **B)
+{
+    int m = P.rows(), n = P.n;
+
+    *A = mxCreateDoubleMatrix(m, n, mxREAL);
+    double *a = mxGetPr(*A);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            a[i + (size_t) j * m] = P.row(i)[j];
+    if (B) {
+        *B = mxCreateDoubleMatrix(m, 1, mxREAL);
+        if (m > 0)
+            memcpy(mxGetPr(*B), P.b.data(), m * sizeof(double));
+    }
+}
+
+static double opt_scalar(int nrhs, const mxArray *prhs[], int k, double def)
+{
+    if (nrhs > k && !mxIsEmpty(prhs[k]))
+        return mxGetScalar(prhs[k]);
+    return def;
+}
+
+/* POLYREDUCE with cache; runs in the MATLAB thread */
+static const ReduceEntry &cached_reduce(DenseLP &lp, const Polytope &P, double removetol,
+                                        int checkempty, const std::vector<double> &x0,
+                                        double zerotol, int *lpsolved)
+{
+    uint64_t h = 1469598103934665603ULL;
+    h = hash_bytes(h, &P.n, sizeof(int));
+    h = hash_bytes(h, P.A.data(), P.A.size() * sizeof(double));
+    h = hash_bytes(h, P.b.data(), P.b.size() * sizeof(double));
+    h = hash_bytes(h, &removetol, sizeof(double));
+    h = hash_bytes(h, &zerotol, sizeof(double));
+    h = hash_bytes(h, &checkempty, sizeof(int));
+
+    std::unordered_map<uint64_t, ReduceEntry>::iterator it = reduce_cache.find(h);
+    if (it != reduce_cache.end()) {
+        const ReduceEntry &e = it->second;
+        if (e.P.n == P.n && e.P.A == P.A && e.P.b == P.b && e.removetol == removetol &&
+            e.zerotol == zerotol && e.checkempty == checkempty)
+            return e;
+    }
+    if (reduce_cache.size() >= POLYMEX_CACHE_SIZE)
+        reduce_cache.clear();
+
+    ReduceEntry &e = reduce_cache[h];
+    e.P = P;
+    e.removetol = removetol;
+    e.zerotol = zerotol;
+    e.checkempty = checkempty;
+    e.Pt = P;
+    e.x0 = x0;
+    if (P.rows() < 2) {
+        /* only one (or none) facet inequality */
+        e.isempty = 0;
+        e.kept.resize(P.rows());
+        for (int i = 0; i < P.rows(); i++)
+            e.kept[i] = i;
+        e.x0.assign(P.n, 0.0);
+    }
+    else
+        e.isempty = poly_reduce(lp, e.Pt, removetol, e.x0, zerotol, &e.kept, lpsolved, checkempty);
+    if (e.isempty) {
+        e.Pt = P;
+        e.kept.resize(P.rows());
+        for (int i = 0; i < P.rows(); i++)
+            e.kept[i] = i;
+        e.x0.assign(P.n, mxGetNaN());
+    }
+    return e;
+}
+
+static void do_reduce(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    DenseLP lp;
+    int lpsolved = 0;
+
+    if (nrhs < 3)
+        mexErrMsgTxt("polymex('reduce',A,B,...) requires A and B.");
+    Polytope P = get_polytope(prhs[1], prhs[2]);
+    double removetol = opt_scalar(nrhs, prhs, 3, 1e-10);
+    int checkempty = (int) opt_scalar(nrhs, prhs, 4, 1);
+    double zerotol = opt_scalar(nrhs, prhs, 6, 1e-8);
+    std::vector<double> x0(P.n, 0.0);
+    if (nrhs > 5 && !mxIsEmpty(prhs[5])) {
+        if ((int) mxGetNumberOfElements(prhs[5]) != P.n)
+            mexErrMsgTxt("x0 must have as many entries as the columns of A.");
+        memcpy(&x0[0], mxGetPr(prhs[5]), P.n * sizeof(double));
+    }
+
+    const ReduceEntry &e = cached_reduce(lp, P, removetol, checkempty, x0, zerotol, &lpsolved);
+    put_polytope(e.Pt, &plhs[0], nlhs > 1 ? &plhs[1] : NULL);
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(e.isempty);
+    if (nlhs > 3) {
+        plhs[3] = mxCreateDoubleMatrix(e.kept.size(), 1, mxREAL);
+        for (size_t k = 0; k < e.kept.size(); k++)
+            mxGetPr(plhs[3])[k] = e.kept[k] + 1;
+    }
+    if (nlhs > 4)
+        plhs[4] = mxCreateDoubleScalar(lpsolved);
+    if (nlhs > 5) {
+        plhs[5] = mxCreateDoubleMatrix(P.n, 1, mxREAL);
+        for (int j = 0; j < P.n; j++)
+            mxGetPr(plhs[5])[j] = e.x0[j];
+    }
+}
+
+static void do_union(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    DenseLP lp;
+    int ok, lpsolved = 0;
+    std::vector<double> x0;
+
+    if (nrhs < 5)
+        mexErrMsgTxt("polymex('union',A1,B1,A2,B2,...) requires two polytopes.");
+    Polytope P1 = get_polytope(prhs[1], prhs[2]), P2 = get_polytope(prhs[3], prhs[4]), P3;
+    if (P1.n != P2.n)
+        mexErrMsgTxt("A1 and A2 must have the same number of columns.");
+    int check = (int) opt_scalar(nrhs, prhs, 5, 1);
+    double tol = opt_scalar(nrhs, prhs, 6, 1e-3);
+    int checkmin = (int) opt_scalar(nrhs, prhs, 7, 0);
+
+    if (!checkmin) {
+        x0.assign(P1.n, 0.0);
+        P1 = cached_reduce(lp, P1, 1e-10, 1, x0, 1e-8, &lpsolved).Pt;
+        P2 = cached_reduce(lp, P2, 1e-10, 1, x0, 1e-8, &lpsolved).Pt;
+    }
+    ok = poly_union(lp, P1, P2, tol, P3, check, &lpsolved);
+    if (!ok)
+        P3 = Polytope(P1.n);
+    put_polytope(P3, &plhs[0], nlhs > 1 ? &plhs[1] : NULL);
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(ok);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar(lpsolved);
+}
+
+static void do_incl(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs < 5)
+        mexErrMsgTxt("polymex('incl',A1,B1,A2,B2) requires two polytopes.");
+    Polytope P1 = get_polytope(prhs[1], prhs[2]), P2 = get_polytope(prhs[3], prhs[4]);
+    if (P1.n != P2.n)
+        mexErrMsgTxt("A1 and A2 must have the same number of columns.");
+
+    int nthreads = mex_num_threads(polymex_threads);
+    std::vector<DenseLP> lps(nthreads);
+    std::vector<std::vector<double> > x(nthreads, std::vector<double>(P1.n, 0.0));
+    std::atomic<int> yesno(1), lpsolved(0);
+
+    mex_parallel_for(P2.rows(), nthreads, 8, [&](int i, int t) {
+        if (!yesno)
+            return;
+        lpsolved++;
+        if (!poly_row_valid(lps[t], P1, P2, i, &x[t][0]))
+            yesno = 0;
+    });
+    plhs[0] = mxCreateDoubleScalar(yesno);
+    if (nlhs > 1)
+        plhs[1] = mxCreateDoubleScalar(lpsolved);
+}
+
+static void do_minus(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    DenseLP lp;
+    int lpsolved = 0, disjoint = 0, isemptysec;
+    std::vector<double> x0;
+    std::vector<Polytope> pieces;
+
+    if (nrhs < 5)
+        mexErrMsgTxt("polymex('minus',A1,B1,A2,B2,...) requires two polytopes.");
+    Polytope P1 = get_polytope(prhs[1], prhs[2]), P2 = get_polytope(prhs[3], prhs[4]);
+    if (P1.n != P2.n)
+        mexErrMsgTxt("A1 and A2 must have the same number of columns.");
+    int check = (int) opt_scalar(nrhs, prhs, 5, 0);
+    int reduce = (int) opt_scalar(nrhs, prhs, 6, 1);
+    x0.assign(P1.n, 0.0);
+
+    /* Intersection of P1 and P2 */
+    if (nrhs > 7)
+        isemptysec = 0;   /* Aint,Bint given: P1, P2 intersect */
+    else {
+        Polytope Q(P1);
+        Q.A.insert(Q.A.end(), P2.A.begin(), P2.A.end());
+        Q.b.insert(Q.b.end(), P2.b.begin(), P2.b.end());
+        isemptysec = cached_reduce(lp, Q, 1e-10, 1, x0, 1e-8, &lpsolved).isempty;
+    }
+    if (check) {
+        P1 = cached_reduce(lp, P1, 1e-10, 1, x0, 1e-8, &lpsolved).Pt;
+        P2 = cached_reduce(lp, P2, 1e-10, 1, x0, 1e-8, &lpsolved).Pt;
+    }
+
+    if (isemptysec) {
+        disjoint = 1;
+        pieces.push_back(P1);
+    }
+    else {
+        int nthreads = mex_num_threads(polymex_threads);
+        std::vector<DenseLP> lps(nthreads);
+        std::vector<double> rcheby(P2.rows());
+        std::atomic<int> lps_par(0);
+
+        /* Order the hyperplanes of P2 by Chebychev radius */
+        mex_parallel_for(P2.rows(), nthreads, 4, [&](int j, int t) {
+            rcheby[j] = poly_minus_radius(lps[t], P1, P2, j);
+            lps_par++;
+        });
+        poly_minus(lp, P1, P2, rcheby, pieces, &lpsolved);
+
+        if (reduce) {
+            mex_parallel_for((int) pieces.size(), nthreads, 1, [&](int k, int t) {
+                std::vector<double> x;
+                int l = 0;
+                poly_reduce(lps[t], pieces[k], 1e-10, x, 1e-8, NULL, &l);
+                lps_par += l;
+            });
+        }
+        lpsolved += lps_par;
+    }
+
+    mxArray *Acell = mxCreateCellMatrix(1, pieces.size());
+    mxArray *Bcell = mxCreateCellMatrix(1, pieces.size());
+    for (size_t k = 0; k < pieces.size(); k++) {
+        mxArray *A, *B;
+        put_polytope(pieces[k], &A, &B);
+        mxSetCell(Acell, k, A);
+        mxSetCell(Bcell, k, B);
+    }
+    plhs[0] = Acell;
+    if (nlhs > 1)
+        plhs[1] = Bcell;
+    else
+        mxDestroyArray(Bcell);
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(disjoint);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar(lpsolved);
+}
+
+/* Multiphase Monte Carlo estimate of the volume of P */
+static double volume_random(DenseLP &lp, const Polytope &P, const std::vector<double> &xc,
+                            double r0, int nsamples, int nthreads)
+{
+    int n = P.n, j, k;
+    double R2 = 0, lo, hi, logv;
+    std::vector<double> x(xc), e(n, 0.0);
+
+    /* Radius of a ball around xc containing P (from the bounding box) */
+    for (j = 0; j < n; j++) {
+        e.assign(n, 0.0);
+        e[j] = 1.0;
+        x = xc;
+        if (poly_maximize(lp, P, &e[0], &x[0], &hi) == LPDENSE_UNBOUNDED)
+            return mxGetInf();
+        e[j] = -1.0;
+        x = xc;
+        if (poly_maximize(lp, P, &e[0], &x[0], &lo) == LPDENSE_UNBOUNDED)
+            return mxGetInf();
+        lo = -lo;
+        R2 += std::max((hi - xc[j]) * (hi - xc[j]), (xc[j] - lo) * (xc[j] - lo));
+    }
+    double R = std::sqrt(R2);
+    int nphases = (R > r0) ? (int) std::ceil(n * std::log(R / r0) / std::log(2.0)) : 0;
+
+    /* volume of the ball of radius r0 */
+    logv = 0.5 * n * std::log(3.14159265358979323846) - std::lgamma(0.5 * n + 1.0) + n * std::log(r0);
+
+    nthreads = std::max(1, std::min(nthreads, nsamples));
+    std::vector<std::vector<double> > pts(nthreads, xc), dirs(nthreads, std::vector<double>(n));
+    std::vector<std::mt19937_64> rng;
+    for (int t = 0; t < nthreads; t++)
+        rng.push_back(std::mt19937_64(5489u + 7919u * t));
+
+    for (k = 1; k <= nphases; k++) {
+        double rk = (k == nphases) ? R : r0 * std::pow(2.0, (double) k / n);
+        double rprev = r0 * std::pow(2.0, (double) (k - 1) / n);
+        std::vector<int> inside(nthreads, 0), count(nthreads, 0);
+
+        mex_parallel_for(nthreads, nthreads, 1, [&](int t, int) {
+            int ns = nsamples / nthreads + (t < nsamples % nthreads ? 1 : 0);
+            double *y = &pts[t][0];
+            for (int s = 0; s < ns; s++) {
+                for (int w = 0; w < n; w++)   /* thinning */
+                    poly_hit_and_run(P, &xc[0], rk, y, &dirs[t][0], rng[t]);
+                double d2 = 0;
+                for (int l = 0; l < n; l++)
+                    d2 += (y[l] - xc[l]) * (y[l] - xc[l]);
+                count[t]++;
+                if (d2 <= rprev * rprev)
+                    inside[t]++;
+            }
+        });
+        int nin = 0, ntot = 0;
+        for (int t = 0; t < nthreads; t++) {
+            nin += inside[t];
+            ntot += count[t];
+        }
+        logv += std::log((double) ntot / std::max(nin, 1));
+    }
+    return std::exp(logv);
+}
+
+static void do_volume(int, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    DenseLP lp;
+    double v = 0, r;
+    std::vector<double> x0;
+
+    if (nrhs < 3)
+        mexErrMsgTxt("polymex('volume',A,B,...) requires A and B.");
+    Polytope P = get_polytope(prhs[1], prhs[2]);
+    int method = (int) opt_scalar(nrhs, prhs, 3, 0);
+    int nsamples = (int) opt_scalar(nrhs, prhs, 4, POLYMEX_NSAMPLES);
+    int nthreads = mex_num_threads(polymex_threads);
+    int n = P.n;
+
+    if (method == 0)
+        method = (n <= POLYMEX_EXACT_DIM) ? 1 : 2;
+
+    if (n == 1)
+        v = poly_volume_exact(lp, P);
+    else if (poly_reduce(lp, P, 1e-10, x0) == 0) {
+        poly_chebyshev(lp, P, NULL, NULL, &x0[0], &r);
+        if (std::isinf(r) && r > 0)
+            v = r;
+        else if (!(r > 1e-10))
+            v = 0;
+        else if (method == 1) {
+            /* pyramids over the facets, one facet per task */
+            std::vector<DenseLP> lps(nthreads);
+            std::vector<double> vi(P.rows());
+            mex_parallel_for(P.rows(), nthreads, 1, [&](int i, int t) {
+                Polytope F;
+                double h = poly_facet_slice(P, i, &x0[0], F);
+                vi[i] = h * poly_volume_exact(lps[t], F);
+            });
+            for (size_t i = 0; i < vi.size(); i++)
+                v += vi[i];
+            v /= n;
+        }
+        else
+            v = volume_random(lp, P, x0, r, nsamples, nthreads);
+    }
+    plhs[0] = mxCreateDoubleScalar(v);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    char action[32];
+
+    mexAtExit(polymex_cleanup);
+
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+        mexErrMsgTxt("First argument must be an action string.");
+    mxGetString(prhs[0], action, sizeof(action));
+
+    if (!strcmp(action, "reduce"))
+        do_reduce(nlhs, plhs, nrhs, prhs);
+    else if (!strcmp(action, "union"))
+        do_union(nlhs, plhs, nrhs, prhs);
+    else if (!strcmp(action, "incl"))
+        do_incl(nlhs, plhs, nrhs, prhs);
+    else if (!strcmp(action, "minus"))
+        do_minus(nlhs, plhs, nrhs, prhs);
+    else if (!strcmp(action, "volume"))
+        do_volume(nlhs, plhs, nrhs, prhs);
+    else if (!strcmp(action, "nthreads")) {
+        if (nrhs > 1)
+            polymex_threads = (int) mxGetScalar(prhs[1]);
+        if (nlhs > 0)
+            plhs[0] = mxCreateDoubleScalar(mex_num_threads(polymex_threads));
+    }
+    else if (!strcmp(action, "clear"))
+        reduce_cache.clear();
+    else
+        mexErrMsgTxt("Unknown action.");
+}
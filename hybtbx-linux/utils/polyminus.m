@@ -23,6 +23,10 @@ function [Acell,Bcell,disjoint,LPs]=polyminus...
 % intersection is non recomputed.
 %
 % P2 includes P1, then Acell,Bcell will be empty.
+%
+% If the MEX function POLYMEX is compiled, the native implementation is used
+% (LPsolver is then ignored) and independent LPs run on multiple threads,
+% see POLYMEX.CPP.
 
 % (C) 2003 by A. Bemporad
 
@@ -38,6 +42,15 @@ if nargin<7|isempty(reduce),
     reduce=1;
 end
 
+if exist('polymex')==3,
+    if nargin<8,
+        [Acell,Bcell,disjoint,LPs]=polymex('minus',A1,B1,A2,B2,check,reduce);
+    else
+        [Acell,Bcell,disjoint,LPs]=polymex('minus',A1,B1,A2,B2,check,reduce,Aint,Bint);
+    end
+    return
+end
+
 LPs=0;
 
 if nargin<8,
@@ -11,6 +11,10 @@ function [At,Bt,isemptypoly,keptrows,lpsolved,x0]=polyreduce(A,B,solver,removeto
 % x0           = a point in (A,B) (x0=NaN if (A,B) is empty)
 % zerotol      = if norm(A(i,:),'inf')<zerotol, it is considered a row of zeros
 %
+% If the MEX function POLYMEX is compiled, the native implementation is used
+% (the LP solver argument is then ignored) and minimal representations are
+% cached, see POLYMEX.CPP.
+%
 %(C) 2003 by A. Bemporad, September 29, 2003
 %(C) 2001 by A. Bemporad, 12/7/2001
 
@@ -58,6 +62,11 @@ if nargin<7|isempty(zerotol),
    zerotol=1e-8;
 end
 
+if exist('polymex')==3,
+    [At,Bt,isemptypoly,keptrows,lpsolved,x0]=polymex('reduce',A,B,removetol,checkempty,x0,zerotol);
+    return
+end
+
 
 % Check for rows of the type 0*x<=b
 i0=find(sum(abs(At)')'<=zerotol); % 0*x
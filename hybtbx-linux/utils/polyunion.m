@@ -24,6 +24,9 @@ function [A3,B3,how]=polyunion(A1,B1,A2,B2,check,tol,checkmin,lpsolver)
 %
 %                  [A3,B3,how]=polyunion(A1,B1,A2,B2,check,tol,checkmin,lpsolver)
 %
+% If the MEX function POLYMEX is compiled, the native implementation is used
+% (lpsolver is then ignored), see POLYMEX.CPP.
+%
 % (C) 2003 by A. Bemporad
 %    (code based on an idea by A. Bemporad and F.D. Torrisi)
 
@@ -47,6 +50,18 @@ if nargin<8 | isempty(lpsolver),
    lpsolver=3; % Default: GLPK
 end
 
+if exist('polymex')==3,
+    [A3,B3,ok]=polymex('union',A1,B1,A2,B2,check,tol,checkmin);
+    if ok,
+        how='ok';
+    else
+        how='fault';
+        A3=[];
+        B3=[];
+    end
+    return
+end
+
 if ~checkmin,
    [A1,B1]=polyreduce(A1,B1,lpsolver);
    [A2,B2]=polyreduce(A2,B2,lpsolver);
@@ -1,4 +1,4 @@
-function [v,V]=polyvolume(A,b)
+function [v,V]=polyvolume(A,b,method,nsamples)
 % POLYVOLUME Compute the volume of a polyhedron in R^n.
 %
 %           v=POLYVOLUME(A,B) returns the volume of polytope {x: A*x <= b}
@@ -9,8 +9,28 @@ function [v,V]=polyvolume(A,b)
 % vertices of the polyhedron, (2) compute Delaunay triangulation, (3)
 % compute and sum the volumes of each simplex.
 %
+% If the MEX function POLYMEX is compiled and the vertices are not
+% requested, the volume is computed natively: exactly for n<=4, by
+% recursive decomposition into pyramids over the facets, and by a
+% randomized (multiphase hit-and-run) estimate for n>4.
+%
+%           v=POLYVOLUME(A,B,method,nsamples) forces the exact (method=1) or
+%           the randomized (method=2) computation, and sets the number of
+%           samples per phase of the randomized method (default: 4000).
+%
 % (C) 2011 by A. Bemporad
 
+if nargin<3,
+    method=[];
+end
+if nargin<4,
+    nsamples=[];
+end
+if nargout<2 && exist('polymex')==3,
+    v=polymex('volume',A,b,method,nsamples);
+    return
+end
+
 clear H
 H.A=A;
 H.B=b;
@@ -0,0 +1,574 @@
+/* Parallel multiparametric dynamic programming for PWA systems -
+   implementation
+
+   See PWADP.H for the API.
+
+   The mpLP of transition T and piece (R,V) of J_{k+1} has the variables
+   [w; e_1,...,e_nterms; eJ] and the cost sum(e)+eJ:
+
+       A*w <= b + S*th                          (transition)
+       +-(Cw*w + Cth*th + c0) <= e_term         (stage cost)
+       -e_q <= 0
+       H_R*(Tth*th + Tw*w + t0) <= K_R          (th+ in R)
+       a_l'*(Tth*th + Tw*w + t0) + c_l <= eJ    (eJ >= V(th+))
+
+   Its feasible set is convex, so it is the intersection of the rows of
+   the critical regions that hold on all of them (the hull of the piece),
+   and its value function is the maximum of the affine values of the
+   critical regions.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "pwadp.h"
+#include "mplppar.h"
+#include "lpdense.h"
+#include "polydense.h"
+#include "mexthreads.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+struct DPTrans {
+    int s, snext, m, mc, nterms;
+    std::vector<double> A, b, S;       /* m-by-nw, m, m-by-np, row-major */
+    std::vector<double> Cw, Cth, c0;   /* mc-by-nw, mc-by-np, mc */
+    std::vector<int> term;
+    std::vector<double> Tth, Tw, t0;   /* np-by-np, np-by-nw, np */
+};
+
+struct DPRegion {
+    std::vector<double> H, K, F, g, V;
+    double v, rcheb;
+};
+
+struct DPPiece {
+    int s, trans;
+    Polytope hull;
+    std::vector<double> V, v;          /* affine values, naff-by-np */
+    std::vector<double> xc;            /* Chebychev center of the hull */
+    double rcheb;
+    std::vector<DPRegion> regions;     /* only for J_0 */
+};
+
+struct pwadp_struct {
+    int np, nw;
+    std::vector<double> thmin0, thmax0, thmin, thmax;
+    std::vector<DPTrans> first, middle;
+    std::vector<DPPiece> terminal, pieces;
+};
+
+void pwadp_default_settings(pwadp_settings *set)
+{
+    set->nthreads = 0;
+    set->flattol = 1e-8;
+    set->tol = 1e-7;
+    set->removetol = 1e-9;
+}
+
+pwadp_t *pwadp_new(int np, int nw, const double *thmin0, const double *thmax0,
+                   const double *thmin, const double *thmax)
+{
+    pwadp_t *dp = new pwadp_struct;
+
+    dp->np = np;
+    dp->nw = nw;
+    dp->thmin0.assign(thmin0, thmin0 + np);
+    dp->thmax0.assign(thmax0, thmax0 + np);
+    dp->thmin.assign(thmin, thmin + np);
+    dp->thmax.assign(thmax, thmax + np);
+    return dp;
+}
+
+void pwadp_free(pwadp_t *dp)
+{
+    delete dp;
+}
+
+/* Row-major copy of the column-major m-by-n matrix M */
+static void rowmajor(std::vector<double> &R, const double *M, int m, int n)
+{
+    R.resize((size_t) m * n);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            R[(size_t) i * n + j] = M[i + (size_t) j * m];
+}
+
+void pwadp_add_terminal(pwadp_t *dp, int s, int nrows, const double *H, const double *K,
+                        int nval, const double *V, const double *v)
+{
+    DPPiece P;
+
+    P.s = s;
+    P.trans = -1;
+    P.hull = Polytope(dp->np);
+    rowmajor(P.hull.A, H, nrows, dp->np);
+    P.hull.b.assign(K, K + nrows);
+    rowmajor(P.V, V, nval, dp->np);
+    P.v.assign(v, v + nval);
+    P.rcheb = 0;
+    dp->terminal.push_back(P);
+}
+
+void pwadp_add_transition(pwadp_t *dp, int first, const pwadp_transition *T)
+{
+    DPTrans D;
+    int np = dp->np, nw = dp->nw;
+
+    D.s = T->s;
+    D.snext = T->snext;
+    D.m = T->m;
+    D.mc = T->mc;
+    rowmajor(D.A, T->A, T->m, nw);
+    D.b.assign(T->b, T->b + T->m);
+    rowmajor(D.S, T->S, T->m, np);
+    rowmajor(D.Cw, T->Cw, T->mc, nw);
+    rowmajor(D.Cth, T->Cth, T->mc, np);
+    D.c0.assign(T->c0, T->c0 + T->mc);
+    D.term.assign(T->term, T->term + T->mc);
+    D.nterms = 0;
+    for (int i = 0; i < T->mc; i++)
+        D.nterms = std::max(D.nterms, T->term[i] + 1);
+    rowmajor(D.Tth, T->Tth, np, np);
+    rowmajor(D.Tw, T->Tw, np, nw);
+    D.t0.assign(T->t0, T->t0 + np);
+    (first ? dp->first : dp->middle).push_back(D);
+}
+
+int pwadp_num_pieces(const pwadp_t *dp)
+{
+    return (int) dp->pieces.size();
+}
+
+void pwadp_get_piece(const pwadp_t *dp, int i, pwadp_piece *p)
+{
+    const DPPiece &P = dp->pieces[i];
+    p->s = P.s;
+    p->trans = P.trans;
+    p->nregions = (int) P.regions.size();
+    p->nrows = P.hull.rows();
+    p->H = P.hull.A.empty() ? NULL : &P.hull.A[0];
+    p->K = P.hull.b.empty() ? NULL : &P.hull.b[0];
+    p->rcheb = P.rcheb;
+}
+
+void pwadp_get_region(const pwadp_t *dp, int i, int r, pwadp_region *reg)
+{
+    const DPRegion &R = dp->pieces[i].regions[r];
+    reg->nrows = (int) R.K.size();
+    reg->H = R.H.empty() ? NULL : &R.H[0];
+    reg->K = R.K.empty() ? NULL : &R.K[0];
+    reg->F = R.F.empty() ? NULL : &R.F[0];
+    reg->g = R.g.empty() ? NULL : &R.g[0];
+    reg->V = R.V.empty() ? NULL : &R.V[0];
+    reg->v = R.v;
+    reg->rcheb = R.rcheb;
+}
+
+/* Largest affine value of P at th */
+static double value(const DPPiece &P, const double *th, int np)
+{
+    double V = -std::numeric_limits<double>::infinity();
+    for (size_t l = 0; l < P.v.size(); l++)
+        V = std::max(V, DenseLP::dot(&P.V[l * np], th, np) + P.v[l]);
+    return V;
+}
+
+static bool same_row(const double *a, double ka, const double *c, double kc, int n, double tol)
+{
+    if (std::fabs(ka - kc) > tol)
+        return false;
+    for (int j = 0; j < n; j++)
+        if (std::fabs(a[j] - c[j]) > tol)
+            return false;
+    return true;
+}
+
+/* Add the box thmin <= th <= thmax to P */
+static void add_box(Polytope &P, const std::vector<double> &thmin, const std::vector<double> &thmax)
+{
+    std::vector<double> e(P.n, 0.0);
+    for (int j = 0; j < P.n; j++) {
+        e[j] = 1.0;
+        P.add_row(&e[0], thmax[j]);
+        e[j] = -1.0;
+        P.add_row(&e[0], -thmin[j]);
+        e[j] = 0.0;
+    }
+}
+
+/* Reduce the hull of P and compute its Chebychev ball. Returns false if
+   the hull is empty or flat. */
+static bool finish_hull(DenseLP &lp, DPPiece &P, const pwadp_settings *set, long &nlp)
+{
+    std::vector<double> x0;
+    int lpsolved = 0;
+
+    if (poly_reduce(lp, P.hull, set->removetol, x0, 1e-8, NULL, &lpsolved)) {
+        nlp += lpsolved;
+        return false;
+    }
+    nlp += lpsolved + 1;
+    P.xc = x0;
+    P.xc.resize(P.hull.n, 0.0);
+    poly_chebyshev(lp, P.hull, NULL, NULL, &P.xc[0], &P.rcheb);
+    return P.rcheb > set->flattol;
+}
+
+/* Does the mpLP A*z <= b + S*th (row-major) have a full-dimensional set
+   of feasible parameters in thmin..thmax? Checked by the LP in [z;th;r]
+
+       max r  s.t.  A*z - S*th + |S|*r <= b,  thmin+r <= th <= thmax-r
+
+   whose solution z is feasible on the whole ball of radius r around th.
+   Used to tell an empty piece from an mpLP that found no region. */
+static bool feasible_ball(const std::vector<double> &A, const std::vector<double> &b,
+                          const std::vector<double> &S, int n, int m, int np,
+                          const std::vector<double> &thmin, const std::vector<double> &thmax,
+                          const pwadp_settings *set, DenseLP &lp, long &nlp)
+{
+    int nv = n + np + 1, i, j;
+    std::vector<double> c(nv, 0.0), y(nv, 0.0);
+
+    lp.resize(nv, m + 2 * np, 0);
+    for (i = 0; i < m; i++) {
+        double *a = lp.row(i), s = 0;
+        for (j = 0; j < n; j++)
+            a[j] = A[(size_t) i * n + j];
+        for (j = 0; j < np; j++) {
+            a[n + j] = -S[(size_t) i * np + j];
+            s += a[n + j] * a[n + j];
+        }
+        a[nv - 1] = std::sqrt(s);
+        lp.b[i] = b[i];
+    }
+    for (j = 0; j < np; j++) {
+        double *a = lp.row(m + 2 * j), *a2 = lp.row(m + 2 * j + 1);
+        for (i = 0; i < nv; i++)
+            a[i] = a2[i] = 0.0;
+        a[n + j] = a[nv - 1] = 1.0;
+        lp.b[m + 2 * j] = thmax[j];
+        a2[n + j] = -1.0;
+        a2[nv - 1] = 1.0;
+        lp.b[m + 2 * j + 1] = -thmin[j];
+        y[n + j] = .5 * (thmin[j] + thmax[j]);
+    }
+    c[nv - 1] = -1.0;
+    nlp++;
+    return lp.solve(&c[0], &y[0]) == LPDENSE_OPTIMAL && y[nv - 1] > set->flattol;
+}
+
+/* mpLP of transition T and piece Q of J_{k+1}: result in P. An mpLP that
+   finds no region although feasible_ball() holds is counted in failed. */
+static bool solve_mplp(const pwadp_t *dp, const DPTrans &T, const DPPiece &Q,
+                       const std::vector<double> &thmin, const std::vector<double> &thmax,
+                       bool keep, const pwadp_settings *set, DenseLP &lp, DPPiece &P,
+                       long &nmplp, long &nlp, mex_counter &unbounded, mex_counter &failed)
+{
+    int np = dp->np, nw = dp->nw, nt = T.nterms, n = nw + nt + 1;
+    int nh = Q.hull.rows(), na = (int) Q.v.size();
+    int m = T.m + 2 * T.mc + nt + nh + na, i, j, l, r;
+    std::vector<double> A((size_t) m * n, 0.0), b(m, 0.0), S((size_t) m * np, 0.0), c(n, 1.0);
+    std::vector<double> hw(nw), hth(np);
+
+    for (j = 0; j < nw; j++)
+        c[j] = 0.0;
+    for (i = 0; i < T.m; i++) {
+        for (j = 0; j < nw; j++)
+            A[(size_t) i * n + j] = T.A[(size_t) i * nw + j];
+        for (j = 0; j < np; j++)
+            S[(size_t) i * np + j] = T.S[(size_t) i * np + j];
+        b[i] = T.b[i];
+    }
+    r = T.m;
+    for (i = 0; i < T.mc; i++) {
+        for (int sg = 1; sg >= -1; sg -= 2, r++) {
+            for (j = 0; j < nw; j++)
+                A[(size_t) r * n + j] = sg * T.Cw[(size_t) i * nw + j];
+            A[(size_t) r * n + nw + T.term[i]] = -1.0;
+            for (j = 0; j < np; j++)
+                S[(size_t) r * np + j] = -sg * T.Cth[(size_t) i * np + j];
+            b[r] = -sg * T.c0[i];
+        }
+    }
+    for (i = 0; i < nt; i++, r++)
+        A[(size_t) r * n + nw + i] = -1.0;
+
+    /* Rows h'*th+ <= k of the next piece, with th+ = Tth*th + Tw*w + t0 */
+    for (i = 0; i < nh + na; i++, r++) {
+        const double *h = (i < nh) ? Q.hull.row(i) : &Q.V[(size_t) (i - nh) * np];
+        double k = (i < nh) ? Q.hull.b[i] : -Q.v[i - nh];
+        for (j = 0; j < nw; j++) {
+            double s = 0;
+            for (l = 0; l < np; l++)
+                s += h[l] * T.Tw[(size_t) l * nw + j];
+            A[(size_t) r * n + j] = s;
+        }
+        for (j = 0; j < np; j++) {
+            double s = 0;
+            for (l = 0; l < np; l++)
+                s += h[l] * T.Tth[(size_t) l * np + j];
+            S[(size_t) r * np + j] = -s;
+        }
+        b[r] = k - DenseLP::dot(h, &T.t0[0], np);
+        if (i >= nh)
+            A[(size_t) r * n + n - 1] = -1.0;
+    }
+
+    /* mplppar wants column-major data */
+    std::vector<double> Ac((size_t) m * n), Sc((size_t) m * np);
+    for (i = 0; i < m; i++) {
+        for (j = 0; j < n; j++)
+            Ac[i + (size_t) j * m] = A[(size_t) i * n + j];
+        for (j = 0; j < np; j++)
+            Sc[i + (size_t) j * m] = S[(size_t) i * np + j];
+    }
+    mplppar_settings ms;
+    mplppar_default_settings(&ms);
+    ms.nthreads = 1;
+    ms.flattol = set->flattol;
+    ms.removetol = set->removetol;
+    mplppar_t *mp = mplppar_new(n, m, np, &c[0], &Ac[0], &b[0], &Sc[0], &thmin[0], &thmax[0]);
+    long npiv = 0, nl = 0;
+    int status = mplppar_solve(mp, &ms, &npiv, &nl);
+    nmplp++;
+    nlp += nl;
+    if (status == MPLPPAR_UNBOUNDED)
+        unbounded++;
+
+    int nr = mplppar_num_regions(mp);
+    std::vector<Polytope> CR(nr, Polytope(np));
+    std::vector<std::vector<double> > xc(nr);
+    P.s = T.s;
+    P.hull = Polytope(np);
+    P.V.clear();
+    P.v.clear();
+    P.regions.clear();
+    for (r = 0; r < nr; r++) {
+        mplppar_region R;
+        mplppar_get_region(mp, r, &R);
+        CR[r].A.assign(R.H, R.H + (size_t) R.nrows * np);
+        CR[r].b.assign(R.K, R.K + R.nrows);
+        xc[r].assign(R.xc, R.xc + np);
+
+        /* Value of the region, kept once */
+        std::vector<double> V(np, 0.0);
+        double v = 0;
+        for (i = nw; i < n; i++) {
+            for (j = 0; j < np; j++)
+                V[j] += R.F[(size_t) i * np + j];
+            v += R.g[i];
+        }
+        bool found = false;
+        for (l = 0; l < (int) P.v.size() && !found; l++)
+            found = same_row(&P.V[(size_t) l * np], P.v[l], &V[0], v, np, set->tol);
+        if (!found) {
+            P.V.insert(P.V.end(), V.begin(), V.end());
+            P.v.push_back(v);
+        }
+        if (keep) {
+            DPRegion D;
+            D.H = CR[r].A;
+            D.K = CR[r].b;
+            D.F.assign(R.F, R.F + (size_t) nw * np);
+            D.g.assign(R.g, R.g + nw);
+            D.V = V;
+            D.v = v;
+            D.rcheb = R.rcheb;
+            P.regions.push_back(D);
+        }
+    }
+    mplppar_free(mp);
+    if (nr == 0) {
+        /* MPLPPAR_NOFEASIBLE is not taken as an empty piece without an LP */
+        if (status != MPLPPAR_UNBOUNDED && feasible_ball(A, b, S, n, m, np, thmin, thmax, set, lp, nlp))
+            failed++;
+        return false;
+    }
+
+    /* Hull: the rows of the critical regions that hold on all of them. Next
+       to a facet of the union the regions may overlap by more than tol (two
+       almost parallel facets meeting at a flat corner), so a row is taken
+       if no region exceeds it by more than hullslack, and is then moved to
+       the largest value of h'*th over the regions */
+    const double hullslack = 1e3 * set->tol;
+    for (r = 0; r < nr; r++) {
+        for (i = 0; i < CR[r].rows(); i++) {
+            const double *h = CR[r].row(i);
+            double k = CR[r].b[i], kmax = k, val;
+            bool valid = true, dup = false;
+            for (l = 0; l < P.hull.rows() && !dup; l++)
+                dup = same_row(P.hull.row(l), P.hull.b[l], h, k, np, 1e-9);
+            if (dup)
+                continue;
+            for (int q = 0; q < nr && valid; q++)
+                valid = (q == r) || DenseLP::dot(h, &xc[q][0], np) <= k + hullslack;
+            for (int q = 0; q < nr && valid; q++) {
+                if (q == r)
+                    continue;
+                std::vector<double> x(xc[q]);
+                int status = poly_maximize(lp, CR[q], h, &x[0], &val);
+                nlp++;
+                if (status == LPDENSE_INFEASIBLE)
+                    continue;
+                valid = status == LPDENSE_OPTIMAL && val <= k + hullslack;
+                kmax = valid ? std::max(kmax, val) : kmax;
+            }
+            if (valid)
+                P.hull.add_row(h, kmax);
+        }
+    }
+    return finish_hull(lp, P, set, nlp);
+}
+
+/* Is A dominated by B (R_A in R_B and V_B <= V_A on R_A)? */
+static bool dominated(const pwadp_t *dp, const DPPiece &A, const DPPiece &B,
+                      const pwadp_settings *set, DenseLP &lp, long &nlp)
+{
+    int np = dp->np, nh = A.hull.rows(), na = (int) A.v.size(), i, j, l;
+    const double *xc = &A.xc[0];
+
+    if (A.s != B.s || value(B, xc, np) > value(A, xc, np) + set->tol)
+        return false;
+    for (i = 0; i < B.hull.rows(); i++)
+        if (DenseLP::dot(B.hull.row(i), xc, np) > B.hull.b[i] + set->tol)
+            return false;
+    for (i = 0; i < B.hull.rows(); i++) {
+        std::vector<double> x(A.xc);
+        nlp++;
+        if (!poly_row_valid(lp, A.hull, B.hull, i, &x[0], set->tol))
+            return false;
+    }
+
+    /* min V_A - (b_l'*th + beta_l) over R_A, in the variables [th;t] */
+    std::vector<double> c(np + 1), x(np + 1);
+    lp.resize(np + 1, nh + na, 0);
+    for (i = 0; i < nh; i++) {
+        double *a = lp.row(i);
+        for (j = 0; j < np; j++)
+            a[j] = A.hull.row(i)[j];
+        a[np] = 0.0;
+        lp.b[i] = A.hull.b[i];
+    }
+    for (l = 0; l < na; l++) {
+        double *a = lp.row(nh + l);
+        for (j = 0; j < np; j++)
+            a[j] = A.V[(size_t) l * np + j];
+        a[np] = -1.0;
+        lp.b[nh + l] = -A.v[l];
+    }
+    for (l = 0; l < (int) B.v.size(); l++) {
+        for (j = 0; j < np; j++) {
+            c[j] = -B.V[(size_t) l * np + j];
+            x[j] = xc[j];
+        }
+        c[np] = 1.0;
+        x[np] = value(A, xc, np);
+        nlp++;
+        int status = lp.solve(&c[0], &x[0]);
+        if (status != LPDENSE_OPTIMAL || lp.fval - B.v[l] < -set->tol)
+            return false;
+    }
+    return true;
+}
+
+/* Remove the dominated pieces. Of two pieces dominating each other the
+   first one is kept. */
+static void prune(const pwadp_t *dp, std::vector<DPPiece> &pieces, const pwadp_settings *set,
+                  std::vector<DenseLP> &lps, std::vector<long> &nlp)
+{
+    int p = (int) pieces.size(), a, c;
+    std::vector<char> dom((size_t) p * p, 0), drop(p, 0);
+
+    mex_parallel_for(p, set->nthreads, 1, [&](int i, int tid) {
+        for (int k = 0; k < p; k++)
+            if (k != i)
+                dom[(size_t) i * p + k] = dominated(dp, pieces[i], pieces[k], set, lps[tid], nlp[tid]);
+    });
+    for (a = 0; a < p; a++)
+        for (c = 0; c < p && !drop[a]; c++)
+            if (dom[(size_t) a * p + c] && (!dom[(size_t) c * p + a] || c < a))
+                drop[a] = 1;
+    std::vector<DPPiece> kept;
+    for (a = 0; a < p; a++)
+        if (!drop[a])
+            kept.push_back(pieces[a]);
+    pieces.swap(kept);
+}
+
+int pwadp_solve(pwadp_t *dp, int N, const pwadp_settings *set, long *nmplp, long *nlp,
+                int *npieces)
+{
+    int nt = mex_num_threads(set->nthreads), k, status = PWADP_OK;
+    std::vector<DenseLP> lps(nt);
+    std::vector<long> nm(nt, 0), nl(nt, 0);
+    std::vector<DPPiece> cur;
+    mex_counter unbounded, failed;
+
+    unbounded = 0;
+    failed = 0;
+    dp->pieces.clear();
+    for (size_t i = 0; i < dp->terminal.size(); i++) {
+        DPPiece P = dp->terminal[i];
+        add_box(P.hull, dp->thmin, dp->thmax);
+        if (finish_hull(lps[0], P, set, nl[0]))
+            cur.push_back(P);
+    }
+    prune(dp, cur, set, lps, nl);
+    if (npieces)
+        npieces[N] = (int) cur.size();
+
+    for (k = N - 1; k >= 0 && !cur.empty(); k--) {
+        const std::vector<DPTrans> &trans = (k == 0) ? dp->first : dp->middle;
+        const std::vector<double> &thmin = (k == 0) ? dp->thmin0 : dp->thmin;
+        const std::vector<double> &thmax = (k == 0) ? dp->thmax0 : dp->thmax;
+        std::vector<std::pair<int, int> > jobs;
+
+        for (size_t t = 0; t < trans.size(); t++)
+            for (size_t j = 0; j < cur.size(); j++)
+                if (cur[j].s == trans[t].snext)
+                    jobs.push_back(std::make_pair((int) t, (int) j));
+        std::vector<DPPiece> out(jobs.size());
+        std::vector<char> ok(jobs.size(), 0);
+        mex_parallel_for((int) jobs.size(), set->nthreads, 1, [&](int i, int tid) {
+            ok[i] = solve_mplp(dp, trans[jobs[i].first], cur[jobs[i].second], thmin, thmax,
+                               k == 0, set, lps[tid], out[i], nm[tid], nl[tid], unbounded,
+                               failed);
+            out[i].trans = jobs[i].first;
+        });
+
+        std::vector<DPPiece> next;
+        for (size_t i = 0; i < jobs.size(); i++)
+            if (ok[i])
+                next.push_back(out[i]);
+        prune(dp, next, set, lps, nl);
+        cur.swap(next);
+        if (npieces)
+            npieces[k] = (int) cur.size();
+    }
+    if (npieces)
+        for (; k >= 0; k--)
+            npieces[k] = 0;
+    if (failed)
+        status = PWADP_INCOMPLETE;
+    else if (cur.empty())
+        status = PWADP_INFEASIBLE;
+    else if (unbounded)
+        status = PWADP_UNBOUNDED;
+
+    std::stable_sort(cur.begin(), cur.end(), [](const DPPiece &a, const DPPiece &c) {
+        return a.s < c.s || (a.s == c.s && a.trans < c.trans);
+    });
+    dp->pieces.swap(cur);
+    if (nmplp) {
+        *nmplp = 0;
+        for (k = 0; k < nt; k++)
+            *nmplp += nm[k];
+    }
+    if (nlp) {
+        *nlp = 0;
+        for (k = 0; k < nt; k++)
+            *nlp += nl[k];
+    }
+    return status;
+}
@@ -0,0 +1,127 @@
+/* Parallel multiparametric dynamic programming for PWA systems - C API
+
+   Computes the explicit solution of the finite-horizon optimal control
+   problem with Inf-norm (or 1-norm) costs
+
+       J_k(th,s) = min  sum_q |Cw_q*w + Cth_q*th + c0_q|_inf + J_{k+1}(th+,s+)
+                   s.t. A*w <= b + S*th
+                        th+ = Tth*th + Tw*w + t0
+
+   backwards for k=N-1,...,0, where th are the continuous parameters
+   (continuous states and references), s is a discrete state (value of
+   the binary states), w the continuous inputs, and the transitions
+   (A,b,S,Cw,Cth,c0,Tth,Tw,t0, s -> s+) are the modes of the PWA system
+   for given values of the binary inputs. J_N is given by terminal pieces.
+
+   J_k(.,s) is the minimum of a list of pieces (R,V): V is a convex PWA
+   function max_l a_l'*th + c_l defined on the polytope R. Each piece of
+   J_k is the value function of the mpLP of one transition and one piece
+   of J_{k+1} (solved by MPLPPAR.CPP), and R is the union of its critical
+   regions. A piece is dropped when another piece with the same s
+   dominates it, i.e. covers its region with a value not larger (one LP
+   for each affine function of the dominating piece). The mpLPs and the
+   dominance checks of each stage run on several threads.
+
+   The pieces of J_0 keep their critical regions and optimal inputs: they
+   form overlapping partitions, and the control law at th is given by the
+   piece with the smallest value among those containing th.
+
+   Matrices are column-major (MATLAB layout). See PWADPMEX.CPP for the MEX
+   interface and PWADP.M for the MATLAB wrapper.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef PWADP_H
+#define PWADP_H
+
+#define PWADP_OK          0
+#define PWADP_INFEASIBLE  1   /* some J_k has no piece */
+#define PWADP_UNBOUNDED   2   /* some mpLP was unbounded (regions lost) */
+#define PWADP_INCOMPLETE  3   /* some mpLP found no region although its
+                                 parameter set is not empty (pieces lost) */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct pwadp_struct pwadp_t;
+
+typedef struct {
+    int nthreads;       /* worker threads (<=0: all cores) */
+    double flattol;     /* critical regions and pieces with smaller
+                           Chebychev radius are discarded (1e-8) */
+    double tol;         /* tolerance of the inclusion and value
+                           comparisons (1e-7) */
+    double removetol;   /* tolerance for removing redundant rows (1e-9) */
+} pwadp_settings;
+
+/* Transition from the discrete state s to snext (0-based). Cost row i
+   belongs to the term term[i] (0-based): the cost of the transition is
+   the sum over the terms of the largest absolute value of their rows. */
+typedef struct {
+    int s, snext;
+    int m;                  /* rows of A (m-by-nw), b, S (m-by-np) */
+    const double *A, *b, *S;
+    int mc;                 /* cost rows: Cw (mc-by-nw), Cth (mc-by-np), c0 */
+    const double *Cw, *Cth, *c0;
+    const int *term;
+    const double *Tth, *Tw, *t0;   /* np-by-np, np-by-nw, np */
+} pwadp_transition;
+
+typedef struct {
+    int s;              /* discrete state */
+    int trans;          /* transition of stage 0 (0-based) */
+    int nregions;       /* critical regions */
+    int nrows;          /* rows of the hull H*th <= K of the regions */
+    const double *H;    /* nrows-by-np, row-major */
+    const double *K;
+    double rcheb;       /* Chebychev radius of the hull */
+} pwadp_piece;
+
+typedef struct {
+    int nrows;
+    const double *H;    /* nrows-by-np, row-major, rows of unit norm */
+    const double *K;
+    const double *F;    /* nw-by-np, row-major: w = F*th + g */
+    const double *g;
+    const double *V;    /* value V'*th + v */
+    double v;
+    double rcheb;
+} pwadp_region;
+
+void pwadp_default_settings(pwadp_settings *set);
+
+/* np parameters and nw inputs. Parameters are bounded by thmin0..thmax0
+   at stage 0 and by thmin..thmax at the other stages. */
+pwadp_t *pwadp_new(int np, int nw, const double *thmin0, const double *thmax0,
+                   const double *thmin, const double *thmax);
+
+/* Piece of J_N: region H*th <= K (H is nrows-by-np) and value
+   max_l V(l,:)*th + v(l) (V is nval-by-np) */
+void pwadp_add_terminal(pwadp_t *dp, int s, int nrows, const double *H, const double *K,
+                        int nval, const double *V, const double *v);
+
+/* Transition of stage 0 (first=1) or of stages 1,...,N-1 (first=0).
+   Data are copied. */
+void pwadp_add_transition(pwadp_t *dp, int first, const pwadp_transition *T);
+
+/* Run the recursion over N stages. Returns one of the PWADP_* codes.
+   nmplp and nlp (may be NULL) receive the number of mpLPs and of other
+   LPs solved, npieces (may be NULL, N+1 entries) the number of pieces of
+   J_0,...,J_N. */
+int pwadp_solve(pwadp_t *dp, int N, const pwadp_settings *set, long *nmplp, long *nlp,
+                int *npieces);
+
+/* Pieces of J_0, ordered by discrete state and transition */
+int pwadp_num_pieces(const pwadp_t *dp);
+void pwadp_get_piece(const pwadp_t *dp, int i, pwadp_piece *p);
+void pwadp_get_region(const pwadp_t *dp, int i, int r, pwadp_region *reg);
+
+void pwadp_free(pwadp_t *dp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
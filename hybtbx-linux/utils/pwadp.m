@@ -0,0 +1,313 @@
+function [sol,lpsolved,colors]=pwadp(P,N,setup)
+% PWADP Explicit hybrid MPC with Inf-norm costs by parallel multiparametric
+% dynamic programming
+%
+% [sol,lpsolved,colors]=PWADP(P,N,setup) computes the explicit solution of
+% the finite-horizon optimal control problem with Inf-norm costs for the
+% PWA system P and horizon N, with the same setup structure and the same
+% outputs as PWAOPT. It is called by EXPCON when options.method='dp'.
+%
+% The problem is solved backwards in time by the native solver PWADPMEX
+% (see PWADP.CPP and MEXCOMPILE.M): the value function J_k of each stage is
+% a list of pieces, one for each mode of P (region and values of the binary
+% states and inputs) and piece of J_{k+1}, each obtained by one mpLP, and
+% the pieces dominated by another piece are removed. The mpLPs and the
+% dominance checks of each stage run on several threads, and only the
+% mode sequences that are optimal somewhere are extended.
+%
+% The pieces of J_0 are returned as overlapping partitions (as for 2-norm
+% hybrid controllers): sol.H, sol.K, sol.F, sol.G, sol.i1, sol.i2 are cell
+% arrays with one partition for each piece, sol.nr is the vector of the
+% numbers of regions, and sol.cost{j}.V, sol.cost{j}.v give the optimal
+% cost V(i,:)*th+v(i) in region i of partition j. The control law at th
+% is given by the partition with the smallest cost among those containing
+% th (see EXPCON/EVAL).
+%
+% Only hard constraints are supported (setup.noslack=1). States that are
+% not bounded by setup.xmin, setup.xmax at times 1,...,N are restricted to
+% a large box around setup.x0min, setup.x0max.
+%
+% setup.nthreads = number of worker threads (default: all cores)
+%
+% See also PWAOPT, EXPCON.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if exist('pwadpmex')~=3,
+    error('pwadp:nomex','PWADPMEX is not compiled (type "mexcompile(''pwadpmex'')"), use options.method=''enum''.');
+end
+if ~isinf(setup.norm),
+    error('pwadp:norm','PWADP only supports Inf-norm costs');
+end
+if ~setup.noslack,
+    error('pwadp:soft','PWADP only supports hard constraints, define the controller with Q.rho=Inf');
+end
+if ~isfield(setup,'nthreads'),
+    setup.nthreads=[];
+end
+if ~isfield(setup,'verbose') || isempty(setup.verbose),
+    setup.verbose=0;
+end
+
+setup.x0min=setup.x0min(:);
+setup.x0max=setup.x0max(:);
+nxr=P.nxr;nxb=P.nxb;nx=nxr+nxb;
+nur=P.nur;nub=P.nub;nu=nur+nub;
+nyr=P.nyr;nyb=P.nyb;ny=nyr+nyb;
+tol=1e-8;
+
+% References as M*r+m0, r=[free rx;free ru;free ry]
+rs=setup.refsignals;
+nrx=length(setdiff(rs.x,setup.fixref.x));
+nru=length(setdiff(rs.u,setup.fixref.u));
+nry=length(setdiff(rs.y,setup.fixref.y));
+nref=nrx+nru+nry;
+[Mx,mx]=refmap(nx,rs.x,setup.fixref.x,setup.valueref.x,0,nref);
+[Mu,mu]=refmap(nu,rs.u,setup.fixref.u,setup.valueref.u,nrx,nref);
+[My,my]=refmap(ny,rs.y,setup.fixref.y,setup.valueref.y,nrx+nru,nref);
+ixr=1:nxr;ixb=nxr+1:nx;
+iur=1:nur;iub=nur+1:nu;
+iyr=1:nyr;iyb=nyr+1:ny;
+
+% Parameters th=[xr;r] of PWADPMEX, at time 0 and at times 1,...,N
+refmin=[setup.x0refmin(:);setup.u0refmin(:);setup.y0refmin(:)];
+refmax=[setup.x0refmax(:);setup.u0refmax(:);setup.y0refmax(:)];
+thmin0=[setup.x0min(ixr);refmin];
+thmax0=[setup.x0max(ixr);refmax];
+large=max(1000,10*max(abs([thmin0(1:nxr);thmax0(1:nxr);0])));
+xmin=setup.xmin(ixr);
+xmin(~isfinite(xmin))=-large;
+xmax=setup.xmax(ixr);
+xmax(~isfinite(xmax))=large;
+thmin=[xmin;refmin];
+thmax=[xmax;refmax];
+np=nxr+nref;
+
+% Values of the binary states allowed at time 0 and at times 1,...,N
+XB=binvalues(nxb);
+UB=binvalues(nub);
+ns=size(XB,2);
+ok0=all(XB>=setup.x0min(ixb)*ones(1,ns)-tol,1) & all(XB<=setup.x0max(ixb)*ones(1,ns)+tol,1);
+ok=all(XB>=setup.xmin(ixb)*ones(1,ns)-tol,1) & all(XB<=setup.xmax(ixb)*ones(1,ns)+tol,1);
+UB=UB(:,all(UB>=setup.umin(iub)*ones(1,size(UB,2))-tol,1) & ...
+    all(UB<=setup.umax(iub)*ones(1,size(UB,2))+tol,1));
+
+% Terminal pieces: Sx*x<=Tx, value |Pc*(xr-rxr)|,|Pb*(xb-rxb)|
+Sx=setup.Sx;
+Tx=setup.Tx(:);
+if isempty(Sx),
+    Sx=zeros(0,nx);
+    Tx=zeros(0,1);
+end
+Pc=setup.Pc;Pb=setup.Pb;
+terminal=struct('s',{},'H',{},'K',{},'V',{},'v',{});
+for s=find(ok),
+    xb=XB(:,s);
+    [H,K,feas]=fixrows(Sx(:,ixr),Tx-Sx(:,ixb)*xb,tol);
+    if ~feas,
+        continue
+    end
+    V=[Pc,-Pc*Mx(ixr,:);zeros(size(Pb,1),np)];
+    v=[-Pc*mx(ixr);Pb*(xb-mx(ixb))];
+    V=[V;-V];
+    v=[v;-v];
+    if isempty(v),
+        V=zeros(1,np);
+        v=0;
+    end
+    terminal(end+1)=struct('s',s,'H',[H,zeros(size(H,1),nref)],'K',K,'V',V,'v',v);
+end
+
+% Transitions: one for each region of P and values of xb, ub and xb+
+Rc=setup.Rc;Rb=setup.Rb;Qc=setup.Qc;Qb=setup.Qb;Yc=setup.Yc;Yb=setup.Yb;
+first=cell(1,0);
+middle=cell(1,0);
+firstub=zeros(nub,0);
+umin=setup.umin(iur);umax=setup.umax(iur);
+ymin=setup.ymin;ymax=setup.ymax;
+Iu=eye(nur);
+iumin=find(isfinite(umin));iumax=find(isfinite(umax));
+iymin=find(isfinite(ymin));iymax=find(isfinite(ymax));
+for i=1:P.nr,
+    Cy=[P.C{i};P.LC{i}];
+    Dy=[P.D{i};P.LD{i}];
+    gy=[P.g{i};P.Lg{i}];
+    Tth=blkdiag(P.A{i},eye(nref));
+    Tw=[P.B{i};zeros(nref,nur)];
+    t0=[P.f{i};zeros(nref,1)];
+    for s=find(ok0|ok),
+        xb=XB(:,s);
+        for q=1:size(UB,2),
+            ub=UB(:,q);
+
+            % Region and constraints on u(k), y(k), as A*ur<=b+S*xr
+            A=[P.Hu{i}(:,iur);Iu(iumax,:);-Iu(iumin,:);Dy(iymax,:);-Dy(iymin,:)];
+            S=-[P.Hx{i}(:,ixr);zeros(length(iumax)+length(iumin),nxr);Cy(iymax,:);-Cy(iymin,:)];
+            b=[P.K{i}-P.Hx{i}(:,ixb)*xb-P.Hu{i}(:,iub)*ub;umax(iumax);-umin(iumin);...
+                ymax(iymax)-gy(iymax);-ymin(iymin)+gy(iymin)];
+            [AS,b,feas]=fixrows([A,-S],b,tol);
+            if ~feas,
+                continue
+            end
+            A=AS(:,1:nur);
+            S=[-AS(:,nur+1:end),zeros(size(AS,1),nref)];
+
+            % Stage cost: terms |u-ru|, |y-ry| and (times 1,...,N-1) |x-rx|
+            Cw=[Rc;zeros(size(Rb,1),nur);Yc*Dy(iyr,:);Yb*Dy(iyb,:)];
+            Cth=[zeros(size(Rc,1),nxr),-Rc*Mu(iur,:);zeros(size(Rb,1),np);...
+                Yc*Cy(iyr,:),-Yc*My(iyr,:);Yb*Cy(iyb,:),-Yb*My(iyb,:)];
+            c0=[-Rc*mu(iur);Rb*(ub-mu(iub));Yc*(gy(iyr)-my(iyr));Yb*(gy(iyb)-my(iyb))];
+            term=[ones(size(Rc,1)+size(Rb,1),1);2*ones(size(Yc,1)+size(Yb,1),1)];
+            Cwx=zeros(size(Qc,1)+size(Qb,1),nur);
+            Cthx=[Qc,-Qc*Mx(ixr,:);zeros(size(Qb,1),np)];
+            c0x=[-Qc*mx(ixr);Qb*(xb-mx(ixb))];
+
+            % Binary states at the next step: if they depend on xr, ur,
+            % one transition for each value xb+, with the rows
+            % sx.*(LA*xr+LB*ur+Lf)<=sx/2, sx=1-2*xb+
+            LA=P.LA{i};LB=P.LB{i};Lf=P.Lf{i};
+            isconst=~any(LA(:)) && ~any(LB(:));
+            if isconst,
+                XBnext=round(Lf);
+            else
+                XBnext=XB;
+            end
+            for j=1:size(XBnext,2),
+                xbn=XBnext(:,j);
+                An=A;Sn=S;bn=b;
+                if ~isconst,
+                    sx=1-2*xbn;
+                    [AS,bx,feas]=fixrows([diag(sx)*LB,diag(sx)*LA],sx/2-sx.*Lf,tol);
+                    if ~feas,
+                        continue
+                    end
+                    An=[A;AS(:,1:nur)];
+                    Sn=[S;-AS(:,nur+1:end),zeros(size(AS,1),nref)];
+                    bn=[b;bx];
+                end
+                snext=1+(2.^(0:nxb-1))*xbn;
+                T=struct('s',s,'snext',snext,'A',An,'b',bn,'S',Sn,'Cw',Cw,...
+                    'Cth',Cth,'c0',c0,'term',term,'Tth',Tth,'Tw',Tw,'t0',t0);
+                if ok0(s),
+                    [T.Cw,T.Cth,T.c0,T.term]=dropzero(Cw,Cth,c0,term);
+                    first{end+1}=T;
+                    firstub(:,end+1)=ub;
+                end
+                if ok(s),
+                    [T.Cw,T.Cth,T.c0,T.term]=dropzero([Cw;Cwx],[Cth;Cthx],[c0;c0x],...
+                        [term;3*ones(size(Cwx,1),1)]);
+                    middle{end+1}=T;
+                end
+            end
+        end
+    end
+end
+first=[first{:}];
+middle=[middle{:}];
+
+opts=struct('nthreads',setup.nthreads,'flattol',setup.flattol);
+[H,K,i1,i2,F,G,V,v,rCheb,ir1,ir2,sp,trans,status,nmplp,nlp,npieces]=...
+    pwadpmex(N,thmin0,thmax0,thmin,thmax,nur,terminal,first,middle,opts);
+if status==1,
+    error('pwadp:infeasible','The optimal control problem is infeasible for all parameters in the range');
+elseif status==2,
+    warning('pwadp:unbounded','Some mpLPs were unbounded, the explicit solution may not cover the whole range');
+elseif status==3,
+    warning('pwadp:incomplete','Some mpLPs found no region on a feasible range, the explicit solution may be suboptimal or not cover the whole range');
+end
+if setup.verbose,
+    fprintf('%d mpLPs, %d LPs, pieces of the value functions J_0,...,J_N:%s\n',...
+        nmplp,nlp,sprintf(' %d',npieces));
+end
+lpsolved=nmplp+nlp;
+colors=[];
+
+% Partitions in the parameters th=[xr;xb;r] of EXPCON, with the rows
+% xb(j)<=1/2 (value 0) or -xb(j)<=-1/2 (value 1)
+npart=length(sp);
+npar=nx+nref;
+sol.H=cell(1,npart);sol.K=sol.H;sol.F=sol.H;sol.G=sol.H;
+sol.i1=sol.H;sol.i2=sol.H;sol.cost=sol.H;
+sol.nr=zeros(1,npart);
+ins=@(M) [M(:,ixr),zeros(size(M,1),nxb),M(:,nxr+1:np)];
+for j=1:npart,
+    xb=XB(:,sp(j));
+    ub=firstub(:,trans(j));
+    sx=1-2*xb;
+    Hb=[zeros(nxb,nxr),diag(sx),zeros(nxb,nref)];
+    ir=ir1(j):ir2(j);
+    nrj=length(ir);
+    Hj=cell(nrj,1);Kj=Hj;Fj=Hj;Gj=Hj;
+    i1j=zeros(nrj,1);i2j=i1j;
+    nh=0;
+    for k=1:nrj,
+        r=ir(k);
+        ih=i1(r):i2(r);
+        Hj{k}=[ins(H(ih,:));Hb];
+        Kj{k}=[K(ih);sx/2];
+        i1j(k)=nh+1;
+        nh=nh+length(ih)+nxb;
+        i2j(k)=nh;
+        iw=(r-1)*nur+1:r*nur;
+        Fj{k}=[ins(F(iw,:));zeros(nub,npar)];
+        Gj{k}=[G(iw);ub];
+    end
+    sol.H{j}=cat(1,zeros(0,npar),Hj{:});
+    sol.K{j}=cat(1,zeros(0,1),Kj{:});
+    sol.F{j}=cat(1,zeros(0,npar),Fj{:});
+    sol.G{j}=cat(1,zeros(0,1),Gj{:});
+    sol.i1{j}=i1j;
+    sol.i2{j}=i2j;
+    sol.nr(j)=nrj;
+    sol.cost{j}=struct('V',ins(V(ir,:)),'v',v(ir));
+end
+xbmin=max(setup.x0min(ixb),0);
+xbmax=min(setup.x0max(ixb),1);
+sol.thmin=[thmin0(1:nxr);xbmin;refmin];
+sol.thmax=[thmax0(1:nxr);xbmax;refmax];
+sol.nu=nu;
+sol.npar=npar;
+sol.nvar=nu;
+sol.type='dp';
+sol.unconstr_num=[];
+sol.label=[];
+sol.rCheb=rCheb;
+sol.flattol=setup.flattol;
+
+%-----------------
+function [M,m0]=refmap(n,isig,ifix,vfix,col,nref)
+% References of the n signals as M*r+m0: fixed references are in m0, the
+% free ones are r(col+1),r(col+2),... in the order of isig
+M=zeros(n,nref);
+m0=zeros(n,1);
+isig=isig(:);
+vfix=vfix(:);
+[isfix,k]=ismember(isig,ifix(:));
+m0(isig(isfix))=vfix(k(isfix));
+ifree=isig(~isfix);
+M(ifree,col+1:col+length(ifree))=eye(length(ifree));
+
+%-----------------
+function B=binvalues(n)
+% All 2^n binary vectors, column #s is the vector with 1+sum(b.*2.^(0:n-1))=s
+B=zeros(n,2^n);
+for k=1:n,
+    B(k,:)=bitget(0:2^n-1,k);
+end
+
+%-----------------
+function [A,b,feas]=fixrows(A,b,tol)
+% Remove the rows A(i,:)*v<=b(i) with A(i,:)=0, feas=0 if one is violated
+iz=all(abs(A)<=tol,2);
+feas=all(b(iz)>=-tol);
+A=A(~iz,:);
+b=b(~iz);
+
+%-----------------
+function [Cw,Cth,c0,term]=dropzero(Cw,Cth,c0,term)
+% Remove the cost rows that are identically zero
+nz=any(Cw,2) | any(Cth,2) | c0~=0;
+Cw=Cw(nz,:);
+Cth=Cth(nz,:);
+c0=c0(nz);
+term=term(nz);
@@ -0,0 +1,228 @@
+/* Parallel multiparametric dynamic programming for PWA systems - MEX
+   interface
+
+   [H,K,i1,i2,F,G,V,v,rCheb,ir1,ir2,s,trans,status,nmplp,nlp,npieces]=...
+       pwadpmex(N,thmin0,thmax0,thmin,thmax,nw,terminal,first,middle,opts)
+
+   Runs the recursion of PWADP.CPP over N stages, with parameters bounded
+   by thmin0..thmax0 at stage 0 and by thmin..thmax at the other stages,
+   and nw continuous inputs.
+
+   terminal is a structure array of the pieces of J_N, with fields s
+   (discrete state, 1-based), H, K (region H*th <= K) and V, v (value
+   max(V*th+v)). first and middle are structure arrays of the transitions
+   of stage 0 and of stages 1,...,N-1, with fields s, snext (1-based),
+   A, b, S (constraints A*w <= b+S*th), Cw, Cth, c0, term (cost rows
+   Cw*w+Cth*th+c0 and their 1-based term) and Tth, Tw, t0 (parameters at
+   the next stage Tth*th+Tw*w+t0), see PWADP.H.
+
+   The pieces of J_0 are returned as overlapping partitions: piece #p has
+   discrete state s(p), comes from the transition first(trans(p)) and is
+   made of the regions ir1(p),...,ir2(p). Region #i is
+   {th: H(i1(i):i2(i),:)*th <= K(i1(i):i2(i))}, where the inputs are
+   w = F((i-1)*nw+1:i*nw,:)*th + G((i-1)*nw+1:i*nw) and the value is
+   V(i,:)*th + v(i).
+
+   opts is a structure with optional fields
+       nthreads  = number of worker threads (default: all cores)
+       flattol   = regions with smaller Chebychev radius are discarded (1e-8)
+       tol       = tolerance of the inclusion and value comparisons (1e-7)
+       removetol = tolerance for removing redundant rows (1e-9)
+
+   status  = 0 solved, 1 infeasible for all parameters, 2 some mpLP was
+             unbounded, 3 some mpLP found no region although its
+             parameter set is not empty
+   nmplp,nlp = number of mpLPs and of other LPs solved
+   npieces = number of pieces of J_0,...,J_N (after removing the
+             dominated ones)
+
+   Compile with MEXCOMPILE.M (or mex -O pwadpmex.cpp pwadp.cpp mplppar.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "pwadp.h"
+#include <vector>
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+/* Field name of element k of the structure array a, an m-by-n full
+   matrix (m<0: any number of rows, returned in *m) */
+static const double *getfield(const mxArray *a, int k, const char *name, int *m, int n)
+{
+    static const double zero = 0.0;
+    const mxArray *f = mxGetField(a, k, name);
+    int rows, cols;
+
+    if (!f)
+        mexErrMsgIdAndTxt("pwadpmex:field", "Missing field %s.", name);
+    rows = (int) mxGetM(f);
+    cols = (int) mxGetN(f);
+    if (rows == 0 && cols == 0 && (*m <= 0 || n == 0)) {
+        rows = (*m < 0) ? 0 : *m;   /* [] for an empty matrix */
+        cols = n;
+    }
+    if (!mxIsDouble(f) || mxIsSparse(f) || (*m >= 0 && rows != *m) || cols != n)
+        mexErrMsgIdAndTxt("pwadpmex:dim", "Field %s of element %d has wrong dimension or type.", name, k + 1);
+    *m = rows;
+    return mxIsEmpty(f) ? &zero : mxGetPr(f);
+}
+
+static void addtransitions(pwadp_t *dp, const mxArray *a, int first, int np, int nw)
+{
+    int k, i, nel = (int) mxGetNumberOfElements(a), one;
+    pwadp_transition T;
+    std::vector<int> term;
+
+    if (nel > 0 && !mxIsStruct(a))
+        mexErrMsgTxt("Transitions must be structure arrays.");
+    for (k = 0; k < nel; k++) {
+        one = 1;
+        T.s = (int) *getfield(a, k, "s", &one, 1) - 1;
+        T.snext = (int) *getfield(a, k, "snext", &one, 1) - 1;
+        T.m = -1;
+        T.A = getfield(a, k, "A", &T.m, nw);
+        T.b = getfield(a, k, "b", &T.m, 1);
+        T.S = getfield(a, k, "S", &T.m, np);
+        T.mc = -1;
+        T.Cw = getfield(a, k, "Cw", &T.mc, nw);
+        T.Cth = getfield(a, k, "Cth", &T.mc, np);
+        T.c0 = getfield(a, k, "c0", &T.mc, 1);
+        const double *t = getfield(a, k, "term", &T.mc, 1);
+        term.resize(T.mc);
+        for (i = 0; i < T.mc; i++)
+            term[i] = (int) t[i] - 1;
+        T.term = term.empty() ? NULL : &term[0];
+        int mt = np;
+        T.Tth = getfield(a, k, "Tth", &mt, np);
+        T.Tw = getfield(a, k, "Tw", &mt, nw);
+        T.t0 = getfield(a, k, "t0", &mt, 1);
+        pwadp_add_transition(dp, first, &T);
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    pwadp_settings set;
+    pwadp_piece P;
+    pwadp_region R;
+    pwadp_t *dp;
+    int N, np, nw, npc, nr = 0, nh = 0, i, j, k, p, r, q, status;
+    long nmplp = 0, nlp = 0;
+    double *H, *K, *F, *G, *V;
+
+    if (nrhs < 9)
+        mexErrMsgTxt("At least nine input arguments required.");
+
+    N = (int) mxGetScalar(prhs[0]);
+    np = (int) mxGetNumberOfElements(prhs[1]);
+    nw = (int) mxGetScalar(prhs[5]);
+    if (N < 1)
+        mexErrMsgTxt("N must be positive.");
+    for (i = 1; i <= 4; i++)
+        if (!mxIsDouble(prhs[i]) || (int) mxGetNumberOfElements(prhs[i]) != np)
+            mexErrMsgTxt("thmin0, thmax0, thmin, thmax must be vectors of the same dimension.");
+
+    pwadp_default_settings(&set);
+    if (nrhs > 9) {
+        set.nthreads = (int) getopt(prhs[9], "nthreads", set.nthreads);
+        set.flattol = getopt(prhs[9], "flattol", set.flattol);
+        set.tol = getopt(prhs[9], "tol", set.tol);
+        set.removetol = getopt(prhs[9], "removetol", set.removetol);
+    }
+
+    dp = pwadp_new(np, nw, mxGetPr(prhs[1]), mxGetPr(prhs[2]), mxGetPr(prhs[3]), mxGetPr(prhs[4]));
+    for (k = 0; k < (int) mxGetNumberOfElements(prhs[6]); k++) {
+        int one = 1, mh = -1, mv = -1;
+        int s = (int) *getfield(prhs[6], k, "s", &one, 1) - 1;
+        const double *Ht = getfield(prhs[6], k, "H", &mh, np);
+        const double *Kt = getfield(prhs[6], k, "K", &mh, 1);
+        const double *Vt = getfield(prhs[6], k, "V", &mv, np);
+        const double *vt = getfield(prhs[6], k, "v", &mv, 1);
+        pwadp_add_terminal(dp, s, mh, Ht, Kt, mv, Vt, vt);
+    }
+    addtransitions(dp, prhs[7], 1, np, nw);
+    addtransitions(dp, prhs[8], 0, np, nw);
+
+    std::vector<int> npieces(N + 1, 0);
+    status = pwadp_solve(dp, N, &set, &nmplp, &nlp, &npieces[0]);
+
+    npc = pwadp_num_pieces(dp);
+    for (p = 0; p < npc; p++) {
+        pwadp_get_piece(dp, p, &P);
+        for (r = 0; r < P.nregions; r++) {
+            pwadp_get_region(dp, p, r, &R);
+            nh += R.nrows;
+        }
+        nr += P.nregions;
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(nh, np, mxREAL);
+    plhs[1] = mxCreateDoubleMatrix(nh, 1, mxREAL);
+    plhs[2] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[3] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[4] = mxCreateDoubleMatrix(nr * nw, np, mxREAL);
+    plhs[5] = mxCreateDoubleMatrix(nr * nw, 1, mxREAL);
+    plhs[6] = mxCreateDoubleMatrix(nr, np, mxREAL);
+    plhs[7] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[8] = mxCreateDoubleMatrix(nr, 1, mxREAL);
+    plhs[9] = mxCreateDoubleMatrix(npc, 1, mxREAL);
+    plhs[10] = mxCreateDoubleMatrix(npc, 1, mxREAL);
+    plhs[11] = mxCreateDoubleMatrix(npc, 1, mxREAL);
+    plhs[12] = mxCreateDoubleMatrix(npc, 1, mxREAL);
+    H = mxGetPr(plhs[0]);
+    K = mxGetPr(plhs[1]);
+    F = mxGetPr(plhs[4]);
+    G = mxGetPr(plhs[5]);
+    V = mxGetPr(plhs[6]);
+
+    for (p = 0, q = 0, k = 0; p < npc; p++) {
+        pwadp_get_piece(dp, p, &P);
+        mxGetPr(plhs[9])[p] = q + 1;
+        for (r = 0; r < P.nregions; r++, q++) {
+            pwadp_get_region(dp, p, r, &R);
+            mxGetPr(plhs[2])[q] = k + 1;
+            for (i = 0; i < R.nrows; i++, k++) {
+                for (j = 0; j < np; j++)
+                    H[k + (size_t) j * nh] = R.H[(size_t) i * np + j];
+                K[k] = R.K[i];
+            }
+            mxGetPr(plhs[3])[q] = k;
+            for (i = 0; i < nw; i++) {
+                for (j = 0; j < np; j++)
+                    F[(size_t) q * nw + i + (size_t) j * nr * nw] = R.F[(size_t) i * np + j];
+                G[(size_t) q * nw + i] = R.g[i];
+            }
+            for (j = 0; j < np; j++)
+                V[q + (size_t) j * nr] = R.V[j];
+            mxGetPr(plhs[7])[q] = R.v;
+            mxGetPr(plhs[8])[q] = R.rcheb;
+        }
+        mxGetPr(plhs[10])[p] = q;
+        mxGetPr(plhs[11])[p] = P.s + 1;
+        mxGetPr(plhs[12])[p] = P.trans + 1;
+    }
+    pwadp_free(dp);
+
+    if (nlhs > 13)
+        plhs[13] = mxCreateDoubleScalar(status);
+    if (nlhs > 14)
+        plhs[14] = mxCreateDoubleScalar((double) nmplp);
+    if (nlhs > 15)
+        plhs[15] = mxCreateDoubleScalar((double) nlp);
+    if (nlhs > 16) {
+        plhs[16] = mxCreateDoubleMatrix(N + 1, 1, mxREAL);
+        for (k = 0; k <= N; k++)
+            mxGetPr(plhs[16])[k] = npieces[k];
+    }
+}
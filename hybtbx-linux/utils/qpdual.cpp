@@ -0,0 +1,454 @@
+/* Dual active-set QP solver (Goldfarb-Idnani) - implementation
+
+   See QPDUAL.H for the API.
+
+   The method (D. Goldfarb, A. Idnani, "A numerically stable dual method
+   for solving strictly convex quadratic programs", Math. Programming 27,
+   1983) starts from the unconstrained minimum -inv(Q)*f and adds violated
+   constraints one at a time, keeping the current point optimal for the
+   constraints in the active set. With Q=L*L' and N the matrix of the
+   active constraint normals, it maintains
+
+       J = inv(L')*Qr,   R   such that   inv(L)*N = Qr*[R;0]
+
+   so that the primal step is z=J2*J2'*n+ and the dual step r=inv(R)*J1'*n+.
+   Adding or dropping a constraint updates J and R by Givens rotations.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "qpdual.h"
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+struct qpdual_struct {
+    int n;
+    std::vector<double> J0;     /* inv(L') = inv(chol(Q)), column-major */
+    std::vector<int> warm;      /* active set of the last solve */
+    int maxiter;
+
+    /* workspace */
+    std::vector<double> J, R, d, z, r, u, np;
+    std::vector<int> act;
+};
+
+/* column-major access */
+#define JJ(i, j) J[(i) + (size_t) (j) * n]
+#define RR(i, j) R[(i) + (size_t) (j) * n]
+
+static double hypot2(double a, double b)
+{
+    double a1 = std::fabs(a), b1 = std::fabs(b), t;
+    if (a1 > b1) {
+        t = b1 / a1;
+        return a1 * std::sqrt(1.0 + t * t);
+    }
+    if (b1 > a1) {
+        t = a1 / b1;
+        return b1 * std::sqrt(1.0 + t * t);
+    }
+    return a1 * std::sqrt(2.0);
+}
+
+static qpdual_t *qpdual_alloc(int n)
+{
+    qpdual_t *qp = new qpdual_struct;
+    qp->n = n;
+    qp->maxiter = 0;
+    qp->J0.assign((size_t) n * n, 0.0);
+    qp->J.resize((size_t) n * n);
+    qp->R.resize((size_t) n * n);
+    qp->d.resize(n);
+    qp->z.resize(n);
+    qp->r.resize(n + 1);
+    qp->u.resize(n + 1);
+    qp->np.resize(n);
+    return qp;
+}
+
+qpdual_t *qpdual_new(int n, const double *Q)
+{
+    int i, j, k;
+    double s;
+    std::vector<double> L((size_t) n * n, 0.0);
+    qpdual_t *qp;
+
+    /* Q = L*L' */
+    for (j = 0; j < n; j++) {
+        s = Q[j + (size_t) j * n];
+        for (k = 0; k < j; k++)
+            s -= L[j + (size_t) k * n] * L[j + (size_t) k * n];
+        if (!(s > 0))
+            return NULL;
+        L[j + (size_t) j * n] = std::sqrt(s);
+        for (i = j + 1; i < n; i++) {
+            s = Q[i + (size_t) j * n];
+            for (k = 0; k < j; k++)
+                s -= L[i + (size_t) k * n] * L[j + (size_t) k * n];
+            L[i + (size_t) j * n] = s / L[j + (size_t) j * n];
+        }
+    }
+
+    /* J0 = inv(L') is upper triangular: solve L'*J0 = I column by column */
+    qp = qpdual_alloc(n);
+    for (j = 0; j < n; j++) {
+        for (i = j; i >= 0; i--) {
+            s = (i == j) ? 1.0 : 0.0;
+            for (k = i + 1; k <= j; k++)
+                s -= L[k + (size_t) i * n] * qp->J0[k + (size_t) j * n];
+            qp->J0[i + (size_t) j * n] = s / L[i + (size_t) i * n];
+        }
+    }
+    return qp;
+}
+
+qpdual_t *qpdual_new_factor(int n, const double *Rinv)
+{
+    qpdual_t *qp = qpdual_alloc(n);
+    for (size_t k = 0; k < (size_t) n * n; k++)
+        qp->J0[k] = Rinv[k];
+    return qp;
+}
+
+void qpdual_free(qpdual_t *qp)
+{
+    delete qp;
+}
+
+void qpdual_set_maxiter(qpdual_t *qp, int maxiter)
+{
+    qp->maxiter = maxiter;
+}
+
+int qpdual_get_active(const qpdual_t *qp, int *aset)
+{
+    if (aset)
+        for (size_t k = 0; k < qp->warm.size(); k++)
+            aset[k] = qp->warm[k];
+    return (int) qp->warm.size();
+}
+
+void qpdual_set_active(qpdual_t *qp, int na, const int *aset)
+{
+    qp->warm.assign(aset, aset + na);
+}
+
+/* d = J'*np */
+static void compute_d(qpdual_t *qp)
+{
+    int n = qp->n, i, j;
+    std::vector<double> &J = qp->J;
+    for (j = 0; j < n; j++) {
+        double s = 0;
+        for (i = 0; i < n; i++)
+            s += JJ(i, j) * qp->np[i];
+        qp->d[j] = s;
+    }
+}
+
+/* z = J(:,iq:n-1)*d(iq:n-1) */
+static void update_z(qpdual_t *qp, int iq)
+{
+    int n = qp->n, i, j;
+    std::vector<double> &J = qp->J;
+    for (i = 0; i < n; i++) {
+        double s = 0;
+        for (j = iq; j < n; j++)
+            s += JJ(i, j) * qp->d[j];
+        qp->z[i] = s;
+    }
+}
+
+/* r = inv(R(0:iq-1,0:iq-1))*d(0:iq-1) */
+static void update_r(qpdual_t *qp, int iq)
+{
+    int n = qp->n, i, j;
+    std::vector<double> &R = qp->R;
+    for (i = iq - 1; i >= 0; i--) {
+        double s = 0;
+        for (j = i + 1; j < iq; j++)
+            s += RR(i, j) * qp->r[j];
+        qp->r[i] = (qp->d[i] - s) / RR(i, i);
+    }
+}
+
+/* Append the constraint with d=J'*np to the factors; false if it is
+   linearly dependent on the active ones */
+static bool add_constraint(qpdual_t *qp, int &iq, double &R_norm)
+{
+    int n = qp->n, j, k;
+    std::vector<double> &J = qp->J, &R = qp->R, &d = qp->d;
+    double cc, ss, h, t1, t2, xny;
+
+    for (j = n - 1; j >= iq + 1; j--) {
+        cc = d[j - 1];
+        ss = d[j];
+        h = hypot2(cc, ss);
+        if (h == 0.0)
+            continue;
+        d[j] = 0.0;
+        ss /= h;
+        cc /= h;
+        if (cc < 0.0) {
+            cc = -cc;
+            ss = -ss;
+            d[j - 1] = -h;
+        }
+        else
+            d[j - 1] = h;
+        xny = ss / (1.0 + cc);
+        for (k = 0; k < n; k++) {
+            t1 = JJ(k, j - 1);
+            t2 = JJ(k, j);
+            JJ(k, j - 1) = t1 * cc + t2 * ss;
+            JJ(k, j) = xny * (t1 + JJ(k, j - 1)) - t2;
+        }
+    }
+    iq++;
+    for (k = 0; k < iq; k++)
+        RR(k, iq - 1) = d[k];
+    if (std::fabs(d[iq - 1]) <= std::numeric_limits<double>::epsilon() * R_norm)
+        return false;
+    R_norm = std::max(R_norm, std::fabs(d[iq - 1]));
+    return true;
+}
+
+/* Drop the constraint at position q of the active set */
+static void delete_constraint(qpdual_t *qp, int &iq, int q)
+{
+    int n = qp->n, i, j, k;
+    std::vector<double> &J = qp->J, &R = qp->R, &u = qp->u;
+    std::vector<int> &act = qp->act;
+    double cc, ss, h, t1, t2, xny;
+
+    for (i = q; i < iq - 1; i++) {
+        act[i] = act[i + 1];
+        u[i] = u[i + 1];
+        for (j = 0; j < n; j++)
+            RR(j, i) = RR(j, i + 1);
+    }
+    act[iq - 1] = act[iq];
+    u[iq - 1] = u[iq];
+    u[iq] = 0.0;
+    for (j = 0; j < iq; j++)
+        RR(j, iq - 1) = 0.0;
+    iq--;
+
+    for (j = q; j < iq; j++) {
+        cc = RR(j, j);
+        ss = RR(j + 1, j);
+        h = hypot2(cc, ss);
+        if (h == 0.0)
+            continue;
+        cc /= h;
+        ss /= h;
+        RR(j + 1, j) = 0.0;
+        if (cc < 0.0) {
+            RR(j, j) = -h;
+            cc = -cc;
+            ss = -ss;
+        }
+        else
+            RR(j, j) = h;
+        xny = ss / (1.0 + cc);
+        for (k = j + 1; k < iq; k++) {
+            t1 = RR(j, k);
+            t2 = RR(j + 1, k);
+            RR(j, k) = t1 * cc + t2 * ss;
+            RR(j + 1, k) = xny * (t1 + RR(j, k)) - t2;
+        }
+        for (k = 0; k < n; k++) {
+            t1 = JJ(k, j);
+            t2 = JJ(k, j + 1);
+            JJ(k, j) = t1 * cc + t2 * ss;
+            JJ(k, j + 1) = xny * (JJ(k, j) + t1) - t2;
+        }
+    }
+}
+
+/* b(c)-A(c,:)*x */
+static double slack(int m, int n, const double *A, const double *b,
+                    const double *x, int c)
+{
+    double v = b[c];
+    for (int j = 0; j < n; j++)
+        v -= A[c + (size_t) j * m] * x[j];
+    return v;
+}
+
+int qpdual_solve(qpdual_t *qp, int m, int meq, const double *A, const double *b,
+                 const double *f, double *x, double *lambda, int *iter)
+{
+    int n = qp->n, i, j, k, iq = 0, neq, p, l, it = 0, status = QPDUAL_OK;
+    int maxiter = qp->maxiter > 0 ? qp->maxiter : 10 * (m + n) + 20;
+    double R_norm = 1.0, t, t1, t2, sp, zn, tol = 1e-9;
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> &J = qp->J, &u = qp->u;
+    std::vector<char> active(m, 0);
+    std::vector<int> warm;
+
+    qp->act.assign(n + 1, -1);
+    J = qp->J0;
+    std::fill(qp->R.begin(), qp->R.end(), 0.0);
+    std::fill(u.begin(), u.end(), 0.0);
+
+    /* warm-start candidates: inequalities of the previous active set */
+    for (k = 0; k < (int) qp->warm.size(); k++)
+        if (qp->warm[k] >= meq && qp->warm[k] < m)
+            warm.push_back(qp->warm[k]);
+
+    /* unconstrained minimum x = -J0*J0'*f */
+    for (j = 0; j < n; j++) {
+        double v = 0;
+        for (i = 0; i < n; i++)
+            v += JJ(i, j) * f[i];
+        qp->d[j] = v;
+    }
+    for (i = 0; i < n; i++) {
+        double v = 0;
+        for (j = 0; j < n; j++)
+            v += JJ(i, j) * qp->d[j];
+        x[i] = -v;
+    }
+
+    /* Equality constraints. A row that depends on the active ones (no
+       component in their null space) is skipped if x satisfies it, the
+       equalities are inconsistent otherwise. */
+    for (p = 0; p < meq && status == QPDUAL_OK; p++) {
+        double nn = 0;
+        for (j = 0; j < n; j++) {
+            qp->np[j] = -A[p + (size_t) j * m];
+            nn += qp->np[j] * qp->np[j];
+        }
+        compute_d(qp);
+        update_z(qp, iq);
+        update_r(qp, iq);
+        zn = 0;
+        for (j = 0; j < n; j++)
+            zn += qp->z[j] * qp->np[j];
+        sp = slack(m, n, A, b, x, p);
+        active[p] = 1;
+        if (zn <= 1e-10 * nn) {
+            if (std::fabs(sp) > tol * (1.0 + std::fabs(b[p])))
+                status = QPDUAL_INFEASIBLE;   /* inconsistent equalities */
+            continue;
+        }
+        t2 = -sp / zn;
+        for (j = 0; j < n; j++)
+            x[j] += t2 * qp->z[j];
+        for (k = 0; k < iq; k++)
+            u[k] -= t2 * qp->r[k];
+        u[iq] = t2;
+        qp->act[iq] = p;
+        if (!add_constraint(qp, iq, R_norm))
+            status = QPDUAL_INFEASIBLE;
+    }
+
+    neq = iq;   /* equalities in the active set, never dropped */
+
+    /* Inequality constraints */
+    while (status == QPDUAL_OK) {
+        /* choose the violated constraint to add: previous active set first,
+           then the most violated one (relative to the row norm) */
+        p = -1;
+        for (k = 0; k < (int) warm.size() && p < 0; k++) {
+            i = warm[k];
+            if (!active[i] && slack(m, n, A, b, x, i) < -tol * (1.0 + std::fabs(b[i])))
+                p = i;
+        }
+        if (p < 0) {
+            double worst = 0;
+            for (i = meq; i < m; i++) {
+                if (active[i])
+                    continue;
+                double nr = 0;
+                for (j = 0; j < n; j++)
+                    nr += A[i + (size_t) j * m] * A[i + (size_t) j * m];
+                sp = slack(m, n, A, b, x, i);
+                if (sp < -tol * (1.0 + std::fabs(b[i])) && sp / std::sqrt(nr) < worst) {
+                    worst = sp / std::sqrt(nr);
+                    p = i;
+                }
+            }
+        }
+        if (p < 0)
+            break;   /* optimal */
+
+        for (j = 0; j < n; j++)
+            qp->np[j] = -A[p + (size_t) j * m];
+        u[iq] = 0.0;
+        qp->act[iq] = p;
+
+        for (;;) {
+            if (++it > maxiter) {
+                status = QPDUAL_MAXITER;
+                break;
+            }
+            compute_d(qp);
+            update_z(qp, iq);
+            update_r(qp, iq);
+
+            /* dual (partial) step length */
+            t1 = inf;
+            l = -1;
+            for (k = neq; k < iq; k++)
+                if (qp->r[k] > 0.0 && u[k] / qp->r[k] < t1) {
+                    t1 = u[k] / qp->r[k];
+                    l = k;
+                }
+            /* primal (full) step length */
+            zn = 0;
+            for (j = 0; j < n; j++)
+                zn += qp->z[j] * qp->np[j];
+            sp = slack(m, n, A, b, x, p);
+            t2 = (std::fabs(zn) > 1e-14 * (1.0 + R_norm)) ? -sp / zn : inf;
+            t = std::min(t1, t2);
+
+            if (t == inf) {
+                status = QPDUAL_INFEASIBLE;
+                break;
+            }
+            if (t2 == inf) {
+                /* step in the dual space only */
+                for (k = 0; k < iq; k++)
+                    u[k] -= t * qp->r[k];
+                u[iq] += t;
+                active[qp->act[l]] = 0;
+                delete_constraint(qp, iq, l);
+                continue;
+            }
+            /* step in primal and dual space */
+            for (j = 0; j < n; j++)
+                x[j] += t * qp->z[j];
+            for (k = 0; k < iq; k++)
+                u[k] -= t * qp->r[k];
+            u[iq] += t;
+            if (t == t2) {
+                /* full step: add constraint p */
+                if (!add_constraint(qp, iq, R_norm))
+                    status = QPDUAL_INFEASIBLE;
+                active[p] = 1;
+                break;
+            }
+            /* partial step: drop constraint l and retry p */
+            active[qp->act[l]] = 0;
+            delete_constraint(qp, iq, l);
+        }
+    }
+
+    if (lambda) {
+        for (i = 0; i < m; i++)
+            lambda[i] = 0.0;
+        for (k = 0; k < iq; k++)
+            lambda[qp->act[k]] = u[k];
+    }
+    if (iter)
+        *iter = it;
+    if (status == QPDUAL_OK)
+        qp->warm.assign(qp->act.begin(), qp->act.begin() + iq);
+    else
+        qp->warm.clear();
+    return status;
+}
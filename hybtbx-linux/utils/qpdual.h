@@ -0,0 +1,73 @@
+/* Dual active-set QP solver (Goldfarb-Idnani) - C API
+
+   Solves
+
+       min  .5*x'*Q*x + f'*x
+       s.t. A(i,:)*x  = b(i),   i=1,...,meq
+            A(i,:)*x <= b(i),   i=meq+1,...,m
+
+   with Q symmetric positive definite. The solver works on the inverse
+   Cholesky factor Rinv=inv(chol(Q)), which is computed once when the
+   solver is created (or supplied by the caller, e.g. from a LINCON
+   object), so that each solve costs no factorization of Q. The QR
+   factors of the active constraints are updated by Givens rotations
+   as constraints enter or leave the active set.
+
+   The solver object remembers the active set of the last solve. The
+   next solve first adds the constraints of that set that are violated
+   (warm start): in receding horizon control the active set changes
+   little between sampling steps, and the solution is usually found
+   after as many iterations as active constraints.
+
+   Matrices are column-major (MATLAB layout). See QPDUALMEX.CPP for the
+   MEX interface and QPDUAL.M for the MATLAB wrapper.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef QPDUAL_H
+#define QPDUAL_H
+
+#define QPDUAL_OK           0
+#define QPDUAL_INFEASIBLE   1
+#define QPDUAL_MAXITER      2
+#define QPDUAL_NOTPOSDEF    3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct qpdual_struct qpdual_t;
+
+/* Create a solver for n variables, factoring Q (n-by-n). Returns NULL if
+   Q is not positive definite. */
+qpdual_t *qpdual_new(int n, const double *Q);
+
+/* Create a solver from the inverse Cholesky factor Rinv=inv(chol(Q))
+   (n-by-n upper triangular) */
+qpdual_t *qpdual_new_factor(int n, const double *Rinv);
+
+/* Solve the QP with m constraints A (m-by-n), b, of which the first meq
+   are equalities. x (n) receives the solution, lambda (m, may be NULL)
+   the multipliers (>=0 for inequalities), iter (may be NULL) the number
+   of iterations. Returns one of the QPDUAL_* codes. */
+int qpdual_solve(qpdual_t *qp, int m, int meq, const double *A, const double *b,
+                 const double *f, double *x, double *lambda, int *iter);
+
+/* Active set of the last solve: returns its size and copies the 0-based
+   constraint indices to aset (if not NULL) */
+int qpdual_get_active(const qpdual_t *qp, int *aset);
+
+/* Replace the warm-start active set (na 0-based constraint indices) */
+void qpdual_set_active(qpdual_t *qp, int na, const int *aset);
+
+/* Maximum number of iterations (0 = automatic) */
+void qpdual_set_maxiter(qpdual_t *qp, int maxiter);
+
+void qpdual_free(qpdual_t *qp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+function [xopt,lambda,how,aset]=qpdual(Q,f,A,b,VLB,VUB,x0,Rinv,display,N,aset0)
+% QPDUAL Solve a strictly convex QP by the dual active-set method of Goldfarb and Idnani
+%
+% [xopt,lambda,how]=QPDUAL(Q,f,A,b,VLB,VUB,x0,Rinv,display,N) solves
+%
+%               min .5*x'Qx+f'x    subject to:   Ax <= b, VLB <= x <= VUB
+%                x                               A(1:N,:)*x == b(1:N)
+%
+% with the same arguments and outputs as QPSOL (x0 is not used, the method
+% starts from the unconstrained minimum). Q must be positive definite.
+%
+% Rinv = inv(chol(Q)) (optional, default: computed from Q). LINCON objects
+% store it in the field Qcholinv, so that no factorization is done online.
+%
+% [xopt,lambda,how,aset]=QPDUAL(...,aset0) also returns the indices of the
+% active constraints at the solution, and tries the constraints aset0 first.
+% If aset0 is not given, the active set of the previous call with the same
+% Hessian is used (warm start): in receding horizon control the active set
+% changes little from one step to the next.
+%
+% QPDUAL uses the MEX function QPDUALMEX (see QPDUAL.CPP and MEXCOMPILE.M).
+% If it is not compiled, QPSOL with the default solver is used instead.
+%
+% See also QPSOL, QPTYPE.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<5,
+    VLB=[];
+end
+if nargin<6,
+    VUB=[];
+end
+if nargin<7,
+    x0=[];
+end
+if nargin<8,
+    Rinv=[];
+end
+if nargin<9 || isempty(display),
+    display=0;
+end
+if nargin<10 || isempty(N),
+    N=0;
+end
+if nargin<11,
+    aset0=[];
+end
+
+n=size(Q,1);
+if isempty(Q),
+    n=size(Rinv,1);
+end
+m=size(A,1);
+if isempty(A),
+    A=zeros(0,n);
+    b=zeros(0,1);
+end
+
+if exist('qpdualmex')~=3,
+    if isempty(Q),
+        R=inv(Rinv);
+        Q=R'*R;
+    end
+    [xopt,lambda,how]=qpsol(Q,f,A,b,VLB,VUB,x0,qptype,[],display,N);
+    aset=find(lambda(1:min(end,m))>0);
+    return
+end
+
+% Append bounds as inequalities
+Ab=A;
+bb=b(:);
+ilb=find(~isinf(VLB(:)));
+iub=find(~isinf(VUB(:)));
+if ~isempty(ilb),
+    I=eye(n);
+    Ab=[Ab;-I(ilb,:)];
+    bb=[bb;-VLB(ilb)];
+end
+if ~isempty(iub),
+    I=eye(n);
+    Ab=[Ab;I(iub,:)];
+    bb=[bb;VUB(iub)];
+end
+
+if isempty(aset0),
+    [xopt,lambda,status,iter,aset]=qpdualmex(Q,f(:),full(Ab),bb,N,[],Rinv);
+else
+    [xopt,lambda,status,iter,aset]=qpdualmex(Q,f(:),full(Ab),bb,N,aset0,Rinv);
+end
+
+switch status
+    case 0
+        how='ok';
+    case 1
+        how='infeasible';
+    case 2
+        how='unreliable';
+    otherwise
+        error('qpdual:notposdef','Q must be positive definite');
+end
+if display>0 && ~strcmp(how,'ok'),
+    fprintf('QPDUAL: problem is %s (%d iterations)\n',how,iter);
+end
@@ -0,0 +1,133 @@
+/* Dual active-set QP solver (Goldfarb-Idnani) - MEX interface
+
+   [x,lambda,status,iter,aset]=qpdualmex(Q,f,A,b,meq,aset0,Rinv)
+
+   Solves min .5*x'*Q*x+f'*x s.t. A(1:meq,:)*x=b(1:meq),
+   A(meq+1:end,:)*x<=b(meq+1:end) by the solver in QPDUAL.CPP.
+
+   Rinv = inv(chol(Q)) (optional). If given, Q is not used and may be [].
+   aset0 = indices of the constraints to try first (warm start). If
+           omitted, the active set of the previous call is used, provided
+           the QP has the same Hessian (or factor) and number of constraints.
+   status = 0 optimal, 1 infeasible, 2 maximum number of iterations
+            reached, 3 Q not positive definite
+   aset  = indices of the active constraints at the solution
+
+   The solver, with the factor of Q, is kept between calls and rebuilt
+   only when the Hessian (or Rinv) changes, so that a sequence of QPs with
+   the same Hessian, such as in receding horizon control, is solved
+   without refactoring Q.
+
+   Compile with MEXCOMPILE.M (or mex -O qpdualmex.cpp qpdual.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "qpdual.h"
+#include <cstring>
+#include <vector>
+
+static qpdual_t *qpdualmex_qp = NULL;
+static std::vector<double> qpdualmex_key;  /* Q or Rinv of qpdualmex_qp */
+static int qpdualmex_isfactor = 0;
+static int qpdualmex_m = -1;
+
+static void qpdualmex_cleanup(void)
+{
+    if (qpdualmex_qp)
+        qpdual_free(qpdualmex_qp);
+    qpdualmex_qp = NULL;
+    qpdualmex_key.clear();
+    qpdualmex_m = -1;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const mxArray *K;
+    const double *key, *f, *A, *b;
+    double *x, *lambda, *a0;
+    std::vector<int> aset;
+    int n, m, meq = 0, isfactor, status, iter = 0, na, k;
+
+    mexAtExit(qpdualmex_cleanup);
+
+    if (nrhs < 4)
+        mexErrMsgTxt("At least four input arguments required.");
+
+    isfactor = (nrhs > 6 && !mxIsEmpty(prhs[6]));
+    K = isfactor ? prhs[6] : prhs[0];
+    n = (int) mxGetM(K);
+    if ((int) mxGetN(K) != n || !mxIsDouble(K) || mxIsSparse(K))
+        mexErrMsgTxt("Q and Rinv must be full square matrices.");
+    if ((int) mxGetNumberOfElements(prhs[1]) != n)
+        mexErrMsgTxt("f has wrong dimension.");
+    m = (int) mxGetM(prhs[2]);
+    if (m > 0 && (int) mxGetN(prhs[2]) != n)
+        mexErrMsgTxt("A has wrong number of columns.");
+    if ((int) mxGetNumberOfElements(prhs[3]) != m)
+        mexErrMsgTxt("b has wrong dimension.");
+    if (m > 0 && mxIsSparse(prhs[2]))
+        mexErrMsgTxt("A must be a full matrix.");
+    if (nrhs > 4 && !mxIsEmpty(prhs[4]))
+        meq = (int) mxGetScalar(prhs[4]);
+    if (meq < 0 || meq > m)
+        mexErrMsgTxt("Wrong number of equality constraints.");
+
+    key = mxGetPr(K);
+    f = mxGetPr(prhs[1]);
+    A = mxGetPr(prhs[2]);
+    b = mxGetPr(prhs[3]);
+
+    /* Reuse the solver (factor and active set) if the Hessian is the same */
+    if (!qpdualmex_qp || isfactor != qpdualmex_isfactor
+        || qpdualmex_key.size() != (size_t) n * n
+        || (n > 0 && memcmp(&qpdualmex_key[0], key, (size_t) n * n * sizeof(double)))) {
+        qpdualmex_cleanup();
+        qpdualmex_qp = isfactor ? qpdual_new_factor(n, key) : qpdual_new(n, key);
+        if (qpdualmex_qp) {
+            qpdualmex_key.assign(key, key + (size_t) n * n);
+            qpdualmex_isfactor = isfactor;
+        }
+    }
+    if (qpdualmex_m != m && qpdualmex_qp)
+        qpdual_set_active(qpdualmex_qp, 0, NULL);
+    qpdualmex_m = m;
+
+    if (nrhs > 5 && !mxIsEmpty(prhs[5]) && qpdualmex_qp) {
+        na = (int) mxGetNumberOfElements(prhs[5]);
+        a0 = mxGetPr(prhs[5]);
+        for (k = 0; k < na; k++)
+            if (a0[k] >= 1 && a0[k] <= m)
+                aset.push_back((int) a0[k] - 1);
+        qpdual_set_active(qpdualmex_qp, (int) aset.size(), aset.empty() ? NULL : &aset[0]);
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(n, 1, mxREAL);
+    x = mxGetPr(plhs[0]);
+    if (nlhs > 1) {
+        plhs[1] = mxCreateDoubleMatrix(m, 1, mxREAL);
+        lambda = mxGetPr(plhs[1]);
+    }
+    else
+        lambda = NULL;
+
+    if (qpdualmex_qp)
+        status = qpdual_solve(qpdualmex_qp, m, meq, A, b, f, x, lambda, &iter);
+    else
+        status = QPDUAL_NOTPOSDEF;
+
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(status);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar(iter);
+    if (nlhs > 4) {
+        na = qpdualmex_qp ? qpdual_get_active(qpdualmex_qp, NULL) : 0;
+        aset.resize(na);
+        if (na > 0)
+            qpdual_get_active(qpdualmex_qp, &aset[0]);
+        plhs[4] = mxCreateDoubleMatrix(na, 1, mxREAL);
+        for (k = 0; k < na; k++)
+            mxGetPr(plhs[4])[k] = aset[k] + 1;
+    }
+}
@@ -15,8 +15,16 @@ function solver=qptype(qpsolver)
 % 'gurobi'    GUROBI
 % 'qpkwik'    New QP solver of MPC Toolbox
 % 'qpkwik2'   New QP solver of MPC Toolbox supporting equality constraints
+% 'qpdual'    Dual active-set solver QPDUAL.M (Goldfarb-Idnani, native MEX),
+%             warm-started from the previous active set. Type 10, solved by
+%             calling QPDUAL (QPSOL is p-code and does not dispatch to it)
+% 'admm'      ADMM solver ADMMQP.M (native MEX), factorization cached
+%             between calls and warm start. Type 11, solved by calling ADMMQP
+% 'anytime'   Primal active-set solver RTQP.M (native MEX) stopped at an
+%             iteration/time budget with a feasible suboptimal solution.
+%             Type 12, solved by calling RTQP
 %
-% See also QPSOL, LPSOL, LPTYPE, MILPSOL, MILPTYPE, MIQPSOL, MIQPTYPE
+% See also QPSOL, QPDUAL, LPSOL, LPTYPE, MILPSOL, MILPTYPE, MIQPSOL, MIQPTYPE
 
 %(C) 2004-2013 by A. Bemporad
 
@@ -66,6 +74,12 @@ switch qpsolver
         solver=99;
     case 'qpnnls'
         solver=98;
+    case 'qpdual'
+        solver=10;
+    case 'admm'
+        solver=11;
+    case 'anytime'
+        solver=12;
     otherwise
         error('unknown QP solver');
 end
@@ -0,0 +1,173 @@
+/* Sparse interior-point solver for linear MPC problems - MEX interface
+
+   [U,X,status,iter]=riccatimex(sp,theta,tol,maxiter)
+
+   Solves the multistage QP of RICCATIQP.H for the parameter vector theta.
+   The structure sp has the fields
+
+     A,B,Q,S,R,Fq,Fr,D,E,d = cell arrays with N+1 elements, element k+1 is
+                             stage k (A,B,S,R,Fr,E of the terminal stage N
+                             must be empty)
+     X0                    = matrix such that x_0=X0*theta
+
+   and the linear cost terms are q_k=Fq{k+1}*theta, r_k=Fr{k+1}*theta (an
+   empty Fq or Fr means zero). Empty D,E,d mean no constraints at stage k.
+
+   U = optimal inputs u_0,...,u_{N-1} stacked in a column vector
+   X = optimal states x_0,...,x_N stacked in a column vector
+   status = 0 optimal, 1 infeasible, 2 maximum number of iterations
+            reached, 3 numerical error (Hessian not positive definite)
+
+   tol = tolerance on the KKT residuals (default: 1e-11)
+   maxiter = maximum number of iterations (default: 100)
+
+   Compile with MEXCOMPILE.M (or mex -O riccatimex.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "riccatiqp.h"
+#include <cstring>
+
+static const mxArray *get_cell(const mxArray *sp, const char *name, int N)
+{
+    const mxArray *c = mxGetField(sp, 0, name);
+    if (!c || !mxIsCell(c) || (int) mxGetNumberOfElements(c) != N + 1)
+        mexErrMsgIdAndTxt("riccatimex:sp", "Field %s must be a cell array with N+1 elements.", name);
+    return c;
+}
+
+/* Copy the k-th matrix of cell c, checking its size */
+static void get_mat(const mxArray *c, int k, const char *name, int m, int n,
+                    std::vector<double> &v)
+{
+    const mxArray *M = mxGetCell(c, k);
+    size_t len = (size_t) m * n;
+    v.assign(len, 0.0);
+    if (!M || mxIsEmpty(M)) {
+        if (len > 0 && strcmp(name, "Fq") && strcmp(name, "Fr"))
+            mexErrMsgIdAndTxt("riccatimex:sp", "%s{%d} is empty.", name, k + 1);
+        return;
+    }
+    if ((int) mxGetM(M) != m || (int) mxGetN(M) != n || !mxIsDouble(M) || mxIsSparse(M))
+        mexErrMsgIdAndTxt("riccatimex:sp", "%s{%d} must be a full %d-by-%d matrix.", name, k + 1, m, n);
+    memcpy(&v[0], mxGetPr(M), len * sizeof(double));
+}
+
+static int cell_rows(const mxArray *c, int k)
+{
+    const mxArray *M = mxGetCell(c, k);
+    return M ? (int) mxGetM(M) : 0;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const mxArray *sp, *cA, *cB, *cQ, *cS, *cR, *cFq, *cFr, *cD, *cE, *cd, *X0;
+    const double *theta;
+    int N, k, i, npar, status, nU = 0, nX = 0;
+    std::vector<double> F, x0;
+    RiccatiQP qp;
+
+    if (nrhs < 2)
+        mexErrMsgTxt("At least two input arguments required.");
+    sp = prhs[0];
+    if (!mxIsStruct(sp))
+        mexErrMsgTxt("First argument must be a structure.");
+    cQ = mxGetField(sp, 0, "Q");
+    if (!cQ || !mxIsCell(cQ) || mxGetNumberOfElements(cQ) < 1)
+        mexErrMsgTxt("Field Q must be a nonempty cell array.");
+    N = (int) mxGetNumberOfElements(cQ) - 1;
+    cA = get_cell(sp, "A", N);
+    cB = get_cell(sp, "B", N);
+    cS = get_cell(sp, "S", N);
+    cR = get_cell(sp, "R", N);
+    cFq = get_cell(sp, "Fq", N);
+    cFr = get_cell(sp, "Fr", N);
+    cD = get_cell(sp, "D", N);
+    cE = get_cell(sp, "E", N);
+    cd = get_cell(sp, "d", N);
+    X0 = mxGetField(sp, 0, "X0");
+    if (!X0)
+        mexErrMsgTxt("Field X0 missing.");
+
+    npar = (int) mxGetNumberOfElements(prhs[1]);
+    theta = mxGetPr(prhs[1]);
+    if ((int) mxGetN(X0) != npar)
+        mexErrMsgTxt("X0 and theta have incompatible dimensions.");
+    if (nrhs > 2 && !mxIsEmpty(prhs[2]))
+        qp.tol = mxGetScalar(prhs[2]);
+    if (nrhs > 3 && !mxIsEmpty(prhs[3]))
+        qp.maxiter = (int) mxGetScalar(prhs[3]);
+
+    qp.stage.resize(N + 1);
+    for (k = 0; k <= N; k++) {
+        RiccatiStage &s = qp.stage[k];
+        s.nx = cell_rows(cQ, k);
+        s.nu = (k < N) ? cell_rows(cR, k) : 0;
+        s.nx1 = (k < N) ? cell_rows(cA, k) : 0;
+        s.m = cell_rows(cd, k);
+        if (k > 0 && s.nx != qp.stage[k - 1].nx1)
+            mexErrMsgIdAndTxt("riccatimex:sp", "Q{%d} and A{%d} have incompatible dimensions.", k + 1, k);
+        get_mat(cQ, k, "Q", s.nx, s.nx, s.Q);
+        if (k < N) {
+            get_mat(cA, k, "A", s.nx1, s.nx, s.A);
+            if (s.nu > 0) {
+                get_mat(cB, k, "B", s.nx1, s.nu, s.B);
+                get_mat(cS, k, "S", s.nu, s.nx, s.S);
+                get_mat(cR, k, "R", s.nu, s.nu, s.R);
+            }
+        }
+        if (s.m > 0) {
+            get_mat(cD, k, "D", s.m, s.nx, s.D);
+            if (s.nu > 0)
+                get_mat(cE, k, "E", s.m, s.nu, s.E);
+            get_mat(cd, k, "d", s.m, 1, s.d);
+        }
+        /* parametric linear terms */
+        s.q.assign(s.nx, 0.0);
+        s.r.assign(s.nu, 0.0);
+        if (cell_rows(cFq, k) > 0) {
+            get_mat(cFq, k, "Fq", s.nx, npar, F);
+            for (int j = 0; j < npar; j++)
+                for (i = 0; i < s.nx; i++)
+                    s.q[i] += F[i + (size_t) j * s.nx] * theta[j];
+        }
+        if (s.nu > 0 && cell_rows(cFr, k) > 0) {
+            get_mat(cFr, k, "Fr", s.nu, npar, F);
+            for (int j = 0; j < npar; j++)
+                for (i = 0; i < s.nu; i++)
+                    s.r[i] += F[i + (size_t) j * s.nu] * theta[j];
+        }
+        nU += s.nu;
+        nX += s.nx;
+    }
+    if ((int) mxGetM(X0) != qp.stage[0].nx)
+        mexErrMsgTxt("X0 has wrong number of rows.");
+    x0.assign(qp.stage[0].nx, 0.0);
+    for (int j = 0; j < npar; j++)
+        for (i = 0; i < qp.stage[0].nx; i++)
+            x0[i] += mxGetPr(X0)[i + (size_t) j * qp.stage[0].nx] * theta[j];
+
+    status = qp.solve(x0.empty() ? NULL : &x0[0]);
+
+    plhs[0] = mxCreateDoubleMatrix(nU, 1, mxREAL);
+    if (nlhs > 1)
+        plhs[1] = mxCreateDoubleMatrix(nX, 1, mxREAL);
+    if (status != RICCATIQP_NOTPOSDEF) {
+        double *U = mxGetPr(plhs[0]);
+        for (k = 0; k < N; k++)
+            for (i = 0; i < qp.stage[k].nu; i++)
+                *U++ = qp.u[k][i];
+        if (nlhs > 1) {
+            double *X = mxGetPr(plhs[1]);
+            for (k = 0; k <= N; k++)
+                for (i = 0; i < qp.stage[k].nx; i++)
+                    *X++ = qp.x[k][i];
+        }
+    }
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(status);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar(qp.iter);
+}
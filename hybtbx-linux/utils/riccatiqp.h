@@ -0,0 +1,578 @@
+/* Sparse interior-point solver for linear MPC problems - C++ header
+
+   Solves the multistage QP
+
+       min  sum_{k=0}^{N-1} .5*[x_k;u_k]'*[Q_k S_k';S_k R_k]*[x_k;u_k] + q_k'*x_k + r_k'*u_k
+            + .5*x_N'*Q_N*x_N + q_N'*x_N
+
+       s.t. x_{k+1} = A_k*x_k + B_k*u_k,           k=0,...,N-1
+            D_k*x_k + E_k*u_k <= d_k,              k=0,...,N
+            x_0 given
+
+   without eliminating the states, by a primal-dual interior-point method
+   with Mehrotra's predictor-corrector. The Newton system of each iteration
+   is an unconstrained LQ problem in the steps, which is solved by a block
+   Riccati recursion: the cost per iteration is O(N*(nx+nu)^3) instead of
+   O((N*nu)^3) for the condensed QP. The factorization of the recursion is
+   shared by the predictor and the corrector step.
+
+   The number of states nx_k and inputs nu_k may change along the horizon
+   (e.g. nu_k=0 after the control horizon, or a slack variable that is an
+   input at k=0 and a state for k>=1).
+
+   Matrices are column-major (MATLAB layout). See RICCATIMEX.CPP for the
+   MEX interface.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef RICCATIQP_H
+#define RICCATIQP_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#define RICCATIQP_OPTIMAL     0
+#define RICCATIQP_INFEASIBLE  1
+#define RICCATIQP_MAXITER     2
+#define RICCATIQP_NOTPOSDEF   3
+
+/* Data of stage k. A,B map (x_k,u_k) to x_{k+1}, which has nx1 components
+   (nx1=0 for the terminal stage). D,E,d are the m constraints of the stage. */
+struct RiccatiStage {
+    int nx, nu, nx1, m;
+    std::vector<double> A, B;           /* nx1-by-nx, nx1-by-nu */
+    std::vector<double> Q, S, R;        /* nx-by-nx, nu-by-nx, nu-by-nu */
+    std::vector<double> q, r;           /* nx, nu */
+    std::vector<double> D, E, d;        /* m-by-nx, m-by-nu, m */
+
+    RiccatiStage() : nx(0), nu(0), nx1(0), m(0) {}
+};
+
+class RiccatiQP {
+public:
+    double tol;      /* tolerance on residuals and duality gap */
+    int maxiter;
+
+    std::vector<RiccatiStage> stage;     /* N+1 stages, last one terminal */
+
+    /* Solution */
+    std::vector<std::vector<double> > x, u;
+    int iter;
+
+    RiccatiQP() : tol(1e-11), maxiter(100), iter(0) {}
+
+    int horizon() const { return (int) stage.size() - 1; }
+
+    /* Solve with initial state x0 (stage[0].nx components) */
+    int solve(const double *x0)
+    {
+        int N = horizon(), k, i, status = RICCATIQP_MAXITER;
+        int mtot = 0;
+        double mu, mu_aff, sigma, alpha, alpha_aff, scale = 1.0;
+
+        alloc();
+        for (k = 0; k <= N; k++) {
+            const RiccatiStage &s = stage[k];
+            mtot += s.m;
+            for (i = 0; i < s.nx; i++)
+                scale = std::max(scale, std::fabs(s.q[i]));
+            for (i = 0; i < s.nu; i++)
+                scale = std::max(scale, std::fabs(s.r[i]));
+        }
+
+        /* initial point: u=0, x from the dynamics, s>=1, z=1 */
+        for (i = 0; i < stage[0].nx; i++)
+            x[0][i] = x0[i];
+        for (k = 0; k <= N; k++) {
+            std::fill(u[k].begin(), u[k].end(), 0.0);
+            std::fill(lam[k].begin(), lam[k].end(), 0.0);
+            if (k < N)
+                matvec(stage[k].A, stage[k].nx1, stage[k].nx, &x[k][0], &x[k + 1][0], false);
+        }
+        for (k = 0; k <= N; k++) {
+            const RiccatiStage &s = stage[k];
+            constraint_values(k, &cs[k][0]);
+            for (i = 0; i < s.m; i++) {
+                sl[k][i] = std::max(s.d[i] - cs[k][i], 1.0);
+                zl[k][i] = 1.0;
+            }
+        }
+
+        for (iter = 0; iter < maxiter; iter++) {
+            double rd, rp;
+            residuals(rd, rp);
+            mu = 0;
+            for (k = 0; k <= N; k++)
+                for (i = 0; i < stage[k].m; i++)
+                    mu += sl[k][i] * zl[k][i];
+            mu = (mtot > 0) ? mu / mtot : 0.0;
+            if (rd <= tol * scale && rp <= tol * (1.0 + dscale) && mu <= tol) {
+                status = RICCATIQP_OPTIMAL;
+                break;
+            }
+            if (mtot > 0 && zmax() > 1e12 * (1.0 + scale)) {
+                status = RICCATIQP_INFEASIBLE;
+                break;
+            }
+
+            if (!factor()) {
+                /* roundoff with huge z./s: accept a nearly optimal point */
+                if (rd <= 1e-6 * scale && rp <= 1e-6 * (1.0 + dscale) && mu <= 1e-6)
+                    status = RICCATIQP_OPTIMAL;
+                else
+                    status = RICCATIQP_NOTPOSDEF;
+                break;
+            }
+
+            /* predictor (affine scaling) step */
+            for (k = 0; k <= N; k++)
+                for (i = 0; i < stage[k].m; i++)
+                    rc[k][i] = sl[k][i] * zl[k][i];
+            step();
+            alpha_aff = max_step();
+            if (mtot > 0) {
+                mu_aff = 0;
+                for (k = 0; k <= N; k++)
+                    for (i = 0; i < stage[k].m; i++)
+                        mu_aff += (sl[k][i] + alpha_aff * dsl[k][i]) * (zl[k][i] + alpha_aff * dzl[k][i]);
+                mu_aff /= mtot;
+                sigma = mu_aff / mu;
+                sigma = sigma * sigma * sigma;
+
+                /* corrector step */
+                for (k = 0; k <= N; k++)
+                    for (i = 0; i < stage[k].m; i++)
+                        rc[k][i] = sl[k][i] * zl[k][i] + dsl[k][i] * dzl[k][i] - sigma * mu;
+                step();
+                alpha = std::min(1.0, 0.995 * max_step());
+            }
+            else
+                alpha = 1.0;
+
+            for (k = 0; k <= N; k++) {
+                const RiccatiStage &s = stage[k];
+                for (i = 0; i < s.nx; i++)
+                    x[k][i] += alpha * dx[k][i];
+                for (i = 0; i < s.nu; i++)
+                    u[k][i] += alpha * du[k][i];
+                for (i = 0; i < s.nx1; i++)
+                    lam[k][i] += alpha * dlam[k][i];
+                for (i = 0; i < s.m; i++) {
+                    sl[k][i] += alpha * dsl[k][i];
+                    zl[k][i] += alpha * dzl[k][i];
+                }
+            }
+        }
+        return status;
+    }
+
+private:
+    /* lam[k] = multipliers of the dynamics x_{k+1}=A_k*x_k+B_k*u_k */
+    std::vector<std::vector<double> > lam, sl, zl, cs, rc;
+    std::vector<std::vector<double> > rdx, rdu, req, rin;
+    std::vector<std::vector<double> > dx, du, dlam, dsl, dzl;
+    /* Riccati factors */
+    std::vector<std::vector<double> > P, Lre, K, kk, p, gx, gu;
+    std::vector<double> t1, t2, Qt, St, Rt, BP, AP;
+    double dscale;
+
+    static std::vector<double> &fit(std::vector<double> &v, size_t n)
+    {
+        v.resize(n);
+        return v;
+    }
+
+    void alloc()
+    {
+        int N = horizon(), k;
+        std::vector<std::vector<double> > *vx[] = {&x, &rdx, &dx, &gx, &p};
+        std::vector<std::vector<double> > *vu[] = {&u, &rdu, &du, &gu, &kk};
+        std::vector<std::vector<double> > *vm[] = {&sl, &zl, &cs, &rc, &rin, &dsl, &dzl};
+        size_t j;
+
+        for (j = 0; j < sizeof(vx) / sizeof(vx[0]); j++)
+            vx[j]->resize(N + 1);
+        for (j = 0; j < sizeof(vu) / sizeof(vu[0]); j++)
+            vu[j]->resize(N + 1);
+        for (j = 0; j < sizeof(vm) / sizeof(vm[0]); j++)
+            vm[j]->resize(N + 1);
+        lam.resize(N + 1);
+        req.resize(N + 1);
+        dlam.resize(N + 1);
+        P.resize(N + 1);
+        Lre.resize(N + 1);
+        K.resize(N + 1);
+        dscale = 0;
+        for (k = 0; k <= N; k++) {
+            const RiccatiStage &s = stage[k];
+            for (j = 0; j < sizeof(vx) / sizeof(vx[0]); j++)
+                fit((*vx[j])[k], s.nx);
+            for (j = 0; j < sizeof(vu) / sizeof(vu[0]); j++)
+                fit((*vu[j])[k], s.nu);
+            for (j = 0; j < sizeof(vm) / sizeof(vm[0]); j++)
+                fit((*vm[j])[k], s.m);
+            fit(lam[k], s.nx1);
+            fit(req[k], s.nx1);
+            fit(dlam[k], s.nx1);
+            fit(P[k], (size_t) s.nx * s.nx);
+            fit(Lre[k], (size_t) s.nu * s.nu);
+            fit(K[k], (size_t) s.nu * s.nx);
+            for (int i = 0; i < s.m; i++)
+                dscale = std::max(dscale, std::fabs(s.d[i]));
+        }
+    }
+
+    /* y = M*v (M is m-by-n), or y += M*v */
+    static void matvec(const std::vector<double> &M, int m, int n, const double *v,
+                       double *y, bool acc)
+    {
+        int i, j;
+        if (!acc)
+            for (i = 0; i < m; i++)
+                y[i] = 0.0;
+        for (j = 0; j < n; j++) {
+            double vj = v[j];
+            if (vj == 0.0)
+                continue;
+            const double *c = &M[0] + (size_t) j * m;
+            for (i = 0; i < m; i++)
+                y[i] += c[i] * vj;
+        }
+    }
+
+    /* y += M'*v (M is m-by-n) */
+    static void matvec_t(const std::vector<double> &M, int m, int n, const double *v, double *y)
+    {
+        for (int j = 0; j < n; j++) {
+            const double *c = &M[0] + (size_t) j * m;
+            double t = 0;
+            for (int i = 0; i < m; i++)
+                t += c[i] * v[i];
+            y[j] += t;
+        }
+    }
+
+    /* C = A'*B with A m-by-n, B m-by-p, C n-by-p; C += if acc */
+    static void mat_tmul(const double *A, int m, int n, const double *B, int p,
+                         double *C, bool acc)
+    {
+        for (int j = 0; j < p; j++)
+            for (int i = 0; i < n; i++) {
+                double t = acc ? C[i + (size_t) j * n] : 0.0;
+                const double *a = A + (size_t) i * m, *b = B + (size_t) j * m;
+                for (int l = 0; l < m; l++)
+                    t += a[l] * b[l];
+                C[i + (size_t) j * n] = t;
+            }
+    }
+
+    /* C += A*B with A m-by-n, B n-by-p */
+    static void mat_mul_acc(const double *A, int m, int n, const double *B, int p, double *C)
+    {
+        for (int j = 0; j < p; j++)
+            for (int l = 0; l < n; l++) {
+                double b = B[l + (size_t) j * n];
+                if (b == 0.0)
+                    continue;
+                const double *a = A + (size_t) l * m;
+                double *c = C + (size_t) j * m;
+                for (int i = 0; i < m; i++)
+                    c[i] += a[i] * b;
+            }
+    }
+
+    double zmax() const
+    {
+        double v = 0;
+        for (size_t k = 0; k < zl.size(); k++)
+            for (size_t i = 0; i < zl[k].size(); i++)
+                v = std::max(v, zl[k][i]);
+        return v;
+    }
+
+    void constraint_values(int k, double *c) const
+    {
+        const RiccatiStage &s = stage[k];
+        if (s.m == 0)
+            return;
+        matvec(s.D, s.m, s.nx, &x[k][0], c, false);
+        if (s.nu > 0)
+            matvec(s.E, s.m, s.nu, &u[k][0], c, true);
+    }
+
+    /* Residuals of the KKT conditions; rd, rp = their inf-norms */
+    void residuals(double &rd, double &rp)
+    {
+        int N = horizon(), k, i;
+        rd = rp = 0;
+        for (k = 0; k <= N; k++) {
+            const RiccatiStage &s = stage[k];
+            std::vector<double> &ax = rdx[k], &au = rdu[k];
+            /* stationarity */
+            for (i = 0; i < s.nx; i++)
+                ax[i] = s.q[i];
+            for (i = 0; i < s.nu; i++)
+                au[i] = s.r[i];
+            matvec(s.Q, s.nx, s.nx, &x[k][0], &ax[0], true);
+            if (s.nu > 0) {
+                matvec_t(s.S, s.nu, s.nx, &u[k][0], &ax[0]);
+                matvec(s.S, s.nu, s.nx, &x[k][0], &au[0], true);
+                matvec(s.R, s.nu, s.nu, &u[k][0], &au[0], true);
+            }
+            if (s.nx1 > 0) {
+                matvec_t(s.A, s.nx1, s.nx, &lam[k][0], &ax[0]);
+                if (s.nu > 0)
+                    matvec_t(s.B, s.nx1, s.nu, &lam[k][0], &au[0]);
+            }
+            if (k > 0)
+                for (i = 0; i < s.nx; i++)
+                    ax[i] -= lam[k - 1][i];
+            if (s.m > 0) {
+                matvec_t(s.D, s.m, s.nx, &zl[k][0], &ax[0]);
+                if (s.nu > 0)
+                    matvec_t(s.E, s.m, s.nu, &zl[k][0], &au[0]);
+            }
+            if (k > 0)   /* x_0 is fixed */
+                for (i = 0; i < s.nx; i++)
+                    rd = std::max(rd, std::fabs(ax[i]));
+            for (i = 0; i < s.nu; i++)
+                rd = std::max(rd, std::fabs(au[i]));
+
+            /* dynamics */
+            if (s.nx1 > 0) {
+                matvec(s.A, s.nx1, s.nx, &x[k][0], &req[k][0], false);
+                if (s.nu > 0)
+                    matvec(s.B, s.nx1, s.nu, &u[k][0], &req[k][0], true);
+                for (i = 0; i < s.nx1; i++) {
+                    req[k][i] -= x[k + 1][i];
+                    rp = std::max(rp, std::fabs(req[k][i]));
+                }
+            }
+
+            /* inequalities */
+            constraint_values(k, &cs[k][0]);
+            for (i = 0; i < s.m; i++) {
+                rin[k][i] = cs[k][i] + sl[k][i] - s.d[i];
+                rp = std::max(rp, std::fabs(rin[k][i]));
+            }
+        }
+    }
+
+    /* Cholesky factorization of the n-by-n matrix M (lower triangle) */
+    static bool chol(double *M, int n)
+    {
+        for (int j = 0; j < n; j++) {
+            double s = M[j + (size_t) j * n];
+            for (int l = 0; l < j; l++)
+                s -= M[j + (size_t) l * n] * M[j + (size_t) l * n];
+            if (!(s > 0))
+                return false;
+            s = std::sqrt(s);
+            M[j + (size_t) j * n] = s;
+            for (int i = j + 1; i < n; i++) {
+                double t = M[i + (size_t) j * n];
+                for (int l = 0; l < j; l++)
+                    t -= M[i + (size_t) l * n] * M[j + (size_t) l * n];
+                M[i + (size_t) j * n] = t / s;
+            }
+        }
+        return true;
+    }
+
+    /* solve L*L'*v = b in place */
+    static void cholsolve(const double *L, int n, double *v)
+    {
+        int i, l;
+        for (i = 0; i < n; i++) {
+            double t = v[i];
+            for (l = 0; l < i; l++)
+                t -= L[i + (size_t) l * n] * v[l];
+            v[i] = t / L[i + (size_t) i * n];
+        }
+        for (i = n - 1; i >= 0; i--) {
+            double t = v[i];
+            for (l = i + 1; l < n; l++)
+                t -= L[l + (size_t) i * n] * v[l];
+            v[i] = t / L[i + (size_t) i * n];
+        }
+    }
+
+    /* Backward Riccati recursion on the Hessian Q,S,R + G'*diag(z./s)*G */
+    bool factor()
+    {
+        int N = horizon(), k, i, j, l;
+
+        for (k = N; k >= 0; k--) {
+            const RiccatiStage &s = stage[k];
+            int nx = s.nx, nu = s.nu, nx1 = s.nx1;
+
+            Qt = s.Q;
+            fit(St, (size_t) nu * nx);
+            for (i = 0; i < nu * nx; i++)
+                St[i] = s.S[i];
+            fit(Rt, (size_t) nu * nu);
+            for (i = 0; i < nu * nu; i++)
+                Rt[i] = s.R[i];
+            for (l = 0; l < s.m; l++) {
+                double w = zl[k][l] / sl[k][l];
+                for (j = 0; j < nx; j++) {
+                    double dj = w * s.D[l + (size_t) j * s.m];
+                    if (dj == 0.0)
+                        continue;
+                    for (i = 0; i < nx; i++)
+                        Qt[i + (size_t) j * nx] += s.D[l + (size_t) i * s.m] * dj;
+                    for (i = 0; i < nu; i++)
+                        St[i + (size_t) j * nu] += s.E[l + (size_t) i * s.m] * dj;
+                }
+                for (j = 0; j < nu; j++) {
+                    double ej = w * s.E[l + (size_t) j * s.m];
+                    if (ej == 0.0)
+                        continue;
+                    for (i = 0; i < nu; i++)
+                        Rt[i + (size_t) j * nu] += s.E[l + (size_t) i * s.m] * ej;
+                }
+            }
+
+            if (nx1 > 0) {
+                const std::vector<double> &Pn = P[k + 1];
+                /* BP = B'*P, AP = A'*P */
+                fit(BP, (size_t) nu * nx1);
+                fit(AP, (size_t) nx * nx1);
+                if (nu > 0)
+                    mat_tmul(&s.B[0], nx1, nu, &Pn[0], nx1, &BP[0], false);
+                mat_tmul(&s.A[0], nx1, nx, &Pn[0], nx1, &AP[0], false);
+                /* Rt += BP*B, St += BP*A, Qt += AP*A */
+                if (nu > 0) {
+                    mat_mul_acc(&BP[0], nu, nx1, &s.B[0], nu, &Rt[0]);
+                    mat_mul_acc(&BP[0], nu, nx1, &s.A[0], nx, &St[0]);
+                }
+                mat_mul_acc(&AP[0], nx, nx1, &s.A[0], nx, &Qt[0]);
+            }
+
+            /* K = -inv(Rt)*St, P = Qt + St'*K */
+            Lre[k] = Rt;
+            if (nu > 0 && !chol(&Lre[k][0], nu)) {
+                /* loss of definiteness by roundoff close to the solution,
+                   where z./s is very large: regularize the diagonal */
+                double dmax = 0, delta;
+                for (i = 0; i < nu; i++)
+                    dmax = std::max(dmax, std::fabs(Rt[i + (size_t) i * nu]));
+                for (delta = 1e-12 * (1.0 + dmax);; delta *= 100.0) {
+                    if (delta > 1e-2 * (1.0 + dmax))
+                        return false;
+                    Lre[k] = Rt;
+                    for (i = 0; i < nu; i++)
+                        Lre[k][i + (size_t) i * nu] += delta;
+                    if (chol(&Lre[k][0], nu))
+                        break;
+                }
+            }
+            for (j = 0; j < nx; j++) {
+                double *c = &K[k][0] + (size_t) j * nu;
+                for (i = 0; i < nu; i++)
+                    c[i] = -St[i + (size_t) j * nu];
+                if (nu > 0)
+                    cholsolve(&Lre[k][0], nu, c);
+            }
+            P[k] = Qt;
+            if (nu > 0)
+                mat_tmul(&St[0], nu, nx, &K[k][0], nx, &P[k][0], true);
+            for (j = 0; j < nx; j++)
+                for (i = 0; i < j; i++) {
+                    double v = .5 * (P[k][i + (size_t) j * nx] + P[k][j + (size_t) i * nx]);
+                    P[k][i + (size_t) j * nx] = P[k][j + (size_t) i * nx] = v;
+                }
+        }
+        return true;
+    }
+
+    /* Newton step for the complementarity residual rc */
+    void step()
+    {
+        int N = horizon(), k, i;
+
+        /* gradients of the LQ problem in the steps */
+        for (k = 0; k <= N; k++) {
+            const RiccatiStage &s = stage[k];
+            gx[k] = rdx[k];
+            gu[k] = rdu[k];
+            if (s.m > 0) {
+                std::vector<double> &w = fit(t1, s.m);
+                for (i = 0; i < s.m; i++)
+                    w[i] = (zl[k][i] * rin[k][i] - rc[k][i]) / sl[k][i];
+                matvec_t(s.D, s.m, s.nx, &w[0], &gx[k][0]);
+                if (s.nu > 0)
+                    matvec_t(s.E, s.m, s.nu, &w[0], &gu[k][0]);
+            }
+        }
+
+        /* backward pass */
+        for (k = N; k >= 0; k--) {
+            const RiccatiStage &s = stage[k];
+            std::vector<double> &re = kk[k];
+            re = gu[k];
+            p[k] = gx[k];
+            if (s.nx1 > 0) {
+                std::vector<double> &t = fit(t2, s.nx1);
+                matvec(P[k + 1], s.nx1, s.nx1, &req[k][0], &t[0], false);
+                for (i = 0; i < s.nx1; i++)
+                    t[i] += p[k + 1][i];
+                if (s.nu > 0)
+                    matvec_t(s.B, s.nx1, s.nu, &t[0], &re[0]);
+                matvec_t(s.A, s.nx1, s.nx, &t[0], &p[k][0]);
+            }
+            /* p += K'*re, kk = -inv(Re)*re */
+            if (s.nu > 0) {
+                matvec_t(K[k], s.nu, s.nx, &re[0], &p[k][0]);
+                cholsolve(&Lre[k][0], s.nu, &re[0]);
+                for (i = 0; i < s.nu; i++)
+                    re[i] = -re[i];
+            }
+        }
+
+        /* forward pass */
+        std::fill(dx[0].begin(), dx[0].end(), 0.0);
+        for (k = 0; k <= N; k++) {
+            const RiccatiStage &s = stage[k];
+            du[k] = kk[k];
+            if (s.nu > 0)
+                matvec(K[k], s.nu, s.nx, &dx[k][0], &du[k][0], true);
+            if (s.nx1 > 0) {
+                dx[k + 1] = req[k];
+                matvec(s.A, s.nx1, s.nx, &dx[k][0], &dx[k + 1][0], true);
+                if (s.nu > 0)
+                    matvec(s.B, s.nx1, s.nu, &du[k][0], &dx[k + 1][0], true);
+                dlam[k] = p[k + 1];
+                matvec(P[k + 1], s.nx1, s.nx1, &dx[k + 1][0], &dlam[k][0], true);
+            }
+            /* slacks and multipliers */
+            if (s.m > 0) {
+                matvec(s.D, s.m, s.nx, &dx[k][0], &dsl[k][0], false);
+                if (s.nu > 0)
+                    matvec(s.E, s.m, s.nu, &du[k][0], &dsl[k][0], true);
+                for (i = 0; i < s.m; i++) {
+                    dsl[k][i] = -rin[k][i] - dsl[k][i];
+                    dzl[k][i] = (-rc[k][i] - zl[k][i] * dsl[k][i]) / sl[k][i];
+                }
+            }
+        }
+    }
+
+    /* largest step in [0,1] keeping s,z nonnegative */
+    double max_step() const
+    {
+        double a = 1.0;
+        for (size_t k = 0; k < sl.size(); k++)
+            for (size_t i = 0; i < sl[k].size(); i++) {
+                if (dsl[k][i] < 0)
+                    a = std::min(a, -sl[k][i] / dsl[k][i]);
+                if (dzl[k][i] < 0)
+                    a = std::min(a, -zl[k][i] / dzl[k][i]);
+            }
+        return a;
+    }
+};
+
+#endif
@@ -0,0 +1,448 @@
+/* Anytime QP solver with iteration/time budget - implementation
+
+   See RTQP.H for the API.
+
+   The problem is solved in the variables z=[x;t], with cost
+   .5*x'*H*x+f'*x+.5*h*t^2+rho*t (h = average diagonal element of H) and
+   constraints G*x-t <= w, -t <= 0. With H=L*L' and Z = [G -1;0 -1]*inv(La')
+   (La = chol of the Hessian in z), the equality-constrained step on the
+   working set W is
+
+       v = inv(La)*g,   lambda = -inv(Z_W*Z_W')*Z_W*v,   p = -inv(La')*(v+Z_W'*lambda)
+
+   where g is the gradient. The Cholesky factor of Z_W*Z_W' is extended
+   when a constraint enters W and recomputed when one leaves it.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "rtqp.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+
+#define RTQP_ITERCAP 10              /* default maxiter = RTQP_ITERCAP*(n+m+1) */
+
+struct rtqp_struct {
+    int n, m;
+    rtqp_settings set;
+    std::vector<double> H, G, L;     /* L = chol(H), lower */
+    double st;                       /* sqrt(h) */
+    std::vector<double> Z;           /* rows of Z, (m+1)-by-(n+1), row-major */
+    std::vector<int> brow, bvar;     /* rows of G with a single nonzero (bounds) */
+    std::vector<int> W;              /* working set */
+    std::vector<char> inW;
+    std::vector<char> skip;          /* dependent on W, out of the ratio test */
+    std::vector<double> R;           /* chol(Z_W*Z_W'), lower, leading dimension n+1 */
+    std::vector<double> z, s, v, u, p, Gp, lam, xbest, tmp;
+};
+
+typedef std::chrono::steady_clock rtqp_clock;
+
+void rtqp_default_settings(rtqp_settings *s)
+{
+    s->maxiter = 0;
+    s->maxtime = 0;
+    s->penalty = 1e6;
+    s->tol = 1e-9;
+}
+
+/* Solve L*y = b in place, L n-by-n lower, column-major */
+static void lsolve(const std::vector<double> &L, int n, double *b)
+{
+    for (int j = 0; j < n; j++) {
+        b[j] /= L[j + (size_t) j * n];
+        double bj = b[j];
+        for (int i = j + 1; i < n; i++)
+            b[i] -= L[i + (size_t) j * n] * bj;
+    }
+}
+
+/* Solve L'*y = b in place */
+static void ltsolve(const std::vector<double> &L, int n, double *b)
+{
+    for (int j = n - 1; j >= 0; j--) {
+        double t = b[j];
+        for (int i = j + 1; i < n; i++)
+            t -= L[i + (size_t) j * n] * b[i];
+        b[j] = t / L[j + (size_t) j * n];
+    }
+}
+
+static double dot(const double *a, const double *b, int n)
+{
+    double t = 0;
+    for (int i = 0; i < n; i++)
+        t += a[i] * b[i];
+    return t;
+}
+
+/* Append row i of Z to the Cholesky factor of Z_W*Z_W' */
+static bool add_row(rtqp_t *qp, int i)
+{
+    int n1 = qp->n + 1, k = (int) qp->W.size(), j;
+    const double *zi = &qp->Z[(size_t) i * n1];
+    double *y = &qp->tmp[0], d;
+
+    if (k >= n1)
+        return false;                 /* W already spans the space */
+    for (j = 0; j < k; j++)
+        y[j] = dot(zi, &qp->Z[(size_t) qp->W[j] * n1], n1);
+    for (j = 0; j < k; j++) {
+        for (int l = 0; l < j; l++)
+            y[j] -= qp->R[j + (size_t) l * n1] * y[l];
+        y[j] /= qp->R[j + (size_t) j * n1];
+    }
+    d = dot(zi, zi, n1) - dot(y, y, k);
+    if (!(d > 1e-12 * dot(zi, zi, n1)))
+        return false;                 /* linearly dependent on W */
+    for (j = 0; j < k; j++)
+        qp->R[k + (size_t) j * n1] = y[j];
+    qp->R[k + (size_t) k * n1] = std::sqrt(d);
+    qp->W.push_back(i);
+    qp->inW[i] = 1;
+    return true;
+}
+
+static void remove_row(rtqp_t *qp, int pos)
+{
+    std::vector<int> W = qp->W;
+    W.erase(W.begin() + pos);
+    qp->W.clear();
+    std::fill(qp->inW.begin(), qp->inW.end(), 0);
+    std::fill(qp->skip.begin(), qp->skip.end(), 0);
+    for (size_t j = 0; j < W.size(); j++)
+        add_row(qp, W[j]);
+}
+
+rtqp_t *rtqp_new(int n, int m, const double *H, const double *G, const rtqp_settings *settings)
+{
+    int i, j, k, n1 = n + 1;
+    double h = 0;
+
+    if (n < 1 || m < 0)
+        return NULL;
+    rtqp_t *qp = new rtqp_t;
+    qp->n = n;
+    qp->m = m;
+    if (settings)
+        qp->set = *settings;
+    else
+        rtqp_default_settings(&qp->set);
+    qp->H.assign(H, H + (size_t) n * n);
+    qp->G.assign(G, G + (size_t) m * n);
+
+    /* Cholesky factor of H */
+    std::vector<double> &L = qp->L;
+    L = qp->H;
+    for (j = 0; j < n; j++) {
+        double s = L[j + (size_t) j * n];
+        for (k = 0; k < j; k++)
+            s -= L[j + (size_t) k * n] * L[j + (size_t) k * n];
+        if (!(s > 0)) {
+            delete qp;
+            return NULL;
+        }
+        s = std::sqrt(s);
+        L[j + (size_t) j * n] = s;
+        for (i = j + 1; i < n; i++) {
+            double t = L[i + (size_t) j * n];
+            for (k = 0; k < j; k++)
+                t -= L[i + (size_t) k * n] * L[j + (size_t) k * n];
+            L[i + (size_t) j * n] = t / s;
+        }
+        for (i = 0; i < j; i++)
+            L[i + (size_t) j * n] = 0;
+        h += qp->H[j + (size_t) j * n];
+    }
+    qp->st = std::sqrt(h / n);
+
+    /* Z = [G -1;0 -1]*inv(La'), i.e. row i is inv(La)*[G(i,:)';-1] */
+    qp->Z.assign((size_t) (m + 1) * n1, 0.0);
+    for (i = 0; i < m; i++) {
+        double *zi = &qp->Z[(size_t) i * n1];
+        int nnz = 0, jb = 0;
+        for (j = 0; j < n; j++) {
+            zi[j] = G[i + (size_t) j * m];
+            if (zi[j] != 0) {
+                nnz++;
+                jb = j;
+            }
+        }
+        if (nnz == 1) {
+            qp->brow.push_back(i);
+            qp->bvar.push_back(jb);
+        }
+        lsolve(L, n, zi);
+        zi[n] = -1.0 / qp->st;
+    }
+    qp->Z[(size_t) m * n1 + n] = -1.0 / qp->st;
+
+    qp->inW.assign(m + 1, 0);
+    qp->skip.assign(m + 1, 0);
+    qp->R.assign((size_t) n1 * n1, 0.0);
+    qp->z.resize(n1);
+    qp->s.resize(m + 1);
+    qp->v.resize(n1);
+    qp->u.resize(n1);
+    qp->p.resize(n1);
+    qp->Gp.resize(m + 1);
+    qp->lam.resize(m + 1);
+    qp->xbest.resize(n);
+    qp->tmp.resize(std::max(n1, m + 1));
+    return qp;
+}
+
+void rtqp_set_budget(rtqp_t *qp, int maxiter, double maxtime)
+{
+    qp->set.maxiter = maxiter;
+    qp->set.maxtime = maxtime;
+}
+
+/* .5*x'*H*x+f'*x */
+static double qpcost(const rtqp_t *qp, const double *x, const double *f)
+{
+    int n = qp->n;
+    double c = 0;
+    for (int j = 0; j < n; j++) {
+        const double *hj = &qp->H[(size_t) j * n];
+        c += x[j] * (.5 * dot(hj, x, n) + f[j]);
+    }
+    return c;
+}
+
+int rtqp_solve(rtqp_t *qp, const double *f, const double *w, const double *x0,
+               double *x, double *lambda, rtqp_info *info)
+{
+    int n = qp->n, m = qp->m, n1 = n + 1, i, j, k, iter = 0, status;
+    double *z = &qp->z[0], *s = &qp->s[0], *p = &qp->p[0], *Gp = &qp->Gp[0];
+    double h = qp->st * qp->st, rho = qp->set.penalty, tol = qp->set.tol;
+    double t, viol, cost, gap;
+    int maxiter = qp->set.maxiter > 0 ? qp->set.maxiter : RTQP_ITERCAP * (n + m + 1);
+    bool converged = false, feasible = false, stationary = false;
+    rtqp_clock::time_point start = rtqp_clock::now();
+
+    /* Initial point, projected onto the bounds */
+    for (j = 0; j < n; j++)
+        z[j] = x0 ? x0[j] : 0.0;
+    for (k = 0; k < (int) qp->brow.size(); k++) {
+        i = qp->brow[k];
+        j = qp->bvar[k];
+        double a = qp->G[i + (size_t) j * m];
+        if (a > 0)
+            z[j] = std::min(z[j], w[i] / a);
+    }
+    for (k = 0; k < (int) qp->brow.size(); k++) {
+        i = qp->brow[k];
+        j = qp->bvar[k];
+        double a = qp->G[i + (size_t) j * m];
+        if (a < 0)
+            z[j] = std::max(z[j], w[i] / a);
+    }
+
+    /* Elastic variable and slacks s = wa-Ga*z >= 0 */
+    t = 0;
+    for (i = 0; i < m; i++) {
+        double r = -w[i];
+        for (j = 0; j < n; j++)
+            r += qp->G[i + (size_t) j * m] * z[j];
+        s[i] = -r;
+        t = std::max(t, r);
+    }
+    z[n] = t;
+    for (i = 0; i < m; i++)
+        s[i] += t;
+    s[m] = t;
+
+    qp->W.clear();
+    std::fill(qp->inW.begin(), qp->inW.end(), 0);
+    std::fill(qp->skip.begin(), qp->skip.end(), 0);
+    std::fill(qp->lam.begin(), qp->lam.end(), 0.0);
+    if (t == 0) {
+        add_row(qp, m);
+        feasible = true;
+        std::copy(z, z + n, qp->xbest.begin());
+    }
+
+    for (;;) {
+        if (iter >= maxiter)
+            break;
+        if (qp->set.maxtime > 0 &&
+            std::chrono::duration<double>(rtqp_clock::now() - start).count() >= qp->set.maxtime)
+            break;
+        iter++;
+
+        /* v = inv(La)*gradient */
+        double *v = &qp->v[0], *u = &qp->u[0];
+        for (j = 0; j < n; j++)
+            v[j] = dot(&qp->H[(size_t) j * n], z, n) + f[j];
+        lsolve(qp->L, n, v);
+        v[n] = (h * z[n] + rho) / qp->st;
+
+        /* Multipliers of the working set */
+        k = (int) qp->W.size();
+        double *lw = &qp->tmp[0];
+        for (j = 0; j < k; j++) {
+            lw[j] = -dot(&qp->Z[(size_t) qp->W[j] * n1], v, n1);
+            for (int l = 0; l < j; l++)
+                lw[j] -= qp->R[j + (size_t) l * n1] * lw[l];
+            lw[j] /= qp->R[j + (size_t) j * n1];
+        }
+        for (j = k - 1; j >= 0; j--) {
+            for (int l = j + 1; l < k; l++)
+                lw[j] -= qp->R[l + (size_t) j * n1] * lw[l];
+            lw[j] /= qp->R[j + (size_t) j * n1];
+        }
+        std::fill(qp->lam.begin(), qp->lam.end(), 0.0);
+        for (j = 0; j < k; j++)
+            qp->lam[qp->W[j]] = lw[j];
+
+        /* Step p = -inv(La')*(v+Z_W'*lambda) */
+        std::copy(v, v + n1, u);
+        for (j = 0; j < k; j++) {
+            const double *zw = &qp->Z[(size_t) qp->W[j] * n1];
+            for (i = 0; i < n1; i++)
+                u[i] += lw[j] * zw[i];
+        }
+        for (i = 0; i < n; i++)
+            p[i] = -u[i];
+        ltsolve(qp->L, n, p);
+        p[n] = -u[n] / qp->st;
+
+        double pn = 0, zn = 0;
+        for (i = 0; i < n1; i++) {
+            pn = std::max(pn, std::fabs(p[i]));
+            zn = std::max(zn, std::fabs(z[i]));
+        }
+        if (stationary || pn <= tol * (1.0 + zn)) {
+            /* Stationary on W (after a full step, or null step): drop the
+               most negative multiplier */
+            int jmin = -1;
+            double lmin = -tol * (1.0 + rho);
+            for (j = 0; j < k; j++)
+                if (lw[j] < lmin) {
+                    lmin = lw[j];
+                    jmin = j;
+                }
+            if (jmin < 0) {
+                converged = true;
+                break;
+            }
+            remove_row(qp, jmin);
+            stationary = false;
+            continue;
+        }
+
+        /* Ratio test */
+        double alpha = 1.0;
+        int blk = -1;
+        for (i = 0; i < m; i++) {
+            double gp = -p[n];
+            for (j = 0; j < n; j++)
+                gp += qp->G[i + (size_t) j * m] * p[j];
+            Gp[i] = gp;
+        }
+        Gp[m] = -p[n];
+        for (i = 0; i <= m; i++)
+            if (!qp->inW[i] && !qp->skip[i] && Gp[i] > 0 && s[i] < alpha * Gp[i]) {
+                alpha = std::max(s[i] / Gp[i], 0.0);
+                blk = i;
+            }
+        for (i = 0; i < n1; i++)
+            z[i] += alpha * p[i];
+        for (i = 0; i <= m; i++)
+            s[i] -= alpha * Gp[i];
+        stationary = (blk < 0);
+        if (blk >= 0) {
+            s[blk] = 0;
+            if (blk == m)
+                z[n] = 0;
+            /* With a full working set p is round-off: treat z as stationary.
+               A row dependent on W (degenerate vertex) is left out of the
+               ratio test, otherwise it would block again with alpha=0. */
+            if ((int) qp->W.size() > n)
+                stationary = true;
+            else if (!add_row(qp, blk))
+                qp->skip[blk] = 1;
+        }
+        if (z[n] <= tol) {
+            feasible = true;
+            std::copy(z, z + n, qp->xbest.begin());
+        }
+    }
+
+    /* t>0 after convergence may be round-off in degenerate problems: look
+       at the violation of x itself */
+    if (converged && z[n] > tol) {
+        double wn = 0;
+        viol = 0;
+        for (i = 0; i < m; i++) {
+            double ri = -w[i];
+            for (j = 0; j < n; j++)
+                ri += qp->G[i + (size_t) j * m] * z[j];
+            viol = std::max(viol, ri);
+            wn = std::max(wn, std::fabs(w[i]));
+        }
+        if (viol <= tol * (1.0 + wn))
+            z[n] = 0;
+    }
+
+    if (converged && z[n] <= tol) {
+        status = RTQP_OPTIMAL;
+        std::copy(z, z + n, x);
+    }
+    else if (converged) {
+        status = RTQP_INFEASIBLE;
+        std::copy(z, z + n, x);
+    }
+    else if (feasible) {
+        status = RTQP_BUDGET;
+        std::copy(qp->xbest.begin(), qp->xbest.end(), x);
+    }
+    else {
+        status = RTQP_NOFEASIBLE;
+        std::copy(z, z + n, x);
+    }
+
+    /* Violation, cost and duality gap d(mu) = -.5*|inv(L)*(f+G'*mu)|^2-w'*mu,
+       mu = max(lambda,0) */
+    viol = 0;
+    for (i = 0; i < m; i++) {
+        double ri = -w[i];
+        for (j = 0; j < n; j++)
+            ri += qp->G[i + (size_t) j * m] * x[j];
+        viol = std::max(viol, ri);
+    }
+    cost = qpcost(qp, x, f);
+    double *r = &qp->u[0], dual = 0;
+    for (j = 0; j < n; j++)
+        r[j] = f[j];
+    for (i = 0; i < m; i++) {
+        double mu = std::max(qp->lam[i], 0.0);
+        if (lambda)
+            lambda[i] = mu;
+        if (mu > 0) {
+            dual -= mu * w[i];
+            for (j = 0; j < n; j++)
+                r[j] += mu * qp->G[i + (size_t) j * m];
+        }
+    }
+    lsolve(qp->L, n, r);
+    dual -= .5 * dot(r, r, n);
+    gap = (status == RTQP_OPTIMAL || status == RTQP_BUDGET) ? std::max(cost - dual, 0.0) : HUGE_VAL;
+
+    if (info) {
+        info->iter = iter;
+        info->cost = cost;
+        info->gap = gap;
+        info->violation = viol;
+        info->time = std::chrono::duration<double>(rtqp_clock::now() - start).count();
+    }
+    return status;
+}
+
+void rtqp_free(rtqp_t *qp)
+{
+    delete qp;
+}
@@ -0,0 +1,90 @@
+/* Anytime QP solver with iteration/time budget - C API
+
+   Solves
+
+       min  .5*x'*H*x + f'*x
+       s.t. G*x <= w
+
+   (H positive definite) by a primal active-set method whose iterates are
+   feasible: the cost decreases at every iteration, so when the budget
+   (maximum number of iterations and/or wall-clock time) is exhausted the
+   current iterate is a feasible, suboptimal solution. The quality of
+   such a solution is measured by the duality gap J(x)-d(lambda), where
+   d(lambda) is the dual function evaluated at the current multipliers
+   (clipped to lambda>=0), a lower bound on the optimal cost.
+
+   The solve starts from a given x0, typically the previous optimal
+   sequence shifted by one step. x0 is first projected onto the
+   constraints made of single variables (bounds), then, if it still
+   violates some constraint, feasibility is recovered within the same
+   iterations by an elastic variable t>=0 (G*x-t <= w) with the exact
+   penalty rho*t in the cost.
+
+   A blocking constraint that is linearly dependent on the working set
+   (degenerate vertex) does not enter it, and is ignored by the ratio
+   test until a constraint leaves the working set. The number of
+   iterations is always bounded: without a given maxiter, the limit is
+   10*(n+m+1).
+
+   H and G are factored once by rtqp_new (Cholesky factor of H, G*inv(L')),
+   only f, w and x0 change from one solve to the next. Matrices are dense
+   and column-major (MATLAB layout). See RTQPMEX.CPP for the MEX interface.
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#ifndef RTQP_H
+#define RTQP_H
+
+#define RTQP_OPTIMAL      0    /* optimal solution */
+#define RTQP_BUDGET       1    /* budget exhausted, feasible suboptimal solution */
+#define RTQP_INFEASIBLE   2    /* converged with t>0: no feasible solution (or penalty too small) */
+#define RTQP_NOFEASIBLE   3    /* budget exhausted before finding a feasible solution */
+#define RTQP_NOTPOSDEF    4    /* H is not positive definite */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rtqp_struct rtqp_t;
+
+typedef struct {
+    int maxiter;       /* maximum number of iterations, <=0 = 10*(n+m+1) (default: 0) */
+    double maxtime;    /* maximum time in seconds, <=0 = no limit (default: 0) */
+    double penalty;    /* weight rho of the elastic variable (default: 1e6) */
+    double tol;        /* optimality and feasibility tolerance (default: 1e-9) */
+} rtqp_settings;
+
+typedef struct {
+    int iter;          /* number of iterations */
+    double cost;       /* .5*x'*H*x+f'*x at the returned x */
+    double gap;        /* upper bound on cost-optimal cost (Inf if x is infeasible) */
+    double time;       /* solution time in seconds */
+    double violation;  /* max(G*x-w,0) */
+} rtqp_info;
+
+/* Default settings */
+void rtqp_default_settings(rtqp_settings *s);
+
+/* Create a solver for n variables and m constraints with Hessian H
+   (n-by-n) and constraint matrix G (m-by-n). settings may be NULL.
+   Returns NULL if H is not positive definite. */
+rtqp_t *rtqp_new(int n, int m, const double *H, const double *G, const rtqp_settings *settings);
+
+/* Change the budget of the next solves */
+void rtqp_set_budget(rtqp_t *qp, int maxiter, double maxtime);
+
+/* Solve with linear term f (n) and rhs w (m), starting from x0 (n, NULL =
+   zero). x (n) receives the solution, lambda (m, may be NULL) the
+   multipliers, info (may be NULL) iterations, cost, gap, time. Returns
+   one of the RTQP_* codes. */
+int rtqp_solve(rtqp_t *qp, const double *f, const double *w, const double *x0,
+               double *x, double *lambda, rtqp_info *info);
+
+void rtqp_free(rtqp_t *qp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+function [xopt,lambda,how,gap,iter]=rtqp(Q,f,A,b,x0,budget)
+% RTQP Solve a convex QP within an iteration/time budget
+%
+% [xopt,lambda,how]=RTQP(Q,f,A,b,x0) solves
+%
+%               min .5*x'Qx+f'x    subject to:   Ax <= b
+%                x
+%
+% (Q positive definite) by a primal active-set method started from x0
+% (default: zero). x0 is first projected onto the constraints that only
+% involve one variable (bounds); if it still violates some constraints,
+% feasibility is recovered during the iterations. After that, all
+% iterates are feasible and have decreasing cost.
+%
+% [xopt,lambda,how,gap,iter]=RTQP(Q,f,A,b,x0,BUDGET) stops after
+% BUDGET.maxiter iterations or BUDGET.maxtime seconds and returns the best
+% feasible solution found so far. maxiter=Inf means 10*(n+m+1) iterations
+% (n variables, m constraints), maxtime=Inf no time limit. gap is an upper bound
+% on the difference between the cost of xopt and the optimal cost (from
+% the dual function at the current multipliers), iter the number of
+% iterations. BUDGET may also contain the fields penalty (weight of the
+% constraint violation, default 1e6) and tol (default 1e-9).
+%
+% how = 'ok'           optimal solution
+%       'suboptimal'   budget exhausted, xopt is feasible
+%       'infeasible'   the QP is infeasible
+%       'unreliable'   budget exhausted before a feasible solution was
+%                      found, xopt is the current iterate
+%
+% The factors of Q and A are kept between calls as long as Q and A do not
+% change. RTQP uses the MEX function RTQPMEX (see RTQP.CPP and
+% MEXCOMPILE.M). If it is not compiled, QPSOL with the default solver is
+% used instead (no budget, gap=0).
+%
+% See also QPSOL, QPDUAL, ADMMQP, QPTYPE.
+
+% (C) 2026 by the Hybrid Toolbox authors
+
+if nargin<5,
+    x0=[];
+end
+if nargin<6,
+    budget=[];
+end
+
+n=size(Q,1);
+if isempty(A),
+    A=zeros(0,n);
+    b=zeros(0,1);
+end
+
+if exist('rtqpmex')~=3,
+    [xopt,lambda,how]=qpsol(Q,f,A,b,[],[],x0,qptype);
+    gap=0;
+    iter=0;
+    return
+end
+
+[xopt,lambda,status,gap,iter]=rtqpmex(Q,f(:),full(A),b(:),x0(:),budget);
+
+switch status
+    case 0
+        how='ok';
+    case 1
+        how='suboptimal';
+    case 2
+        how='infeasible';
+    case 3
+        how='unreliable';
+    otherwise
+        error('rtqp:notposdef','Q is not positive definite');
+end
@@ -0,0 +1,150 @@
+/* Anytime QP solver with iteration/time budget - MEX interface
+
+   [x,lambda,status,gap,iter,cost]=rtqpmex(H,f,G,w,x0,opts)
+
+   Solves min .5*x'*H*x+f'*x s.t. G*x<=w by the solver in RTQP.CPP,
+   starting from x0 ([] = zero).
+
+   opts   = structure with optional fields maxiter, maxtime (budget, 0 or
+            Inf = 10*(n+m+1) iterations and no time limit), penalty, tol
+            (see RTQP.H)
+   status = 0 optimal, 1 budget exhausted (x is feasible, suboptimal),
+            2 infeasible, 3 budget exhausted before a feasible x was
+            found, 4 H not positive definite
+   gap    = upper bound on cost-(optimal cost) (Inf if x is infeasible)
+
+   The solver, with the factors of H and G, is kept between calls and
+   rebuilt only when H or G change.
+
+   Compile with MEXCOMPILE.M (or mex -O rtqpmex.cpp rtqp.cpp)
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mex.h"
+#include "rtqp.h"
+#include <cstring>
+#include <cmath>
+#include <vector>
+
+static rtqp_t *rtqpmex_qp = NULL;
+static std::vector<double> rtqpmex_H, rtqpmex_G;  /* data of rtqpmex_qp */
+static double rtqpmex_opt[2];                     /* penalty, tol */
+static int rtqpmex_m = -1;
+
+static void rtqpmex_cleanup(void)
+{
+    if (rtqpmex_qp)
+        rtqp_free(rtqpmex_qp);
+    rtqpmex_qp = NULL;
+    rtqpmex_H.clear();
+    rtqpmex_G.clear();
+    rtqpmex_m = -1;
+}
+
+static bool same(const std::vector<double> &v, const double *p, size_t len)
+{
+    return v.size() == len && (len == 0 || !memcmp(&v[0], p, len * sizeof(double)));
+}
+
+static double getopt(const mxArray *opts, const char *name, double def)
+{
+    const mxArray *f;
+    if (!opts || !mxIsStruct(opts))
+        return def;
+    f = mxGetField(opts, 0, name);
+    if (!f || mxIsEmpty(f))
+        return def;
+    return mxGetScalar(f);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const mxArray *opts;
+    const double *H, *f, *G, *w, *x0;
+    double *x, *lambda, maxiter, maxtime;
+    rtqp_settings set;
+    rtqp_info info;
+    int n, m, status;
+
+    mexAtExit(rtqpmex_cleanup);
+
+    if (nrhs < 4)
+        mexErrMsgTxt("At least four input arguments required.");
+
+    n = (int) mxGetM(prhs[0]);
+    if ((int) mxGetN(prhs[0]) != n || !mxIsDouble(prhs[0]) || mxIsSparse(prhs[0]))
+        mexErrMsgTxt("H must be a full square matrix.");
+    if ((int) mxGetNumberOfElements(prhs[1]) != n)
+        mexErrMsgTxt("f has wrong dimension.");
+    m = (int) mxGetM(prhs[2]);
+    if (m > 0 && (int) mxGetN(prhs[2]) != n)
+        mexErrMsgTxt("G has wrong number of columns.");
+    if (m > 0 && mxIsSparse(prhs[2]))
+        mexErrMsgTxt("G must be a full matrix.");
+    if ((int) mxGetNumberOfElements(prhs[3]) != m)
+        mexErrMsgTxt("w must have as many elements as the rows of G.");
+    x0 = NULL;
+    if (nrhs > 4 && !mxIsEmpty(prhs[4])) {
+        if ((int) mxGetNumberOfElements(prhs[4]) != n)
+            mexErrMsgTxt("x0 has wrong dimension.");
+        x0 = mxGetPr(prhs[4]);
+    }
+
+    opts = nrhs > 5 ? prhs[5] : NULL;
+    rtqp_default_settings(&set);
+    maxiter = getopt(opts, "maxiter", 0);
+    maxtime = getopt(opts, "maxtime", 0);
+    set.maxiter = (maxiter > 0 && !mxIsInf(maxiter)) ? (int) maxiter : 0;
+    set.maxtime = (maxtime > 0 && !mxIsInf(maxtime)) ? maxtime : 0;
+    set.penalty = getopt(opts, "penalty", set.penalty);
+    set.tol = getopt(opts, "tol", set.tol);
+
+    H = mxGetPr(prhs[0]);
+    f = mxGetPr(prhs[1]);
+    G = mxGetPr(prhs[2]);
+    w = mxGetPr(prhs[3]);
+
+    /* Reuse the solver (factors) if H, G and settings are the same */
+    if (!rtqpmex_qp || rtqpmex_m != m
+        || !same(rtqpmex_H, H, (size_t) n * n)
+        || !same(rtqpmex_G, G, (size_t) m * n)
+        || rtqpmex_opt[0] != set.penalty || rtqpmex_opt[1] != set.tol) {
+        rtqpmex_cleanup();
+        rtqpmex_qp = rtqp_new(n, m, H, G, &set);
+        if (rtqpmex_qp) {
+            rtqpmex_H.assign(H, H + (size_t) n * n);
+            rtqpmex_G.assign(G, G + (size_t) m * n);
+            rtqpmex_opt[0] = set.penalty;
+            rtqpmex_opt[1] = set.tol;
+            rtqpmex_m = m;
+        }
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(n, 1, mxREAL);
+    x = mxGetPr(plhs[0]);
+    if (nlhs > 1) {
+        plhs[1] = mxCreateDoubleMatrix(m, 1, mxREAL);
+        lambda = mxGetPr(plhs[1]);
+    }
+    else
+        lambda = NULL;
+
+    memset(&info, 0, sizeof(info));
+    info.gap = mxGetInf();
+    if (rtqpmex_qp) {
+        rtqp_set_budget(rtqpmex_qp, set.maxiter, set.maxtime);
+        status = rtqp_solve(rtqpmex_qp, f, w, x0, x, lambda, &info);
+    }
+    else
+        status = RTQP_NOTPOSDEF;
+
+    if (nlhs > 2)
+        plhs[2] = mxCreateDoubleScalar(status);
+    if (nlhs > 3)
+        plhs[3] = mxCreateDoubleScalar(info.gap == HUGE_VAL ? mxGetInf() : info.gap);
+    if (nlhs > 4)
+        plhs[4] = mxCreateDoubleScalar(info.iter);
+    if (nlhs > 5)
+        plhs[5] = mxCreateDoubleScalar(info.cost);
+}
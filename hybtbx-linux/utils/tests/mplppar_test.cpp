@@ -0,0 +1,134 @@
+/* Test of the parallel mpLP solver on the one-step problem of a PWA
+   system in one of its two modes (x1 >= 0), whose feasible parameter set
+   is half of the box:
+
+       min  e+eJ
+       s.t. |u| <= 1,  e >= .3*|u|,  e >= 0
+            x1 >= 0                       (row with zero coefficients of [u e eJ])
+            |A*x+B*u|_inf <= 5,  eJ >= |A*x+B*u|_inf
+            -5 <= x <= 5
+
+   with parameters th = x. The regions must cover the parameters with
+   x1 > 0 and give there the optimal cost of the LP solved at th, and must
+   not contain parameters with x1 < 0.
+
+   Compile and run from the utils folder:
+
+       g++ -O2 -std=c++11 -pthread -I. tests/mplppar_test.cpp mplppar.cpp -o mplppar_test
+       ./mplppar_test
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "mplppar.h"
+#include "lpdense.h"
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+#define NV 3        /* u, e, eJ */
+#define NP 2
+
+static int fails = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        fails++;
+    }
+}
+
+/* Region containing th and cost of its solution at th, -1 if none */
+static int locate(const mplppar_t *mp, const double *c, const double *th, double *cost)
+{
+    mplppar_region r;
+    for (int i = 0; i < mplppar_num_regions(mp); i++) {
+        mplppar_get_region(mp, i, &r);
+        bool in = true;
+        for (int k = 0; k < r.nrows && in; k++)
+            in = r.H[NP * k] * th[0] + r.H[NP * k + 1] * th[1] <= r.K[k] + 1e-9;
+        if (in) {
+            *cost = 0;
+            for (int j = 0; j < NV; j++)
+                *cost += c[j] * (r.F[NP * j] * th[0] + r.F[NP * j + 1] * th[1] + r.g[j]);
+            return i;
+        }
+    }
+    return -1;
+}
+
+int main()
+{
+    const double Ax[4] = {0.078425465578873768, -0.1286151490709547,
+                          -0.41083377535636456, -0.3742435440071008};   /* row-major */
+    const double Bu[2] = {-0.90507209245639619, -0.10278496721578034};
+    const double c[NV] = {0, 1, 1}, thmin[NP] = {-5, -5}, thmax[NP] = {5, 5};
+    std::vector<double> rows, b, S;   /* row-major */
+    int nthreads[2] = {1, 4}, i, j, k, sg;
+
+#define ROW(a0, a1, a2, bb, s0, s1) \
+    do { rows.push_back(a0); rows.push_back(a1); rows.push_back(a2); \
+         b.push_back(bb); S.push_back(s0); S.push_back(s1); } while (0)
+    ROW(1, 0, 0, 1, 0, 0);
+    ROW(-1, 0, 0, 1, 0, 0);
+    ROW(0, 0, 0, 0, 1, 0);            /* x1 >= 0 */
+    ROW(.3, -1, 0, 0, 0, 0);
+    ROW(-.3, -1, 0, 0, 0, 0);
+    ROW(0, -1, 0, 0, 0, 0);
+    for (i = 0; i < NP; i++)
+        for (sg = -1; sg <= 1; sg += 2) {
+            ROW(sg * Bu[i], 0, 0, 5, -sg * Ax[2 * i], -sg * Ax[2 * i + 1]);
+            ROW(sg * Bu[i], 0, -1, 0, -sg * Ax[2 * i], -sg * Ax[2 * i + 1]);
+        }
+#undef ROW
+    int m = (int) b.size();
+    std::vector<double> Ac(m * NV), Sc(m * NP);
+    for (i = 0; i < m; i++) {
+        for (j = 0; j < NV; j++)
+            Ac[i + j * m] = rows[i * NV + j];
+        for (j = 0; j < NP; j++)
+            Sc[i + j * m] = S[i * NP + j];
+    }
+
+    for (int t = 0; t < 2; t++) {
+        mplppar_settings set;
+        mplppar_default_settings(&set);
+        set.nthreads = nthreads[t];
+        mplppar_t *mp = mplppar_new(NV, m, NP, c, &Ac[0], &b[0], &Sc[0], thmin, thmax);
+        int status = mplppar_solve(mp, &set, NULL, NULL);
+        check(status == MPLPPAR_OK, "status");
+
+        int nfeas = 0, miss = 0, wrong = 0, outside = 0;
+        DenseLP lp;
+        for (i = 0; i <= 40; i++)
+            for (j = 0; j <= 40; j++) {
+                double th[NP] = {-4.99 + .2495 * i, -4.99 + .2495 * j}, cost = 0, x[NV] = {0, 0, 0};
+                int reg = locate(mp, c, th, &cost);
+                lp.resize(NV, m, 0);
+                for (k = 0; k < m; k++) {
+                    for (int l = 0; l < NV; l++)
+                        lp.row(k)[l] = rows[k * NV + l];
+                    lp.b[k] = b[k] + S[k * NP] * th[0] + S[k * NP + 1] * th[1];
+                }
+                if (lp.solve(c, x) != LPDENSE_OPTIMAL) {
+                    outside += reg >= 0;
+                    continue;
+                }
+                nfeas++;
+                if (reg < 0)
+                    miss++;
+                else if (std::fabs(cost - lp.fval) > 1e-7 * (1 + std::fabs(lp.fval)))
+                    wrong++;
+            }
+        check(nfeas > 0 && miss == 0, "feasible parameters not covered");
+        check(wrong == 0, "wrong optimal cost");
+        check(outside == 0, "infeasible parameters covered");
+        printf("%d threads: status %d, %d regions, %d feasible points, %d missed, %d wrong, "
+               "%d outside\n", nthreads[t], status, mplppar_num_regions(mp), nfeas, miss,
+               wrong, outside);
+        mplppar_free(mp);
+    }
+    printf(fails ? "mplppar_test: %d checks failed\n" : "mplppar_test: passed\n", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+/* Test of the mp-DP solver against the enumeration of the mode sequences
+   on PWA systems (random ones, and three on which pieces were lost or
+   too large)
+   with two states and two modes
+
+       x(k+1) = A_i*x(k) + B_i*u(k) + f_i,   i = 0 if x1(k) >= 0, else 1
+       |u(k)| <= 1,  |x(k)|_inf <= 5
+
+   with cost sum_k .3*|u(k)| + sum_{k=1}^{N-1} |x(k)|_inf + |x(N)|_inf.
+   For each sequence of modes the problem is an LP in [u;e] (x(k) is an
+   affine function of x(0) and u); its smallest optimal value over the
+   sequences must be the value of J_0 at x(0), and J_0 must cover x(0)
+   exactly where one of the LPs is feasible.
+
+   Compile and run from the utils folder:
+
+       g++ -O2 -std=c++11 -pthread -I. tests/pwadp_test.cpp pwadp.cpp mplppar.cpp -o pwadp_test
+       ./pwadp_test
+
+   (C) 2026 by the Hybrid Toolbox authors
+*/
+
+#include "pwadp.h"
+#include "lpdense.h"
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+#define NX 2
+#define XMAX 5.0
+#define RU .3
+#define TRIALS 20
+#define POINTS 100
+
+static int fails = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        fails++;
+    }
+}
+
+/* Uniform in [-1,1), same sequence on every platform */
+static double rnd(unsigned int &seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) / 8388608.0 - 1.0;
+}
+
+struct PWA {
+    double A[2][NX * NX], B[2][NX], f[2][NX];   /* A row-major */
+};
+
+/* Optimal cost from x0 by enumeration of the mode sequences, Inf if
+   infeasible */
+static double enumerate(const PWA &S, int N, const double *x0)
+{
+    int nv = 3 * N, iu = 0, ie = N, ix = 2 * N, i, j, k, a, sg;   /* u, e_u, e_x (k=1..N) */
+    double best = INFINITY;
+    DenseLP lp;
+
+    for (int seq = 0; seq < (1 << N); seq++) {
+        /* x(k) = c[k] + G[k]*u */
+        std::vector<std::vector<double> > c(N + 1, std::vector<double>(NX, 0.0));
+        std::vector<std::vector<double> > G(N + 1, std::vector<double>(NX * N, 0.0));
+        std::vector<std::vector<double> > rows;
+        std::vector<double> rhs, row(nv), cost(nv, 0.0), x(nv, 0.0);
+
+        for (j = 0; j < NX; j++)
+            c[0][j] = x0[j];
+        for (k = 0; k < N; k++) {
+            int m = (seq >> k) & 1;
+            double s = m == 0 ? -1.0 : 1.0;   /* mode row s*x1 <= 0 */
+            std::fill(row.begin(), row.end(), 0.0);
+            for (j = 0; j < N; j++)
+                row[iu + j] = s * G[k][j];
+            rows.push_back(row);
+            rhs.push_back(-s * c[k][0]);
+            for (a = 0; a < NX; a++) {
+                c[k + 1][a] = S.f[m][a];
+                for (i = 0; i < NX; i++) {
+                    c[k + 1][a] += S.A[m][a * NX + i] * c[k][i];
+                    for (j = 0; j < N; j++)
+                        G[k + 1][a * N + j] += S.A[m][a * NX + i] * G[k][i * N + j];
+                }
+                G[k + 1][a * N + k] += S.B[m][a];
+            }
+        }
+        for (k = 0; k < N; k++)
+            for (sg = -1; sg <= 1; sg += 2) {
+                std::fill(row.begin(), row.end(), 0.0);
+                row[iu + k] = sg;
+                rows.push_back(row);
+                rhs.push_back(1.0);
+                row[iu + k] = sg * RU;
+                row[ie + k] = -1.0;
+                rows.push_back(row);
+                rhs.push_back(0.0);
+            }
+        for (k = 1; k <= N; k++)
+            for (a = 0; a < NX; a++)
+                for (sg = -1; sg <= 1; sg += 2) {
+                    std::fill(row.begin(), row.end(), 0.0);
+                    for (j = 0; j < N; j++)
+                        row[iu + j] = sg * G[k][a * N + j];
+                    rows.push_back(row);
+                    rhs.push_back(XMAX - sg * c[k][a]);
+                    row[ix + k - 1] = -1.0;
+                    rows.push_back(row);
+                    rhs.push_back(-sg * c[k][a]);
+                }
+
+        lp.resize(nv, (int) rows.size(), 0);
+        for (i = 0; i < (int) rows.size(); i++) {
+            for (j = 0; j < nv; j++)
+                lp.row(i)[j] = rows[i][j];
+            lp.b[i] = rhs[i];
+        }
+        for (j = ie; j < nv; j++)
+            cost[j] = 1.0;
+        if (lp.solve(&cost[0], &x[0]) == LPDENSE_OPTIMAL && lp.fval < best)
+            best = lp.fval;
+    }
+    return best;
+}
+
+/* J_0 at x0 (smallest value of the pieces containing it), Inf if none */
+static double value(const pwadp_t *dp, const double *x0)
+{
+    double V = INFINITY;
+    for (int p = 0; p < pwadp_num_pieces(dp); p++) {
+        pwadp_piece P;
+        pwadp_get_piece(dp, p, &P);
+        for (int r = 0; r < P.nregions; r++) {
+            pwadp_region R;
+            pwadp_get_region(dp, p, r, &R);
+            bool in = true;
+            for (int i = 0; i < R.nrows && in; i++)
+                in = R.H[NX * i] * x0[0] + R.H[NX * i + 1] * x0[1] <= R.K[i] + 1e-8;
+            if (in) {
+                V = std::fmin(V, R.V[0] * x0[0] + R.V[1] * x0[1] + R.v);
+                break;
+            }
+        }
+    }
+    return V;
+}
+
+static pwadp_t *setup(const PWA &S)
+{
+    double xmin[NX] = {-XMAX, -XMAX}, xmax[NX] = {XMAX, XMAX};
+    pwadp_t *dp = pwadp_new(NX, 1, xmin, xmax, xmin, xmax);
+
+    /* J_N = |x|_inf = max of +-x1, +-x2 (column-major 4-by-2) */
+    double V[8] = {1, 0, -1, 0, 0, 1, 0, -1}, v[4] = {0, 0, 0, 0};
+    pwadp_add_terminal(dp, 0, 0, NULL, NULL, 4, V, v);
+
+    for (int first = 1; first >= 0; first--)
+        for (int m = 0; m < 2; m++) {
+            /* |u| <= 1, mode row 0 <= +-x1 (column-major 3-by-1, 3-by-2) */
+            double Aw[3] = {1, -1, 0}, b[3] = {1, 1, 0};
+            double Sx[6] = {0, 0, m == 0 ? 1.0 : -1.0, 0, 0, 0};
+            /* .3*|u| (term 0), and |x|_inf (term 1) but at stage 0 */
+            double Cw[3] = {RU, 0, 0}, Cth[6] = {0, 1, 0, 0, 0, 1}, c0[3] = {0, 0, 0};
+            double Cth1[2] = {0, 0};
+            int term[3] = {0, 1, 1};
+            double Tth[4] = {S.A[m][0], S.A[m][2], S.A[m][1], S.A[m][3]};
+            pwadp_transition T;
+            T.s = T.snext = 0;
+            T.m = 3;
+            T.A = Aw;
+            T.b = b;
+            T.S = Sx;
+            T.mc = first ? 1 : 3;
+            T.Cw = Cw;
+            T.Cth = first ? Cth1 : Cth;
+            T.c0 = c0;
+            T.term = term;
+            T.Tth = Tth;
+            T.Tw = S.B[m];
+            T.t0 = S.f[m];
+            pwadp_add_transition(dp, first, &T);
+        }
+    return dp;
+}
+
+struct Counts {
+    long points, status, miss, wrong, outside;
+};
+
+/* Solve over N steps and compare with enumerate() at the states x0 */
+static void run(const PWA &S, int N, int nthreads, const std::vector<double> &x0, Counts &c)
+{
+    pwadp_t *dp = setup(S);
+    pwadp_settings set;
+    pwadp_default_settings(&set);
+    set.nthreads = nthreads;
+    std::vector<int> npieces(N + 1);
+    c.status += pwadp_solve(dp, N, &set, NULL, NULL, &npieces[0]) != PWADP_OK;
+
+    for (size_t q = 0; q < x0.size(); q += NX, c.points++) {
+        double Jbest = enumerate(S, N, &x0[q]), J = value(dp, &x0[q]);
+        if (std::isinf(Jbest))
+            c.outside += !std::isinf(J);
+        else if (std::isinf(J))
+            c.miss++;
+        else if (std::fabs(J - Jbest) > 1e-6 * (1 + std::fabs(Jbest)))
+            c.wrong++;
+    }
+    pwadp_free(dp);
+}
+
+static void report(const char *name, const Counts &c)
+{
+    check(c.status == 0, "status");
+    check(c.miss == 0, "feasible states not covered");
+    check(c.wrong == 0, "wrong optimal cost");
+    check(c.outside == 0, "infeasible states covered");
+    printf("%s: %ld states, %ld not solved, %ld missed, %ld wrong, %ld outside\n", name,
+           c.points, c.status, c.miss, c.wrong, c.outside);
+}
+
+int main()
+{
+    /* Systems on which mplppar missed regions: a facet crossing landed in
+       the same basis (N=3), and a critical region lost a row because its
+       LPs cycled on identical rows (N=4); and one where the hull of a piece
+       lost two almost parallel facets of the union of its regions (N=4) */
+    const PWA fixed[3] = {
+        {{{-1.1810980634379296, 0.069599378030066897, -0.36510238157330444, -0.63743010314405113},
+          {-1.0023657873617995, -0.98822228128087142, 0.71447273495759811, 0.54947378829319715}},
+         {{-0.4346031289199207, 0.052294619134471976}, {0.95131437754719461, 0.24041263050685058}},
+         {{0.21166320838554845, 0.0090030797689940375}, {-0.26548517382127318, 0.23820630363954542}}},
+        {{{1.0529216359329736, 0.82774467526262774, -1.1138392646155579, 0.11413841827136695},
+          {0.36721609091800689, -0.44203864263488019, 0.70748295395009242, -0.76078878322790322}},
+         {{0.22712462478833584, 0.3977484572834058}, {0.12376073119898678, -0.090149725418615434}},
+         {{0.24666408974137388, 0.20578273889904508}, {-0.1244247943225113, -0.097463997848738784}}},
+        {{{0.25718776783584474, 1.1100628018048009, 0.28880159512936771, -0.54310067194211287},
+          {-0.45339816120796189, 1.0480482590363667, 0.96150544873785027, 0.19765004203563433}},
+         {{-0.00042040167059242961, -0.86730438013393851}, {-0.24008615611058859, 0.87743327760620682}},
+         {{0.27036552677177911, -0.082833078089428039}, {0.18385508253244651, -0.015685953532322171}}}};
+    const int Nfixed[3] = {3, 4, 4};
+    unsigned int seed = 5;
+    int N, t, q, i, k;
+    char name[32];
+    std::vector<double> x0(NX * POINTS);
+
+    for (N = 2; N <= 3; N++) {
+        Counts c = {0, 0, 0, 0, 0};
+        for (t = 0; t < TRIALS; t++) {
+            PWA S;
+            for (i = 0; i < 2; i++) {
+                for (k = 0; k < NX * NX; k++)
+                    S.A[i][k] = 1.2 * rnd(seed);
+                for (k = 0; k < NX; k++) {
+                    S.B[i][k] = rnd(seed);
+                    S.f[i][k] = .3 * rnd(seed);
+                }
+            }
+            for (q = 0; q < NX * POINTS; q++)
+                x0[q] = XMAX * rnd(seed);
+            run(S, N, (t % 2) ? 1 : 4, x0, c);
+        }
+        sprintf(name, "random, N=%d", N);
+        report(name, c);
+    }
+
+    /* Grid of states for the fixed systems */
+    x0.clear();
+    for (i = 0; i <= 30; i++)
+        for (k = 0; k <= 30; k++) {
+            x0.push_back(-XMAX + (i + .5) * XMAX / 15.5);
+            x0.push_back(-XMAX + (k + .5) * XMAX / 15.5);
+        }
+    for (t = 0; t < 3; t++) {
+        Counts c = {0, 0, 0, 0, 0};
+        run(fixed[t], Nfixed[t], 1, x0, c);
+        sprintf(name, "system %d, N=%d", t + 1, Nfixed[t]);
+        report(name, c);
+    }
+    printf(fails ? "pwadp_test: %d checks failed\n" : "pwadp_test: passed\n", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+'''
+Python interface to the ADMM QP solver of the Hybrid Toolbox
+(hybtbx-linux/utils/admmqp.cpp), for the QP
+
+    min  .5*x'*P*x + q'*x
+    s.t. l <= A*x <= u
+
+The matrix of the ADMM iterations is factored once by setup(). In MPC
+only q, l and u change with the state: update() replaces them without
+refactoring, and solve() starts from the solution of the previous call.
+The methods follow the OSQP Python interface, so that
+
+    prob = ADMMQP()
+    prob.setup(sparse.triu(P, format='csc'), q, A, l, u, alpha=1.0)
+    for t in range(T):
+        prob.update(q=q, l=l, u=u)
+        res = prob.solve()
+
+also runs with osqp.OSQP() in place of ADMMQP().
+
+The solver is loaded from the shared library libadmmqp.so (admmqp.dll on
+Windows) in the folder of this file, or from the path in the environment
+variable ADMMQP_LIB. See README.md for how to build it.
+
+(C) 2026 by the Hybrid Toolbox authors
+'''
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+SOLVED = 0
+PRIMAL_INFEASIBLE = 1
+DUAL_INFEASIBLE = 2
+MAXITER = 3
+NOTPOSDEF = 4
+
+_status_names = {SOLVED: 'solved',
+                 PRIMAL_INFEASIBLE: 'primal infeasible',
+                 DUAL_INFEASIBLE: 'dual infeasible',
+                 MAXITER: 'maximum iterations reached',
+                 NOTPOSDEF: 'non convex'}
+
+
+class _Settings(ctypes.Structure):
+    _fields_ = [('rho', ctypes.c_double),
+                ('sigma', ctypes.c_double),
+                ('alpha', ctypes.c_double),
+                ('eps_abs', ctypes.c_double),
+                ('eps_rel', ctypes.c_double),
+                ('eps_inf', ctypes.c_double),
+                ('maxiter', ctypes.c_int),
+                ('check_every', ctypes.c_int),
+                ('scaling', ctypes.c_int),
+                ('adaptive_rho_interval', ctypes.c_int)]
+
+
+def _load():
+    path = os.environ.get('ADMMQP_LIB')
+    if not path:
+        name = 'admmqp.dll' if sys.platform.startswith('win') else 'libadmmqp.so'
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+    lib = ctypes.CDLL(path)
+    dp = ctypes.POINTER(ctypes.c_double)
+    lib.admmqp_default_settings.argtypes = [ctypes.POINTER(_Settings)]
+    lib.admmqp_default_settings.restype = None
+    lib.admmqp_new.argtypes = [ctypes.c_int, ctypes.c_int, dp, dp, dp, dp,
+                               ctypes.POINTER(_Settings)]
+    lib.admmqp_new.restype = ctypes.c_void_p
+    lib.admmqp_update.argtypes = [ctypes.c_void_p, dp, dp, dp]
+    lib.admmqp_update.restype = None
+    lib.admmqp_solve.argtypes = [ctypes.c_void_p, dp, dp, ctypes.POINTER(ctypes.c_int)]
+    lib.admmqp_solve.restype = ctypes.c_int
+    lib.admmqp_warm_start.argtypes = [ctypes.c_void_p, dp, dp]
+    lib.admmqp_warm_start.restype = None
+    lib.admmqp_num_factorizations.argtypes = [ctypes.c_void_p]
+    lib.admmqp_num_factorizations.restype = ctypes.c_int
+    lib.admmqp_free.argtypes = [ctypes.c_void_p]
+    lib.admmqp_free.restype = None
+    return lib
+
+_lib = _load()
+
+
+def _dense(M, order='F'):
+    '''Dense float64 array (also from scipy.sparse matrices)'''
+    if hasattr(M, 'toarray'):
+        M = M.toarray()
+    return np.require(np.asarray(M, dtype=np.float64), requirements=[order, 'A'])
+
+
+def _vec(v, size):
+    v = _dense(v).ravel()
+    if v.size != size:
+        raise ValueError('wrong vector dimension: %d instead of %d' % (v.size, size))
+    return np.ascontiguousarray(v)
+
+
+def _ptr(v):
+    return v.ctypes.data_as(ctypes.POINTER(ctypes.c_double))
+
+
+class _Info(object):
+    pass
+
+
+class _Results(object):
+    pass
+
+
+class ADMMQP(object):
+
+    def __init__(self):
+        self._qp = None
+        self.n = 0
+        self.m = 0
+
+    def setup(self, P, q, A, l, u, rho=0.1, sigma=1e-6, alpha=1.6,
+              eps_abs=1e-6, eps_rel=1e-6, eps_prim_inf=1e-7, max_iter=4000,
+              check_termination=5, scaling=10, adaptive_rho_interval=25,
+              **kwargs):
+        '''Store the problem data and factor the iteration matrix. As in
+        OSQP, only the upper triangle of P is used (pass sparse.triu(P)).
+        adaptive_rho_interval=0 keeps rho fixed. Other OSQP settings
+        (verbose, ...) are accepted and ignored.'''
+        P = np.triu(_dense(P))
+        P = _dense(P + np.triu(P, 1).T)
+        A = _dense(A)
+        self.n = P.shape[0]
+        self.m = A.shape[0] if A.size > 0 else 0
+        if self.m == 0:
+            A = np.zeros((0, self.n), order='F')
+        s = _Settings()
+        _lib.admmqp_default_settings(ctypes.byref(s))
+        s.rho = rho
+        s.sigma = sigma
+        s.alpha = alpha
+        s.eps_abs = eps_abs
+        s.eps_rel = eps_rel
+        s.eps_inf = eps_prim_inf
+        s.maxiter = int(max_iter)
+        s.check_every = max(1, int(check_termination))
+        s.scaling = max(0, int(scaling))
+        s.adaptive_rho_interval = max(0, int(adaptive_rho_interval))
+        l = _vec(l, self.m)
+        u = _vec(u, self.m)
+        self._free()
+        self._P = P
+        self._A = A
+        self._qp = _lib.admmqp_new(self.n, self.m, _ptr(P), _ptr(A), _ptr(l), _ptr(u),
+                                   ctypes.byref(s))
+        if not self._qp:
+            raise ValueError('P+sigma*I+A\'*diag(rho)*A is not positive definite')
+        self.update(q=q, l=l, u=u)
+
+    def update(self, q=None, l=None, u=None):
+        '''Replace q, l, u (the factorization is kept)'''
+        qv = None if q is None else _vec(q, self.n)
+        lv = None if l is None else _vec(l, self.m)
+        uv = None if u is None else _vec(u, self.m)
+        _lib.admmqp_update(self._qp,
+                           None if qv is None else _ptr(qv),
+                           None if lv is None else _ptr(lv),
+                           None if uv is None else _ptr(uv))
+
+    def warm_start(self, x=None, y=None):
+        xv = None if x is None else _vec(x, self.n)
+        yv = None if y is None else _vec(y, self.m)
+        _lib.admmqp_warm_start(self._qp,
+                               None if xv is None else _ptr(xv),
+                               None if yv is None else _ptr(yv))
+
+    def solve(self):
+        '''Solve, starting from the solution of the previous call. Returns
+        an object with fields x, y and info (status, status_val, iter).'''
+        x = np.zeros(self.n)
+        y = np.zeros(self.m)
+        it = ctypes.c_int(0)
+        status = _lib.admmqp_solve(self._qp, _ptr(x), _ptr(y), ctypes.byref(it))
+        res = _Results()
+        res.x = x
+        res.y = y
+        res.info = _Info()
+        res.info.status_val = status
+        res.info.status = _status_names.get(status, 'unknown')
+        res.info.iter = it.value
+        return res
+
+    def num_factorizations(self):
+        return _lib.admmqp_num_factorizations(self._qp) if self._qp else 0
+
+    def _free(self):
+        if self._qp:
+            _lib.admmqp_free(self._qp)
+            self._qp = None
+
+    def __del__(self):
+        self._free()
@@ -0,0 +1,218 @@
+'''
+Python interface to the condensing engine of the Hybrid Toolbox
+(hybtbx-linux/utils/condense.cpp).
+
+For the model x(k+1) = A*x(k) + B*u(k), y(k) = C*x(k), with u(k) = u(Nu-1)
+for k >= Nu, and the cost
+
+    sum_{k=1}^{N-1} y(k)'*Q*y(k) + x(N)'*P*x(N) + sum_{k=0}^{N-1} u(k)'*R*u(k)
+
+it builds the condensed QP
+
+    .5*U'*H*U + x0'*F'*U + .5*x0'*Y*x0,   G*U <= W + S*x0
+
+with the limits umin <= u(k) <= umax, ymin <= y(k) <= ymax, and the output
+prediction [y(1);...;y(N)] = Sbar*U + Tbar*x0 (the matrices S_bar, T_bar,
+CS_bar, CT_bar of the demos). Example:
+
+    c = Condenser(A, B, C, N)
+    c.set_weights(Q, R, P)
+    c.set_limits(umin=-1, umax=1)
+    H, F = c.H, c.F
+
+set_weights() reuses the prediction matrices, set_limits() only rewrites
+W if the set of finite limits does not change.
+
+For a time-varying model x(k+1) = A(k)*x(k) + B(k)*u(k), y(k) = C(k)*x(k),
+the stages are given as arrays of shape (N, nx, nx), (N, nx, nu) and
+(N, ny, nx) (A(0..N-1), B(0..N-1), C(1..N)), and shift() moves the
+prediction window by one step, computing only the new last stage:
+
+    c = Condenser.ltv(As, Bs, Cs)
+    ...
+    c.shift(A_new, B_new, C_new)
+
+The engine is loaded from the shared library libcondense.so in the folder
+of this file, or from the path in the environment variable CONDENSE_LIB.
+See README.md for how to build it.
+
+(C) 2026 by the Hybrid Toolbox authors
+'''
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+_which = {'H': 0, 'F': 1, 'Y': 2, 'G': 3, 'W': 4, 'S': 5, 'Sbar': 6, 'Tbar': 7}
+
+
+def _load():
+    path = os.environ.get('CONDENSE_LIB')
+    if not path:
+        name = 'condense.dll' if sys.platform.startswith('win') else 'libcondense.so'
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+    lib = ctypes.CDLL(path)
+    dp = ctypes.POINTER(ctypes.c_double)
+    ip = ctypes.POINTER(ctypes.c_int)
+    lib.condense_new.argtypes = [ctypes.c_int] * 5 + [dp, dp, dp]
+    lib.condense_new.restype = ctypes.c_void_p
+    lib.condense_new_ltv.argtypes = [ctypes.c_int] * 5 + [dp, dp, dp]
+    lib.condense_new_ltv.restype = ctypes.c_void_p
+    lib.condense_shift.argtypes = [ctypes.c_void_p, dp, dp, dp]
+    lib.condense_shift.restype = ctypes.c_int
+    lib.condense_set_model.argtypes = [ctypes.c_void_p, dp, dp, dp]
+    lib.condense_set_model.restype = None
+    lib.condense_set_weights.argtypes = [ctypes.c_void_p, dp, dp, dp]
+    lib.condense_set_weights.restype = None
+    lib.condense_set_limits.argtypes = [ctypes.c_void_p, dp, dp, dp, dp]
+    lib.condense_set_limits.restype = None
+    lib.condense_get.argtypes = [ctypes.c_void_p, ctypes.c_int, ip, ip]
+    lib.condense_get.restype = dp
+    lib.condense_counters.argtypes = [ctypes.c_void_p, ip, ip, ip]
+    lib.condense_counters.restype = None
+    lib.condense_free.argtypes = [ctypes.c_void_p]
+    lib.condense_free.restype = None
+    return lib
+
+_lib = _load()
+
+
+def _mat(M, rows, cols):
+    M = np.asarray(M, dtype=np.float64)
+    if M.size == 1 and rows * cols > 1:
+        M = M.ravel()[0] * np.eye(rows, cols)   # scalar weight
+    M = np.asfortranarray(M.reshape((rows, cols), order='F'))
+    return M
+
+
+def _ptr(M):
+    if M is None:
+        return None
+    return M.ctypes.data_as(ctypes.POINTER(ctypes.c_double))
+
+
+def _stages(M, N, rows, cols):
+    # (N, rows, cols) -> the N column-major matrices one after the other
+    M = np.asarray(M, dtype=np.float64).reshape((N, rows, cols))
+    return np.ascontiguousarray(M.transpose(0, 2, 1).reshape(-1))
+
+
+def _lim(v, size):
+    if v is None:
+        return None
+    return np.ascontiguousarray(np.asarray(v, dtype=np.float64).ravel() * np.ones(size))
+
+
+class Condenser(object):
+
+    def __init__(self, A, B, C=None, N=1, Nu=None):
+        A = np.atleast_2d(np.asarray(A, dtype=np.float64))
+        B = np.asarray(B, dtype=np.float64)
+        self.nx = A.shape[0]
+        B = B.reshape((self.nx, -1))
+        self.nu = B.shape[1]
+        self.ny = self.nx if C is None else np.atleast_2d(C).shape[0]
+        self.N = int(N)
+        self.Nu = self.N if Nu is None else int(Nu)
+        self._A = _mat(A, self.nx, self.nx)
+        self._B = _mat(B, self.nx, self.nu)
+        self._C = None if C is None else _mat(C, self.ny, self.nx)
+        self._c = _lib.condense_new(self.nx, self.nu, self.ny, self.N, self.Nu,
+                                    _ptr(self._A), _ptr(self._B), _ptr(self._C))
+        if not self._c:
+            raise ValueError('wrong dimensions or horizons')
+
+    @classmethod
+    def ltv(cls, A, B, C=None, Nu=None):
+        '''Engine for the time-varying model with stages A[k], B[k], C[k]
+        (C[k] is the output matrix of y(k+1)); N = len(A)'''
+        A = np.asarray(A, dtype=np.float64)
+        B = np.asarray(B, dtype=np.float64)
+        self = cls.__new__(cls)
+        self.N, self.nx = A.shape[0], A.shape[1]
+        self.nu = B.reshape((self.N, self.nx, -1)).shape[2]
+        self.ny = self.nx if C is None else np.asarray(C).shape[1]
+        self.Nu = self.N if Nu is None else int(Nu)
+        self._A = _stages(A, self.N, self.nx, self.nx)
+        self._B = _stages(B, self.N, self.nx, self.nu)
+        self._C = None if C is None else _stages(C, self.N, self.ny, self.nx)
+        self._c = _lib.condense_new_ltv(self.nx, self.nu, self.ny, self.N, self.Nu,
+                                        _ptr(self._A), _ptr(self._B), _ptr(self._C))
+        if not self._c:
+            raise ValueError('wrong dimensions or horizons')
+        return self
+
+    def shift(self, A, B, C=None):
+        '''Time-varying models: drop the first stage and append A(N-1),
+        B(N-1), C(N)'''
+        A = _mat(A, self.nx, self.nx)
+        B = _mat(B, self.nx, self.nu)
+        C = None if C is None else _mat(C, self.ny, self.nx)
+        if _lib.condense_shift(self._c, _ptr(A), _ptr(B), _ptr(C)) < 0:
+            raise ValueError('shift() requires a time-varying model')
+
+    def set_model(self, A, B, C=None):
+        if np.ndim(A) == 3:
+            self._A = _stages(A, self.N, self.nx, self.nx)
+            self._B = _stages(B, self.N, self.nx, self.nu)
+            self._C = None if C is None else _stages(C, self.N, self.ny, self.nx)
+        else:
+            self._A = _mat(A, self.nx, self.nx)
+            self._B = _mat(B, self.nx, self.nu)
+            self._C = None if C is None else _mat(C, self.ny, self.nx)
+        _lib.condense_set_model(self._c, _ptr(self._A), _ptr(self._B), _ptr(self._C))
+
+    def set_weights(self, Q, R, P=None):
+        Q = _mat(Q, self.ny, self.ny)
+        R = _mat(R, self.nu, self.nu)
+        P = None if P is None else _mat(P, self.nx, self.nx)
+        _lib.condense_set_weights(self._c, _ptr(Q), _ptr(R), _ptr(P))
+
+    def set_limits(self, umin=None, umax=None, ymin=None, ymax=None):
+        umin = _lim(umin, self.nu)
+        umax = _lim(umax, self.nu)
+        ymin = _lim(ymin, self.ny)
+        ymax = _lim(ymax, self.ny)
+        _lib.condense_set_limits(self._c, _ptr(umin), _ptr(umax), _ptr(ymin), _ptr(ymax))
+
+    def get(self, name):
+        '''Copy of one of the matrices H, F, Y, G, W, S, Sbar, Tbar'''
+        rows = ctypes.c_int(0)
+        cols = ctypes.c_int(0)
+        p = _lib.condense_get(self._c, _which[name], ctypes.byref(rows), ctypes.byref(cols))
+        if rows.value * cols.value == 0:
+            return np.zeros((rows.value, cols.value))
+        v = np.ctypeslib.as_array(p, shape=(rows.value * cols.value,))
+        return v.reshape((rows.value, cols.value), order='F').copy()
+
+    def counters(self):
+        '''Number of computations of the prediction matrices, of H/F/Y and of G/S'''
+        m = ctypes.c_int(0)
+        w = ctypes.c_int(0)
+        c = ctypes.c_int(0)
+        _lib.condense_counters(self._c, ctypes.byref(m), ctypes.byref(w), ctypes.byref(c))
+        return m.value, w.value, c.value
+
+    H = property(lambda self: self.get('H'))
+    F = property(lambda self: self.get('F'))
+    Y = property(lambda self: self.get('Y'))
+    G = property(lambda self: self.get('G'))
+    W = property(lambda self: self.get('W'))
+    S = property(lambda self: self.get('S'))
+    Sbar = property(lambda self: self.get('Sbar'))
+    Tbar = property(lambda self: self.get('Tbar'))
+
+    def __del__(self):
+        if getattr(self, '_c', None):
+            _lib.condense_free(self._c)
+            self._c = None
+
+
+def condense(A, B, C, N, Q, R, P=None, Nu=None, umin=None, umax=None, ymin=None, ymax=None):
+    '''Condensed QP in one call: returns H, F, Y, G, W, S'''
+    c = Condenser(A, B, C, N, Nu)
+    c.set_weights(Q, R, P)
+    c.set_limits(umin, umax, ymin, ymax)
+    return c.H, c.F, c.Y, c.G, c.W, c.S
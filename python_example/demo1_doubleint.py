@@ -1,4 +1,8 @@
-import osqp
+try:
+    # native ADMM solver, factorization done once (see README.md)
+    from admmqp import ADMMQP as QPSolver
+except (ImportError, OSError):
+    from osqp import OSQP as QPSolver
 import numpy as np
 import matplotlib.pyplot as plt
 from scipy import sparse
@@ -67,20 +71,23 @@ status_x0 = []
 status_x1 = []
 U = []
 T = 41
+# P and W do not change: factor once, then only update q, l, u
+P = sparse.csc_matrix(H)
+W = sparse.csc_matrix([[1,0],[1,0],[0,1]])
+prob = None
 for t in range(T):
 	status_x0.append(float(X0[0]))
 	status_x1.append(float(X0[1]))
-	P = sparse.csc_matrix(H)
 	q = np.dot(X0.transpose(),F.transpose()).transpose()
-	W = sparse.csc_matrix([[1,0],[1,0],[0,1]])
-	l = np.array([-1-X0[1],-1,-1])
+	l = np.array([-1-float(X0[1]),-1,-1])
 	u = np.array([float('inf'),1, 1])
 
-	# Create an OSQP object
-	prob = osqp.OSQP()
-
-	# Setup workspace and change alpha parameter
-	prob.setup(P, q, W, l, u, alpha=1.0)
+	if prob is None:
+		# Setup workspace and change alpha parameter
+		prob = QPSolver()
+		prob.setup(sparse.triu(P, format='csc'), q, W, l, u, alpha=1.0)
+	else:
+		prob.update(q=q, l=l, u=u)
 
 	# Solve problem
 	res = prob.solve()
@@ -1,4 +1,8 @@
-import osqp
+try:
+    # native ADMM solver, factorization done once (see README.md)
+    from admmqp import ADMMQP as QPSolver
+except (ImportError, OSError):
+    from osqp import OSQP as QPSolver
 import numpy as np
 import matplotlib.pyplot as plt
 from scipy import sparse
@@ -100,18 +104,20 @@ A_ineq = np.eye(N)
 l = -0.2*np.ones([N,1])
 u = 0.2*np.ones([N,1])
 
+# P and W do not change: factor once, then only update q
+P = sparse.csc_matrix(H)
+W = sparse.csc_matrix(A_ineq)
+prob = None
 for i in range(n):
     r = Y_ref[i]*np.ones([ny*N, 1])
-    P = sparse.csc_matrix(H)
     q = np.dot(F_tmp, (np.dot(CT_bar, x0) - r))
-    W = sparse.csc_matrix(A_ineq)
-    
-    # print A_ineq
-    # Create an OSQP object
-    prob = osqp.OSQP()
 
-	# Setup workspace and change alpha parameter
-    prob.setup(P, q, W, l, u, alpha=1.0)
+    if prob is None:
+        # Setup workspace and change alpha parameter
+        prob = QPSolver()
+        prob.setup(sparse.triu(P, format='csc'), q, W, l, u, alpha=1.0)
+    else:
+        prob.update(q=q)
 
 	# Solve problem
     res = prob.solve()
@@ -1,4 +1,8 @@
-import osqp
+try:
+    # native ADMM solver, factorization done once (see README.md)
+    from admmqp import ADMMQP as QPSolver
+except (ImportError, OSError):
+    from osqp import OSQP as QPSolver
 import numpy as np
 import matplotlib.pyplot as plt
 from scipy import sparse
@@ -101,23 +105,27 @@ for i in range(N):
             A_ineq[i,j] = 1
 
 u_tmp = 0
+# P and W do not change: factor once, then only update q, l, u
+P = sparse.csc_matrix(H)
+W = sparse.csc_matrix(A_ineq)
+prob = None
 for i in range(n):
     t.append(i*ts)
     r = Y_ref[i]*np.ones([ny*N, 1])
-    P = sparse.csc_matrix(H)
     q = np.dot(F_tmp, (np.dot(CT_bar, x0) - r))
-    W = sparse.csc_matrix(A_ineq)
     # l = float('-inf')*np.ones([N,1])
     # u = float('inf')*np.ones([N,1])
     l = 0.8*np.ones([N,1])
     u = 1.2*np.ones([N,1])
     l = l - u_tmp
     u = u - u_tmp
-    # Create an OSQP object
-    prob = osqp.OSQP()
 
-	# Setup workspace and change alpha parameter
-    prob.setup(P, q, W, l, u, alpha=1.0)
+    if prob is None:
+        # Setup workspace and change alpha parameter
+        prob = QPSolver()
+        prob.setup(sparse.triu(P, format='csc'), q, W, l, u, alpha=1.0)
+    else:
+        prob.update(q=q, l=l, u=u)
 
 	# Solve problem
     res = prob.solve()
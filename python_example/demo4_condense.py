@@ -0,0 +1,61 @@
+import time
+import numpy as np
+from condense import Condenser
+
+'''
+Condensing of the MPC problem for the model of demo2 (tf([1],[1,0.4 1]),
+ts = 0.5) for increasing prediction horizons: block loops as in
+demo2_example3.py vs. the native engine (condense.py, see README.md).
+
+    J = sum k from 1 to N: y(k)^2 + 0.04*u(k-1)^2
+    subject to: -1 <= u(k) <= 1, -2 <= y(k) <= 2
+'''
+
+A = np.array([[1.5968225, -0.8187308], [1.0, 0]])
+B = np.array([[0.5], [0]])
+C = np.array([[0.22936237,  0.2144542]])
+nx = 2
+nu = 1
+ny = 1
+Q = np.array([[1.0]])
+R = np.array([[0.04]])
+P = np.dot(C.transpose(), np.dot(Q, C))   # weight on y(N)
+
+
+def condense_loops(N):
+    S_bar = np.zeros([nx*N, nu*N])
+    T_bar = np.zeros([nx*N, nx])
+    Q_bar = np.zeros([nx*N, nx*N])
+    R_bar = np.zeros([nu*N, nu*N])
+    for i in range(N):
+        R_bar[i*nu:(i+1)*nu, i*nu:(i+1)*nu] = R
+        Q_bar[i*nx:(i+1)*nx, i*nx:(i+1)*nx] = P
+        if i == 0:
+            T_bar[0:nx, :] = A
+        else:
+            T_bar[i*nx:(i+1)*nx, :] = np.dot(A, T_bar[(i-1)*nx:i*nx, :])
+    for i in range(N):
+        for j in range(i+1):
+            if i == j:
+                S_bar[i*nx:(i+1)*nx, j*nu:(j+1)*nu] = B
+            else:
+                S_bar[i*nx:(i+1)*nx, j*nu:(j+1)*nu] = np.dot(
+                    A, S_bar[(i-1)*nx:i*nx, j*nu:(j+1)*nu])
+    H = 2.0*(R_bar + np.dot(np.dot(S_bar.transpose(), Q_bar), S_bar))
+    F = 2.0*np.dot(np.dot(S_bar.transpose(), Q_bar), T_bar)
+    return H, F
+
+
+print('     N    loops [s]   native [s]   weights only [s]   max|H1-H2|')
+for N in [10, 50, 100, 200, 400]:
+    t0 = time.time()
+    H1, F1 = condense_loops(N)
+    t1 = time.time()
+    c = Condenser(A, B, C, N)
+    c.set_weights(Q, R, P)
+    c.set_limits(umin=-1, umax=1, ymin=-2, ymax=2)
+    H2 = c.H
+    t2 = time.time()
+    c.set_weights(Q, 2*R, P)   # retuning: prediction matrices are reused
+    t3 = time.time()
+    print('%6d   %10.4f   %10.4f   %16.4f   %10.2e' % (N, t1-t0, t2-t1, t3-t2, abs(H1-H2).max()))